@@ -28,9 +28,9 @@ using namespace std;
     2) EX - Create subdirectories for the master and data nodes
     3) EX - Store the database info in a file
     4) Create the system catalogs
-        - Create RM files for relcat and attrcat
+        - Create RM files for relcat, attrcat and statcat
         - Open the files
-        - Insert the relcat and attrcat records in relcat
+        - Insert the relcat, attrcat and statcat records in relcat
         - Insert the attribute records in  attrcat
         - Close the files
 */
@@ -130,8 +130,9 @@ int main(int argc, char *argv[])
     // Create the system catalogs
     const char* relcatFileName = "relcat";
     const char* attrcatFileName = "attrcat";
+    const char* statcatFileName = "statcat";
 
-    // Create RM files for relcat and attrcat
+    // Create RM files for relcat, attrcat and statcat
     if ((rc = rmManager.CreateFile(relcatFileName, sizeof(SM_RelcatRecord)))) {
         RM_PrintError(rc);
         return rc;
@@ -140,6 +141,10 @@ int main(int argc, char *argv[])
         RM_PrintError(rc);
         return rc;
     }
+    if ((rc = rmManager.CreateFile(statcatFileName, sizeof(SM_StatcatRecord)))) {
+        RM_PrintError(rc);
+        return rc;
+    }
 
     // Open the files
     RM_FileHandle relcatFH;
@@ -181,6 +186,19 @@ int main(int argc, char *argv[])
         return rc;
     }
 
+    // Insert statcat record in relcat
+    strcpy(rcRecord->relName, "statcat");
+    rcRecord->tupleLength = sizeof(SM_StatcatRecord);
+    rcRecord->attrCount = SM_STATCAT_ATTR_COUNT;
+    rcRecord->indexCount = 0;
+    // EX - distributed database
+    rcRecord->distributed = FALSE;
+    strcpy(rcRecord->attrName, "NA");
+    if ((rc = relcatFH.InsertRec((char*) rcRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+
     // Insert relcat attributes in attrcat
     SM_AttrcatRecord* acRecord = new SM_AttrcatRecord;
     memset(acRecord, 0, sizeof(SM_AttrcatRecord));
@@ -192,6 +210,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = STRING;
     acRecord->attrLength = MAXNAME+1;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -204,6 +223,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -215,6 +235,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -226,6 +247,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -237,6 +259,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -248,6 +271,20 @@ int main(int argc, char *argv[])
     acRecord->attrType = STRING;
     acRecord->attrLength = MAXNAME + 1;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += MAXNAME+1;
+    while (currentOffset % 4 != 0) currentOffset++;
+
+    strcpy(acRecord->attrName, "tupleCount");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -262,6 +299,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = STRING;
     acRecord->attrLength = MAXNAME + 1;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -273,6 +311,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = STRING;
     acRecord->attrLength = MAXNAME + 1;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -285,6 +324,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -296,6 +336,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -307,6 +348,7 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -318,6 +360,143 @@ int main(int argc, char *argv[])
     acRecord->attrType = INT;
     acRecord->attrLength = 4;
     acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "indexType");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "distinctCount");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+
+    // Insert statcat attributes in attrcat
+    currentOffset = 0;
+    strcpy(acRecord->relName, "statcat");
+
+    strcpy(acRecord->attrName, "relName");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = STRING;
+    acRecord->attrLength = MAXNAME + 1;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += MAXNAME+1;
+
+    strcpy(acRecord->attrName, "attrName");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = STRING;
+    acRecord->attrLength = MAXNAME + 1;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += MAXNAME+1;
+    while (currentOffset % 4 != 0) currentOffset++;
+
+    strcpy(acRecord->attrName, "tupleCount");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "pageCount");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "distinctCount");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = INT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "minValue");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = FLOAT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "maxValue");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = FLOAT;
+    acRecord->attrLength = 4;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += 4;
+
+    strcpy(acRecord->attrName, "minPrefix");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = STRING;
+    acRecord->attrLength = SM_HISTOGRAM_PREFIX + 1;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
+    if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+        RM_PrintError(rc);
+        return rc;
+    }
+    currentOffset += SM_HISTOGRAM_PREFIX+1;
+
+    strcpy(acRecord->attrName, "maxPrefix");
+    acRecord->offset = currentOffset;
+    acRecord->attrType = STRING;
+    acRecord->attrLength = SM_HISTOGRAM_PREFIX + 1;
+    acRecord->indexNo = -1;
+    acRecord->indexType = -1;
     if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
         RM_PrintError(rc);
         return rc;
@@ -364,7 +543,7 @@ int main(int argc, char *argv[])
                 return rc;
             }
 
-            // Create RM files for relcat and attrcat
+            // Create RM files for relcat, attrcat and statcat
             if ((rc = rmManager.CreateFile(relcatFileName, sizeof(SM_RelcatRecord)))) {
                 RM_PrintError(rc);
                 return rc;
@@ -373,6 +552,10 @@ int main(int argc, char *argv[])
                 RM_PrintError(rc);
                 return rc;
             }
+            if ((rc = rmManager.CreateFile(statcatFileName, sizeof(SM_StatcatRecord)))) {
+                RM_PrintError(rc);
+                return rc;
+            }
 
             // Open the files
             if ((rc = rmManager.OpenFile(relcatFileName, relcatFH))) {
@@ -412,6 +595,19 @@ int main(int argc, char *argv[])
                 return rc;
             }
 
+            // Insert statcat record in relcat
+            strcpy(rcRecord->relName, "statcat");
+            rcRecord->tupleLength = sizeof(SM_StatcatRecord);
+            rcRecord->attrCount = SM_STATCAT_ATTR_COUNT;
+            rcRecord->indexCount = 0;
+            // EX - distributed database
+            rcRecord->distributed = FALSE;
+            strcpy(rcRecord->attrName, "NA");
+            if ((rc = relcatFH.InsertRec((char*) rcRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+
             // Insert relcat attributes in attrcat
             SM_AttrcatRecord* acRecord = new SM_AttrcatRecord;
             memset(acRecord, 0, sizeof(SM_AttrcatRecord));
@@ -423,6 +619,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = STRING;
             acRecord->attrLength = MAXNAME+1;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -435,6 +632,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -446,6 +644,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -457,6 +656,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -468,6 +668,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -479,6 +680,20 @@ int main(int argc, char *argv[])
             acRecord->attrType = STRING;
             acRecord->attrLength = MAXNAME + 1;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += MAXNAME+1;
+            while (currentOffset % 4 != 0) currentOffset++;
+
+            strcpy(acRecord->attrName, "tupleCount");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -493,6 +708,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = STRING;
             acRecord->attrLength = MAXNAME + 1;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -504,6 +720,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = STRING;
             acRecord->attrLength = MAXNAME + 1;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -516,6 +733,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -527,6 +745,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -538,6 +757,7 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
@@ -549,6 +769,143 @@ int main(int argc, char *argv[])
             acRecord->attrType = INT;
             acRecord->attrLength = 4;
             acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "indexType");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "distinctCount");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+
+            // Insert statcat attributes in attrcat
+            currentOffset = 0;
+            strcpy(acRecord->relName, "statcat");
+
+            strcpy(acRecord->attrName, "relName");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = STRING;
+            acRecord->attrLength = MAXNAME + 1;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += MAXNAME+1;
+
+            strcpy(acRecord->attrName, "attrName");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = STRING;
+            acRecord->attrLength = MAXNAME + 1;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += MAXNAME+1;
+            while (currentOffset % 4 != 0) currentOffset++;
+
+            strcpy(acRecord->attrName, "tupleCount");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "pageCount");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "distinctCount");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = INT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "minValue");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = FLOAT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "maxValue");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = FLOAT;
+            acRecord->attrLength = 4;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += 4;
+
+            strcpy(acRecord->attrName, "minPrefix");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = STRING;
+            acRecord->attrLength = SM_HISTOGRAM_PREFIX + 1;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
+            if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
+                RM_PrintError(rc);
+                return rc;
+            }
+            currentOffset += SM_HISTOGRAM_PREFIX+1;
+
+            strcpy(acRecord->attrName, "maxPrefix");
+            acRecord->offset = currentOffset;
+            acRecord->attrType = STRING;
+            acRecord->attrLength = SM_HISTOGRAM_PREFIX + 1;
+            acRecord->indexNo = -1;
+            acRecord->indexType = -1;
             if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
                 RM_PrintError(rc);
                 return rc;
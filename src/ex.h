@@ -8,8 +8,11 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
 #include "redbase.h"
 #include <vector>
+#include <string>
+#include <memory>
 #include "parser.h"
 #include "printer.h"
 #include "rm.h"
@@ -70,6 +73,25 @@ struct EX_StringPartitionVectorRecord {
     }
 };
 
+// EX_RoutingTable - Partition vector of a distributed relation kept in memory
+/* Stores the following:
+    1) relName - name of the relation - char*
+    2) attrName - name of the partition attribute - char*
+    3) attrType - type of the partition attribute - AttrType
+    4) partitioning - EX_RANGE_PARTITIONED or EX_HASH_PARTITIONED - integer
+    5) intRanges / floatRanges / stringRanges - partition vector records of the attribute type
+       (ranges of hash buckets in intRanges for hash partitioning), sorted by start value - vector
+*/
+struct EX_RoutingTable {
+    char relName[MAXNAME+1];
+    char attrName[MAXNAME+1];
+    AttrType attrType;
+    int partitioning;
+    vector<EX_IntPartitionVectorRecord> intRanges;
+    vector<EX_FloatPartitionVectorRecord> floatRanges;
+    vector<EX_StringPartitionVectorRecord> stringRanges;
+};
+
 // Constants
 #define EX_DBINFO_ATTR_COUNT            2
 #define EX_PARTITION_VECTOR_ATTR_COUNT  3
@@ -82,18 +104,135 @@ struct EX_StringPartitionVectorRecord {
 #define MIN_STRING  ""
 #define MAX_STRING  "zzzzzzzz"
 
+// Hash partitioning
+/* A value is hashed into one of EX_HASH_BUCKETS buckets, and the partition vector of the
+   relation gives the range of buckets of each node. The bucket of a value never changes, so
+   the nodes can be rebalanced by moving ranges of buckets instead of rehashing every tuple.
+*/
+#define EX_HASH_BUCKETS     4096
+
+
+// EX_MessageHeader - Header of a message sent by a data node worker process
+/* Stores the following:
+    1) type - EX_TUPLES_MESSAGE or EX_END_MESSAGE - integer
+    2) length - number of bytes following the header - integer
+*/
+struct EX_MessageHeader {
+    int type;
+    int length;
+};
+
+// EX_Worker - Worker process running a query fragment of a data node
+/* Stores the following:
+    1) node - data node of the fragment - integer
+    2) pid - process id of the worker (0 for a worker of another process) - pid_t
+    3) socket - end of the socket pair read by the master node - integer
+    4) tupleLength - length of the tuples sent by the worker - integer
+*/
+struct EX_Worker {
+    int node;
+    pid_t pid;
+    int socket;
+    int tupleLength;
+};
+
+// Messages of the worker processes
+#define EX_TUPLES_MESSAGE               1   // Tuples of the fragment, stored back to back
+#define EX_END_MESSAGE                  2   // Return code of the fragment, then its printed plan
+#define EX_MESSAGE_SIZE                 (PF_PAGE_SIZE*4) // Bytes of tuples sent in a message
+#define EX_SOCKET_MESSAGES              2   // Messages a worker may send ahead of the master node
+
+
+// EX_Repartition - Tuples of a relation sent into a data node by the workers of the other nodes
+/* Stores the following:
+    1) fileName - temporary file of the data node storing the tuples - string
+    2) tupleLength - length of the tuples - integer
+    3) sockets - end of the socket from each worker sending the tuples - vector<int>
+*/
+struct EX_Repartition {
+    string fileName;
+    int tupleLength;
+    vector<int> sockets;
+};
+
+// How each relation of a join in the data nodes gets there
+#define EX_IN_PLACE                     0   // Fragments (or copies) stored in the data nodes
+#define EX_REPARTITIONED                1   // Sent between the data nodes by the join key
+#define EX_BROADCAST                    2   // Sent whole by the master node to every data node
+
+
+// EX_WorkerStream class
+// Stream of the tuples sent by the workers of a fragment, merged as they arrive
+/* The stream holds the message of tuples being returned, while the socket of each worker
+   buffers at most EX_SOCKET_MESSAGES more: a worker filling its next message blocks till
+   the master node reads, so the tuples in flight stay bounded without any temporary file.
+*/
+class EX_WorkerStream {
+public:
+    EX_WorkerStream(const vector<EX_Worker> &workers);
+    ~EX_WorkerStream();
+
+    RC GetNext(char* tupleData);                // Get the next tuple of any worker
+    RC End();                                   // End the workers and get their return code
+    void PrintPlans(int indentationLevel);      // Print the plans sent by the workers
+    int GetTupleLength() const;
+
+private:
+    vector<EX_Worker> workers;
+    vector<int> nodes;                          // Data nodes of the workers
+    vector<bool> done;                          // Whether the end message of the worker arrived
+    vector<int> workerRCs;                      // Return codes of the workers
+    vector<string> plans;                       // Plans printed by the workers
+    int nDone;
+    int nextWorker;                             // Worker polled first for the next message
+    int tupleLength;
+    vector<char> batch;                         // Message of tuples being returned
+    int batchLength;
+    int batchPosition;                          // Offset of the next tuple in the message
+    bool ended;
+    bool failed;                                // Whether GetNext already returned an error
+
+    RC ReadNextMessage();
+};
+
+
+struct SM_StatcatRecord;
+class QL_Manager;
+class QL_ShuffleDataOp;
+class QL_Op;
+
+// EX_DataNodeSession - Database of a data node kept open by the communication layer
+/* Stores the following:
+    1) smManager - SM_Manager with the catalogs of the data node open - SM_Manager*
+    2) qlManager - QL_Manager running the queries in the data node - QL_Manager*
+*/
+struct EX_DataNodeSession {
+    SM_Manager* smManager;
+    QL_Manager* qlManager;
+};
 
 // EX_CommLayer class
 // Class to simulate the communication layer for the distributed redbase
+/* The master SM_Manager keeps one communication layer while its database is open. The
+   database of a data node is opened the first time the node is used and stays open in its
+   session, so the methods only change to the directory of the node and back.
+   The query fragments of a data node run in a worker process forked in the directory of
+   the node, which streams the tuples back to the master node through a socket pair.
+   GetDataFromDataNode, JoinInDataNode and AggregateInDataNode only start the worker, so
+   the fragments of all the nodes run concurrently till GatherFromWorkers merges them.
+   RepartitionJoin also connects the workers of the data nodes with each other, so that the
+   tuples of a relation are sent to the data node of their join key without the master node,
+   and may broadcast the small relations of the master node to every data node.
+*/
 class EX_CommLayer {
 public:
-    EX_CommLayer(RM_Manager* rmm, IX_Manager* ixm);
+    EX_CommLayer(RM_Manager* rmm, IX_Manager* ixm, SM_Manager* masterSmm);
     ~EX_CommLayer();
 
     RC CreateTableInDataNode(const char* relName, int attrCount, AttrInfo* attributes, int node);
     RC DropTableInDataNode(const char* relName, int node);
     RC PrintInDataNode(Printer &p, const char* relName, int node);
-    RC CreateIndexInDataNode(const char* relName, const char* attrName, int node);
+    RC CreateIndexInDataNode(const char* relName, const char* attrName, IX_IndexType indexType, int node);
     RC DropIndexInDataNode(const char* relName, const char* attrName, int node);
     RC LoadInDataNode(const char* relName, vector<string> nodeTuples, int node);
     RC InsertInDataNode(const char* relName, int nValues, const Value values[], int node);
@@ -101,28 +240,79 @@ public:
     RC DeleteInDataNode(const char* relName, int nConditions, const Condition conditions[], int node);
     RC UpdateInDataNode(const char* relName, const RelAttr &updAttr, const int bIsValue, const RelAttr &rhsRelAttr,
                         const Value &rhsValue, int nConditions, const Condition conditions[], int node, bool reshuffle);
-    RC GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMFH, int node,
-                           bool isCond, Condition* filterCond, Condition conditions[], int &nConditions);
+    RC GetDataFromDataNode(const char* relName, int node,
+                           bool isCond, Condition* filterCond, const Condition conditions[], int nConditions,
+                           int nProjAttrs, RelAttr projAttrs[]);
+    RC AnalyzeInDataNode(const char* relName, int samplePercent, int attrCount,
+                         SM_StatcatRecord* statistics, int node);
+
+    // Optimize joins of co-partitioned relations
+    RC JoinInDataNode(int nRelations, const char* const relations[], int nConditions, const Condition conditions[],
+                      int nProjAttrs, RelAttr projAttrs[], int node);
+
+    // Join relations that are not co-partitioned by repartitioning them between the data nodes
+    RC RepartitionJoin(int nRelations, const char* const relations[], const RelAttr keyAttrs[],
+                       const int exchanges[], const int tupleCounts[], const EX_RoutingTable &routingTable,
+                       int nConditions, const Condition conditions[], int nProjAttrs, RelAttr projAttrs[],
+                       const bool joinNodes[]);
 
-    // Optimize joins
-    RC JoinInDataNode(const char* rel1, const char* rel2, Condition* joinCond, int node, RM_FileHandle &rmFH,
-                      bool isCond1, Condition* filterCond1, bool isCond2, Condition* filterCond2);
+    // Aggregate in data nodes
+    RC AggregateInDataNode(const char* relName, int node, int nConditions, const Condition conditions[],
+                           int nGroupAttrs, const RelAttr groupAttrs[], int nAggs, const AggFun aggFuns[],
+                           const RelAttr aggAttrs[]);
+
+    // Get the data of the fragments started in the data nodes since the last call
+    RC GatherFromWorkers(RM_FileHandle &rmFH, int* tupleCount = NULL);
+    // Hand the workers started since the last call over to a stream read by the master node
+    void TakeWorkers(vector<EX_Worker> &startedWorkers);
+
+    // Close the databases of the data nodes
+    RC CloseSessions();
 
 private:
     RM_Manager* rmManager;
     IX_Manager* ixManager;
-    SM_Manager* smManager;
+    SM_Manager* masterManager;                  // SM_Manager of the master node
+    vector<EX_DataNodeSession> sessions;        // Session of each data node (index 0 unused)
+    SM_Manager* smManager;                      // Managers of the data node entered
     QL_Manager* qlManager;
+    vector<EX_Worker> workers;                  // Workers started and not gathered yet
+    vector<int> exchangeSockets;                // Sockets between the workers of a repartitioning
+
+    RC EnterDataNode(int node);                 // Change to the directory of the data node
+    RC LeaveDataNode();                         // Change back to the master node
+
+    // Run the shuffle operator of a fragment in a worker process of the data node entered
+    // (after storing the tuples repartitioned into the data node)
+    RC StartWorker(QL_ShuffleDataOp* shuffleOp, int node,
+                   const vector<EX_Repartition> &repartitions = vector<EX_Repartition>());
+    // Close the sockets of the workers started and wait for them
+    void DiscardWorkers();
+    // Create a socket between two workers of a repartitioning
+    RC ConnectWorkers(int &sendSocket, int &receiveSocket);
+    // Close the sockets between the workers in the master node
+    void CloseExchangeSockets();
+    // Create the scan of a relation of a node, filtered with the conditions on it
+    RC CreateScanOp(SM_Manager* nodeManager, const char* relName, int nConditions,
+                    const Condition conditions[], std::shared_ptr<QL_Op> &scanOp);
 };
 
 
 // Helper methods for EX part
-RC GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relName,
+RC LoadRoutingTable(RM_Manager* rmManager, const char* relName, const char* attrName,
+                    AttrType attrType, int partitioning, EX_RoutingTable &routingTable);
+int EX_HashBucket(const Value &key);
+RC GetDataNodeForTuple(SM_Manager* smManager, const Value key, const char* relName,
                        const char* attrName, int &node);
-RC CheckDataNodeForCondition(RM_Manager* rmManager, const char* relName, const char* attrName,
-                             Condition checkCondition, int node, bool &valid);
-template <typename T>
-bool MatchValues(T start, T end, CompOp op, T value);
+RC GetDataNodeForKey(const EX_RoutingTable &routingTable, const Value &key, int &node);
+RC GetDataNodesForConditions(SM_Manager* smManager, const char* relName, const char* attrName,
+                             int nConditions, const Condition conditions[], vector<bool> &nodes);
+RC CheckCoPartitioned(SM_Manager* smManager, const char* relName1, const char* attrName1,
+                      const char* relName2, const char* attrName2, AttrType attrType, bool &coPartitioned);
+RC EX_WriteMessage(int socket, int type, const char* data, int length);
+RC EX_ReadMessage(int socket, EX_MessageHeader &header, vector<char> &data);
+void EX_EndWorkers(vector<EX_Worker> &workers);
+RC EX_ReceiveRepartition(RM_Manager* rmManager, const EX_Repartition &repartition);
 
 // Print-error function
 void EX_PrintError(RC rc);
@@ -133,10 +323,13 @@ void EX_PrintError(RC rc);
 #define EX_INVALID_VALUE                    (START_EX_WARN + 2) // Invalid value
 #define EX_INVALID_DATA_NODE                (START_EX_WARN + 3) // Invalid data node
 #define EX_INCONSISTENT_PV                  (START_EX_WARN + 4) // Inconsistent partition vector
-#define EX_LASTWARN                         EX_INCONSISTENT_PV
+#define EX_STREAM_ENDED                     (START_EX_WARN + 5) // Stream of the workers already ended
+#define EX_EOF                              (START_EX_WARN + 6) // End of the stream of the workers
+#define EX_LASTWARN                         EX_EOF
 
 // Errors
-#define EX_UNIX                             (START_EX_ERR - 0) // Unix error
+#define EX_WORKER_FAILED                    (START_EX_ERR - 0) // Worker process ended without its result
+#define EX_UNIX                             (START_EX_ERR - 1) // Unix error
 #define EX_LASTERROR                        EX_UNIX
 
 #endif
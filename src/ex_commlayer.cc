@@ -9,6 +9,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <algorithm>
 #include "redbase.h"
 #include "rm.h"
 #include "ix.h"
@@ -24,21 +25,92 @@ using namespace std;
 /***** EX_CommLayer class */
 
 // Constructor
-EX_CommLayer::EX_CommLayer(RM_Manager* rmm, IX_Manager* ixm) {
+EX_CommLayer::EX_CommLayer(RM_Manager* rmm, IX_Manager* ixm, SM_Manager* masterSmm) {
     // Set the class members
     rmManager = rmm;
     ixManager = ixm;
-
-    // Create SM and QL managers
-    smManager = new SM_Manager(*ixManager, *rmManager);
-    qlManager = new QL_Manager(*smManager, *ixManager, *rmManager);
+    masterManager = masterSmm;
+    smManager = NULL;
+    qlManager = NULL;
 }
 
 // Destructor
 EX_CommLayer::~EX_CommLayer() {
-    // Delete SM and QL managers
-    delete smManager;
-    delete qlManager;
+    // Close the data nodes and delete their SM and QL managers
+    CloseSessions();
+}
+
+
+// Method: EnterDataNode(int node)
+// Change to the directory of the data node, opening its database the first time
+RC EX_CommLayer::EnterDataNode(int node) {
+    int rc;
+    string dataNode = "data." + to_string(node);
+
+    // Create the session of the data node
+    if (node >= (int) sessions.size()) {
+        EX_DataNodeSession emptySession = { NULL, NULL };
+        sessions.resize(node+1, emptySession);
+    }
+    EX_DataNodeSession &session = sessions[node];
+    if (session.smManager == NULL) {
+        session.smManager = new SM_Manager(*ixManager, *rmManager);
+        session.qlManager = new QL_Manager(*session.smManager, *ixManager, *rmManager);
+    }
+
+    // Open the database, or change to its directory if it is open
+    if (!session.smManager->getOpenFlag()) {
+        if ((rc = session.smManager->OpenDb(dataNode.c_str()))) {
+            return rc;
+        }
+    }
+    else if (chdir(dataNode.c_str()) == -1) {
+        return EX_INVALID_DATA_NODE;
+    }
+
+    smManager = session.smManager;
+    qlManager = session.qlManager;
+    return OK_RC;
+}
+
+// Method: LeaveDataNode()
+// Change back to the directory of the master node (the database of the data node stays open)
+RC EX_CommLayer::LeaveDataNode() {
+    if (chdir("../") == -1) {
+        return EX_INVALID_DATA_NODE;
+    }
+    return OK_RC;
+}
+
+// Method: CloseSessions()
+// Close the databases of the data nodes (called from the directory of the master node)
+RC EX_CommLayer::CloseSessions() {
+    // End the workers that were not gathered
+    DiscardWorkers();
+
+    int rc = OK_RC;
+    for (int node=1; node<(int) sessions.size(); node++) {
+        EX_DataNodeSession &session = sessions[node];
+        if (session.smManager != NULL && session.smManager->getOpenFlag()) {
+            // Closing the database changes back to the master node
+            string dataNode = "data." + to_string(node);
+            if (chdir(dataNode.c_str()) == -1) {
+                rc = EX_INVALID_DATA_NODE;
+            }
+            else {
+                RC closeRC = session.smManager->CloseDb();
+                if (closeRC && !rc) {
+                    rc = closeRC;
+                }
+            }
+        }
+        delete session.qlManager;
+        delete session.smManager;
+    }
+    sessions.clear();
+    smManager = NULL;
+    qlManager = NULL;
+    return rc;
 }
 
 
@@ -46,10 +118,9 @@ EX_CommLayer::~EX_CommLayer() {
 // Create a table in the data node
 RC EX_CommLayer::CreateTableInDataNode(const char* relName, int attrCount, AttrInfo* attributes, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the database
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -59,7 +130,7 @@ RC EX_CommLayer::CreateTableInDataNode(const char* relName, int attrCount, AttrI
     }
 
     // Close the database
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -71,10 +142,9 @@ RC EX_CommLayer::CreateTableInDataNode(const char* relName, int attrCount, AttrI
 // Drop a table from the data node
 RC EX_CommLayer::DropTableInDataNode(const char* relName, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -84,7 +154,7 @@ RC EX_CommLayer::DropTableInDataNode(const char* relName, int node) {
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -98,10 +168,9 @@ RC EX_CommLayer::PrintInDataNode(Printer &p, const char* relName, int node) {
     int rc;
     RM_Record rec;
     char* recordData;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -140,7 +209,7 @@ RC EX_CommLayer::PrintInDataNode(Printer &p, const char* relName, int node) {
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -148,24 +217,25 @@ RC EX_CommLayer::PrintInDataNode(Printer &p, const char* relName, int node) {
 }
 
 
-// Method: CreateIndexInDataNode(const char* relName, const char* attrName, int node)
+// Method: CreateIndexInDataNode(const char* relName, const char* attrName,
+//                               IX_IndexType indexType, int node)
 // Create an index in the data node
-RC EX_CommLayer::CreateIndexInDataNode(const char* relName, const char* attrName, int node) {
+RC EX_CommLayer::CreateIndexInDataNode(const char* relName, const char* attrName,
+                                       IX_IndexType indexType, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
     // Create the index
-    if ((rc = smManager->CreateIndex(relName, attrName))) {
+    if ((rc = smManager->CreateIndex(relName, attrName, indexType))) {
         return rc;
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -177,10 +247,9 @@ RC EX_CommLayer::CreateIndexInDataNode(const char* relName, const char* attrName
 // Create an index in the data node
 RC EX_CommLayer::DropIndexInDataNode(const char* relName, const char* attrName, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -190,7 +259,7 @@ RC EX_CommLayer::DropIndexInDataNode(const char* relName, const char* attrName,
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -202,10 +271,9 @@ RC EX_CommLayer::DropIndexInDataNode(const char* relName, const char* attrName,
 // Load the tuples in the vector to the relation in the data node
 RC EX_CommLayer::LoadInDataNode(const char* relName, vector<string> nodeTuples, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -331,7 +399,7 @@ RC EX_CommLayer::LoadInDataNode(const char* relName, vector<string> nodeTuples,
     delete[] tupleData;
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -343,10 +411,9 @@ RC EX_CommLayer::LoadInDataNode(const char* relName, vector<string> nodeTuples,
 // Insert a tuple in the data node
 RC EX_CommLayer::InsertInDataNode(const char* relName, int nValues, const Value values[], int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -357,7 +424,7 @@ RC EX_CommLayer::InsertInDataNode(const char* relName, int nValues, const Value
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -369,10 +436,9 @@ RC EX_CommLayer::InsertInDataNode(const char* relName, int nValues, const Value
 // Insert a tuple in the data node
 RC EX_CommLayer::InsertInDataNode(const char* relName, const char* recordData, int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -394,7 +460,7 @@ RC EX_CommLayer::InsertInDataNode(const char* relName, const char* recordData, i
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -406,10 +472,9 @@ RC EX_CommLayer::InsertInDataNode(const char* relName, const char* recordData, i
 // Pass a delete query to the data node
 RC EX_CommLayer::DeleteInDataNode(const char* relName, int nConditions, const Condition conditions[], int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -420,7 +485,7 @@ RC EX_CommLayer::DeleteInDataNode(const char* relName, int nConditions, const Co
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -434,10 +499,9 @@ RC EX_CommLayer::DeleteInDataNode(const char* relName, int nConditions, const Co
 RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, const int bIsValue, const RelAttr &rhsRelAttr,
                                   const Value &rhsValue, int nConditions, const Condition conditions[], int node, bool reshuffle) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -484,7 +548,7 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
         }
 
         // Close the data node
-        if ((rc = smManager->CloseDb())) {
+        if ((rc = LeaveDataNode())) {
             return rc;
         }
 
@@ -504,7 +568,7 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
                 key.data = keyValue;
 
                 // Get the node for the key
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, updAttr.attrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(masterManager, key, relName, updAttr.attrName, dataNode))) {
                     return rc;
                 }
                 delete keyValue;
@@ -515,7 +579,7 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
                 key.data = keyValue;
 
                 // Get the node for the key
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, updAttr.attrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(masterManager, key, relName, updAttr.attrName, dataNode))) {
                     return rc;
                 }
                 delete keyValue;
@@ -526,7 +590,7 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
                 key.data = keyValue;
 
                 // Get the node for the key
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, updAttr.attrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(masterManager, key, relName, updAttr.attrName, dataNode))) {
                     return rc;
                 }
                 delete[] keyValue;
@@ -565,7 +629,7 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
     // No need to reshuffle
     else {
         // Close the data node
-        if ((rc = smManager->CloseDb())) {
+        if ((rc = LeaveDataNode())) {
             return rc;
         }
     }
@@ -574,16 +638,20 @@ RC EX_CommLayer::UpdateInDataNode(const char* relName, const RelAttr &updAttr, c
 }
 
 
-// Method: GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMFH, int node,
-//                             bool isCond, Condition* filterCond, Condition conditions[], int &nConditions)
-// Get data for a relation from the data node
-RC EX_CommLayer::GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMFH, int node,
-                                     bool isCond, Condition* filterCond, Condition conditions[], int &nConditions) {
+// Method: GetDataFromDataNode(const char* relName, int node,
+//                             bool isCond, Condition* filterCond, const Condition conditions[], int nConditions,
+//                             int nProjAttrs, RelAttr projAttrs[])
+// Start getting data for a relation from the data node, projected on projAttrs unless nProjAttrs
+// is 0 (the data is received by GatherFromWorkers)
+// A condition of the relation may be used for an index scan; the conditions are not changed,
+// since all the data nodes use them and the master node checks them again
+RC EX_CommLayer::GetDataFromDataNode(const char* relName, int node,
+                                     bool isCond, Condition* filterCond, const Condition conditions[], int nConditions,
+                                     int nProjAttrs, RelAttr projAttrs[]) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
@@ -615,7 +683,7 @@ RC EX_CommLayer::GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMF
             if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
                 return rc;
             }
-            if (attributeData->indexNo != -1) {
+            if (IndexSupportsCondition(*attributeData, cond.op)) {
                 indexScan = true;
                 indexCondition = i;
                 break;
@@ -632,7 +700,6 @@ RC EX_CommLayer::GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMF
     if (indexScan) {
         Condition cond = conditions[indexCondition];
         scanOp.reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relName, (cond.lhsAttr).attrName, cond.op, &cond.rhsValue));
-        RemoveCondition(conditions, nConditions, indexCondition);
         rootOp = scanOp;
 
         // Create a filter operation in case of additional condition
@@ -652,30 +719,54 @@ RC EX_CommLayer::GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMF
         rootOp = scanOp;
     }
 
-    // Create and open the shuffle operator
+    // Project the tuples on the needed attributes before sending them
+    if (nProjAttrs > 0) {
+        rootOp.reset(new QL_ProjectOp(smManager, rootOp, nProjAttrs, projAttrs));
+    }
+
+    // Start the shuffle operator in a worker process of the data node
     QL_ShuffleDataOp* shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, node, 0);
-    if ((rc = shuffleOp->Open())) {
+    rc = StartWorker(shuffleOp, node);
+    delete shuffleOp;
+    if (rc) {
         return rc;
     }
 
-    // Get the data via the shuffle operator
-    if ((rc = shuffleOp->GetData(tempRMFH))) {
+    // Close the data node
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
-    // Close the operator
-    if ((rc = shuffleOp->Close())) {
+    return OK_RC;
+}
+
+
+// Method: AnalyzeInDataNode(const char* relName, int samplePercent, int attrCount,
+//                            SM_StatcatRecord* statistics, int node)
+// Collect the statistics of the relation in the data node and return them
+RC EX_CommLayer::AnalyzeInDataNode(const char* relName, int samplePercent, int attrCount,
+                                   SM_StatcatRecord* statistics, int node) {
+    int rc;
+
+    // Open the data node
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
-    // Print the shuffle operator
-    if (bQueryPlans) {
-        shuffleOp->Print(0);
+    // Analyze the relation and read back its statcat records
+    if ((rc = smManager->Analyze(relName, samplePercent))) {
+        return rc;
+    }
+    int found;
+    if ((rc = smManager->GetStatInfo(relName, attrCount, statistics, found))) {
+        return rc;
+    }
+    if (!found) {
+        return SM_INCORRECT_ATTRIBUTE_COUNT;
     }
-    delete shuffleOp;
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
@@ -684,71 +775,433 @@ RC EX_CommLayer::GetDataFromDataNode(const char* relName, RM_FileHandle &tempRMF
 
 
 // Optimize by performing join in data node
-// Method: JoinInDataNode(const char* rel1, const char* rel2, Condition* joinCond, int node, RM_FileHandle &rmFH,
-//                        bool isCond1, Condition* filterCond1, bool isCond2, Condition* filterCond2)
-// Join relations in the data node
-RC EX_CommLayer::JoinInDataNode(const char* rel1, const char* rel2, Condition* joinCond, int node, RM_FileHandle &rmFH,
-                                bool isCond1, Condition* filterCond1, bool isCond2, Condition* filterCond2) {
+// Method: JoinInDataNode(int nRelations, const char* const relations[], int nConditions, const Condition conditions[],
+//                        int nProjAttrs, RelAttr projAttrs[], int node)
+// Start joining co-partitioned relations in the data node with all the conditions on them, in the
+// join order chosen by the optimizer from the catalogs and statistics of the data node, and
+// shipping the needed attributes of the result (received by GatherFromWorkers or a stream)
+RC EX_CommLayer::JoinInDataNode(int nRelations, const char* const relations[], int nConditions, const Condition conditions[],
+                                int nProjAttrs, RelAttr projAttrs[], int node) {
     int rc;
-    string dataNode = "data." + to_string(node);
 
     // Open the data node
-    if ((rc = smManager->OpenDb(dataNode.c_str()))) {
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
-    // Create the scan operators
-    shared_ptr<QL_Op> scanOp1;
-    shared_ptr<QL_Op> scanOp2;
+    // Get the relations and attributes information of the data node
+    SM_RelcatRecord* rcRecords[nRelations];
+    DataAttrInfo* attributes[nRelations];
+    int scanAttrCounts[nRelations];
+    DataAttrInfo* scanAttributes[nRelations];
+    for (int i=0; i<nRelations; i++) {
+        rcRecords[i] = new SM_RelcatRecord;
+        memset(rcRecords[i], 0, sizeof(SM_RelcatRecord));
+        attributes[i] = NULL;
+        scanAttributes[i] = NULL;
+    }
+    for (int i=0; i<nRelations && !rc; i++) {
+        if (!(rc = smManager->GetRelInfo(relations[i], rcRecords[i]))) {
+            scanAttrCounts[i] = rcRecords[i]->attrCount;
+            attributes[i] = new DataAttrInfo[rcRecords[i]->attrCount];
+            rc = smManager->GetAttrInfo(relations[i], rcRecords[i]->attrCount, (char*) attributes[i]);
+        }
+    }
 
-    // Do file scan for rel1
-    if (isCond1) {
-        scanOp1.reset(new QL_FileScanOp(smManager, rmManager, rel1, true, (filterCond1->lhsAttr).attrName, filterCond1->op, &(filterCond1->rhsValue)));
+    // Form the join tree, projected on the needed attributes
+    shared_ptr<QL_Op> rootOp;
+    if (!rc) {
+        QL_Optimizer optimizer(smManager, ixManager, rmManager, nRelations, relations, rcRecords, attributes,
+                               nConditions, conditions, nProjAttrs, projAttrs, scanAttrCounts, scanAttributes);
+        if (!(rc = optimizer.Optimize(rootOp))) {
+            rootOp.reset(new QL_ProjectOp(smManager, rootOp, nProjAttrs, projAttrs));
+        }
     }
-    else {
-        scanOp1.reset(new QL_FileScanOp(smManager, rmManager, rel1, false, NULL, NO_OP, NULL));
+    for (int i=0; i<nRelations; i++) {
+        delete rcRecords[i];
+        delete[] attributes[i];
+    }
+    if (rc) {
+        LeaveDataNode();
+        return rc;
     }
 
-    // Do file scan for rel2
-    if (isCond2) {
-        scanOp2.reset(new QL_FileScanOp(smManager, rmManager, rel2, true, (filterCond2->lhsAttr).attrName, filterCond2->op, &(filterCond2->rhsValue)));
+    // Start the shuffle operator in a worker process of the data node
+    QL_ShuffleDataOp* shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, node, 0);
+    rc = StartWorker(shuffleOp, node);
+    delete shuffleOp;
+    if (rc) {
+        return rc;
     }
-    else {
-        scanOp2.reset(new QL_FileScanOp(smManager, rmManager, rel2, false, NULL, NO_OP, NULL));
+
+    // Close the data node
+    if ((rc = LeaveDataNode())) {
+        return rc;
     }
 
-    // Create the join operator
-    shared_ptr<QL_Op> joinOp;
-    joinOp.reset(new QL_NLJoinOp(smManager, scanOp1, scanOp2, *joinCond));
+    return OK_RC;
+}
 
-    // Create and open the shuffle operator
-    QL_ShuffleDataOp* shuffleOp = new QL_ShuffleDataOp(rmManager, joinOp, node, 0);
-    if ((rc = shuffleOp->Open())) {
-        return rc;
+
+// Optimize by repartitioning the relations of a join between the data nodes
+// Method: RepartitionJoin(int nRelations, const char* const relations[], const RelAttr keyAttrs[],
+//                         const int exchanges[], const int tupleCounts[], const EX_RoutingTable &routingTable,
+//                         int nConditions, const Condition conditions[], int nProjAttrs, RelAttr projAttrs[],
+//                         const bool joinNodes[])
+// Start joining relations that are not co-partitioned in the data nodes: each data node sends the
+// tuples of the repartitioned relations to the data node of their join key (keyAttrs) in routingTable,
+// the master node sends the tuples of the broadcast relations to every data node joining, and each
+// data node joining (joinNodes[node], all of them if a relation is repartitioned) joins the tuples it
+// receives with its fragments (or copies) of the other relations, shipping the needed attributes of
+// the result (received by GatherFromWorkers or a stream)
+/* Steps:
+    1) Create a socket from each data node to each data node for each repartitioned relation,
+       and from the master node to each data node joining for each broadcast relation
+    2) Start the workers sending the repartitioned relations in every data node, and the broadcast
+       relations in the master node, filtered with their conditions and projected on the
+       attributes needed by the join
+    3) Start the workers joining in the data nodes with the other conditions, the relations sent
+       read from temporary files (estimated to hold tupleCounts / nodes tuples if repartitioned)
+    4) Close the sockets between the workers in the master node
+*/
+RC EX_CommLayer::RepartitionJoin(int nRelations, const char* const relations[], const RelAttr keyAttrs[],
+                                 const int exchanges[], const int tupleCounts[], const EX_RoutingTable &routingTable,
+                                 int nConditions, const Condition conditions[], int nProjAttrs, RelAttr projAttrs[],
+                                 const bool joinNodes[]) {
+    int rc;
+    int numberNodes = masterManager->getNumberNodes();
+
+    // Find the data nodes joining
+    bool repartitioning = false;
+    for (int k=0; k<nRelations; k++) {
+        if (exchanges[k] == EX_REPARTITIONED) {
+            repartitioning = true;
+        }
+    }
+    vector<int> joiningNodes;
+    for (int j=1; j<=numberNodes; j++) {
+        if (repartitioning || joinNodes[j]) {
+            joiningNodes.push_back(j);
+        }
     }
 
-    // Get the data via the shuffle operator
-    if ((rc = shuffleOp->GetData(rmFH))) {
+    // Create the sockets
+    // (sendSockets[i][k] sends relation k from node i, or the master node 0, to each data node
+    // joining, where receiveSockets[j][k] holds the sockets of the sending nodes in order)
+    vector<vector<vector<int> > > sendSockets(numberNodes+1, vector<vector<int> >(nRelations));
+    vector<vector<vector<int> > > receiveSockets(numberNodes+1, vector<vector<int> >(nRelations));
+    for (int i=0; i<=numberNodes; i++) {
+        for (int k=0; k<nRelations; k++) {
+            if (exchanges[k] != (i == 0 ? EX_BROADCAST : EX_REPARTITIONED)) {
+                continue;
+            }
+            for (int n=0; n<(int) joiningNodes.size(); n++) {
+                int sendSocket;
+                int receiveSocket;
+                if ((rc = ConnectWorkers(sendSocket, receiveSocket))) {
+                    CloseExchangeSockets();
+                    return rc;
+                }
+                sendSockets[i][k].push_back(sendSocket);
+                receiveSockets[joiningNodes[n]][k].push_back(receiveSocket);
+            }
+        }
+    }
+
+    // Split the conditions into those of a single relation sent, checked before sending its
+    // tuples, and those of the join
+    vector<vector<Condition> > sendConditions(nRelations);
+    vector<Condition> joinConditions;
+    for (int c=0; c<nConditions; c++) {
+        const Condition &cond = conditions[c];
+        int k = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+        if (exchanges[k] != EX_IN_PLACE && (!cond.bRhsIsAttr || strcmp((cond.rhsAttr).relName, relations[k]) == 0)) {
+            sendConditions[k].push_back(cond);
+        }
+        else {
+            joinConditions.push_back(cond);
+        }
+    }
+
+    // Get the attributes of the relations sent needed by the join
+    vector<vector<RelAttr> > sendAttrs(nRelations);
+    for (int a=0; a<nProjAttrs + 2*(int) joinConditions.size(); a++) {
+        RelAttr relAttr;
+        if (a < nProjAttrs) {
+            relAttr = projAttrs[a];
+        }
+        else if ((a - nProjAttrs) % 2 == 0) {
+            relAttr = joinConditions[(a - nProjAttrs) / 2].lhsAttr;
+        }
+        else if (joinConditions[(a - nProjAttrs) / 2].bRhsIsAttr) {
+            relAttr = joinConditions[(a - nProjAttrs) / 2].rhsAttr;
+        }
+        else {
+            continue;
+        }
+        int k = FindRelation(nRelations, relations, relAttr.relName);
+        if (exchanges[k] != EX_IN_PLACE && FindAttribute(sendAttrs[k].data(), sendAttrs[k].size(), relAttr) == -1) {
+            sendAttrs[k].push_back(relAttr);
+        }
+    }
+
+    // Start the sending workers
+    // (the broadcast relations are scanned in the master node, before the data nodes)
+    vector<vector<DataAttrInfo> > layouts(nRelations);
+    for (int i=0; i<=numberNodes && !joiningNodes.empty(); i++) {
+        SM_Manager* nodeManager = masterManager;
+        if (i > 0) {
+            if ((rc = EnterDataNode(i))) {
+                DiscardWorkers();
+                return rc;
+            }
+            nodeManager = smManager;
+        }
+        for (int k=0; k<nRelations; k++) {
+            if (exchanges[k] != (i == 0 ? EX_BROADCAST : EX_REPARTITIONED)) {
+                continue;
+            }
+            shared_ptr<QL_Op> rootOp;
+            if ((rc = CreateScanOp(nodeManager, relations[k], sendConditions[k].size(), sendConditions[k].data(), rootOp))) {
+                if (i > 0) {
+                    LeaveDataNode();
+                }
+                DiscardWorkers();
+                return rc;
+            }
+            rootOp.reset(new QL_ProjectOp(nodeManager, rootOp, sendAttrs[k].size(), sendAttrs[k].data()));
+
+            // Get the layout of the tuples sent, without the indexes of the relation
+            if (layouts[k].empty()) {
+                int attrCount;
+                rootOp->GetAttributeCount(attrCount);
+                layouts[k].resize(attrCount);
+                rootOp->GetAttributeInfo(layouts[k].data());
+                int offset = 0;
+                for (int a=0; a<attrCount; a++) {
+                    layouts[k][a].offset = offset;
+                    layouts[k][a].indexNo = -1;
+                    offset += layouts[k][a].attrLength;
+                }
+            }
+
+            QL_ShuffleDataOp* shuffleOp;
+            if (exchanges[k] == EX_BROADCAST) {
+                shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, i, joiningNodes, sendSockets[i][k]);
+            }
+            else {
+                shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, i, keyAttrs[k], routingTable, sendSockets[i][k]);
+            }
+            rc = StartWorker(shuffleOp, i);
+            delete shuffleOp;
+            if (rc) {
+                if (i > 0) {
+                    LeaveDataNode();
+                }
+                return rc;
+            }
+        }
+        if (i > 0 && (rc = LeaveDataNode())) {
+            DiscardWorkers();
+            return rc;
+        }
+    }
+
+    // Start the joining workers
+    for (int n=0; n<(int) joiningNodes.size(); n++) {
+        int j = joiningNodes[n];
+        if ((rc = EnterDataNode(j))) {
+            DiscardWorkers();
+            return rc;
+        }
+
+        // Get the relations and attributes information of the data node, or of the
+        // temporary files of the relations sent
+        vector<string> fileNames(nRelations);
+        const char* joinRelations[nRelations];
+        SM_RelcatRecord* rcRecords[nRelations];
+        DataAttrInfo* attributes[nRelations];
+        int scanAttrCounts[nRelations];
+        DataAttrInfo* scanAttributes[nRelations];
+        vector<EX_Repartition> repartitions;
+        for (int k=0; k<nRelations; k++) {
+            rcRecords[k] = new SM_RelcatRecord;
+            memset(rcRecords[k], 0, sizeof(SM_RelcatRecord));
+            attributes[k] = NULL;
+            scanAttributes[k] = NULL;
+        }
+        for (int k=0; k<nRelations && !rc; k++) {
+            if (exchanges[k] == EX_IN_PLACE) {
+                joinRelations[k] = relations[k];
+                if (!(rc = smManager->GetRelInfo(relations[k], rcRecords[k]))) {
+                    scanAttrCounts[k] = rcRecords[k]->attrCount;
+                    attributes[k] = new DataAttrInfo[rcRecords[k]->attrCount];
+                    rc = smManager->GetAttrInfo(relations[k], rcRecords[k]->attrCount, (char*) attributes[k]);
+                }
+                continue;
+            }
+
+            // The name of the temporary file is not a valid relation name
+            fileNames[k] = ("." + string(relations[k])).substr(0, MAXNAME);
+            joinRelations[k] = fileNames[k].c_str();
+            int attrCount = layouts[k].size();
+            int tupleLength = 0;
+            for (int a=0; a<attrCount; a++) {
+                tupleLength += layouts[k][a].attrLength;
+            }
+            strcpy(rcRecords[k]->relName, fileNames[k].c_str());
+            rcRecords[k]->tupleLength = tupleLength;
+            rcRecords[k]->attrCount = attrCount;
+            strcpy(rcRecords[k]->attrName, "NA");
+            rcRecords[k]->tupleCount = exchanges[k] == EX_BROADCAST ? tupleCounts[k] : tupleCounts[k] / numberNodes;
+            attributes[k] = new DataAttrInfo[attrCount];
+            scanAttributes[k] = new DataAttrInfo[attrCount];
+            for (int a=0; a<attrCount; a++) {
+                attributes[k][a] = layouts[k][a];
+                scanAttributes[k][a] = layouts[k][a];
+            }
+            scanAttrCounts[k] = attrCount;
+
+            EX_Repartition repartition;
+            repartition.fileName = fileNames[k];
+            repartition.tupleLength = tupleLength;
+            repartition.sockets = receiveSockets[j][k];
+            repartitions.push_back(repartition);
+        }
+
+        // Form the join tree, projected on the needed attributes
+        shared_ptr<QL_Op> rootOp;
+        if (!rc) {
+            QL_Optimizer optimizer(smManager, ixManager, rmManager, nRelations, joinRelations, rcRecords, attributes,
+                                   joinConditions.size(), joinConditions.data(), nProjAttrs, projAttrs, scanAttrCounts, scanAttributes);
+            if (!(rc = optimizer.Optimize(rootOp))) {
+                rootOp.reset(new QL_ProjectOp(smManager, rootOp, nProjAttrs, projAttrs));
+            }
+        }
+        for (int k=0; k<nRelations; k++) {
+            delete rcRecords[k];
+            delete[] attributes[k];
+            delete[] scanAttributes[k];
+        }
+        if (rc) {
+            LeaveDataNode();
+            DiscardWorkers();
+            return rc;
+        }
+
+        // Start the shuffle operator in a worker process of the data node, after the
+        // tuples sent are received
+        QL_ShuffleDataOp* shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, j, 0);
+        rc = StartWorker(shuffleOp, j, repartitions);
+        delete shuffleOp;
+        if (rc) {
+            LeaveDataNode();
+            return rc;
+        }
+        if ((rc = LeaveDataNode())) {
+            DiscardWorkers();
+            return rc;
+        }
+    }
+
+    // Only the workers keep the sockets between them
+    CloseExchangeSockets();
+
+    return OK_RC;
+}
+
+
+// Optimize by performing a partial aggregation in data node
+// Method: AggregateInDataNode(const char* relName, int node, int nConditions, const Condition conditions[],
+//                             int nGroupAttrs, const RelAttr groupAttrs[], int nAggs, const AggFun aggFuns[],
+//                             const RelAttr aggAttrs[])
+// Filter the relation with all the conditions and aggregate it partially in the data node,
+// shipping only the partial aggregates of its groups (received by GatherFromWorkers)
+RC EX_CommLayer::AggregateInDataNode(const char* relName, int node, int nConditions, const Condition conditions[],
+                                     int nGroupAttrs, const RelAttr groupAttrs[], int nAggs, const AggFun aggFuns[],
+                                     const RelAttr aggAttrs[]) {
+    int rc;
+
+    // Open the data node
+    if ((rc = EnterDataNode(node))) {
         return rc;
     }
 
-    // Close the operator
-    if ((rc = shuffleOp->Close())) {
+    // Create the scan operator, filtered with the conditions
+    shared_ptr<QL_Op> rootOp;
+    if ((rc = CreateScanOp(smManager, relName, nConditions, conditions, rootOp))) {
         return rc;
     }
 
-    // Print the shuffle operator
-    if (bQueryPlans) {
-        shuffleOp->Print(0);
+    // Create the partial aggregation operator
+    rootOp.reset(new QL_HashAggregateOp(smManager, rmManager, rootOp, nGroupAttrs, groupAttrs, nAggs, aggFuns, aggAttrs, QL_AGGREGATE_PARTIAL));
+
+    // Start the shuffle operator in a worker process of the data node
+    QL_ShuffleDataOp* shuffleOp = new QL_ShuffleDataOp(rmManager, rootOp, node, 0);
+    rc = StartWorker(shuffleOp, node);
+    delete shuffleOp;
+    if (rc) {
+        return rc;
     }
 
     // Close the data node
-    if ((rc = smManager->CloseDb())) {
+    if ((rc = LeaveDataNode())) {
         return rc;
     }
 
-    // Clean up
-    delete shuffleOp;
+    return OK_RC;
+}
+
+
+// Method: CreateScanOp(SM_Manager* nodeManager, const char* relName, int nConditions,
+//                       const Condition conditions[], shared_ptr<QL_Op> &scanOp)
+// Create the scan of a relation of the node of nodeManager, filtered with the conditions on it
+// (an index scan if a condition allows it, then a filter for each other condition)
+RC EX_CommLayer::CreateScanOp(SM_Manager* nodeManager, const char* relName, int nConditions,
+                              const Condition conditions[], shared_ptr<QL_Op> &scanOp) {
+    int rc;
+
+    // Get the attributes information
+    SM_RelcatRecord* rcRecord = new SM_RelcatRecord;
+    memset(rcRecord, 0, sizeof(SM_RelcatRecord));
+    if ((rc = nodeManager->GetRelInfo(relName, rcRecord))) {
+        delete rcRecord;
+        return rc;
+    }
+    int attrCount = rcRecord->attrCount;
+    delete rcRecord;
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    if ((rc = nodeManager->GetAttrInfo(relName, attrCount, (char*) attributes))) {
+        delete[] attributes;
+        return rc;
+    }
+
+    // Create the scan operator - index scan if a condition allows it
+    Condition changedConditions[nConditions];
+    for (int i=0; i<nConditions; i++) {
+        changedConditions[i] = conditions[i];
+    }
+    int indexCondition, rangeCondition;
+    scanOp = ChooseIndexScanOp(nodeManager, ixManager, rmManager, relName, attrCount, attributes,
+                               nConditions, changedConditions, NULL, indexCondition, rangeCondition);
+    if (rangeCondition > indexCondition) {
+        RemoveCondition(changedConditions, nConditions, rangeCondition);
+    }
+    if (indexCondition != -1) {
+        RemoveCondition(changedConditions, nConditions, indexCondition);
+    }
+    if (rangeCondition != -1 && rangeCondition < indexCondition) {
+        RemoveCondition(changedConditions, nConditions, rangeCondition);
+    }
+    delete[] attributes;
+    if (!scanOp) {
+        scanOp.reset(new QL_FileScanOp(nodeManager, rmManager, relName, false, NULL, NO_OP, NULL));
+    }
+
+    // Create the filter operators for the other conditions
+    for (int i=0; i<nConditions; i++) {
+        scanOp.reset(new QL_FilterOp(nodeManager, scanOp, changedConditions[i]));
+    }
 
     return OK_RC;
 }
@@ -756,13 +1209,18 @@ RC EX_CommLayer::JoinInDataNode(const char* rel1, const char* rel2, Condition* j
 
 /***** Helper methods for EX part *****/
 
-// Method: GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relName,
-//                             const char* attrName, int &node)
-// Get the data node number for the required tuple based on the partition vector
-RC GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relName,
-                       const char* attrName, int &node) {
-    // Get the type
-    AttrType attrType = key.type;
+// Method: LoadRoutingTable(RM_Manager* rmManager, const char* relName, const char* attrName,
+//                          AttrType attrType, int partitioning, EX_RoutingTable &routingTable)
+// Read the partition vector of a relation into a routing table sorted by start value
+RC LoadRoutingTable(RM_Manager* rmManager, const char* relName, const char* attrName,
+                    AttrType attrType, int partitioning, EX_RoutingTable &routingTable) {
+    // Set the relation and attribute
+    memset(routingTable.relName, 0, MAXNAME+1);
+    strcpy(routingTable.relName, relName);
+    memset(routingTable.attrName, 0, MAXNAME+1);
+    strcpy(routingTable.attrName, attrName);
+    routingTable.attrType = attrType;
+    routingTable.partitioning = partitioning;
 
     // Open the RM file
     char partitionVectorFileName[255];
@@ -776,7 +1234,7 @@ RC GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relNa
         return rc;
     }
 
-    // Scan the file for the required value
+    // Read all the records
     RM_FileScan rmFS;
     RM_Record rec;
     char* recordData;
@@ -784,48 +1242,23 @@ RC GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relNa
         return rc;
     }
     while ((rc = rmFS.GetNextRec(rec)) != RM_EOF) {
-        // Get the record data
+        if (rc) {
+            return rc;
+        }
         if ((rc = rec.GetData(recordData))) {
             return rc;
         }
-
-        // Check for each type
-        if (attrType == INT) {
-            int givenValue = *static_cast<int*>(key.data);
-            EX_IntPartitionVectorRecord* pV = (EX_IntPartitionVectorRecord*) recordData;
-            if (givenValue >= pV->startValue && givenValue < pV->endValue) {
-                node = pV->node;
-                break;
-            }
+        if (attrType == INT || partitioning == EX_HASH_PARTITIONED) {
+            routingTable.intRanges.push_back(*(EX_IntPartitionVectorRecord*) recordData);
         }
-
         else if (attrType == FLOAT) {
-            float givenValue = *static_cast<float*>(key.data);
-            EX_FloatPartitionVectorRecord* pV = (EX_FloatPartitionVectorRecord*) recordData;
-            if (givenValue >= pV->startValue && givenValue < pV->endValue) {
-                node = pV->node;
-                break;
-            }
+            routingTable.floatRanges.push_back(*(EX_FloatPartitionVectorRecord*) recordData);
         }
-
         else {
-            char* givenValueChar = static_cast<char*>(key.data);
-            EX_StringPartitionVectorRecord* pV = (EX_StringPartitionVectorRecord*) recordData;
-            string givenValue(givenValueChar);
-            string startValue(pV->startValue);
-            string endValue(pV->endValue);
-            if (givenValue >= startValue && givenValue < endValue) {
-                node = pV->node;
-                break;
-            }
+            routingTable.stringRanges.push_back(*(EX_StringPartitionVectorRecord*) recordData);
         }
     }
 
-    // Check if the value was found
-    if (rc == RM_EOF) {
-        return EX_INCONSISTENT_PV;
-    }
-
     // Close the scan and file
     if ((rc = rmFS.CloseScan())) {
         return rc;
@@ -834,95 +1267,407 @@ RC GetDataNodeForTuple(RM_Manager* rmManager, const Value key, const char* relNa
         return rc;
     }
 
+    // Sort the ranges by start value
+    sort(routingTable.intRanges.begin(), routingTable.intRanges.end(),
+         [](const EX_IntPartitionVectorRecord &a, const EX_IntPartitionVectorRecord &b) {
+             return a.startValue < b.startValue;
+         });
+    sort(routingTable.floatRanges.begin(), routingTable.floatRanges.end(),
+         [](const EX_FloatPartitionVectorRecord &a, const EX_FloatPartitionVectorRecord &b) {
+             return a.startValue < b.startValue;
+         });
+    sort(routingTable.stringRanges.begin(), routingTable.stringRanges.end(),
+         [](const EX_StringPartitionVectorRecord &a, const EX_StringPartitionVectorRecord &b) {
+             return strcmp(a.startValue, b.startValue) < 0;
+         });
+
     return OK_RC;
 }
 
 
-// Method: CheckDataNodeForCondition(RM_Manager* rmManager, const char* relName, const char* attrName,
-//                                   Condition checkCondition, int node, bool &valid)
-// Check the data node whether its partition range satisfies the condition
-RC CheckDataNodeForCondition(RM_Manager* rmManager, const char* relName, const char* attrName,
-                             Condition checkCondition, int node, bool &valid) {
-    // Open the RM file
-    char partitionVectorFileName[255];
-    strcpy(partitionVectorFileName, relName);
-    strcat(partitionVectorFileName, "_partitions_");
-    strcat(partitionVectorFileName, attrName);
+// Find the node of the last range starting at or before the value (binary search), if the
+// value is before the end of that range
+template <typename Record, typename T>
+static bool RouteValue(const vector<Record> &ranges, const T &value, int &node) {
+    typename vector<Record>::const_iterator it =
+        upper_bound(ranges.begin(), ranges.end(), value,
+                    [](const T &v, const Record &range) { return v < range.startValue; });
+    if (it == ranges.begin()) {
+        return false;
+    }
+    --it;
+    if (!(value < it->endValue)) {
+        return false;
+    }
+    node = it->node;
+    return true;
+}
 
+// Method: EX_HashBucket(const Value &key)
+// Hash bucket of a value of a hash partitioned relation (MurmurHash3 of the bytes of the value)
+int EX_HashBucket(const Value &key) {
+    // Get the bytes of the value
+    const unsigned char* data;
+    int length;
+    float floatValue;
+    if (key.type == STRING) {
+        data = static_cast<const unsigned char*>(key.data);
+        length = strlen(static_cast<const char*>(key.data));
+    }
+    else if (key.type == FLOAT) {
+        // Negative and positive zero are equal values
+        floatValue = *static_cast<float*>(key.data);
+        if (floatValue == 0) {
+            floatValue = 0;
+        }
+        data = reinterpret_cast<const unsigned char*>(&floatValue);
+        length = sizeof(float);
+    }
+    else {
+        data = static_cast<const unsigned char*>(key.data);
+        length = sizeof(int);
+    }
+
+    // Mix the blocks of 4 bytes, then the remaining bytes
+    unsigned int hash = 0;
+    int nBlocks = length / 4;
+    for (int i=0; i<nBlocks; i++) {
+        unsigned int k;
+        memcpy(&k, data + i*4, sizeof(unsigned int));
+        k *= 0xcc9e2d51u;
+        k = (k << 15) | (k >> 17);
+        k *= 0x1b873593u;
+        hash ^= k;
+        hash = (hash << 13) | (hash >> 19);
+        hash = hash*5 + 0xe6546b64u;
+    }
+    int tailLength = length & 3;
+    if (tailLength > 0) {
+        unsigned int k = 0;
+        for (int i=tailLength-1; i>=0; i--) {
+            k = (k << 8) | data[nBlocks*4 + i];
+        }
+        k *= 0xcc9e2d51u;
+        k = (k << 15) | (k >> 17);
+        k *= 0x1b873593u;
+        hash ^= k;
+    }
+
+    // Finalize, so that every bit of the value changes the bucket
+    hash ^= length;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+
+    return (int) (((unsigned long long) hash * EX_HASH_BUCKETS) >> 32);
+}
+
+// Method: GetDataNodeForTuple(SM_Manager* smManager, const Value key, const char* relName,
+//                             const char* attrName, int &node)
+// Get the data node number for the required tuple based on the partition vector
+// (routed through the in-memory routing table of the relation kept by the SM_Manager)
+RC GetDataNodeForTuple(SM_Manager* smManager, const Value key, const char* relName,
+                       const char* attrName, int &node) {
+    // Get the routing table
     int rc;
-    RM_FileHandle rmFH;
-    if ((rc = rmManager->OpenFile(partitionVectorFileName, rmFH))) {
+    const EX_RoutingTable* routingTable;
+    if ((rc = smManager->GetRoutingTable(relName, attrName, key.type, routingTable))) {
         return rc;
     }
 
-    // Scan the file for the required node
-    RM_FileScan rmFS;
-    RM_Record rec;
-    char* recordData;
-    if ((rc = rmFS.OpenScan(rmFH, INT, 4, 0, EQ_OP, &node))) {
-        return rc;
+    return GetDataNodeForKey(*routingTable, key, node);
+}
+
+// Method: GetDataNodeForKey(const EX_RoutingTable &routingTable, const Value &key, int &node)
+// Get the data node of a value of the partition attribute from the routing table
+RC GetDataNodeForKey(const EX_RoutingTable &routingTable, const Value &key, int &node) {
+    // Find the range of the value (or of its hash bucket)
+    bool found;
+    if (routingTable.partitioning == EX_HASH_PARTITIONED) {
+        found = RouteValue(routingTable.intRanges, EX_HashBucket(key), node);
+    }
+    else if (key.type == INT) {
+        found = RouteValue(routingTable.intRanges, *static_cast<int*>(key.data), node);
+    }
+    else if (key.type == FLOAT) {
+        found = RouteValue(routingTable.floatRanges, *static_cast<float*>(key.data), node);
+    }
+    else {
+        string givenValue(static_cast<char*>(key.data));
+        found = RouteValue(routingTable.stringRanges, givenValue, node);
     }
 
-    // Get the record
-    if ((rc = rmFS.GetNextRec(rec)) == RM_EOF) {
+    // Check if the value was found
+    if (!found) {
         return EX_INCONSISTENT_PV;
     }
-    else {
-        // Get the record data
-        if ((rc = rec.GetData(recordData))) {
-            return rc;
+
+    return OK_RC;
+}
+
+
+// Values of the partition attribute allowed by its conditions: the values between the bounds
+// (if any, open or closed) other than the excluded ones
+template <typename T>
+struct ValueRange {
+    bool hasLow, lowOpen;
+    bool hasHigh, highOpen;
+    T low, high;
+    vector<T> excluded;
+    ValueRange() : hasLow(false), lowOpen(false), hasHigh(false), highOpen(false), low(), high() {}
+};
+
+static void ReadValue(const Value &value, int &x) { x = *static_cast<int*>(value.data); }
+static void ReadValue(const Value &value, float &x) { x = *static_cast<float*>(value.data); }
+static void ReadValue(const Value &value, string &x) { x = static_cast<char*>(value.data); }
+
+// Intersect the range with the conditions (op value) on the partition attribute
+template <typename T>
+static void NarrowRange(ValueRange<T> &range, const vector<const Condition*> &conditions) {
+    for (unsigned int i=0; i<conditions.size(); i++) {
+        CompOp op = conditions[i]->op;
+        T value;
+        ReadValue(conditions[i]->rhsValue, value);
+        if (op == EQ_OP || op == GT_OP || op == GE_OP) {
+            bool open = op == GT_OP;
+            if (!range.hasLow || range.low < value || (range.low == value && open)) {
+                range.hasLow = true;
+                range.low = value;
+                range.lowOpen = open;
+            }
         }
+        if (op == EQ_OP || op == LT_OP || op == LE_OP) {
+            bool open = op == LT_OP;
+            if (!range.hasHigh || value < range.high || (value == range.high && open)) {
+                range.hasHigh = true;
+                range.high = value;
+                range.highOpen = open;
+            }
+        }
+        if (op == NE_OP) {
+            range.excluded.push_back(value);
+        }
+    }
+}
 
-        // Check the start and end values
-        AttrType partitionAttrType = checkCondition.rhsValue.type;
-        if (partitionAttrType == INT) {
-            EX_IntPartitionVectorRecord* pv = (EX_IntPartitionVectorRecord*) recordData;
-            int value = *static_cast<int*>(checkCondition.rhsValue.data);
-            valid = MatchValues(pv->startValue, pv->endValue, checkCondition.op, value);
+// Check whether the values from low to high (open or closed) are all excluded
+template <typename T>
+static bool EmptyInterval(const T &low, bool lowOpen, const T &high, bool highOpen, const vector<T> &excluded) {
+    if (high < low) {
+        return true;
+    }
+    if (low == high) {
+        return lowOpen || highOpen || find(excluded.begin(), excluded.end(), low) != excluded.end();
+    }
+    return false;
+}
+
+// Integers close the open bounds on the next values, and skip the excluded values at the bounds
+static bool EmptyInterval(int low, bool lowOpen, int high, bool highOpen, const vector<int> &excluded) {
+    long long first = (long long) low + (lowOpen ? 1 : 0);
+    long long last = (long long) high - (highOpen ? 1 : 0);
+    bool moved = true;
+    while (first <= last && moved) {
+        moved = false;
+        if (find(excluded.begin(), excluded.end(), first) != excluded.end()) {
+            first++;
+            moved = true;
         }
-        else if (partitionAttrType == FLOAT) {
-            EX_FloatPartitionVectorRecord* pv = (EX_FloatPartitionVectorRecord*) recordData;
-            float value = *static_cast<float*>(checkCondition.rhsValue.data);
-            valid = MatchValues(pv->startValue, pv->endValue, checkCondition.op, value);
+        if (first <= last && find(excluded.begin(), excluded.end(), last) != excluded.end()) {
+            last--;
+            moved = true;
         }
-        else {
-            EX_StringPartitionVectorRecord* pv = (EX_StringPartitionVectorRecord*) recordData;
-            char* valueChar = static_cast<char*>(checkCondition.rhsValue.data);
-            string value(valueChar);
-            string startValue(pv->startValue);
-            string endValue(pv->endValue);
-            valid = MatchValues(startValue, endValue, checkCondition.op, value);
+    }
+    return first > last;
+}
+
+// Check whether the range holds a value
+template <typename T>
+static bool RangeHolds(const ValueRange<T> &range, const T &value) {
+    if (range.hasLow && (value < range.low || (value == range.low && range.lowOpen))) {
+        return false;
+    }
+    if (range.hasHigh && (range.high < value || (value == range.high && range.highOpen))) {
+        return false;
+    }
+    return find(range.excluded.begin(), range.excluded.end(), value) == range.excluded.end();
+}
+
+// Mark the nodes of the partitions [start, end) holding values of the range
+template <typename Record, typename T>
+static void PruneRanges(const vector<Record> &ranges, const ValueRange<T> &range, vector<bool> &nodes) {
+    for (unsigned int i=0; i<ranges.size(); i++) {
+        // Intersect the bounds of the range with the partition
+        T low = ranges[i].startValue;
+        bool lowOpen = false;
+        if (range.hasLow && (low < range.low || (range.low == low && range.lowOpen))) {
+            low = range.low;
+            lowOpen = range.lowOpen;
+        }
+        T high = ranges[i].endValue;
+        bool highOpen = true;
+        if (range.hasHigh && range.high < high) {
+            high = range.high;
+            highOpen = range.highOpen;
+        }
+        if (!EmptyInterval(low, lowOpen, high, highOpen, range.excluded)) {
+            nodes[ranges[i].node] = true;
         }
     }
+}
 
-    // Close the scan and file
-    if ((rc = rmFS.CloseScan())){
-        return rc;
+// Method: GetDataNodesForConditions(SM_Manager* smManager, const char* relName, const char* attrName,
+//                                   int nConditions, const Condition conditions[], vector<bool> &nodes)
+// Find the data nodes (nodes[node], from 1) whose partitions may hold tuples of the relation
+// satisfying all the conditions on its partition attribute, intersected once over the routing table
+// (a hash partitioned relation is pruned only by an equality, through the bucket of the value)
+RC GetDataNodesForConditions(SM_Manager* smManager, const char* relName, const char* attrName,
+                             int nConditions, const Condition conditions[], vector<bool> &nodes) {
+    // Find the conditions on the partition attribute
+    vector<const Condition*> partitionConditions;
+    const Condition* equality = NULL;
+    for (int i=0; i<nConditions; i++) {
+        const RelAttr &lhsAttr = conditions[i].lhsAttr;
+        if (!conditions[i].bRhsIsAttr && conditions[i].op != NO_OP && strcmp(lhsAttr.attrName, attrName) == 0 &&
+            (lhsAttr.relName == NULL || strcmp(lhsAttr.relName, relName) == 0)) {
+            partitionConditions.push_back(&conditions[i]);
+            if (equality == NULL && conditions[i].op == EQ_OP) {
+                equality = &conditions[i];
+            }
+        }
     }
-    if ((rc = rmManager->CloseFile(rmFH))) {
+
+    // Every node may hold the tuples without such conditions
+    int numberNodes = smManager->getNumberNodes();
+    nodes.assign(numberNodes+1, partitionConditions.empty());
+    nodes[0] = false;
+    if (partitionConditions.empty()) {
+        return OK_RC;
+    }
+
+    // Get the routing table
+    int rc;
+    AttrType attrType = partitionConditions[0]->rhsValue.type;
+    const EX_RoutingTable* routingTable;
+    if ((rc = smManager->GetRoutingTable(relName, attrName, attrType, routingTable))) {
         return rc;
     }
 
+    // Hash partitioning - only the node of the bucket of an equality, if its value satisfies
+    // the other conditions (any node may hold the values of a range)
+    if (routingTable->partitioning == EX_HASH_PARTITIONED) {
+        if (equality == NULL) {
+            nodes.assign(numberNodes+1, true);
+            nodes[0] = false;
+            return OK_RC;
+        }
+        bool holds;
+        if (attrType == INT) {
+            ValueRange<int> range;
+            NarrowRange(range, partitionConditions);
+            int value;
+            ReadValue(equality->rhsValue, value);
+            holds = RangeHolds(range, value);
+        }
+        else if (attrType == FLOAT) {
+            ValueRange<float> range;
+            NarrowRange(range, partitionConditions);
+            float value;
+            ReadValue(equality->rhsValue, value);
+            holds = RangeHolds(range, value);
+        }
+        else {
+            ValueRange<string> range;
+            NarrowRange(range, partitionConditions);
+            string value;
+            ReadValue(equality->rhsValue, value);
+            holds = RangeHolds(range, value);
+        }
+        if (holds) {
+            int node;
+            if ((rc = GetDataNodeForKey(*routingTable, equality->rhsValue, node))) {
+                return rc;
+            }
+            nodes[node] = true;
+        }
+    }
+
+    // Range partitioning - the nodes of the partitions intersecting the range of the conditions
+    else if (attrType == INT) {
+        ValueRange<int> range;
+        NarrowRange(range, partitionConditions);
+        PruneRanges(routingTable->intRanges, range, nodes);
+    }
+    else if (attrType == FLOAT) {
+        ValueRange<float> range;
+        NarrowRange(range, partitionConditions);
+        PruneRanges(routingTable->floatRanges, range, nodes);
+    }
+    else {
+        ValueRange<string> range;
+        NarrowRange(range, partitionConditions);
+        PruneRanges(routingTable->stringRanges, range, nodes);
+    }
+
     return OK_RC;
 }
 
 
-// Method: bool MatchValues(T start, T end, CompOp op, T value)
-// Check whether a record from the partition vector satisfies the condition (op value)
-template <typename T>
-bool MatchValues(T start, T end, CompOp op, T value) {
-    switch(op) {
-        case EQ_OP:
-            return (value >= start && value < end);
-        case LT_OP:
-            return (start < value);
-        case GT_OP:
-            return (end > value);
-        case LE_OP:
-            return (start <= value);
-        case GE_OP:
-            return (end > value);
-        default:
-            return true;
+// Method: CheckCoPartitioned(SM_Manager* smManager, const char* relName1, const char* attrName1,
+//                            const char* relName2, const char* attrName2, AttrType attrType, bool &coPartitioned)
+// Check whether two distributed relations place equal values of their partition attributes (of
+// type attrType) in the same node - the same partitioning scheme with the same ranges
+RC CheckCoPartitioned(SM_Manager* smManager, const char* relName1, const char* attrName1,
+                      const char* relName2, const char* attrName2, AttrType attrType, bool &coPartitioned) {
+    coPartitioned = false;
+
+    // Get the routing tables
+    int rc;
+    const EX_RoutingTable* routingTable1;
+    const EX_RoutingTable* routingTable2;
+    if ((rc = smManager->GetRoutingTable(relName1, attrName1, attrType, routingTable1))) {
+        return rc;
     }
+    if ((rc = smManager->GetRoutingTable(relName2, attrName2, attrType, routingTable2))) {
+        return rc;
+    }
+    if (routingTable1->partitioning != routingTable2->partitioning) {
+        return OK_RC;
+    }
+
+    // Compare the ranges (of hash buckets for hash partitioning)
+    const vector<EX_IntPartitionVectorRecord> &intRanges1 = routingTable1->intRanges;
+    const vector<EX_IntPartitionVectorRecord> &intRanges2 = routingTable2->intRanges;
+    const vector<EX_FloatPartitionVectorRecord> &floatRanges1 = routingTable1->floatRanges;
+    const vector<EX_FloatPartitionVectorRecord> &floatRanges2 = routingTable2->floatRanges;
+    const vector<EX_StringPartitionVectorRecord> &stringRanges1 = routingTable1->stringRanges;
+    const vector<EX_StringPartitionVectorRecord> &stringRanges2 = routingTable2->stringRanges;
+    if (intRanges1.size() != intRanges2.size() || floatRanges1.size() != floatRanges2.size() ||
+        stringRanges1.size() != stringRanges2.size()) {
+        return OK_RC;
+    }
+    for (unsigned int i=0; i<intRanges1.size(); i++) {
+        if (intRanges1[i].node != intRanges2[i].node || intRanges1[i].startValue != intRanges2[i].startValue ||
+            intRanges1[i].endValue != intRanges2[i].endValue) {
+            return OK_RC;
+        }
+    }
+    for (unsigned int i=0; i<floatRanges1.size(); i++) {
+        if (floatRanges1[i].node != floatRanges2[i].node || floatRanges1[i].startValue != floatRanges2[i].startValue ||
+            floatRanges1[i].endValue != floatRanges2[i].endValue) {
+            return OK_RC;
+        }
+    }
+    for (unsigned int i=0; i<stringRanges1.size(); i++) {
+        if (stringRanges1[i].node != stringRanges2[i].node ||
+            strcmp(stringRanges1[i].startValue, stringRanges2[i].startValue) != 0 ||
+            strcmp(stringRanges1[i].endValue, stringRanges2[i].endValue) != 0) {
+            return OK_RC;
+        }
+    }
+    coPartitioned = true;
+
+    return OK_RC;
 }
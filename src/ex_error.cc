@@ -17,10 +17,13 @@ static char *EX_WarnMsg[] = {
   (char*)"invalid attribute name",
   (char*)"invalid value in partition vector",
   (char*)"invalid data node",
-  (char*)"inconsistent partition vector"
+  (char*)"inconsistent partition vector",
+  (char*)"stream of the data node workers already ended",
+  (char*)"end of the stream of the data node workers"
 };
 
 static char *EX_ErrorMsg[] = {
+  (char*)"data node worker process ended without its result"
 };
 
 //
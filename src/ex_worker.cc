@@ -0,0 +1,509 @@
+//
+// File:        ex_worker.cc
+// Description: Worker processes of the data nodes and their tuple protocol
+// Authors:     Aditya Bhandari (adityasb@stanford.edu)
+//
+
+#include <cstdio>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <poll.h>
+#undef PF_UNIX                      // Socket family name (AF_UNIX), clashes with the PF error code
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include "redbase.h"
+#include "rm.h"
+#include "ix.h"
+#include "sm.h"
+#include "ql.h"
+#include "ql_internal.h"
+#include "ex.h"
+#include "parser.h"
+using namespace std;
+
+
+/***** Worker processes of EX_CommLayer */
+
+// Method: StartWorker(QL_ShuffleDataOp* shuffleOp, int node, const vector<EX_Repartition> &repartitions)
+// Fork a worker process running the shuffle operator in the data node entered
+/* Steps:
+    1) Write the dirty pages to disk, so that the worker never writes back a stale copy
+    2) Create the socket pair and fork the worker
+    3) Worker - Store the tuples repartitioned into the data node in their temporary files,
+       send the tuples of the shuffle operator and then the end message with the return code
+       and the printed plan, destroy the temporary files, and exit without closing the files
+       of the master
+    4) Master - Add the worker to the workers to gather
+*/
+RC EX_CommLayer::StartWorker(QL_ShuffleDataOp* shuffleOp, int node, const vector<EX_Repartition> &repartitions) {
+    int rc;
+    if ((rc = rmManager->ForceAllPages())) {
+        DiscardWorkers();
+        return rc;
+    }
+
+    // Do not let the worker repeat the output buffered so far
+    cout.flush();
+    fflush(stdout);
+
+    // Create the socket pair and fork the worker
+    int sockets[2];
+    if (socketpair(AF_LOCAL, SOCK_STREAM, 0, sockets) == -1) {
+        DiscardWorkers();
+        return EX_UNIX;
+    }
+    // Let the worker send only EX_SOCKET_MESSAGES messages ahead of the master node
+    int bufferSize = EX_SOCKET_MESSAGES * (EX_MESSAGE_SIZE + sizeof(EX_MessageHeader));
+    setsockopt(sockets[1], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+    setsockopt(sockets[0], SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        close(sockets[0]);
+        close(sockets[1]);
+        DiscardWorkers();
+        return EX_UNIX;
+    }
+
+    // Worker process
+    if (pid == 0) {
+        // Only the master node may hold the sockets of the other workers
+        close(sockets[0]);
+        for (int i=0; i<(int) workers.size(); i++) {
+            close(workers[i].socket);
+        }
+
+        // Keep only the sockets of the repartitionings used by the worker
+        vector<int> usedSockets = shuffleOp->GetNodeSockets();
+        for (int i=0; i<(int) repartitions.size(); i++) {
+            usedSockets.insert(usedSockets.end(), repartitions[i].sockets.begin(), repartitions[i].sockets.end());
+        }
+        for (int i=0; i<(int) exchangeSockets.size(); i++) {
+            if (find(usedSockets.begin(), usedSockets.end(), exchangeSockets[i]) == usedSockets.end()) {
+                close(exchangeSockets[i]);
+            }
+        }
+
+        int workerRC = OK_RC;
+        for (int i=0; i<(int) repartitions.size() && !workerRC; i++) {
+            workerRC = EX_ReceiveRepartition(rmManager, repartitions[i]);
+        }
+        if (!workerRC) {
+            workerRC = shuffleOp->Open();
+        }
+        if (!workerRC) {
+            workerRC = shuffleOp->SendData(sockets[1]);
+            int closeRC = shuffleOp->Close();
+            if (!workerRC) {
+                workerRC = closeRC;
+            }
+        }
+
+        // Print the plan into the end message
+        ostringstream plan;
+        if (bQueryPlans || bExplainAnalyze) {
+            streambuf* coutBuffer = cout.rdbuf(plan.rdbuf());
+            shuffleOp->Print(0);
+            cout.rdbuf(coutBuffer);
+        }
+        string planText = plan.str();
+        vector<char> endData(sizeof(int) + planText.size());
+        memcpy(&endData[0], &workerRC, sizeof(int));
+        memcpy(&endData[sizeof(int)], planText.data(), planText.size());
+        EX_WriteMessage(sockets[1], EX_END_MESSAGE, &endData[0], endData.size());
+        close(sockets[1]);
+        for (int i=0; i<(int) repartitions.size(); i++) {
+            rmManager->DestroyFile(repartitions[i].fileName.c_str());
+        }
+        _exit(workerRC ? 1 : 0);
+    }
+
+    // Master node
+    close(sockets[1]);
+    EX_Worker worker;
+    worker.node = node;
+    worker.pid = pid;
+    worker.socket = sockets[0];
+    worker.tupleLength = shuffleOp->GetTupleLength();
+    workers.push_back(worker);
+
+    return OK_RC;
+}
+
+// Method: GatherFromWorkers(RM_FileHandle &rmFH, int* tupleCount)
+// Insert the tuples sent by the workers into rmFH as they arrive, then print their plans
+// in the order the workers were started (counting the tuples if tupleCount is given)
+RC EX_CommLayer::GatherFromWorkers(RM_FileHandle &rmFH, int* tupleCount) {
+    EX_WorkerStream stream(workers);
+    workers.clear();
+
+    // Insert the tuples of the stream
+    int rc;
+    RID rid;
+    int count = 0;
+    vector<char> tupleData(stream.GetTupleLength() > 0 ? stream.GetTupleLength() : 1);
+    while ((rc = stream.GetNext(&tupleData[0])) == OK_RC) {
+        if ((rc = rmFH.InsertRec(&tupleData[0], rid))) {
+            break;
+        }
+        count++;
+    }
+    if (tupleCount != NULL) {
+        *tupleCount = count;
+    }
+    if (rc == EX_EOF) {
+        rc = OK_RC;
+    }
+
+    // Wait for the workers (ending the ones still sending after an error)
+    int endRC = stream.End();
+    stream.PrintPlans(0);
+    if (rc) {
+        return rc;
+    }
+    return endRC;
+}
+
+// Method: TakeWorkers(vector<EX_Worker> &startedWorkers)
+// Hand the workers started since the last call over to the caller
+void EX_CommLayer::TakeWorkers(vector<EX_Worker> &startedWorkers) {
+    startedWorkers = workers;
+    workers.clear();
+}
+
+// Method: DiscardWorkers()
+// End the workers started and not gathered
+// (the workers of a repartitioning stop once the master node closes its sockets between them)
+void EX_CommLayer::DiscardWorkers() {
+    CloseExchangeSockets();
+    EX_EndWorkers(workers);
+}
+
+// Method: ConnectWorkers(int &sendSocket, int &receiveSocket)
+// Create a socket pair between two workers of a repartitioning, kept in the master node till
+// all the workers are started
+RC EX_CommLayer::ConnectWorkers(int &sendSocket, int &receiveSocket) {
+    int sockets[2];
+    if (socketpair(AF_LOCAL, SOCK_STREAM, 0, sockets) == -1) {
+        return EX_UNIX;
+    }
+    sendSocket = sockets[1];
+    receiveSocket = sockets[0];
+    exchangeSockets.push_back(sockets[0]);
+    exchangeSockets.push_back(sockets[1]);
+    return OK_RC;
+}
+
+// Method: CloseExchangeSockets()
+// Close the sockets between the workers of a repartitioning, once all of them are started
+void EX_CommLayer::CloseExchangeSockets() {
+    for (int i=0; i<(int) exchangeSockets.size(); i++) {
+        close(exchangeSockets[i]);
+    }
+    exchangeSockets.clear();
+}
+
+
+/***** EX_WorkerStream class *****/
+
+// Constructor
+EX_WorkerStream::EX_WorkerStream(const vector<EX_Worker> &workers) {
+    this->workers = workers;
+    for (int i=0; i<(int) workers.size(); i++) {
+        nodes.push_back(workers[i].node);
+    }
+    done.assign(workers.size(), false);
+    workerRCs.assign(workers.size(), EX_WORKER_FAILED);
+    plans.assign(workers.size(), string());
+    nDone = 0;
+    nextWorker = 0;
+    // (the workers repartitioning tuples between the data nodes send none to the master node)
+    tupleLength = 0;
+    for (int i=0; i<(int) workers.size(); i++) {
+        tupleLength = max(tupleLength, workers[i].tupleLength);
+    }
+    batchLength = 0;
+    batchPosition = 0;
+    ended = false;
+    failed = false;
+}
+
+// Destructor
+EX_WorkerStream::~EX_WorkerStream() {
+    // End the workers if the stream was not read to the end
+    End();
+}
+
+// Method: GetTupleLength()
+// Get the length of the tuples of the stream
+int EX_WorkerStream::GetTupleLength() const {
+    return tupleLength;
+}
+
+// Method: GetNext(char* tupleData)
+// Get the next tuple of the message being returned, reading a new message when it is used up
+RC EX_WorkerStream::GetNext(char* tupleData) {
+    if (ended) {
+        return EX_STREAM_ENDED;
+    }
+    // The error of a worker is returned once, and the stream then ends
+    if (failed) {
+        return EX_EOF;
+    }
+
+    int rc;
+    while (batchPosition + tupleLength > batchLength || tupleLength == 0) {
+        // All the workers sent their end message
+        if (nDone == (int) workers.size()) {
+            for (int i=0; i<(int) workers.size(); i++) {
+                if (workerRCs[i]) {
+                    failed = true;
+                    return workerRCs[i];
+                }
+            }
+            return EX_EOF;
+        }
+        if ((rc = ReadNextMessage())) {
+            failed = true;
+            return rc;
+        }
+    }
+
+    memcpy(tupleData, &batch[batchPosition], tupleLength);
+    batchPosition += tupleLength;
+    return OK_RC;
+}
+
+// Method: ReadNextMessage()
+// Wait for a message of any worker that did not end, taking the workers in turns
+/* Steps:
+    1) Poll the sockets of the workers that did not send their end message yet
+    2) Read a message of the first worker ready after the one read last
+    3) Return the tuples of a tuples message, or keep the return code and plan of an
+       end message
+*/
+RC EX_WorkerStream::ReadNextMessage() {
+    int nWorkers = workers.size();
+    vector<struct pollfd> pollSockets;
+    vector<int> pollWorkers;
+    for (int k=0; k<nWorkers; k++) {
+        int i = (nextWorker + k) % nWorkers;
+        if (!done[i]) {
+            struct pollfd pollSocket;
+            pollSocket.fd = workers[i].socket;
+            pollSocket.events = POLLIN;
+            pollSocket.revents = 0;
+            pollSockets.push_back(pollSocket);
+            pollWorkers.push_back(i);
+        }
+    }
+    while (poll(&pollSockets[0], pollSockets.size(), -1) == -1) {
+        if (errno != EINTR) {
+            return EX_UNIX;
+        }
+    }
+    int i = -1;
+    for (int k=0; k<(int) pollSockets.size() && i == -1; k++) {
+        if (pollSockets[k].revents != 0) {
+            i = pollWorkers[k];
+        }
+    }
+    if (i == -1) {
+        return OK_RC;
+    }
+    nextWorker = (i + 1) % nWorkers;
+
+    // Read the message
+    int rc;
+    EX_MessageHeader header;
+    if ((rc = EX_ReadMessage(workers[i].socket, header, batch))) {
+        return rc;
+    }
+    batchLength = 0;
+    batchPosition = 0;
+    if (header.type == EX_TUPLES_MESSAGE) {
+        batchLength = header.length;
+    }
+    else if (header.type == EX_END_MESSAGE && header.length >= (int) sizeof(int)) {
+        memcpy(&workerRCs[i], &batch[0], sizeof(int));
+        plans[i].assign(&batch[sizeof(int)], header.length - sizeof(int));
+        done[i] = true;
+        nDone++;
+    }
+    else {
+        return EX_WORKER_FAILED;
+    }
+
+    return OK_RC;
+}
+
+// Method: End()
+// Close the sockets and wait for the workers, returning the first error of the workers
+// (a stream not read to the end, e.g. under a LIMIT, stops the workers still sending, and
+// an error already returned by GetNext is not returned again)
+RC EX_WorkerStream::End() {
+    if (ended) {
+        return OK_RC;
+    }
+    ended = true;
+    bool cancelled = nDone < (int) workers.size();
+    EX_EndWorkers(workers);
+
+    if (!cancelled && !failed) {
+        for (int i=0; i<(int) done.size(); i++) {
+            if (workerRCs[i]) {
+                return workerRCs[i];
+            }
+        }
+    }
+    return OK_RC;
+}
+
+// Method: PrintPlans(int indentationLevel)
+// Print the plans sent by the workers, in the order the workers were started
+// (a worker stopped before its end message did not send its plan)
+void EX_WorkerStream::PrintPlans(int indentationLevel) {
+    for (int i=0; i<(int) plans.size(); i++) {
+        if (!done[i]) {
+            for (int j=0; j<indentationLevel; j++) cout << "\t";
+            cout << "ShuffleDataOp (" << nodes[i] << ", 0) stopped" << endl;
+            continue;
+        }
+        istringstream planLines(plans[i]);
+        string line;
+        while (getline(planLines, line)) {
+            for (int j=0; j<indentationLevel; j++) cout << "\t";
+            cout << line << endl;
+        }
+    }
+}
+
+
+/***** Tuple protocol *****/
+
+// Method: EX_WriteMessage(int socket, int type, const char* data, int length)
+// Send a message with the given type and data
+RC EX_WriteMessage(int socket, int type, const char* data, int length) {
+    EX_MessageHeader header;
+    header.type = type;
+    header.length = length;
+
+    // Send the header and then the data
+    const char* buffers[2] = { (const char*) &header, data };
+    int lengths[2] = { (int) sizeof(EX_MessageHeader), length };
+    for (int i=0; i<2; i++) {
+        int sent = 0;
+        while (sent < lengths[i]) {
+            ssize_t n = write(socket, buffers[i] + sent, lengths[i] - sent);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return EX_UNIX;
+            }
+            sent += n;
+        }
+    }
+
+    return OK_RC;
+}
+
+// Method: EX_ReadMessage(int socket, EX_MessageHeader &header, vector<char> &data)
+// Receive the next message into header and data
+RC EX_ReadMessage(int socket, EX_MessageHeader &header, vector<char> &data) {
+    // Receive the header and then the data
+    char* buffers[2] = { (char*) &header, NULL };
+    int lengths[2] = { (int) sizeof(EX_MessageHeader), 0 };
+    for (int i=0; i<2; i++) {
+        if (i == 1) {
+            if (header.length < 0) {
+                return EX_WORKER_FAILED;
+            }
+            data.resize(header.length > 0 ? header.length : 1);
+            buffers[1] = &data[0];
+            lengths[1] = header.length;
+        }
+        int received = 0;
+        while (received < lengths[i]) {
+            ssize_t n = read(socket, buffers[i] + received, lengths[i] - received);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n == -1) {
+                return EX_UNIX;
+            }
+            // The worker exited before sending the whole message
+            if (n == 0) {
+                return EX_WORKER_FAILED;
+            }
+            received += n;
+        }
+    }
+
+    return OK_RC;
+}
+
+// Method: EX_EndWorkers(vector<EX_Worker> &workers)
+// Close the sockets of the workers and wait for them to exit (a worker still sending
+// tuples fails on the closed socket)
+void EX_EndWorkers(vector<EX_Worker> &workers) {
+    for (int i=0; i<(int) workers.size(); i++) {
+        close(workers[i].socket);
+    }
+    for (int i=0; i<(int) workers.size(); i++) {
+        int status;
+        if (workers[i].pid > 0) {
+            while (waitpid(workers[i].pid, &status, 0) == -1 && errno == EINTR);
+        }
+    }
+    workers.clear();
+}
+
+// Method: EX_ReceiveRepartition(RM_Manager* rmManager, const EX_Repartition &repartition)
+// Store the tuples sent by the workers of the other nodes into the temporary file of the
+// repartition, as they arrive
+RC EX_ReceiveRepartition(RM_Manager* rmManager, const EX_Repartition &repartition) {
+    // The workers sending the tuples are not children of the receiving worker
+    vector<EX_Worker> senders;
+    for (int i=0; i<(int) repartition.sockets.size(); i++) {
+        EX_Worker sender;
+        sender.node = i+1;
+        sender.pid = 0;
+        sender.socket = repartition.sockets[i];
+        sender.tupleLength = repartition.tupleLength;
+        senders.push_back(sender);
+    }
+    EX_WorkerStream stream(senders);
+
+    // Create the temporary file
+    int rc;
+    RM_FileHandle rmFH;
+    if ((rc = rmManager->CreateFile(repartition.fileName.c_str(), repartition.tupleLength))) {
+        return rc;
+    }
+    if ((rc = rmManager->OpenFile(repartition.fileName.c_str(), rmFH))) {
+        return rc;
+    }
+
+    // Insert the tuples of the stream
+    RID rid;
+    vector<char> tupleData(repartition.tupleLength);
+    while ((rc = stream.GetNext(&tupleData[0])) == OK_RC) {
+        if ((rc = rmFH.InsertRec(&tupleData[0], rid))) {
+            break;
+        }
+    }
+    if (rc == EX_EOF) {
+        rc = OK_RC;
+    }
+    int endRC = stream.End();
+    int closeRC = rmManager->CloseFile(rmFH);
+    if (rc || (rc = endRC)) {
+        return rc;
+    }
+    return closeRC;
+}
@@ -33,6 +33,7 @@ extern QL_Manager *pQlm;
 #define E_TOOLONG           -9
 #define E_STRINGTOOLONG     -10
 #define E_INVATTRNAME       -11
+#define E_INVAGGFUNC        -12
 
 /*
  * file pointer to which error messages are printed
@@ -45,7 +46,10 @@ extern QL_Manager *pQlm;
 static int mk_attr_infos(NODE *list, int max, AttrInfo attrInfos[]);
 static int parse_format_string(char *format_string, AttrType *type, int *len);
 static int mk_rel_attrs(NODE *list, int max, RelAttr relAttrs[]);
+static int mk_sel_attrs(NODE *list, int max, RelAttr relAttrs[],
+      AggFun aggFuns[]);
 static void mk_rel_attr(NODE *node, RelAttr &relAttr);
+static int mk_order_attrs(NODE *list, int max, OrderAttr orderAttrs[]);
 static int mk_relations(NODE *list, int max, char *relations[]);
 static int mk_conditions(NODE *list, int max, Condition conditions[]);
 static int mk_values(NODE *list, int max, Value values[]);
@@ -60,6 +64,8 @@ static void print_relattr(NODE *n);
 static void print_value(NODE *n);
 static void print_condition(NODE *n);
 static void print_relattrs(NODE *n);
+static void print_sel_attrs(NODE *n);
+static void print_order_attrs(NODE *n);
 static void print_relations(NODE *n);
 static void print_conditions(NODE *n);
 static void print_values(NODE *n);
@@ -104,8 +110,11 @@ RC interp(NODE *n)
             int nValues = 0;
             int isDistributed = 0;
 
+            /* A replicated table has no partition attribute */
             if (n -> u.CREATETABLE.distribute_data != NULL) {
-               isDistributed = 1;
+               isDistributed = (n -> u.CREATETABLE.distribute_data)-> u.DISTRIBUTE.partitioning;
+            }
+            if (isDistributed && isDistributed != EX_REPLICATED) {
                attrName = (n -> u.CREATETABLE.distribute_data)-> u.DISTRIBUTE.attrName;
                for (int i=0; i<nattrs; i++) {
                   if (!strcmp(attrInfos[i].attrName, attrName)) {
@@ -118,11 +127,13 @@ RC interp(NODE *n)
                   break;
                }
 
-               /* Get the partition vector data */
-               nValues = mk_partition_vector((n -> u.CREATETABLE.distribute_data)-> u.DISTRIBUTE.value_list, MAXATTRS, partition_vector);
-               if(nValues < 0){
-                  print_error((char*)"create", nValues);
-                  break;
+               /* Get the partition vector data (none for hash partitioning) */
+               if (isDistributed == EX_RANGE_PARTITIONED) {
+                  nValues = mk_partition_vector((n -> u.CREATETABLE.distribute_data)-> u.DISTRIBUTE.value_list, MAXATTRS, partition_vector);
+                  if(nValues < 0){
+                     print_error((char*)"create", nValues);
+                     break;
+                  }
                }
             }
 
@@ -135,7 +146,8 @@ RC interp(NODE *n)
       case N_CREATEINDEX:            /* for CreateIndex() */
 
          errval = pSmm->CreateIndex(n->u.CREATEINDEX.relname,
-               n->u.CREATEINDEX.attrname);
+               n->u.CREATEINDEX.attrname,
+               (IX_IndexType) n->u.CREATEINDEX.indextype);
          break;
 
       case N_DROPINDEX:            /* for DropIndex() */
@@ -155,6 +167,12 @@ RC interp(NODE *n)
                n->u.LOAD.filename);
          break;
 
+      case N_ANALYZE:         /* for Analyze() */
+
+         errval = pSmm->Analyze(n->u.ANALYZE.relname,
+               n->u.ANALYZE.samplepercent);
+         break;
+
       case N_SET:                    /* for Set() */
 
          errval = pSmm->Set(n->u.SET.paramName,
@@ -178,14 +196,19 @@ RC interp(NODE *n)
          {
             int       nSelAttrs = 0;
             RelAttr  relAttrs[MAXATTRS];
+            AggFun    aggFuns[MAXATTRS];
             int       nRelations = 0;
             char      *relations[MAXATTRS];
             int       nConditions = 0;
             Condition conditions[MAXATTRS];
+            int       nGroupAttrs = 0;
+            RelAttr   groupAttrs[MAXATTRS];
+            int       nOrderAttrs = 0;
+            OrderAttr orderAttrs[MAXATTRS];
 
             /* Make a list of RelAttrs suitable for sending to Query */
-            nSelAttrs = mk_rel_attrs(n->u.QUERY.relattrlist, MAXATTRS,
-                  relAttrs);
+            nSelAttrs = mk_sel_attrs(n->u.QUERY.relattrlist, MAXATTRS,
+                  relAttrs, aggFuns);
             if(nSelAttrs < 0){
                print_error((char*)"select", nSelAttrs);
                break;
@@ -206,10 +229,32 @@ RC interp(NODE *n)
                break;
             }
 
-            /* Make the call to Select */
-            errval = pQlm->Select(nSelAttrs, relAttrs,
+            /* Make a list of group by RelAttrs suitable for sending to Query */
+            nGroupAttrs = mk_rel_attrs(n->u.QUERY.grouplist, MAXATTRS,
+                  groupAttrs);
+            if(nGroupAttrs < 0){
+               print_error((char*)"select", nGroupAttrs);
+               break;
+            }
+
+            /* Make a list of OrderAttrs suitable for sending to Query */
+            nOrderAttrs = mk_order_attrs(n->u.QUERY.orderlist, MAXATTRS,
+                  orderAttrs);
+            if(nOrderAttrs < 0){
+               print_error((char*)"select", nOrderAttrs);
+               break;
+            }
+
+            /* Make the call to Select (collecting the runtime statistics
+               of the operators for EXPLAIN ANALYZE) */
+            bExplainAnalyze = n->u.QUERY.explain;
+            errval = pQlm->Select(nSelAttrs, relAttrs, aggFuns,
                   nRelations, relations,
-                  nConditions, conditions);
+                  nConditions, conditions,
+                  nGroupAttrs, groupAttrs,
+                  nOrderAttrs, orderAttrs,
+                  n->u.QUERY.limit);
+            bExplainAnalyze = 0;
             break;
          }
 
@@ -364,6 +409,55 @@ static int mk_rel_attrs(NODE *list, int max, RelAttr relAttrs[])
    return i;
 }
 
+/*
+ * mk_sel_attrs: converts a list of select attributes (relation-attributes
+ * or aggregate functions of relation-attributes) into an array of RelAttrs
+ * and an array of the aggregate functions
+ *
+ * Returns:
+ *    the lengh of the list on success ( >= 0 )
+ *    error code otherwise
+ */
+static int mk_sel_attrs(NODE *list, int max, RelAttr relAttrs[],
+      AggFun aggFuns[])
+{
+   int i;
+   NODE *current;
+   char *function;
+
+   /* For each element of the list... */
+   for(i = 0; list != NULL; ++i, list = list -> u.LIST.next){
+      /* If the list is too long then error */
+      if(i == max)
+         return E_TOOMANY;
+
+      current = list -> u.LIST.curr;
+      if(current -> kind == N_RELATTR){
+         mk_rel_attr(current, relAttrs[i]);
+         aggFuns[i] = NO_F;
+         continue;
+      }
+
+      /* Look up the aggregate function, ignoring case */
+      mk_rel_attr(current->u.AGGRELATTR.relattr, relAttrs[i]);
+      function = current->u.AGGRELATTR.function;
+      if(!strcasecmp(function, "min"))
+         aggFuns[i] = MIN_F;
+      else if(!strcasecmp(function, "max"))
+         aggFuns[i] = MAX_F;
+      else if(!strcasecmp(function, "count"))
+         aggFuns[i] = COUNT_F;
+      else if(!strcasecmp(function, "sum"))
+         aggFuns[i] = SUM_F;
+      else if(!strcasecmp(function, "avg"))
+         aggFuns[i] = AVG_F;
+      else
+         return E_INVAGGFUNC;
+   }
+
+   return i;
+}
+
 /*
  * mk_rel_attr: converts a single relation-attribute (<relation,
  * attribute> pair) into a RelAttr
@@ -374,6 +468,33 @@ static void mk_rel_attr(NODE *node, RelAttr &relAttr)
    relAttr.attrName = node->u.RELATTR.attrname;
 }
 
+/*
+ * mk_order_attrs: converts a list of order by attributes into an array of
+ * OrderAttrs
+ *
+ * Returns:
+ *    the lengh of the list on success ( >= 0 )
+ *    error code otherwise
+ */
+static int mk_order_attrs(NODE *list, int max, OrderAttr orderAttrs[])
+{
+   int i;
+   NODE *current;
+
+   /* For each element of the list... */
+   for(i = 0; list != NULL; ++i, list = list -> u.LIST.next){
+      /* If the list is too long then error */
+      if(i == max)
+         return E_TOOMANY;
+
+      current = list -> u.LIST.curr;
+      mk_rel_attr(current->u.ORDERATTR.relattr, orderAttrs[i].attr);
+      orderAttrs[i].bDescending = current->u.ORDERATTR.descending;
+   }
+
+   return i;
+}
+
 /*
  * mk_relations: converts a list of relations into an array of relations
  *
@@ -616,6 +737,9 @@ static void print_error(char *errmsg, RC errval)
       case E_INVATTRNAME:
          fprintf(stderr, "attribute name for distribute is not valid\n");
          break;
+      case E_INVAGGFUNC:
+         fprintf(stderr, "invalid aggregate function (should be min, max, count, sum or avg)\n");
+         break;
       default:
          fprintf(ERRFP, "unrecognized errval: %d\n", errval);
    }
@@ -631,8 +755,9 @@ static void echo_query(NODE *n)
          printf(";\n");
          break;
       case N_CREATEINDEX:            /* for CreateIndex() */
-         printf("create index %s(%s);\n", n -> u.CREATEINDEX.relname,
-               n -> u.CREATEINDEX.attrname);
+         printf("create index %s(%s)%s;\n", n -> u.CREATEINDEX.relname,
+               n -> u.CREATEINDEX.attrname,
+               n -> u.CREATEINDEX.indextype == IX_HASH ? " using hash" : "");
          break;
       case N_DROPINDEX:            /* for DropIndex() */
          printf("drop index %s(%s);\n", n -> u.DROPINDEX.relname,
@@ -645,6 +770,12 @@ static void echo_query(NODE *n)
          printf("load %s(\"%s\");\n",
                n -> u.LOAD.relname, n -> u.LOAD.filename);
          break;
+      case N_ANALYZE:         /* for Analyze() */
+         printf("analyze %s", n -> u.ANALYZE.relname);
+         if (n -> u.ANALYZE.samplepercent < 100)
+            printf(" sample %d", n -> u.ANALYZE.samplepercent);
+         printf(";\n");
+         break;
       case N_HELP:            /* for Help() */
          printf("help");
          if(n -> u.HELP.relname != NULL)
@@ -658,8 +789,10 @@ static void echo_query(NODE *n)
          printf("set %s = \"%s\";\n", n->u.SET.paramName, n->u.SET.string);
          break;
       case N_QUERY:            /* for Query() */
+         if (n->u.QUERY.explain)
+            printf("explain analyze ");
          printf("select ");
-         print_relattrs(n -> u.QUERY.relattrlist);
+         print_sel_attrs(n -> u.QUERY.relattrlist);
          printf("\n from ");
          print_relations(n -> u.QUERY.rellist);
          printf("\n");
@@ -667,6 +800,16 @@ static void echo_query(NODE *n)
             printf("where ");
             print_conditions(n->u.QUERY.conditionlist);
          }
+         if (n->u.QUERY.grouplist) {
+            printf(" group by");
+            print_relattrs(n->u.QUERY.grouplist);
+         }
+         if (n->u.QUERY.orderlist) {
+            printf(" order by");
+            print_order_attrs(n->u.QUERY.orderlist);
+         }
+         if (n->u.QUERY.limit >= 0)
+            printf(" limit %d", n->u.QUERY.limit);
          printf(";\n");
          break;
       case N_INSERT:            /* for Insert() */
@@ -791,6 +934,24 @@ static void print_relattrs(NODE *n)
    }
 }
 
+static void print_sel_attrs(NODE *n)
+{
+   NODE *attr;
+
+   for(; n != NULL; n = n -> u.LIST.next){
+      attr = n -> u.LIST.curr;
+      if(attr -> kind == N_AGGRELATTR){
+         printf(" %s(", attr -> u.AGGRELATTR.function);
+         print_relattr(attr -> u.AGGRELATTR.relattr);
+         printf(")");
+      }
+      else
+         print_relattr(attr);
+      if(n -> u.LIST.next != NULL)
+         printf(",");
+   }
+}
+
 static void print_relations(NODE *n)
 {
    for(; n != NULL; n = n -> u.LIST.next){
@@ -800,6 +961,17 @@ static void print_relations(NODE *n)
    }
 }
 
+static void print_order_attrs(NODE *n)
+{
+   for(; n != NULL; n = n -> u.LIST.next){
+      print_relattr(n->u.LIST.curr->u.ORDERATTR.relattr);
+      if(n->u.LIST.curr->u.ORDERATTR.descending)
+         printf(" desc");
+      if(n -> u.LIST.next != NULL)
+         printf(",");
+   }
+}
+
 static void print_conditions(NODE *n)
 {
    for(; n != NULL; n = n -> u.LIST.next){
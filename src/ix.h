@@ -13,18 +13,33 @@
 #include "rm_rid.h"  // Please don't change these lines
 #include "pf.h"
 
+// IX_IndexType: Structure used by an index
+enum IX_IndexType {
+    IX_BTREE,
+    IX_HASH
+};
+
+#define IX_HASH_MAX_DEPTH       9                           // Maximum global depth of a hash index
+#define IX_HASH_DIRECTORY_SIZE  (1 << IX_HASH_MAX_DEPTH)    // Hash directory slots in the header
+
 // IX_IndexHeader: Struct for the index file header
 /* Stores the following:
     1) attrType - Attribute type for the index - AttrType
     2) attrLength - Attribute length - integer
     3) rootPage - Page number of the B+ Tree root - PageNum
     4) degree - Degree of a node in the B+ Tree - integer
+    5) indexType - B+ Tree or extendible hash index - IX_IndexType
+    6) globalDepth - Global depth of the hash directory - integer
+    7) directory - Bucket page for each hash directory slot - PageNum array
 */
 struct IX_IndexHeader {
     AttrType attrType;
     int attrLength;
     PageNum rootPage;
     int degree;
+    IX_IndexType indexType;
+    int globalDepth;
+    PageNum directory[IX_HASH_DIRECTORY_SIZE];
 };
 
 // IX_Entry: Struct for the index entry
@@ -56,12 +71,20 @@ public:
     // Force index files to disk
     RC ForcePages();
 
+    // Get the type of the index
+    IX_IndexType GetIndexType() const;
+
+    // Hash a value of an attribute (the hash of the keys of a hash index)
+    static unsigned int HashValue(const void* pData, AttrType attrType, int attrLength);
+
 private:
     PF_FileHandle pfFH;                 // PF file handle
     IX_IndexHeader indexHeader;         // Index file header
     int isOpen;                         // index handle open flag
     int headerModified;                 // Modified flag for the index header
     IX_Entry lastDeletedEntry;               // Last deleted entry
+    PageNum lastDisposedPage;           // Hash overflow page disposed by the last deletion
+    PageNum lastDisposedNext;           // Page that followed it in the bucket chain
 
     RC InsertEntryRecursive(void *pData, const RID &rid, PageNum node);
     RC pushKeyUp(void* pData, PageNum node, PageNum left, PageNum right);
@@ -74,6 +97,16 @@ private:
     template<typename T>
     bool satisfiesInterval(T key1, T key2, T value);
 
+    // Hash index methods (ix_hash.cc)
+    RC InsertHashEntry(void *pData, const RID &rid);
+    RC DeleteHashEntry(void *pData, const RID &rid);
+    RC AllocateHashBucket(int localDepth, PageNum &pageNumber);
+    RC AppendToHashBucket(PageNum bucket, void* pData, const RID &rid,
+                            bool allowOverflow, bool &appended);
+    RC SplitHashBucket(PageNum bucket, bool &split);
+    unsigned int HashKey(void* pData) const;
+    bool MatchKey(char* key, void* pData) const;
+
     // template<typename T>
     // RC InsertInRootLeaf(void* pData, RID &rid, char* keyData, char* valueData, int numberKeys, int keyCapacity);
 };
@@ -92,6 +125,15 @@ public:
                 void *value,
                 ClientHint  pinHint = NO_HINT);
 
+    // Open a range scan bounded by a lower and an upper condition
+    // (lowerOp is NO_OP, GT_OP or GE_OP; upperOp is NO_OP, LT_OP or LE_OP)
+    RC OpenScan(const IX_IndexHandle &indexHandle,
+                CompOp lowerOp,
+                void *lowerValue,
+                CompOp upperOp,
+                void *upperValue,
+                ClientHint  pinHint = NO_HINT);
+
     // Get the next matching entry return IX_EOF if no more matching
     // entries.
     RC GetNextEntry(RID &rid);
@@ -106,22 +148,29 @@ private:
     const IX_IndexHandle* indexHandle;      // Index handle for the index
     AttrType attrType;                      // Attribute type
     int attrLength;                         // Attribute length
-    CompOp compOp;                          // Comparison operator
-    void* value;                            // Value to be compared
+    CompOp lowerOp;                         // Lower bound operator
+    void* lowerValue;                       // Lower bound value
+    CompOp upperOp;                         // Upper bound operator
+    void* upperValue;                       // Upper bound value
     ClientHint pinHint;                     // Pinning hint
     int scanOpen;                           // Flag to track if scan open
     int degree;                             // Degree of the nodes
     int inBucket;                           // Flag whether currently in bucket
+    int hashScan;                           // Flag whether scanning a hash index
+    PageNum bucketLeafPage;                 // Leaf page holding the key of the current bucket
     IX_Entry lastScannedEntry;                   // Last scanned entry
 
     RC SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition);
+    RC GetNextHashEntry(RID &rid);
 
+    bool satisfiesBound(char* key, CompOp op, void* value);
     template<typename T>
-    bool satisfiesCondition(T key, T value);
+    bool satisfiesCondition(T key, T value, CompOp op);
     template<typename T>
     bool satisfiesInterval(T key1, T key2, T value);
     bool compareRIDs(const RID &rid1, const RID &rid2);
     bool compareEntries(const IX_Entry &e1, const IX_Entry &e2);
+    void freeLastScannedEntry();
 };
 
 //
@@ -134,7 +183,8 @@ public:
 
     // Create a new Index
     RC CreateIndex(const char *fileName, int indexNo,
-                   AttrType attrType, int attrLength);
+                   AttrType attrType, int attrLength,
+                   IX_IndexType indexType = IX_BTREE);
 
     // Destroy an Index
     RC DestroyIndex(const char *fileName, int indexNo);
@@ -174,7 +224,8 @@ void IX_PrintError(RC rc);
 #define IX_INVALID_OPERATOR         (START_IX_WARN + 12) // Invalid operator
 #define IX_SCAN_CLOSED              (START_IX_WARN + 13) // Scan is closed
 #define IX_DELETE_ENTRY_NOT_FOUND   (START_IX_WARN + 14) // Delete an entry that does not exist
-#define IX_LASTWARN                 IX_DELETE_ENTRY_NOT_FOUND
+#define IX_INVALID_INDEX_TYPE       (START_IX_WARN + 15) // Invalid index type
+#define IX_LASTWARN                 IX_INVALID_INDEX_TYPE
 
 // Errors
 #define IX_INVALIDNAME          (START_IX_ERR - 0) // Invalid PC file name
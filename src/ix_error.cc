@@ -28,7 +28,8 @@ static char *IX_WarnMsg[] = {
   (char*)"invalid attribute",
   (char*)"invalid operator",
   (char*)"scan is closed",
-  (char*)"delete an entry that does not exist"
+  (char*)"delete an entry that does not exist",
+  (char*)"invalid index type"
 };
 
 static char *IX_ErrorMsg[] = {
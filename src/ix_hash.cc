@@ -0,0 +1,523 @@
+//
+// File:        ix_hash.cc
+// Description: Extendible hash index methods of IX_IndexHandle
+// Authors:     Aditya Bhandari (adityasb@stanford.edu)
+//
+
+#include "ix_internal.h"
+#include "ix.h"
+#include <cstring>
+#include <vector>
+using namespace std;
+
+/************** CODE FOR HASH INDEXES *****************/
+
+// A hash index keeps the directory in the index header. Every directory slot
+// points to a bucket page; a bucket page holds (key, RID) entries after its
+// IX_HashBucketHeader and chains overflow pages for keys that cannot be
+// separated by splitting.
+
+// Method: InsertHashEntry(void *pData, const RID &rid)
+// Insert a new entry in a hash index
+/* Steps:
+    1) If the directory is empty, allocate the first bucket
+    2) Append the entry to the bucket chain of its directory slot
+    3) If the bucket chain is full, split the bucket and try again
+    4) If the bucket cannot be split, append an overflow page
+*/
+RC IX_IndexHandle::InsertHashEntry(void *pData, const RID &rid) {
+    // Declare an integer for the return code
+    int rc;
+
+    // Allocate the first bucket
+    if (indexHeader.directory[0] == IX_NO_PAGE) {
+        PageNum firstBucket;
+        if ((rc = AllocateHashBucket(0, firstBucket))) {
+            return rc;
+        }
+        indexHeader.globalDepth = 0;
+        indexHeader.directory[0] = firstBucket;
+        headerModified = TRUE;
+    }
+
+    while (true) {
+        // Get the bucket of the key
+        unsigned int mask = (1u << indexHeader.globalDepth) - 1;
+        PageNum bucket = indexHeader.directory[HashKey(pData) & mask];
+
+        // Append to the bucket chain if there is space
+        bool appended = false;
+        if ((rc = AppendToHashBucket(bucket, pData, rid, false, appended))) {
+            return rc;
+        }
+        if (appended) {
+            return OK_RC;
+        }
+
+        // Split the full bucket
+        bool split = false;
+        if ((rc = SplitHashBucket(bucket, split))) {
+            return rc;
+        }
+
+        // If all the keys in the bucket share the hash, chain an overflow page
+        if (!split) {
+            if ((rc = AppendToHashBucket(bucket, pData, rid, true, appended))) {
+                return rc;
+            }
+            return OK_RC;
+        }
+    }
+}
+
+// Method: DeleteHashEntry(void *pData, const RID &rid)
+// Delete an entry from a hash index
+/* Steps:
+    1) Get the bucket of the key
+    2) Search the bucket chain for the entry
+    3) Move the last entry of the page in the place of the deleted entry
+    4) If an overflow page becomes empty, unlink it from the chain and dispose of it
+    5) Store the last deleted entry
+*/
+RC IX_IndexHandle::DeleteHashEntry(void *pData, const RID &rid) {
+    // Declare an integer for the return code
+    int rc;
+
+    // Get the bucket of the key
+    unsigned int mask = (1u << indexHeader.globalDepth) - 1;
+    PageNum pageNumber = indexHeader.directory[HashKey(pData) & mask];
+    int attrLength = indexHeader.attrLength;
+    int entrySize = attrLength + sizeof(RID);
+    PageNum previousPage = IX_NO_PAGE;
+    lastDisposedPage = IX_NO_PAGE;
+
+    // Search the bucket chain
+    while (pageNumber != IX_NO_PAGE) {
+        PF_PageHandle pfPH;
+        char* pageData;
+        if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
+            return rc;
+        }
+        if ((rc = pfPH.GetData(pageData))) {
+            return rc;
+        }
+
+        IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+        char* entryData = pageData + sizeof(IX_HashBucketHeader);
+        for (int i=0; i<bucketHeader->numberEntries; i++) {
+            char* entry = entryData + i*entrySize;
+            RID entryRID = *(RID*) (entry + attrLength);
+            if (MatchKey(entry, pData) && compareRIDs(entryRID, rid)) {
+                // Fill the hole with the last entry of the page
+                char* lastEntry = entryData + (bucketHeader->numberEntries-1)*entrySize;
+                if (lastEntry != entry) {
+                    memcpy(entry, lastEntry, entrySize);
+                }
+                bucketHeader->numberEntries--;
+                bool empty = bucketHeader->numberEntries == 0 && previousPage != IX_NO_PAGE;
+                PageNum nextPage = bucketHeader->overflowPage;
+                if ((rc = pfFH.MarkDirty(pageNumber))) {
+                    return rc;
+                }
+                if ((rc = pfFH.UnpinPage(pageNumber))) {
+                    return rc;
+                }
+
+                // Unlink and dispose of an empty overflow page
+                if (empty) {
+                    if ((rc = pfFH.GetThisPage(previousPage, pfPH))) {
+                        return rc;
+                    }
+                    if ((rc = pfPH.GetData(pageData))) {
+                        return rc;
+                    }
+                    ((IX_HashBucketHeader*) pageData)->overflowPage = nextPage;
+                    if ((rc = pfFH.MarkDirty(previousPage))) {
+                        return rc;
+                    }
+                    if ((rc = pfFH.UnpinPage(previousPage))) {
+                        return rc;
+                    }
+                    if ((rc = pfFH.DisposePage(pageNumber))) {
+                        return rc;
+                    }
+                    lastDisposedPage = pageNumber;
+                    lastDisposedNext = nextPage;
+                }
+
+                // Store the last deleted entry
+                if (lastDeletedEntry.keyValue == NULL) {
+                    lastDeletedEntry.keyValue = new char[attrLength];
+                }
+                memcpy(lastDeletedEntry.keyValue, pData, attrLength);
+                lastDeletedEntry.rid = rid;
+
+                // Return OK
+                return OK_RC;
+            }
+        }
+
+        PageNum nextPage = bucketHeader->overflowPage;
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
+        }
+        previousPage = pageNumber;
+        pageNumber = nextPage;
+    }
+
+    return IX_DELETE_ENTRY_NOT_FOUND;
+}
+
+// Method: AllocateHashBucket(int localDepth, PageNum &pageNumber)
+// Allocate an empty bucket page with the given local depth
+RC IX_IndexHandle::AllocateHashBucket(int localDepth, PageNum &pageNumber) {
+    // Declare an integer for the return code
+    int rc;
+
+    // Allocate a new page
+    PF_PageHandle pfPH;
+    char* pageData;
+    if ((rc = pfFH.AllocatePage(pfPH))) {
+        return rc;
+    }
+    if ((rc = pfPH.GetData(pageData))) {
+        return rc;
+    }
+    if ((rc = pfPH.GetPageNum(pageNumber))) {
+        return rc;
+    }
+    if ((rc = pfFH.MarkDirty(pageNumber))) {
+        return rc;
+    }
+
+    // Initialize the bucket header
+    IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+    bucketHeader->numberEntries = 0;
+    bucketHeader->entryCapacity = (PF_PAGE_SIZE - sizeof(IX_HashBucketHeader)) /
+                                  (indexHeader.attrLength + sizeof(RID));
+    bucketHeader->localDepth = localDepth;
+    bucketHeader->overflowPage = IX_NO_PAGE;
+
+    // Unpin the page
+    if ((rc = pfFH.UnpinPage(pageNumber))) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+// Method: AppendToHashBucket(PageNum bucket, void* pData, const RID &rid,
+//                            bool allowOverflow, bool &appended)
+// Append an entry to the first page of a bucket chain with free space
+/* Steps:
+    1) Walk the bucket chain up to the first page with free space
+        - Return IX_ENTRY_EXISTS for a duplicate entry in a bucket without overflow pages
+        - An overflow chain holds keys sharing one hash (a skewed key), so its entries
+          are not searched for each insert
+    2) Copy the entry in the first page with free space
+    3) If no page has free space and overflow is allowed, chain a new page
+*/
+RC IX_IndexHandle::AppendToHashBucket(PageNum bucket, void* pData, const RID &rid,
+                                      bool allowOverflow, bool &appended) {
+    // Declare an integer for the return code
+    int rc;
+
+    int attrLength = indexHeader.attrLength;
+    int entrySize = attrLength + sizeof(RID);
+    PageNum freePage = IX_NO_PAGE;
+    PageNum lastPage = IX_NO_PAGE;
+    int localDepth = 0;
+    appended = false;
+
+    // Walk the bucket chain
+    PageNum pageNumber = bucket;
+    while (pageNumber != IX_NO_PAGE) {
+        PF_PageHandle pfPH;
+        char* pageData;
+        if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
+            return rc;
+        }
+        if ((rc = pfPH.GetData(pageData))) {
+            return rc;
+        }
+
+        IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+        if (pageNumber == bucket && bucketHeader->overflowPage == IX_NO_PAGE) {
+            char* entryData = pageData + sizeof(IX_HashBucketHeader);
+            for (int i=0; i<bucketHeader->numberEntries; i++) {
+                char* entry = entryData + i*entrySize;
+                RID entryRID = *(RID*) (entry + attrLength);
+                if (MatchKey(entry, pData) && compareRIDs(entryRID, rid)) {
+                    pfFH.UnpinPage(pageNumber);
+                    return IX_ENTRY_EXISTS;
+                }
+            }
+        }
+
+        if (pageNumber == bucket) {
+            localDepth = bucketHeader->localDepth;
+        }
+        lastPage = pageNumber;
+        PageNum nextPage = bucketHeader->overflowPage;
+        bool free = bucketHeader->numberEntries < bucketHeader->entryCapacity;
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
+        }
+        if (free) {
+            freePage = pageNumber;
+            break;
+        }
+        pageNumber = nextPage;
+    }
+
+    // Chain an overflow page if allowed
+    if (freePage == IX_NO_PAGE) {
+        if (!allowOverflow) {
+            return OK_RC;
+        }
+        if ((rc = AllocateHashBucket(localDepth, freePage))) {
+            return rc;
+        }
+
+        PF_PageHandle pfPH;
+        char* pageData;
+        if ((rc = pfFH.GetThisPage(lastPage, pfPH))) {
+            return rc;
+        }
+        if ((rc = pfPH.GetData(pageData))) {
+            return rc;
+        }
+        ((IX_HashBucketHeader*) pageData)->overflowPage = freePage;
+        if ((rc = pfFH.MarkDirty(lastPage))) {
+            return rc;
+        }
+        if ((rc = pfFH.UnpinPage(lastPage))) {
+            return rc;
+        }
+    }
+
+    // Copy the entry in the page
+    PF_PageHandle pfPH;
+    char* pageData;
+    if ((rc = pfFH.GetThisPage(freePage, pfPH))) {
+        return rc;
+    }
+    if ((rc = pfPH.GetData(pageData))) {
+        return rc;
+    }
+    IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+    char* entry = pageData + sizeof(IX_HashBucketHeader) + bucketHeader->numberEntries*entrySize;
+    memcpy(entry, pData, attrLength);
+    memcpy(entry + attrLength, &rid, sizeof(RID));
+    bucketHeader->numberEntries++;
+    if ((rc = pfFH.MarkDirty(freePage))) {
+        return rc;
+    }
+    if ((rc = pfFH.UnpinPage(freePage))) {
+        return rc;
+    }
+
+    appended = true;
+
+    // Return OK
+    return OK_RC;
+}
+
+// Method: SplitHashBucket(PageNum bucket, bool &split)
+// Split a full bucket on the next hash bit
+/* Steps:
+    1) Collect the entries of the bucket chain
+    2) If all entries share the hash or the directory is at its maximum
+       depth with the bucket at global depth, do not split
+    3) Double the directory if the local depth equals the global depth
+    4) Allocate the sibling bucket and point half of the directory slots to it
+    5) Dispose of the overflow pages and redistribute the entries
+*/
+RC IX_IndexHandle::SplitHashBucket(PageNum bucket, bool &split) {
+    // Declare an integer for the return code
+    int rc;
+
+    int attrLength = indexHeader.attrLength;
+    int entrySize = attrLength + sizeof(RID);
+    split = false;
+
+    // Collect the entries of the bucket chain
+    vector<char> entries;
+    vector<PageNum> overflowPages;
+    int localDepth = 0;
+    bool oneHash = true;
+    unsigned int firstHash = 0;
+    PageNum pageNumber = bucket;
+    while (pageNumber != IX_NO_PAGE) {
+        PF_PageHandle pfPH;
+        char* pageData;
+        if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
+            return rc;
+        }
+        if ((rc = pfPH.GetData(pageData))) {
+            return rc;
+        }
+
+        IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+        char* entryData = pageData + sizeof(IX_HashBucketHeader);
+        for (int i=0; i<bucketHeader->numberEntries; i++) {
+            char* entry = entryData + i*entrySize;
+            unsigned int hash = HashKey(entry);
+            if (entries.empty()) {
+                firstHash = hash;
+            }
+            else if (hash != firstHash) {
+                oneHash = false;
+            }
+            entries.insert(entries.end(), entry, entry + entrySize);
+        }
+
+        if (pageNumber == bucket) {
+            localDepth = bucketHeader->localDepth;
+        }
+        else {
+            overflowPages.push_back(pageNumber);
+        }
+        PageNum nextPage = bucketHeader->overflowPage;
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
+        }
+        pageNumber = nextPage;
+    }
+
+    // Check whether splitting can separate the entries
+    if (oneHash || localDepth >= IX_HASH_MAX_DEPTH) {
+        return OK_RC;
+    }
+
+    // Double the directory
+    if (localDepth == indexHeader.globalDepth) {
+        int directorySize = 1 << indexHeader.globalDepth;
+        for (int i=0; i<directorySize; i++) {
+            indexHeader.directory[directorySize + i] = indexHeader.directory[i];
+        }
+        indexHeader.globalDepth++;
+    }
+
+    // Allocate the sibling bucket
+    PageNum sibling;
+    if ((rc = AllocateHashBucket(localDepth+1, sibling))) {
+        return rc;
+    }
+
+    // Point the slots with the new hash bit set to the sibling
+    int directorySize = 1 << indexHeader.globalDepth;
+    for (int i=0; i<directorySize; i++) {
+        if (indexHeader.directory[i] == bucket && ((i >> localDepth) & 1)) {
+            indexHeader.directory[i] = sibling;
+        }
+    }
+    headerModified = TRUE;
+
+    // Empty the bucket and increase its local depth
+    PF_PageHandle pfPH;
+    char* pageData;
+    if ((rc = pfFH.GetThisPage(bucket, pfPH))) {
+        return rc;
+    }
+    if ((rc = pfPH.GetData(pageData))) {
+        return rc;
+    }
+    IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+    bucketHeader->numberEntries = 0;
+    bucketHeader->localDepth = localDepth+1;
+    bucketHeader->overflowPage = IX_NO_PAGE;
+    if ((rc = pfFH.MarkDirty(bucket))) {
+        return rc;
+    }
+    if ((rc = pfFH.UnpinPage(bucket))) {
+        return rc;
+    }
+
+    // Dispose of the overflow pages
+    for (unsigned int i=0; i<overflowPages.size(); i++) {
+        if ((rc = pfFH.DisposePage(overflowPages[i]))) {
+            return rc;
+        }
+    }
+
+    // Redistribute the entries
+    unsigned int mask = directorySize - 1;
+    int numberEntries = entries.size() / entrySize;
+    for (int i=0; i<numberEntries; i++) {
+        char* entry = &entries[i*entrySize];
+        RID entryRID = *(RID*) (entry + attrLength);
+        bool appended;
+        PageNum target = indexHeader.directory[HashKey(entry) & mask];
+        if ((rc = AppendToHashBucket(target, entry, entryRID, true, appended))) {
+            return rc;
+        }
+    }
+
+    split = true;
+
+    // Return OK
+    return OK_RC;
+}
+
+// Method: HashKey(void* pData)
+// Hash a key of the index attribute
+unsigned int IX_IndexHandle::HashKey(void* pData) const {
+    return HashValue(pData, indexHeader.attrType, indexHeader.attrLength);
+}
+
+// Method: HashValue(const void* pData, AttrType attrType, int attrLength)
+// Hash a value of an attribute
+unsigned int IX_IndexHandle::HashValue(const void* pData, AttrType attrType, int attrLength) {
+    unsigned int hash = 0;
+    if (attrType == STRING) {
+        // FNV-1a over the string
+        const char* key = static_cast<const char*>(pData);
+        hash = 2166136261u;
+        for (int i=0; i<attrLength && key[i] != '\0'; i++) {
+            hash ^= (unsigned char) key[i];
+            hash *= 16777619u;
+        }
+    }
+    else {
+        if (attrType == FLOAT) {
+            // Negative and positive zero are equal keys
+            float key;
+            memcpy(&key, pData, sizeof(float));
+            if (key == 0) {
+                key = 0;
+            }
+            memcpy(&hash, &key, sizeof(float));
+        }
+        else {
+            memcpy(&hash, pData, sizeof(int));
+        }
+
+        // Mix the bits so that the low bits depend on the whole key
+        hash ^= hash >> 16;
+        hash *= 0x7feb352du;
+        hash ^= hash >> 15;
+        hash *= 0x846ca68bu;
+        hash ^= hash >> 16;
+    }
+    return hash;
+}
+
+// Method: MatchKey(char* key, void* pData)
+// Boolean whether a stored key is equal to the given value
+bool IX_IndexHandle::MatchKey(char* key, void* pData) const {
+    if (indexHeader.attrType == INT) {
+        int key1, key2;
+        memcpy(&key1, key, sizeof(int));
+        memcpy(&key2, pData, sizeof(int));
+        return key1 == key2;
+    }
+    else if (indexHeader.attrType == FLOAT) {
+        float key1, key2;
+        memcpy(&key1, key, sizeof(float));
+        memcpy(&key2, pData, sizeof(float));
+        return key1 == key2;
+    }
+    return strncmp(key, static_cast<char*>(pData), indexHeader.attrLength) == 0;
+}
@@ -18,6 +18,7 @@ IX_IndexHandle::IX_IndexHandle() {
 
     // Initialize the index header
     indexHeader.rootPage = IX_NO_PAGE;
+    indexHeader.indexType = IX_BTREE;
 }
 
 // Destructor
@@ -69,6 +70,11 @@ RC IX_IndexHandle::InsertEntry(void *pData, const RID &rid) {
         return IX_NULL_ENTRY;
     }
 
+    // Hash indexes keep their own bucket structure
+    if (indexHeader.indexType == IX_HASH) {
+        return InsertHashEntry(pData, rid);
+    }
+
     // Declare an integer for the return code
     int rc;
 
@@ -2775,6 +2781,11 @@ RC IX_IndexHandle::DeleteEntry(void *pData, const RID &rid) {
         return IX_NULL_ENTRY;
     }
 
+    // Hash indexes keep their own bucket structure
+    if (indexHeader.indexType == IX_HASH) {
+        return DeleteHashEntry(pData, rid);
+    }
+
     // Get the root page
     PageNum rootPage = indexHeader.rootPage;
     if (rootPage == IX_NO_PAGE) {
@@ -3524,6 +3535,12 @@ RC IX_IndexHandle::ForcePages() {
     return OK_RC;
 }
 
+// Method: GetIndexType()
+// Get the type of the index
+IX_IndexType IX_IndexHandle::GetIndexType() const {
+    return indexHeader.indexType;
+}
+
 // Method: compareRIDs(RID &rid1, RID &rid2)
 // Boolean whether the two RIDs are the same
 bool IX_IndexHandle::compareRIDs(const RID &rid1, const RID &rid2) {
@@ -26,24 +26,102 @@ IX_IndexScan::~IX_IndexScan() {
 // Open index scan
 /* Steps:
     1) Check for erroneous input
-    2) Initialize the class variables
-        - Store attrType, attrLength, compOp, value, pinHint and degree
-    3) Get the first key satisfying the condition and store
+    2) Convert the condition into a lower and an upper bound
+        - EQ_OP becomes [value, value]
+        - LT_OP and LE_OP only have an upper bound
+        - GT_OP and GE_OP only have a lower bound
+    3) Open the range scan
+    4) For a hash index, only EQ_OP is supported
+        - Start at the bucket of the value
 */
 RC IX_IndexScan::OpenScan(const IX_IndexHandle &indexHandle, CompOp compOp,
                           void *value, ClientHint  pinHint) {
     // Check for erroneous input
+    if (compOp != NO_OP && compOp != EQ_OP && compOp != LT_OP &&
+        compOp != GT_OP && compOp != LE_OP && compOp != GE_OP) {
+        return IX_INVALID_OPERATOR;
+    }
+
+    // Open an equality scan on a hash index
+    if (indexHandle.isOpen && (indexHandle.indexHeader).indexType == IX_HASH) {
+        if (compOp != EQ_OP || value == NULL) {
+            return IX_INVALID_OPERATOR;
+        }
+
+        // Store the class variables
+        this->indexHandle = &indexHandle;
+        this->attrType = (indexHandle.indexHeader).attrType;
+        this->attrLength = (indexHandle.indexHeader).attrLength;
+        this->lowerOp = EQ_OP;
+        this->lowerValue = value;
+        this->upperOp = NO_OP;
+        this->upperValue = NULL;
+        this->pinHint = pinHint;
+        this->hashScan = TRUE;
+        this->inBucket = FALSE;
+        (this->lastScannedEntry).keyValue = NULL;
+        (this->lastScannedEntry).rid = dummyRID;
+
+        // Get the bucket of the value
+        const IX_IndexHeader &indexHeader = indexHandle.indexHeader;
+        unsigned int mask = (1u << indexHeader.globalDepth) - 1;
+        this->pageNumber = indexHeader.directory[indexHandle.HashKey(value) & mask];
+        this->keyPosition = 0;
+
+        // Set the scan open flag
+        scanOpen = TRUE;
+
+        // Return OK
+        return OK_RC;
+    }
+
+    // Convert the condition into bounds
+    switch (compOp) {
+        case EQ_OP:
+            return OpenScan(indexHandle, GE_OP, value, LE_OP, value, pinHint);
+        case LT_OP:
+        case LE_OP:
+            return OpenScan(indexHandle, NO_OP, NULL, compOp, value, pinHint);
+        case GT_OP:
+        case GE_OP:
+            return OpenScan(indexHandle, compOp, value, NO_OP, NULL, pinHint);
+        default:
+            return OpenScan(indexHandle, NO_OP, NULL, NO_OP, NULL, pinHint);
+    }
+}
+
+// Method: OpenScan(const IX_IndexHandle &indexHandle, CompOp lowerOp,
+//                  void *lowerValue, CompOp upperOp, void *upperValue,
+//                  ClientHint  pinHint)
+// Open a range scan over the keys between the two bounds
+/* Steps:
+    1) Check for erroneous input
+    2) Initialize the class variables
+        - Store attrType, attrLength, bounds, pinHint and degree
+    3) Get the first key satisfying the lower bound and store
+*/
+RC IX_IndexScan::OpenScan(const IX_IndexHandle &indexHandle, CompOp lowerOp,
+                          void *lowerValue, CompOp upperOp, void *upperValue,
+                          ClientHint  pinHint) {
+    // Check for erroneous input
     if (!indexHandle.isOpen) {
         return IX_INDEX_CLOSED;
     }
 
-    if (compOp != NO_OP && compOp != EQ_OP && compOp != LT_OP &&
-        compOp != GT_OP && compOp != LE_OP && compOp != GE_OP) {
+    // Hash indexes do not support range scans
+    if ((indexHandle.indexHeader).indexType == IX_HASH) {
+        return IX_INVALID_OPERATOR;
+    }
+
+    if (lowerOp != NO_OP && lowerOp != GT_OP && lowerOp != GE_OP) {
+        return IX_INVALID_OPERATOR;
+    }
+    if (upperOp != NO_OP && upperOp != LT_OP && upperOp != LE_OP) {
         return IX_INVALID_OPERATOR;
     }
 
-    // If the value is a null pointer
-    if (compOp != NO_OP && value == NULL) {
+    // If a bound value is a null pointer
+    if ((lowerOp != NO_OP && lowerValue == NULL) || (upperOp != NO_OP && upperValue == NULL)) {
         return IX_INVALID_OPERATOR;
     }
 
@@ -51,10 +129,13 @@ RC IX_IndexScan::OpenScan(const IX_IndexHandle &indexHandle, CompOp compOp,
     this->indexHandle = &indexHandle;
     this->attrType = (indexHandle.indexHeader).attrType;
     this->attrLength = (indexHandle.indexHeader).attrLength;
-    this->compOp = compOp;
-    this->value = value;
+    this->lowerOp = lowerOp;
+    this->lowerValue = lowerValue;
+    this->upperOp = upperOp;
+    this->upperValue = upperValue;
     this->pinHint = pinHint;
     this->degree = (indexHandle.indexHeader).degree;
+    this->hashScan = FALSE;
     this->inBucket = FALSE;
     this->bucketPosition = 0;
     (this->lastScannedEntry).keyValue = NULL;
@@ -98,20 +179,19 @@ RC IX_IndexScan::OpenScan(const IX_IndexHandle &indexHandle, CompOp compOp,
 /* Steps:
     1) If current page is IX_NO_PAGE, return IX_EOF
     2) Get the data from the current page
-    3) If the last scanned entry is deleted
-        - If in bucket and position = 0, update page number to the parent node
-        - If in bucket and position != 0, update bucket position
-        - If not in bucket and position != 0, update key position
-    4) If in bucket
+    3) If the last scanned entry was deleted from a leaf, search for its key again
+    4) Else if the last scanned entry is not deleted
+        - If in bucket, update bucket position (go back to the leaf at the end of the bucket)
+        - If not in bucket, go to the bucket of the key or increment key position
+    5) If in bucket
         - Go the bucket position and set rid to stored RID
-        - If bucket position = capacity, go to parent node and increment key position (go to next page in case of last key)
-    5) Else if not in bucket
-        - Go to the key position and check if it satisfies the condition
-    6) If it satisfies the condition
+    6) Else if not in bucket
+        - Skip to the next leaf at the end of a node
+        - Skip keys not satisfying the lower bound
+        - Return IX_EOF at the first key beyond the upper bound
         - Get the RID and assign it to rid
-        - If bucket is IX_NO_PAGE, increment key position (go to next page in case of last key)
-        - Else set inBucket to TRUE and bucket position to 0
-    7) Return OK
+    7) Store the key and rid as the last scanned entry
+    8) Return OK
 */
 RC IX_IndexScan::GetNextEntry(RID &rid) {
     // Return error if the scan is closed
@@ -121,16 +201,43 @@ RC IX_IndexScan::GetNextEntry(RID &rid) {
 
     // Check the current page
     if (pageNumber == IX_NO_PAGE) {
-        // Free the last scanned entry array
-        char* temp = static_cast<char*> (lastScannedEntry.keyValue);
-        delete[] temp;
-
+        freeLastScannedEntry();
         return IX_EOF;
     }
 
+    // Hash index scans walk a single bucket chain
+    if (hashScan) {
+        return GetNextHashEntry(rid);
+    }
+
     // Declare an integer for the return code
     int rc;
 
+    // If the last scanned entry was deleted from a leaf, the leaf may have been
+    // shifted or disposed, so search again from the root for the first key
+    // not less than the deleted key
+    bool lastEntryDeleted = !compareRIDs(lastScannedEntry.rid, dummyRID) &&
+        !compareRIDs((indexHandle->lastDeletedEntry).rid, dummyRID) &&
+        compareEntries(lastScannedEntry, indexHandle->lastDeletedEntry);
+    if (lastEntryDeleted && !inBucket) {
+        CompOp scanLowerOp = lowerOp;
+        void* scanLowerValue = lowerValue;
+        lowerOp = GE_OP;
+        lowerValue = lastScannedEntry.keyValue;
+        rc = SearchEntry((indexHandle->indexHeader).rootPage, pageNumber, keyPosition);
+        lowerOp = scanLowerOp;
+        lowerValue = scanLowerValue;
+        if (rc) {
+            return rc;
+        }
+
+        lastScannedEntry.rid = dummyRID;
+        if (pageNumber == IX_NO_PAGE) {
+            freeLastScannedEntry();
+            return IX_EOF;
+        }
+    }
+
     // Get the data from the current page
     PF_FileHandle pfFH = indexHandle->pfFH;
     PF_PageHandle pfPH;
@@ -142,102 +249,43 @@ RC IX_IndexScan::GetNextEntry(RID &rid) {
         return rc;
     }
 
-    // If the last scanned entry exists
-    if (!compareRIDs(lastScannedEntry.rid, dummyRID)) {
-        // Check if the last scanned entry was deleted
-        if (!compareRIDs((indexHandle->lastDeletedEntry).rid, dummyRID) && compareEntries(lastScannedEntry, indexHandle->lastDeletedEntry)) {
-            if ((rc = pfFH.UnpinPage(pageNumber))) {
-                return rc;
-            }
+    // If the last scanned entry exists and was not deleted, go to the next entry
+    if (!compareRIDs(lastScannedEntry.rid, dummyRID) && !lastEntryDeleted) {
+        // Unpin the current page
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
         }
 
-        // Else if this is not the first entry scanned, update the variables
+        if (inBucket) {
+            IX_BucketPageHeader* bucketHeader = (IX_BucketPageHeader*) pageData;
+            bucketPosition++;
+
+            // If end of the bucket, go back to the next key in the leaf
+            // (the parent node stored in the bucket is not updated on leaf splits)
+            if (bucketPosition == bucketHeader->numberRecords) {
+                inBucket = FALSE;
+                bucketPosition = 0;
+                pageNumber = bucketLeafPage;
+                keyPosition++;
+            }
+        }
         else {
-            if (inBucket) {
-                IX_BucketPageHeader* bucketHeader = (IX_BucketPageHeader*) pageData;
-                int numberRecords = bucketHeader->numberRecords;
-
-                bucketPosition++;
-
-                // Unpin the bucket page
-                if ((rc = pfFH.UnpinPage(pageNumber))) {
-                    return rc;
-                }
-
-                // If end of the bucket
-                if (bucketPosition == numberRecords) {
-                    inBucket = FALSE;
-                    bucketPosition = 0;
+            char* valueData = pageData + sizeof(IX_NodeHeader) + attrLength*degree;
+            IX_NodeValue* valueArray = (IX_NodeValue*) valueData;
 
-                    // Set the new page number and key position
-                    pageNumber = bucketHeader->parentNode;
-                    keyPosition++;
-
-                    // Get the page data
-                    if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
-                        return rc;
-                    }
-                    if ((rc = pfPH.GetData(pageData))) {
-                        return rc;
-                    }
-
-                    IX_NodeHeader* nodeHeader = (IX_NodeHeader*) pageData;
-                    int numberKeys = nodeHeader->numberKeys;
-                    char* valueData = pageData + sizeof(IX_NodeHeader) + attrLength*degree;
-                    IX_NodeValue* valueArray = (IX_NodeValue*) valueData;
-
-                    // Unpin the page
-                    if ((rc = pfFH.UnpinPage(pageNumber))) {
-                        return rc;
-                    }
-
-                    // If end of the node
-                    if (keyPosition == numberKeys) {
-                        pageNumber = valueArray[degree].page;
-                        keyPosition = 0;
-                    }
-                }
+            // Go to the bucket if it exists, else to the next key
+            if (valueArray[keyPosition].page == IX_NO_PAGE) {
+                keyPosition++;
             }
             else {
-                IX_NodeHeader* nodeHeader = (IX_NodeHeader*) pageData;
-                int numberKeys = nodeHeader->numberKeys;
-                char* keyData = pageData + sizeof(IX_NodeHeader);
-                char* valueData = keyData + attrLength*degree;
-                IX_NodeValue* valueArray = (IX_NodeValue*) valueData;
-
-                // Unpin the page
-                if ((rc = pfFH.UnpinPage(pageNumber))) {
-                    return rc;
-                }
-
-                // Go to the next position
-                // If no bucket
-                if (valueArray[keyPosition].page == IX_NO_PAGE) {
-                    keyPosition++;
-
-                    // If end of a node
-                    if (keyPosition == numberKeys) {
-                        pageNumber = valueArray[degree].page;
-                        keyPosition = 0;
-                    }
-                }
-                else {
-                    pageNumber = valueArray[keyPosition].page;
-                    inBucket = TRUE;
-                    bucketPosition = 0;
-                }
+                bucketLeafPage = pageNumber;
+                pageNumber = valueArray[keyPosition].page;
+                inBucket = TRUE;
+                bucketPosition = 0;
             }
         }
 
-        // Check that we have not reached the end of file
-        if (pageNumber == IX_NO_PAGE) {
-            // Free the last scanned entry array
-            char* temp = static_cast<char*> (lastScannedEntry.keyValue);
-            delete[] temp;
-
-            return IX_EOF;
-        }
-
+        // Get the new page
         if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
             return rc;
         }
@@ -260,108 +308,150 @@ RC IX_IndexScan::GetNextEntry(RID &rid) {
 
     // else if not in bucket
     else {
-        IX_NodeHeader* nodeHeader = (IX_NodeHeader*) pageData;
-        int numberKeys = nodeHeader->numberKeys;
-        char* keyData = pageData + sizeof(IX_NodeHeader);
-        char* valueData = keyData + attrLength*degree;
-        IX_NodeValue* valueArray = (IX_NodeValue*) valueData;
+        while (true) {
+            IX_NodeHeader* nodeHeader = (IX_NodeHeader*) pageData;
+            char* keyData = pageData + sizeof(IX_NodeHeader);
+            IX_NodeValue* valueArray = (IX_NodeValue*) (keyData + attrLength*degree);
 
-        // Unpin the current page
-        if ((rc = pfFH.UnpinPage(pageNumber))) {
-            return rc;
-        }
-        bool unpinned = true;
+            // If end of a node, go to the next leaf
+            if (keyPosition >= nodeHeader->numberKeys) {
+                PageNum nextPage = valueArray[degree].page;
+                if ((rc = pfFH.UnpinPage(pageNumber))) {
+                    return rc;
+                }
+                pageNumber = nextPage;
+                keyPosition = 0;
 
-        // Check if the current key satisfies the condition
-        if (keyPosition == numberKeys) {
-            pageNumber = valueArray[degree].page;
-            keyPosition = 0;
+                if (pageNumber == IX_NO_PAGE) {
+                    freeLastScannedEntry();
+                    return IX_EOF;
+                }
+                if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
+                    return rc;
+                }
+                if ((rc = pfPH.GetData(pageData))) {
+                    return rc;
+                }
+                continue;
+            }
 
-            if (pageNumber == IX_NO_PAGE) {
-                // Free the last scanned entry array
-                char* temp = static_cast<char*> (lastScannedEntry.keyValue);
-                delete[] temp;
+            // Skip the keys below the lower bound
+            char* currentKey = keyData + keyPosition*attrLength;
+            if (!satisfiesBound(currentKey, lowerOp, lowerValue)) {
+                keyPosition++;
+                continue;
+            }
 
+            // Stop the scan at the first key beyond the upper bound
+            if (!satisfiesBound(currentKey, upperOp, upperValue)) {
+                if ((rc = pfFH.UnpinPage(pageNumber))) {
+                    return rc;
+                }
+                pageNumber = IX_NO_PAGE;
+                freeLastScannedEntry();
                 return IX_EOF;
             }
-        }
-        while (true) {
-            if (attrType == INT) {
-                int* keyArray = (int*) keyData;
-                int givenValue = *static_cast<int*>(value);
-                if(satisfiesCondition(keyArray[keyPosition], givenValue))
-                    break;
-            }
-            else if (attrType == FLOAT) {
-                float* keyArray = (float*) keyData;
-                float givenValue = *static_cast<float*>(value);
-                if (satisfiesCondition(keyArray[keyPosition], givenValue))
-                    break;
-            }
-            else {
-                char* keyArray = (char*) keyData;
-                char* givenValueChar = static_cast<char*>(value);
-                string givenValue(givenValueChar);
-                string currentKey(keyArray + keyPosition*attrLength);
-                if (satisfiesCondition(currentKey, givenValue))
-                    break;
+
+            // Get the RID and assign to rid
+            rid = valueArray[keyPosition].rid;
+
+            // Store the current key
+            if (lastScannedEntry.keyValue == NULL) {
+                lastScannedEntry.keyValue = new char[attrLength];
             }
+            memcpy(lastScannedEntry.keyValue, currentKey, attrLength);
+            break;
+        }
+
+        // Unpin the current page
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
+        }
+    }
 
-            // Go to the next key position
-            keyPosition++;
+    // Update the last scanned entry
+    lastScannedEntry.rid = rid;
 
-            // If end of a node
-            if (keyPosition == numberKeys) {
-                PageNum previousPage = pageNumber;
-                pageNumber = valueArray[degree].page;
-                keyPosition = 0;
+    // Return OK
+    return OK_RC;
+}
 
-                // Unpin the previous page
-                if (!unpinned) {
-                    if ((rc = pfFH.UnpinPage(previousPage))) {
-                       return rc;
-                    }
-                }
+// Method: GetNextHashEntry(RID &rid)
+// Get the next entry equal to the scan value in the bucket chain of a hash index
+/* Steps:
+    1) If the last scanned entry was not deleted, go to the next position
+        - A deleted entry is replaced by the last entry of its page, so the
+          position is not changed after a deletion
+        - If the deletion emptied and disposed of the overflow page, go to
+          the page that followed it
+    2) Walk the bucket chain from the current position
+        - Go to the overflow page at the end of a page
+        - Return the first entry with a matching key
+    3) Return IX_EOF at the end of the chain
+*/
+RC IX_IndexScan::GetNextHashEntry(RID &rid) {
+    // Declare an integer for the return code
+    int rc;
 
-                if (pageNumber == IX_NO_PAGE) {
-                    // Free the last scanned entry array
-                    char* temp = static_cast<char*> (lastScannedEntry.keyValue);
-                    delete[] temp;
+    // Go to the next position unless the last scanned entry was deleted
+    bool lastEntryDeleted = !compareRIDs(lastScannedEntry.rid, dummyRID) &&
+        !compareRIDs((indexHandle->lastDeletedEntry).rid, dummyRID) &&
+        compareEntries(lastScannedEntry, indexHandle->lastDeletedEntry);
+    if (!compareRIDs(lastScannedEntry.rid, dummyRID) && !lastEntryDeleted) {
+        keyPosition++;
+    }
+    else if (lastEntryDeleted && pageNumber == indexHandle->lastDisposedPage) {
+        pageNumber = indexHandle->lastDisposedNext;
+        keyPosition = 0;
+    }
 
-                    return IX_EOF;
+    PF_FileHandle pfFH = indexHandle->pfFH;
+    int entrySize = attrLength + sizeof(RID);
+    while (pageNumber != IX_NO_PAGE) {
+        // Get the data from the current page
+        PF_PageHandle pfPH;
+        char* pageData;
+        if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
+            return rc;
+        }
+        if ((rc = pfPH.GetData(pageData))) {
+            return rc;
+        }
+
+        // Search the page for a matching key
+        IX_HashBucketHeader* bucketHeader = (IX_HashBucketHeader*) pageData;
+        char* entryData = pageData + sizeof(IX_HashBucketHeader);
+        for (; keyPosition < bucketHeader->numberEntries; keyPosition++) {
+            char* entry = entryData + keyPosition*entrySize;
+            if (indexHandle->MatchKey(entry, lowerValue)) {
+                rid = *(RID*) (entry + attrLength);
+
+                // Store the current key
+                if (lastScannedEntry.keyValue == NULL) {
+                    lastScannedEntry.keyValue = new char[attrLength];
                 }
-                else {
-                    // Get the new page
-                    if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
-                        return rc;
-                    }
-                    if ((rc = pfPH.GetData(pageData))) {
-                        return rc;
-                    }
-                    unpinned = false;
+                memcpy(lastScannedEntry.keyValue, entry, attrLength);
+                lastScannedEntry.rid = rid;
 
-                    nodeHeader = (IX_NodeHeader*) pageData;
-                    numberKeys = nodeHeader->numberKeys;
-                    keyData = pageData + sizeof(IX_NodeHeader);
-                    valueData = keyData + attrLength*degree;
-                    valueArray = (IX_NodeValue*) valueData;
+                // Unpin the page and return OK
+                if ((rc = pfFH.UnpinPage(pageNumber))) {
+                    return rc;
                 }
+                return OK_RC;
             }
         }
 
-        // Get the RID and assign to rid
-        rid = valueArray[keyPosition].rid;
-    }
-
-    // Update the last scanned entry
-    if (lastScannedEntry.keyValue == NULL) {
-        lastScannedEntry.keyValue = new char[attrLength];
+        // Go to the overflow page
+        PageNum nextPage = bucketHeader->overflowPage;
+        if ((rc = pfFH.UnpinPage(pageNumber))) {
+            return rc;
+        }
+        pageNumber = nextPage;
+        keyPosition = 0;
     }
-    memcpy(lastScannedEntry.keyValue, value, attrLength);
-    lastScannedEntry.rid = rid;
 
-    // Return OK
-    return OK_RC;
+    freeLastScannedEntry();
+    return IX_EOF;
 }
 
 // Method: CloseScan()
@@ -376,6 +466,9 @@ RC IX_IndexScan::CloseScan() {
         return IX_SCAN_CLOSED;
     }
 
+    // Free the last scanned entry
+    freeLastScannedEntry();
+
     // Set scan open flag to FALSE
     scanOpen = FALSE;
 
@@ -428,51 +521,17 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
 
     // If leaf node
     if (nodeType == LEAF || nodeType == ROOT_LEAF) {
-        bool found = false;
-        if (attrType == INT) {
-            int* keyArray = (int*) keyData;
-            int intValue = *static_cast<int*>(value);
-            for (int i=0; i<numberKeys; i++) {
-                if (satisfiesCondition(keyArray[i], intValue)) {
-                    pageNumber = node;
-                    keyPosition = i;
-                    found = true;
-                    break;
-                }
-            }
-        }
-        else if (attrType == FLOAT) {
-            float* keyArray = (float*) keyData;
-            float floatValue = *static_cast<float*>(value);
-            for (int i=0; i<numberKeys; i++) {
-                if (satisfiesCondition(keyArray[i], floatValue)) {
-                    pageNumber = node;
-                    keyPosition = i;
-                    found = true;
-                    break;
-                }
-            }
-        }
-        else {
-            char* keyArray = (char*) keyData;
-            char* charValue = static_cast<char*>(value);
-            string stringValue(charValue);
-            for (int i=0; i<numberKeys; i++) {
-                string currentKey(keyArray + i*attrLength);
-                if (satisfiesCondition(currentKey, stringValue)) {
-                    pageNumber = node;
-                    keyPosition = i;
-                    found = true;
-                    break;
-                }
+        // Get the first key satisfying the lower bound
+        // If there is none, start from the next leaf
+        pageNumber = node;
+        keyPosition = numberKeys;
+        for (int i=0; i<numberKeys; i++) {
+            if (satisfiesBound(keyData + i*attrLength, lowerOp, lowerValue)) {
+                keyPosition = i;
+                break;
             }
         }
 
-        if (!found) {
-            pageNumber = IX_NO_PAGE;
-            keyPosition = -1;
-        }
-
         // Unpin the node page
         if ((rc = pfFH.UnpinPage(node))) {
             return rc;
@@ -482,13 +541,13 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
     // Else if it is an internal node find the next page
     else if (nodeType == NODE || nodeType == ROOT) {
         PageNum nextPage = IX_NO_PAGE;
-        if (compOp == LT_OP || compOp == LE_OP) {
+        if (lowerOp == NO_OP) {
             nextPage = valueArray[0].page;
         }
         else {
             if (attrType == INT) {
                 int* keyArray = (int*) keyData;
-                int intValue = *static_cast<int*>(value);
+                int intValue = *static_cast<int*>(lowerValue);
                 if (intValue < keyArray[0]) {
                     nextPage = valueArray[0].page;
                 }
@@ -496,7 +555,7 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
                     nextPage = valueArray[numberKeys].page;
                 }
                 else {
-                    bool found;
+                    bool found = false;
                     for (int i=1; i<numberKeys; i++) {
                         if (satisfiesInterval(keyArray[i-1], keyArray[i], intValue)) {
                             nextPage = valueArray[i].page;
@@ -509,7 +568,7 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
             }
             else if (attrType == FLOAT) {
                 float* keyArray = (float*) keyData;
-                float floatValue = *static_cast<float*>(value);
+                float floatValue = *static_cast<float*>(lowerValue);
                 if (floatValue < keyArray[0]) {
                     nextPage = valueArray[0].page;
                 }
@@ -517,7 +576,7 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
                     nextPage = valueArray[numberKeys].page;
                 }
                 else {
-                    bool found;
+                    bool found = false;
                     for (int i=1; i<numberKeys; i++) {
                         if (satisfiesInterval(keyArray[i-1], keyArray[i], floatValue)) {
                             nextPage = valueArray[i].page;
@@ -530,7 +589,7 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
             }
             else {
                 char* keyArray = (char*) keyData;
-                char* charValue = static_cast<char*>(value);
+                char* charValue = static_cast<char*>(lowerValue);
                 string stringValue(charValue);
                 string firstKey(keyArray);
                 string lastKey(keyArray + (numberKeys-1)*attrLength);
@@ -541,7 +600,7 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
                     nextPage = valueArray[numberKeys].page;
                 }
                 else {
-                    bool found;
+                    bool found = false;
                     for (int i=1; i<numberKeys; i++) {
                         string currentKey(keyArray + i*attrLength);
                         string previousKey(keyArray + (i-1)*attrLength);
@@ -571,12 +630,36 @@ RC IX_IndexScan::SearchEntry(PageNum node, PageNum &pageNumber, int &keyPosition
     return OK_RC;
 }
 
-// Method: satisfiesCondition(T key, T value)
+// Method: satisfiesBound(char* key, CompOp op, void* value)
+// Boolean whether the key stored at the given location satisfies the bound
+bool IX_IndexScan::satisfiesBound(char* key, CompOp op, void* value) {
+    if (op == NO_OP) {
+        return true;
+    }
+
+    if (attrType == INT) {
+        int intKey;
+        memcpy(&intKey, key, sizeof(int));
+        return satisfiesCondition(intKey, *static_cast<int*>(value), op);
+    }
+    else if (attrType == FLOAT) {
+        float floatKey;
+        memcpy(&floatKey, key, sizeof(float));
+        return satisfiesCondition(floatKey, *static_cast<float*>(value), op);
+    }
+    else {
+        string stringKey(key, strnlen(key, attrLength));
+        string stringValue(static_cast<char*>(value));
+        return satisfiesCondition(stringKey, stringValue, op);
+    }
+}
+
+// Method: satisfiesCondition(T key, T value, CompOp op)
 // Boolean whether the key satisfies the required condition
 template<typename T>
-bool IX_IndexScan::satisfiesCondition(T key, T value) {
+bool IX_IndexScan::satisfiesCondition(T key, T value, CompOp op) {
     bool match = false;
-    switch(compOp) {
+    switch(op) {
         case EQ_OP:
             if (key == value) match = true;
             break;
@@ -592,6 +675,9 @@ bool IX_IndexScan::satisfiesCondition(T key, T value) {
         case GE_OP:
             if (key >= value) match = true;
             break;
+        case NO_OP:
+            match = true;
+            break;
         default:
             break;
     }
@@ -621,7 +707,7 @@ bool IX_IndexScan::compareRIDs(const RID &rid1, const RID &rid2) {
 
 bool IX_IndexScan::compareEntries(const IX_Entry &e1, const IX_Entry &e2) {
     bool keyMatch = false;
-    if (e1.keyValue == NULL || e1.keyValue == NULL) {
+    if (e1.keyValue == NULL || e2.keyValue == NULL) {
         return false;
     }
 
@@ -643,4 +729,13 @@ bool IX_IndexScan::compareEntries(const IX_Entry &e1, const IX_Entry &e2) {
         if (key1 == key2) keyMatch = true;
     }
     return keyMatch && compareRIDs(e1.rid, e2.rid);
-}
\ No newline at end of file
+}
+
+// Method: freeLastScannedEntry()
+// Free the key stored for the last scanned entry
+void IX_IndexScan::freeLastScannedEntry() {
+    char* temp = static_cast<char*> (lastScannedEntry.keyValue);
+    delete[] temp;
+    lastScannedEntry.keyValue = NULL;
+    lastScannedEntry.rid = dummyRID;
+}
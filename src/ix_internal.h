@@ -83,4 +83,18 @@ struct IX_BucketPageHeader {
     // PageNum nextBucket;
 };
 
+// IX_HashBucketHeader: Struct for the hash index bucket page header
+/* Stores the following:
+    1) numberEntries - Number of (key, RID) entries in the page - integer
+    2) entryCapacity - Maximum number of entries in the page - integer
+    3) localDepth - Number of hash bits shared by the bucket - integer
+    4) overflowPage - Page number of the next overflow page - PageNum
+*/
+struct IX_HashBucketHeader {
+    int numberEntries;
+    int entryCapacity;
+    int localDepth;
+    PageNum overflowPage;
+};
+
 #endif
\ No newline at end of file
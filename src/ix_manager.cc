@@ -24,22 +24,25 @@ IX_Manager::~IX_Manager() {
     // Nothing to free
 }
 
-// Method: CreateIndex(const char *fileName, int indexNo, AttrType attrType, int attrLength)
+// Method: CreateIndex(const char *fileName, int indexNo, AttrType attrType, int attrLength,
+//                     IX_IndexType indexType)
 // Create a new Index for the given file name
 /* Steps:
     1) Check whether the index number is valid (non negative)
     2) Generate index filename = fileName.indexNo
-    3) Check the attribute type and length consistency
+    3) Check the attribute type, length and index type consistency
     4) Create index file using the PF Manager
     5) Allocate a header page by opening the file
     6) Get the header page number and mark page as dirty
     7) Create a index header object
+        - A hash index starts with an empty directory of global depth 0
     8) Copy the index header to the index header page
     9) Unpin page and flush to disk
     10) Close the opened file
 */
 RC IX_Manager::CreateIndex(const char *fileName, int indexNo,
-                           AttrType attrType, int attrLength) {
+                           AttrType attrType, int attrLength,
+                           IX_IndexType indexType) {
     // Validate the index
     if (indexNo < 0) {
         return IX_NEGATIVE_INDEX;
@@ -70,6 +73,10 @@ RC IX_Manager::CreateIndex(const char *fileName, int indexNo,
         return IX_INCONSISTENT_ATTRIBUTE;
     }
 
+    // Check the index type
+    if (indexType != IX_BTREE && indexType != IX_HASH) {
+        return IX_INVALID_INDEX_TYPE;
+    }
 
     // Create index file using the PF Manager
     if ((rc = pfManager->CreateFile(indexFileName))) {
@@ -117,6 +124,11 @@ RC IX_Manager::CreateIndex(const char *fileName, int indexNo,
     indexHeader->attrLength = attrLength;
     indexHeader->rootPage = IX_NO_PAGE;
     indexHeader->degree = findDegreeOfNode(attrLength);
+    indexHeader->indexType = indexType;
+    indexHeader->globalDepth = 0;
+    for (int i=0; i<IX_HASH_DIRECTORY_SIZE; i++) {
+        indexHeader->directory[i] = IX_NO_PAGE;
+    }
 
     // Copy the index header in the header page
     char* fileData = (char*) indexHeader;
@@ -225,6 +237,8 @@ RC IX_Manager::OpenIndex(const char *fileName, int indexNo, IX_IndexHandle &inde
     // Initialize the last deleted entry
     indexHandle.lastDeletedEntry.keyValue = NULL;
     indexHandle.lastDeletedEntry.rid = dummyRID;
+    indexHandle.lastDisposedPage = IX_NO_PAGE;
+    indexHandle.lastDisposedNext = IX_NO_PAGE;
 
     // Store the index header in memory
     // Create PF page handle for the header page
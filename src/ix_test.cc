@@ -59,6 +59,7 @@ RC Test2(void);
 RC Test3(void);
 RC Test4(void);
 RC Test5(void);
+RC Test6(void);
 
 void PrintError(RC rc);
 void LsFiles(char *fileName);
@@ -76,14 +77,15 @@ RC PrintIndex(IX_IndexHandle &ih);
 //
 // Array of pointers to the test functions
 //
-#define NUM_TESTS       5               // number of tests
+#define NUM_TESTS       6               // number of tests
 int (*tests[])() =                      // RC doesn't work on some compilers
 {
    Test1,
    Test2,
    Test3,
    Test4,
-   Test5
+   Test5,
+   Test6
 };
 
 //
@@ -874,4 +876,94 @@ end:
          (rc = ixm.DestroyIndex(FILENAME, OK5))) {
       PrintError(rc);
    }
-}
\ No newline at end of file
+}
+
+//
+// Test 6 tests range scans bounded on both sides
+//
+RC Test6(void)
+{
+   RC             rc;
+   IX_IndexHandle ih;
+   int            index=0;
+   int            i;
+   int            lower = FEW_ENTRIES/4;
+   int            upper = FEW_ENTRIES/2;
+   int            value;
+   RID            rid;
+
+   printf("Test6: Range scans... \n");
+
+   if ((rc = ixm.CreateIndex(FILENAME, index, INT, sizeof(int))) ||
+         (rc = ixm.OpenIndex(FILENAME, index, ih)) ||
+         (rc = InsertIntEntries(ih, FEW_ENTRIES)))
+      return (rc);
+
+   // Scan >= lower and < upper
+   IX_IndexScan scan;
+   if ((rc = scan.OpenScan(ih, GE_OP, &lower, LT_OP, &upper))) {
+     printf("Scan error: opening scan\n");
+     return (rc);
+   }
+
+   i = 0;
+   while (!(rc = scan.GetNextEntry(rid))) {
+      i++;
+   }
+   if (rc != IX_EOF || (rc = scan.CloseScan()))
+      return (rc);
+
+   printf("Found %d entries in [%d, %d)-scan.\n", i, lower, upper);
+   if (i != upper - lower) {
+      printf("Range scan error: expected %d entries\n", upper - lower);
+      return (IX_EOF);
+   }
+
+   // Scan > lower and <= upper, deleting every entry found
+   if ((rc = scan.OpenScan(ih, GT_OP, &lower, LE_OP, &upper))) {
+     printf("Scan error: opening scan\n");
+     return (rc);
+   }
+
+   i = 0;
+   while (!(rc = scan.GetNextEntry(rid))) {
+      PageNum pageNum;
+      if ((rc = rid.GetPageNum(pageNum)))
+         return (rc);
+      value = pageNum;
+      if ((rc = ih.DeleteEntry(&value, rid)))
+         return (rc);
+      i++;
+   }
+   if (rc != IX_EOF || (rc = scan.CloseScan()))
+      return (rc);
+
+   printf("Deleted %d entries in (%d, %d]-scan.\n", i, lower, upper);
+   if (i != upper - lower) {
+      printf("Range scan error: expected %d entries\n", upper - lower);
+      return (IX_EOF);
+   }
+
+   // Only the lower bound itself must remain in [lower, upper]
+   if ((rc = scan.OpenScan(ih, GE_OP, &lower, LE_OP, &upper)))
+      return (rc);
+   i = 0;
+   while (!(rc = scan.GetNextEntry(rid))) {
+      i++;
+   }
+   if (rc != IX_EOF || (rc = scan.CloseScan()))
+      return (rc);
+   if (i != 1) {
+      printf("Range scan error: found %d entries after deletion\n", i);
+      return (IX_EOF);
+   }
+
+   if ((rc = ixm.CloseIndex(ih)))
+      return (rc);
+
+   if ((rc = ixm.DestroyIndex(FILENAME, index)))
+      return (rc);
+
+   printf("Passed Test 6\n\n");
+   return (0);
+}
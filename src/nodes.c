@@ -96,12 +96,13 @@ NODE *create_table_node(char *relname, NODE *attrlist, NODE *distribute_data)
  * create_index_node: allocates, initializes, and returns a pointer to a new
  * create index node having the indicated values.
  */
-NODE *create_index_node(char *relname, char *attrname)
+NODE *create_index_node(char *relname, char *attrname, int indextype)
 {
     NODE *n = newnode(N_CREATEINDEX);
 
     n -> u.CREATEINDEX.relname = relname;
     n -> u.CREATEINDEX.attrname = attrname;
+    n -> u.CREATEINDEX.indextype = indextype;
     return n;
 }
 
@@ -143,6 +144,19 @@ NODE *load_node(char *relname, char *filename)
     return n;
 }
 
+/*
+ * analyze_node: allocates, initializes, and returns a pointer to a new
+ * analyze node having the indicated values.
+ */
+NODE *analyze_node(char *relname, int samplepercent)
+{
+    NODE *n = newnode(N_ANALYZE);
+
+    n -> u.ANALYZE.relname = relname;
+    n -> u.ANALYZE.samplepercent = samplepercent;
+    return n;
+}
+
 /*
  * set_node: allocates, initializes, and returns a pointer to a new
  * set node having the indicated values.
@@ -184,16 +198,31 @@ NODE *print_node(char *relname)
  * query_node: allocates, initializes, and returns a pointer to a new
  * query node having the indicated values.
  */
-NODE *query_node(NODE *relattrlist, NODE *rellist, NODE *conditionlist)
+NODE *query_node(NODE *relattrlist, NODE *rellist, NODE *conditionlist,
+                 NODE *grouplist, NODE *orderlist, int limit)
 {
     NODE *n = newnode(N_QUERY);
 
     n->u.QUERY.relattrlist = relattrlist;
     n->u.QUERY.rellist = rellist;
     n->u.QUERY.conditionlist = conditionlist;
+    n->u.QUERY.grouplist = grouplist;
+    n->u.QUERY.orderlist = orderlist;
+    n->u.QUERY.limit = limit;
+    n->u.QUERY.explain = FALSE;
     return n;
 }
 
+/*
+ * explain_node: marks a query node to be run by EXPLAIN ANALYZE and returns
+ * a pointer to it.
+ */
+NODE *explain_node(NODE *query)
+{
+    query->u.QUERY.explain = TRUE;
+    return query;
+}
+
 /*
  * insert_node: allocates, initializes, and returns a pointer to a new
  * insert node having the indicated values.
@@ -250,6 +279,32 @@ NODE *relattr_node(char *relname, char *attrname)
     return n;
 }
 
+/*
+ * agg_relattr_node: allocates, initializes, and returns a pointer to a new
+ * aggregate relattr node having the indicated values.
+ */
+NODE *agg_relattr_node(char *function, NODE *relattr)
+{
+    NODE *n = newnode(N_AGGRELATTR);
+
+    n -> u.AGGRELATTR.function = function;
+    n -> u.AGGRELATTR.relattr = relattr;
+    return n;
+}
+
+/*
+ * order_attr_node: allocates, initializes, and returns a pointer to a new
+ * order by attribute node having the indicated values.
+ */
+NODE *order_attr_node(NODE *relattr, int descending)
+{
+    NODE *n = newnode(N_ORDERATTR);
+
+    n -> u.ORDERATTR.relattr = relattr;
+    n -> u.ORDERATTR.descending = descending;
+    return n;
+}
+
 /*
  * condition_node: allocates, initializes, and returns a pointer to a new
  * condition node having the indicated values.
@@ -357,14 +412,15 @@ NODE *prepend(NODE *n, NODE *list)
 
 // EX - distribute_node
 /*
- * creates a distribute table node with attribute name, attribute type
- * and list of values for the partition vector
+ * creates a distribute table node with the partitioning scheme, attribute name
+ * and list of values for the partition vector (only for range partitioning)
  */
-NODE *distribute_node(char* attrName, NODE* value_list)
+NODE *distribute_node(char* attrName, NODE* value_list, int partitioning)
 {
     NODE *n = newnode(N_DISTRIBUTE);
 
     n->u.DISTRIBUTE.attrName = attrName;
     n->u.DISTRIBUTE.value_list = value_list;
+    n->u.DISTRIBUTE.partitioning = partitioning;
     return n;
 }
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 1 "parse.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 1 "parse.y"
 
 /*
  * parser.y: yacc specification for RQL
@@ -128,31 +133,38 @@ int bExit;                 // when to return from RBparse
 
 int bQueryPlans;           // When to print the query plans
 
+int bExplainAnalyze;       // While a query run by EXPLAIN ANALYZE executes
+
 PF_Manager *pPfm;          // PF component manager
 SM_Manager *pSmm;          // SM component manager
 QL_Manager *pQlm;          // QL component manager
 
 
-#line 137 "y.tab.c" /* yacc.c:339  */
+#line 144 "y.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
 #ifndef YY_YY_Y_TAB_H_INCLUDED
 # define YY_YY_Y_TAB_H_INCLUDED
 /* Debug traces.  */
@@ -163,53 +175,74 @@ QL_Manager *pQlm;          // QL component manager
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    RW_CREATE = 258,
-    RW_DROP = 259,
-    RW_TABLE = 260,
-    RW_INDEX = 261,
-    RW_LOAD = 262,
-    RW_SET = 263,
-    RW_HELP = 264,
-    RW_PRINT = 265,
-    RW_EXIT = 266,
-    RW_SELECT = 267,
-    RW_FROM = 268,
-    RW_WHERE = 269,
-    RW_INSERT = 270,
-    RW_DELETE = 271,
-    RW_UPDATE = 272,
-    RW_AND = 273,
-    RW_INTO = 274,
-    RW_VALUES = 275,
-    T_EQ = 276,
-    T_LT = 277,
-    T_LE = 278,
-    T_GT = 279,
-    T_GE = 280,
-    T_NE = 281,
-    T_EOF = 282,
-    NOTOKEN = 283,
-    RW_RESET = 284,
-    RW_IO = 285,
-    RW_BUFFER = 286,
-    RW_RESIZE = 287,
-    RW_QUERY_PLAN = 288,
-    RW_ON = 289,
-    RW_OFF = 290,
-    RW_DISTRIBUTED = 291,
-    T_INT = 292,
-    T_REAL = 293,
-    T_STRING = 294,
-    T_QSTRING = 295,
-    T_SHELL_CMD = 296
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    RW_CREATE = 258,               /* RW_CREATE  */
+    RW_DROP = 259,                 /* RW_DROP  */
+    RW_TABLE = 260,                /* RW_TABLE  */
+    RW_INDEX = 261,                /* RW_INDEX  */
+    RW_LOAD = 262,                 /* RW_LOAD  */
+    RW_SET = 263,                  /* RW_SET  */
+    RW_HELP = 264,                 /* RW_HELP  */
+    RW_PRINT = 265,                /* RW_PRINT  */
+    RW_EXIT = 266,                 /* RW_EXIT  */
+    RW_SELECT = 267,               /* RW_SELECT  */
+    RW_FROM = 268,                 /* RW_FROM  */
+    RW_WHERE = 269,                /* RW_WHERE  */
+    RW_INSERT = 270,               /* RW_INSERT  */
+    RW_DELETE = 271,               /* RW_DELETE  */
+    RW_UPDATE = 272,               /* RW_UPDATE  */
+    RW_AND = 273,                  /* RW_AND  */
+    RW_INTO = 274,                 /* RW_INTO  */
+    RW_VALUES = 275,               /* RW_VALUES  */
+    T_EQ = 276,                    /* T_EQ  */
+    T_LT = 277,                    /* T_LT  */
+    T_LE = 278,                    /* T_LE  */
+    T_GT = 279,                    /* T_GT  */
+    T_GE = 280,                    /* T_GE  */
+    T_NE = 281,                    /* T_NE  */
+    T_EOF = 282,                   /* T_EOF  */
+    NOTOKEN = 283,                 /* NOTOKEN  */
+    RW_RESET = 284,                /* RW_RESET  */
+    RW_IO = 285,                   /* RW_IO  */
+    RW_BUFFER = 286,               /* RW_BUFFER  */
+    RW_RESIZE = 287,               /* RW_RESIZE  */
+    RW_QUERY_PLAN = 288,           /* RW_QUERY_PLAN  */
+    RW_ON = 289,                   /* RW_ON  */
+    RW_OFF = 290,                  /* RW_OFF  */
+    RW_DISTRIBUTED = 291,          /* RW_DISTRIBUTED  */
+    RW_USING = 292,                /* RW_USING  */
+    RW_HASH = 293,                 /* RW_HASH  */
+    RW_REPLICATED = 294,           /* RW_REPLICATED  */
+    RW_ORDER = 295,                /* RW_ORDER  */
+    RW_BY = 296,                   /* RW_BY  */
+    RW_LIMIT = 297,                /* RW_LIMIT  */
+    RW_ASC = 298,                  /* RW_ASC  */
+    RW_DESC = 299,                 /* RW_DESC  */
+    RW_GROUP = 300,                /* RW_GROUP  */
+    RW_ANALYZE = 301,              /* RW_ANALYZE  */
+    RW_SAMPLE = 302,               /* RW_SAMPLE  */
+    RW_EXPLAIN = 303,              /* RW_EXPLAIN  */
+    T_INT = 304,                   /* T_INT  */
+    T_REAL = 305,                  /* T_REAL  */
+    T_STRING = 306,                /* T_STRING  */
+    T_QSTRING = 307,               /* T_QSTRING  */
+    T_SHELL_CMD = 308              /* T_SHELL_CMD  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define RW_CREATE 258
 #define RW_DROP 259
 #define RW_TABLE 260
@@ -244,18 +277,29 @@ extern int yydebug;
 #define RW_ON 289
 #define RW_OFF 290
 #define RW_DISTRIBUTED 291
-#define T_INT 292
-#define T_REAL 293
-#define T_STRING 294
-#define T_QSTRING 295
-#define T_SHELL_CMD 296
+#define RW_USING 292
+#define RW_HASH 293
+#define RW_REPLICATED 294
+#define RW_ORDER 295
+#define RW_BY 296
+#define RW_LIMIT 297
+#define RW_ASC 298
+#define RW_DESC 299
+#define RW_GROUP 300
+#define RW_ANALYZE 301
+#define RW_SAMPLE 302
+#define RW_EXPLAIN 303
+#define T_INT 304
+#define T_REAL 305
+#define T_STRING 306
+#define T_QSTRING 307
+#define T_SHELL_CMD 308
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 72 "parse.y" /* yacc.c:355  */
+#line 74 "parse.y"
 
     int ival;
     CompOp cval;
@@ -263,8 +307,10 @@ union YYSTYPE
     char *sval;
     NODE *n;
 
-#line 267 "y.tab.c" /* yacc.c:355  */
+#line 311 "y.tab.c"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -272,40 +318,217 @@ union YYSTYPE
 
 extern YYSTYPE yylval;
 
+
 int yyparse (void);
 
+
 #endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_RW_CREATE = 3,                  /* RW_CREATE  */
+  YYSYMBOL_RW_DROP = 4,                    /* RW_DROP  */
+  YYSYMBOL_RW_TABLE = 5,                   /* RW_TABLE  */
+  YYSYMBOL_RW_INDEX = 6,                   /* RW_INDEX  */
+  YYSYMBOL_RW_LOAD = 7,                    /* RW_LOAD  */
+  YYSYMBOL_RW_SET = 8,                     /* RW_SET  */
+  YYSYMBOL_RW_HELP = 9,                    /* RW_HELP  */
+  YYSYMBOL_RW_PRINT = 10,                  /* RW_PRINT  */
+  YYSYMBOL_RW_EXIT = 11,                   /* RW_EXIT  */
+  YYSYMBOL_RW_SELECT = 12,                 /* RW_SELECT  */
+  YYSYMBOL_RW_FROM = 13,                   /* RW_FROM  */
+  YYSYMBOL_RW_WHERE = 14,                  /* RW_WHERE  */
+  YYSYMBOL_RW_INSERT = 15,                 /* RW_INSERT  */
+  YYSYMBOL_RW_DELETE = 16,                 /* RW_DELETE  */
+  YYSYMBOL_RW_UPDATE = 17,                 /* RW_UPDATE  */
+  YYSYMBOL_RW_AND = 18,                    /* RW_AND  */
+  YYSYMBOL_RW_INTO = 19,                   /* RW_INTO  */
+  YYSYMBOL_RW_VALUES = 20,                 /* RW_VALUES  */
+  YYSYMBOL_T_EQ = 21,                      /* T_EQ  */
+  YYSYMBOL_T_LT = 22,                      /* T_LT  */
+  YYSYMBOL_T_LE = 23,                      /* T_LE  */
+  YYSYMBOL_T_GT = 24,                      /* T_GT  */
+  YYSYMBOL_T_GE = 25,                      /* T_GE  */
+  YYSYMBOL_T_NE = 26,                      /* T_NE  */
+  YYSYMBOL_T_EOF = 27,                     /* T_EOF  */
+  YYSYMBOL_NOTOKEN = 28,                   /* NOTOKEN  */
+  YYSYMBOL_RW_RESET = 29,                  /* RW_RESET  */
+  YYSYMBOL_RW_IO = 30,                     /* RW_IO  */
+  YYSYMBOL_RW_BUFFER = 31,                 /* RW_BUFFER  */
+  YYSYMBOL_RW_RESIZE = 32,                 /* RW_RESIZE  */
+  YYSYMBOL_RW_QUERY_PLAN = 33,             /* RW_QUERY_PLAN  */
+  YYSYMBOL_RW_ON = 34,                     /* RW_ON  */
+  YYSYMBOL_RW_OFF = 35,                    /* RW_OFF  */
+  YYSYMBOL_RW_DISTRIBUTED = 36,            /* RW_DISTRIBUTED  */
+  YYSYMBOL_RW_USING = 37,                  /* RW_USING  */
+  YYSYMBOL_RW_HASH = 38,                   /* RW_HASH  */
+  YYSYMBOL_RW_REPLICATED = 39,             /* RW_REPLICATED  */
+  YYSYMBOL_RW_ORDER = 40,                  /* RW_ORDER  */
+  YYSYMBOL_RW_BY = 41,                     /* RW_BY  */
+  YYSYMBOL_RW_LIMIT = 42,                  /* RW_LIMIT  */
+  YYSYMBOL_RW_ASC = 43,                    /* RW_ASC  */
+  YYSYMBOL_RW_DESC = 44,                   /* RW_DESC  */
+  YYSYMBOL_RW_GROUP = 45,                  /* RW_GROUP  */
+  YYSYMBOL_RW_ANALYZE = 46,                /* RW_ANALYZE  */
+  YYSYMBOL_RW_SAMPLE = 47,                 /* RW_SAMPLE  */
+  YYSYMBOL_RW_EXPLAIN = 48,                /* RW_EXPLAIN  */
+  YYSYMBOL_T_INT = 49,                     /* T_INT  */
+  YYSYMBOL_T_REAL = 50,                    /* T_REAL  */
+  YYSYMBOL_T_STRING = 51,                  /* T_STRING  */
+  YYSYMBOL_T_QSTRING = 52,                 /* T_QSTRING  */
+  YYSYMBOL_T_SHELL_CMD = 53,               /* T_SHELL_CMD  */
+  YYSYMBOL_54_ = 54,                       /* ';'  */
+  YYSYMBOL_55_ = 55,                       /* '('  */
+  YYSYMBOL_56_ = 56,                       /* ')'  */
+  YYSYMBOL_57_ = 57,                       /* ','  */
+  YYSYMBOL_58_ = 58,                       /* '*'  */
+  YYSYMBOL_59_ = 59,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 60,                  /* $accept  */
+  YYSYMBOL_start = 61,                     /* start  */
+  YYSYMBOL_command = 62,                   /* command  */
+  YYSYMBOL_ddl = 63,                       /* ddl  */
+  YYSYMBOL_dml = 64,                       /* dml  */
+  YYSYMBOL_utility = 65,                   /* utility  */
+  YYSYMBOL_queryplans = 66,                /* queryplans  */
+  YYSYMBOL_buffer = 67,                    /* buffer  */
+  YYSYMBOL_statistics = 68,                /* statistics  */
+  YYSYMBOL_createtable = 69,               /* createtable  */
+  YYSYMBOL_createindex = 70,               /* createindex  */
+  YYSYMBOL_droptable = 71,                 /* droptable  */
+  YYSYMBOL_dropindex = 72,                 /* dropindex  */
+  YYSYMBOL_load = 73,                      /* load  */
+  YYSYMBOL_analyze = 74,                   /* analyze  */
+  YYSYMBOL_opt_sample_clause = 75,         /* opt_sample_clause  */
+  YYSYMBOL_set = 76,                       /* set  */
+  YYSYMBOL_help = 77,                      /* help  */
+  YYSYMBOL_print = 78,                     /* print  */
+  YYSYMBOL_exit = 79,                      /* exit  */
+  YYSYMBOL_query = 80,                     /* query  */
+  YYSYMBOL_explain = 81,                   /* explain  */
+  YYSYMBOL_insert = 82,                    /* insert  */
+  YYSYMBOL_delete = 83,                    /* delete  */
+  YYSYMBOL_update = 84,                    /* update  */
+  YYSYMBOL_non_mt_attrtype_list = 85,      /* non_mt_attrtype_list  */
+  YYSYMBOL_attrtype = 86,                  /* attrtype  */
+  YYSYMBOL_non_mt_select_clause = 87,      /* non_mt_select_clause  */
+  YYSYMBOL_non_mt_select_list = 88,        /* non_mt_select_list  */
+  YYSYMBOL_select_attr = 89,               /* select_attr  */
+  YYSYMBOL_non_mt_relattr_list = 90,       /* non_mt_relattr_list  */
+  YYSYMBOL_relattr = 91,                   /* relattr  */
+  YYSYMBOL_non_mt_relation_list = 92,      /* non_mt_relation_list  */
+  YYSYMBOL_relation = 93,                  /* relation  */
+  YYSYMBOL_opt_where_clause = 94,          /* opt_where_clause  */
+  YYSYMBOL_opt_group_by_clause = 95,       /* opt_group_by_clause  */
+  YYSYMBOL_opt_order_by_clause = 96,       /* opt_order_by_clause  */
+  YYSYMBOL_non_mt_order_list = 97,         /* non_mt_order_list  */
+  YYSYMBOL_order_attr = 98,                /* order_attr  */
+  YYSYMBOL_opt_order_direction = 99,       /* opt_order_direction  */
+  YYSYMBOL_opt_limit_clause = 100,         /* opt_limit_clause  */
+  YYSYMBOL_non_mt_cond_list = 101,         /* non_mt_cond_list  */
+  YYSYMBOL_condition = 102,                /* condition  */
+  YYSYMBOL_relattr_or_value = 103,         /* relattr_or_value  */
+  YYSYMBOL_non_mt_value_list = 104,        /* non_mt_value_list  */
+  YYSYMBOL_value = 105,                    /* value  */
+  YYSYMBOL_opt_relname = 106,              /* opt_relname  */
+  YYSYMBOL_op = 107,                       /* op  */
+  YYSYMBOL_opt_distributed = 108,          /* opt_distributed  */
+  YYSYMBOL_opt_index_type = 109,           /* opt_index_type  */
+  YYSYMBOL_nothing = 110                   /* nothing  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
-/* Copy the second part of user declarations.  */
 
-#line 282 "y.tab.c" /* yacc.c:358  */
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -313,15 +536,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -335,47 +571,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -388,8 +620,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -454,8 +700,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -464,17 +709,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -487,11 +732,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -503,12 +748,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -518,37 +763,40 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  65
+#define YYFINAL  72
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   117
+#define YYLAST   181
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  48
+#define YYNTOKENS  60
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  39
+#define YYNNTS  51
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  80
+#define YYNRULES  107
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  144
+#define YYNSTATES  197
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   308
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   296
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      43,    44,    46,     2,    45,     2,    47,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    42,
+      55,    56,    58,     2,    57,     2,    59,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    54,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -572,251 +820,296 @@ static const yytype_uint8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   165,   165,   170,   184,   190,   199,   200,   201,   202,
-     209,   210,   211,   212,   216,   217,   218,   219,   223,   224,
-     225,   226,   227,   228,   229,   230,   234,   240,   251,   259,
-     264,   272,   283,   296,   303,   310,   317,   324,   332,   339,
-     346,   353,   361,   368,   375,   382,   389,   393,   400,   407,
-     408,   415,   419,   426,   430,   437,   441,   448,   455,   459,
-     466,   470,   477,   484,   488,   495,   499,   506,   510,   514,
-     521,   525,   532,   536,   540,   544,   548,   552,   559,   563,
-     569
+       0,   192,   192,   197,   211,   217,   226,   227,   228,   229,
+     236,   237,   238,   239,   243,   244,   245,   246,   247,   251,
+     252,   253,   254,   255,   256,   257,   258,   259,   263,   269,
+     280,   288,   293,   301,   312,   325,   332,   339,   346,   353,
+     360,   367,   371,   378,   385,   392,   399,   407,   415,   422,
+     429,   436,   443,   447,   454,   461,   462,   468,   472,   479,
+     480,   484,   492,   496,   503,   507,   514,   518,   525,   532,
+     536,   543,   547,   554,   558,   565,   569,   576,   583,   587,
+     591,   598,   602,   609,   613,   620,   627,   631,   638,   642,
+     649,   653,   657,   664,   668,   675,   679,   683,   687,   691,
+     695,   702,   706,   710,   714,   721,   725,   732
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "RW_CREATE", "RW_DROP", "RW_TABLE",
-  "RW_INDEX", "RW_LOAD", "RW_SET", "RW_HELP", "RW_PRINT", "RW_EXIT",
-  "RW_SELECT", "RW_FROM", "RW_WHERE", "RW_INSERT", "RW_DELETE",
+  "\"end of file\"", "error", "\"invalid token\"", "RW_CREATE", "RW_DROP",
+  "RW_TABLE", "RW_INDEX", "RW_LOAD", "RW_SET", "RW_HELP", "RW_PRINT",
+  "RW_EXIT", "RW_SELECT", "RW_FROM", "RW_WHERE", "RW_INSERT", "RW_DELETE",
   "RW_UPDATE", "RW_AND", "RW_INTO", "RW_VALUES", "T_EQ", "T_LT", "T_LE",
   "T_GT", "T_GE", "T_NE", "T_EOF", "NOTOKEN", "RW_RESET", "RW_IO",
   "RW_BUFFER", "RW_RESIZE", "RW_QUERY_PLAN", "RW_ON", "RW_OFF",
-  "RW_DISTRIBUTED", "T_INT", "T_REAL", "T_STRING", "T_QSTRING",
+  "RW_DISTRIBUTED", "RW_USING", "RW_HASH", "RW_REPLICATED", "RW_ORDER",
+  "RW_BY", "RW_LIMIT", "RW_ASC", "RW_DESC", "RW_GROUP", "RW_ANALYZE",
+  "RW_SAMPLE", "RW_EXPLAIN", "T_INT", "T_REAL", "T_STRING", "T_QSTRING",
   "T_SHELL_CMD", "';'", "'('", "')'", "','", "'*'", "'.'", "$accept",
   "start", "command", "ddl", "dml", "utility", "queryplans", "buffer",
   "statistics", "createtable", "createindex", "droptable", "dropindex",
-  "load", "set", "help", "print", "exit", "query", "insert", "delete",
-  "update", "non_mt_attrtype_list", "attrtype", "non_mt_select_clause",
+  "load", "analyze", "opt_sample_clause", "set", "help", "print", "exit",
+  "query", "explain", "insert", "delete", "update", "non_mt_attrtype_list",
+  "attrtype", "non_mt_select_clause", "non_mt_select_list", "select_attr",
   "non_mt_relattr_list", "relattr", "non_mt_relation_list", "relation",
-  "opt_where_clause", "non_mt_cond_list", "condition", "relattr_or_value",
+  "opt_where_clause", "opt_group_by_clause", "opt_order_by_clause",
+  "non_mt_order_list", "order_attr", "opt_order_direction",
+  "opt_limit_clause", "non_mt_cond_list", "condition", "relattr_or_value",
   "non_mt_value_list", "value", "opt_relname", "op", "opt_distributed",
-  "nothing", YY_NULLPTR
+  "opt_index_type", "nothing", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,    59,    40,    41,    44,    42,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -133
+#define YYPACT_NINF (-144)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-133)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -81
+#define YYTABLE_NINF (-108)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-       9,  -133,    34,    53,   -34,   -32,   -28,    -2,  -133,   -31,
-       4,    14,    -4,  -133,    30,    15,    28,  -133,    64,    23,
-    -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,
-    -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,
-      27,    29,    32,    33,    24,    48,  -133,  -133,  -133,  -133,
-    -133,  -133,    26,  -133,    57,  -133,    35,    36,    37,    66,
-    -133,  -133,    40,  -133,  -133,  -133,  -133,    38,    39,  -133,
-      41,    43,    45,    47,    49,    50,    58,    65,    50,  -133,
-      51,    52,    54,    55,  -133,  -133,  -133,    65,    42,  -133,
-      59,    50,  -133,  -133,    71,    56,    60,    61,    63,    67,
-    -133,  -133,    49,     7,    31,  -133,    76,    -6,  -133,    62,
-      51,  -133,  -133,  -133,  -133,  -133,  -133,    68,    69,  -133,
-    -133,  -133,  -133,  -133,  -133,    -6,    50,  -133,    65,  -133,
-      74,  -133,  -133,  -133,  -133,     7,  -133,  -133,  -133,    72,
-    -133,     7,    73,  -133
+       1,  -144,    18,    33,   -30,    -3,     2,   -16,  -144,   -26,
+      47,    56,    24,  -144,    21,    45,    37,    26,    32,  -144,
+      80,    27,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,
+    -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,
+    -144,  -144,  -144,  -144,    31,    34,    36,    38,    28,    63,
+    -144,  -144,  -144,  -144,  -144,  -144,   -33,  -144,    73,  -144,
+      39,  -144,    40,    41,    82,  -144,  -144,    44,  -144,  -144,
+      48,    76,  -144,  -144,    42,    43,  -144,    49,    50,    51,
+     -14,    54,    55,    57,    79,    86,    58,  -144,    61,  -144,
+    -144,  -144,    60,    64,    65,    62,  -144,    53,    66,    67,
+    -144,  -144,    86,    68,  -144,    52,    58,  -144,  -144,    93,
+    -144,    69,    70,    71,    74,    75,  -144,  -144,  -144,    72,
+      55,    -7,    35,  -144,   103,    13,  -144,    88,    60,    96,
+    -144,    94,    97,  -144,  -144,  -144,  -144,  -144,    78,    81,
+    -144,  -144,  -144,  -144,  -144,  -144,    13,    58,  -144,    86,
+    -144,   -10,  -144,  -144,  -144,    98,  -144,  -144,    58,    99,
+     100,  -144,  -144,    -7,  -144,  -144,  -144,  -144,   101,    89,
+    -144,  -144,    84,    58,   102,  -144,  -144,  -144,    90,    -7,
+      58,    30,  -144,    91,  -144,    92,   105,  -144,  -144,  -144,
+    -144,  -144,    58,   106,  -144,  -144,  -144
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     4,     0,     0,     0,     0,    80,     0,    41,     0,
-       0,     0,     0,     5,     0,     0,     0,     3,     0,     0,
-       6,     7,     8,    25,    23,    24,    10,    11,    12,    13,
-      18,    20,    21,    22,    19,    14,    15,    16,    17,     9,
-       0,     0,     0,     0,     0,     0,    70,    39,    71,    31,
-      29,    40,    54,    50,     0,    49,    52,     0,     0,     0,
-      32,    28,     0,    26,    27,     1,     2,     0,     0,    35,
-       0,     0,     0,     0,     0,     0,     0,    80,     0,    30,
-       0,     0,     0,     0,    38,    53,    57,    80,    56,    51,
-       0,     0,    44,    59,     0,     0,     0,    47,     0,     0,
-      37,    42,     0,     0,     0,    58,    61,     0,    48,    80,
-       0,    34,    36,    55,    68,    69,    67,     0,    66,    76,
-      72,    73,    74,    75,    77,     0,     0,    63,    80,    64,
-       0,    33,    79,    46,    43,     0,    62,    60,    45,     0,
-      65,     0,     0,    78
+       0,     4,     0,     0,     0,     0,   107,     0,    46,     0,
+       0,     0,     0,     5,     0,     0,     0,     0,     0,     3,
+       0,     0,     6,     7,     8,    27,    25,    26,    10,    11,
+      12,    13,    19,    20,    22,    23,    24,    21,    14,    15,
+      16,    17,    18,     9,     0,     0,     0,     0,     0,     0,
+      93,    44,    94,    33,    31,    45,    65,    56,     0,    55,
+      58,    59,     0,     0,     0,    34,    30,     0,    28,    29,
+     107,     0,     1,     2,     0,     0,    37,     0,     0,     0,
+       0,     0,     0,     0,     0,   107,     0,    32,     0,    40,
+      42,    48,     0,     0,     0,     0,    43,    65,     0,     0,
+      64,    68,   107,    67,    57,     0,     0,    50,    70,     0,
+      41,     0,     0,    53,     0,     0,    39,    61,    60,   107,
+       0,     0,     0,    69,    84,     0,    54,   107,     0,   107,
+      38,     0,   107,    72,    66,    91,    92,    90,     0,    89,
+      99,    95,    96,    97,    98,   100,     0,     0,    86,   107,
+      87,     0,    35,   104,    52,     0,    36,   106,     0,     0,
+     107,    74,    49,     0,    85,    83,    51,   103,     0,     0,
+     105,    71,    63,     0,     0,    47,    82,    88,     0,     0,
+       0,   107,    73,    76,    81,     0,     0,    62,    78,    79,
+      77,    80,     0,     0,   101,    75,   102
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,
-    -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,  -133,
-    -133,  -133,   -14,  -133,  -133,    22,   -77,    -1,  -133,   -85,
-     -26,  -133,   -22,  -132,  -103,  -133,  -133,  -133,     0
+    -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,
+    -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,  -144,
+      83,  -144,  -144,  -144,  -144,    19,  -144,  -144,    85,  -144,
+     -34,   -79,    29,  -144,   -99,  -144,  -144,   -42,  -144,  -144,
+    -144,     5,  -144,     7,  -143,  -106,  -144,  -144,  -144,  -144,
+       0
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    18,    19,    20,    21,    22,    23,    24,    25,    26,
-      27,    28,    29,    30,    31,    32,    33,    34,    35,    36,
-      37,    38,    96,    97,    54,    55,    56,    87,    88,    92,
-     105,   106,   128,   117,   118,    47,   125,   131,    93
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    89,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,   112,   113,    58,    59,    60,
+     171,    61,   102,   103,   107,   132,   160,   182,   183,   190,
+     175,   123,   124,   149,   138,   139,    51,   146,   152,   156,
+     108
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      39,    94,   101,   140,   129,    44,    48,    45,    52,   142,
-       1,    46,     2,     3,   104,    53,     4,     5,     6,     7,
-       8,     9,   129,    57,    10,    11,    12,    58,    49,    50,
-     127,   114,   115,    52,   116,    59,    13,    51,    14,    40,
-      41,    15,    16,   138,   114,   115,    62,   116,   127,   104,
-      17,   -80,   119,   120,   121,   122,   123,   124,    42,    43,
-      60,    61,    63,    64,    65,    66,    67,    71,    68,    72,
-      74,    69,    70,    73,    78,    76,    77,    79,    90,    91,
-      75,    80,    81,    83,    82,    84,    85,   102,    86,    52,
-      95,    98,   107,    99,   126,   108,   133,    89,   130,   100,
-     137,   113,   103,   136,   109,     0,   110,   111,     0,   132,
-       0,   112,   134,   139,   135,   141,     0,   143
+      43,    99,     1,   119,     2,     3,    52,   109,     4,     5,
+       6,     7,     8,     9,    53,    54,    10,    11,    12,   150,
+     177,    48,    80,    44,    45,    56,    81,   122,    13,   167,
+      14,   168,    57,    15,    16,    55,   186,    97,    46,    47,
+     150,   169,   135,   136,    98,   137,   148,    17,    49,    18,
+     166,    65,    66,    50,    19,  -107,   140,   141,   142,   143,
+     144,   145,   135,   136,    97,   137,    62,   148,   122,    63,
+      90,    68,    69,   188,   189,    64,    67,    70,    71,   172,
+      72,    73,    74,    78,    79,    75,    82,    76,     9,    77,
+      86,    84,    85,    87,   181,    88,    83,    92,    93,   105,
+     106,   172,    95,    96,    94,   100,   101,   121,    56,    97,
+     110,   111,    81,   181,   125,   114,   115,   131,   116,   133,
+     126,   147,   117,   118,   151,   120,   127,   153,   128,   157,
+     129,   130,   161,   155,   162,   158,   170,   159,   163,   178,
+     173,   180,   174,   193,   179,   185,   187,   154,   192,   134,
+     195,   184,   165,   164,    91,     0,     0,     0,     0,     0,
+     176,   194,   196,     0,     0,     0,     0,     0,   104,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   191
 };
 
 static const yytype_int16 yycheck[] =
 {
-       0,    78,    87,   135,   107,    39,     6,    39,    39,   141,
-       1,    39,     3,     4,    91,    46,     7,     8,     9,    10,
-      11,    12,   125,    19,    15,    16,    17,    13,    30,    31,
-     107,    37,    38,    39,    40,    39,    27,    39,    29,     5,
-       6,    32,    33,   128,    37,    38,    31,    40,   125,   126,
-      41,    42,    21,    22,    23,    24,    25,    26,     5,     6,
-      30,    31,    34,    35,     0,    42,    39,    43,    39,    21,
-      13,    39,    39,    47,     8,    39,    39,    37,    20,    14,
-      45,    43,    43,    40,    43,    40,    39,    45,    39,    39,
-      39,    39,    21,    39,    18,    39,   110,    75,    36,    44,
-     126,   102,    43,   125,    44,    -1,    45,    44,    -1,   109,
-      -1,    44,    44,    39,    45,    43,    -1,    44
+       0,    80,     1,   102,     3,     4,     6,    86,     7,     8,
+       9,    10,    11,    12,    30,    31,    15,    16,    17,   125,
+     163,    51,    55,     5,     6,    51,    59,   106,    27,    39,
+      29,    41,    58,    32,    33,    51,   179,    51,     5,     6,
+     146,    51,    49,    50,    58,    52,   125,    46,    51,    48,
+     149,    30,    31,    51,    53,    54,    21,    22,    23,    24,
+      25,    26,    49,    50,    51,    52,    19,   146,   147,    13,
+      70,    34,    35,    43,    44,    51,    31,    51,    46,   158,
+       0,    54,    51,    55,    21,    51,    13,    51,    12,    51,
+       8,    51,    51,    49,   173,    47,    57,    55,    55,    20,
+      14,   180,    52,    52,    55,    51,    51,    55,    51,    51,
+      49,    51,    59,   192,    21,    51,    51,    45,    56,   119,
+      51,    18,    56,    56,    36,    57,    56,   127,    57,   129,
+      56,    56,   132,    37,    56,    41,    38,    40,    57,    38,
+      41,    57,    42,    51,    55,    55,   180,   128,    57,   120,
+     192,    49,   147,   146,    71,    -1,    -1,    -1,    -1,    -1,
+     160,    56,    56,    -1,    -1,    -1,    -1,    -1,    83,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   181
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     1,     3,     4,     7,     8,     9,    10,    11,    12,
-      15,    16,    17,    27,    29,    32,    33,    41,    49,    50,
-      51,    52,    53,    54,    55,    56,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,    66,    67,    68,    69,    86,
-       5,     6,     5,     6,    39,    39,    39,    83,    86,    30,
-      31,    39,    39,    46,    72,    73,    74,    19,    13,    39,
-      30,    31,    31,    34,    35,     0,    42,    39,    39,    39,
-      39,    43,    21,    47,    13,    45,    39,    39,     8,    37,
-      43,    43,    43,    40,    40,    39,    39,    75,    76,    73,
-      20,    14,    77,    86,    74,    39,    70,    71,    39,    39,
-      44,    77,    45,    43,    74,    78,    79,    21,    39,    44,
-      45,    44,    44,    75,    37,    38,    40,    81,    82,    21,
-      22,    23,    24,    25,    26,    84,    18,    74,    80,    82,
-      36,    85,    86,    70,    44,    45,    80,    78,    77,    39,
-      81,    43,    81,    44
+      15,    16,    17,    27,    29,    32,    33,    46,    48,    53,
+      61,    62,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    76,    77,    78,    79,    80,    81,
+      82,    83,    84,   110,     5,     6,     5,     6,    51,    51,
+      51,   106,   110,    30,    31,    51,    51,    58,    87,    88,
+      89,    91,    19,    13,    51,    30,    31,    31,    34,    35,
+      51,    46,     0,    54,    51,    51,    51,    51,    55,    21,
+      55,    59,    13,    57,    51,    51,     8,    49,    47,    75,
+     110,    80,    55,    55,    55,    52,    52,    51,    58,    91,
+      51,    51,    92,    93,    88,    20,    14,    94,   110,    91,
+      49,    51,    85,    86,    51,    51,    56,    56,    56,    94,
+      57,    55,    91,   101,   102,    21,    51,    56,    57,    56,
+      56,    45,    95,   110,    92,    49,    50,    52,   104,   105,
+      21,    22,    23,    24,    25,    26,   107,    18,    91,   103,
+     105,    36,   108,   110,    85,    37,   109,   110,    41,    40,
+      96,   110,    56,    57,   103,   101,    94,    39,    41,    51,
+      38,    90,    91,    41,    42,   100,   110,   104,    38,    55,
+      57,    91,    97,    98,    49,    55,   104,    90,    43,    44,
+      99,   110,    57,    51,    56,    97,    56
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    48,    49,    49,    49,    49,    50,    50,    50,    50,
-      51,    51,    51,    51,    52,    52,    52,    52,    53,    53,
-      53,    53,    53,    53,    53,    53,    54,    54,    55,    55,
-      55,    56,    56,    57,    58,    59,    60,    61,    62,    63,
-      64,    65,    66,    67,    68,    69,    70,    70,    71,    72,
-      72,    73,    73,    74,    74,    75,    75,    76,    77,    77,
-      78,    78,    79,    80,    80,    81,    81,    82,    82,    82,
-      83,    83,    84,    84,    84,    84,    84,    84,    85,    85,
-      86
+       0,    60,    61,    61,    61,    61,    62,    62,    62,    62,
+      63,    63,    63,    63,    64,    64,    64,    64,    64,    65,
+      65,    65,    65,    65,    65,    65,    65,    65,    66,    66,
+      67,    67,    67,    68,    68,    69,    70,    71,    72,    73,
+      74,    75,    75,    76,    77,    78,    79,    80,    81,    82,
+      83,    84,    85,    85,    86,    87,    87,    88,    88,    89,
+      89,    89,    90,    90,    91,    91,    92,    92,    93,    94,
+      94,    95,    95,    96,    96,    97,    97,    98,    99,    99,
+      99,   100,   100,   101,   101,   102,   103,   103,   104,   104,
+     105,   105,   105,   106,   106,   107,   107,   107,   107,   107,
+     107,   108,   108,   108,   108,   109,   109,   110
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     2,     2,     2,     2,
-       3,     2,     2,     7,     6,     3,     6,     5,     4,     2,
-       2,     1,     5,     7,     4,     7,     3,     1,     2,     1,
-       1,     3,     1,     3,     1,     3,     1,     1,     2,     1,
-       3,     1,     3,     1,     1,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     5,     1,
-       0
+       1,     1,     1,     1,     1,     1,     1,     1,     2,     2,
+       2,     2,     3,     2,     2,     7,     7,     3,     6,     5,
+       3,     2,     1,     4,     2,     2,     1,     8,     3,     7,
+       4,     7,     3,     1,     2,     1,     1,     3,     1,     1,
+       4,     4,     3,     1,     3,     1,     3,     1,     1,     2,
+       1,     3,     1,     3,     1,     3,     1,     2,     1,     1,
+       1,     2,     1,     3,     1,     3,     1,     1,     3,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     5,     6,     2,     1,     2,     1,     0
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -833,55 +1126,52 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -890,7 +1180,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -913,21 +1203,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -942,8 +1232,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -966,249 +1256,30 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1217,6 +1288,8 @@ YYSTYPE yylval;
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1224,43 +1297,36 @@ int yynerrs;
 int
 yyparse (void)
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1268,71 +1334,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1340,30 +1410,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1374,18 +1445,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1413,15 +1495,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1436,7 +1516,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1456,18 +1536,18 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 166 "parse.y" /* yacc.c:1646  */
-    {
+  case 2: /* start: command ';'  */
+#line 193 "parse.y"
+   {
       parse_tree = (yyvsp[-1].n);
       YYACCEPT;
    }
-#line 1466 "y.tab.c" /* yacc.c:1646  */
+#line 1546 "y.tab.c"
     break;
 
-  case 3:
-#line 171 "parse.y" /* yacc.c:1646  */
-    {
+  case 3: /* start: T_SHELL_CMD  */
+#line 198 "parse.y"
+   {
       if (!isatty(0)) {
         cout << ((yyvsp[0].sval)) << "\n";
         cout.flush();
@@ -1480,90 +1560,90 @@ yyreduce:
       parse_tree = NULL;
       YYACCEPT;
    }
-#line 1484 "y.tab.c" /* yacc.c:1646  */
+#line 1564 "y.tab.c"
     break;
 
-  case 4:
-#line 185 "parse.y" /* yacc.c:1646  */
-    {
+  case 4: /* start: error  */
+#line 212 "parse.y"
+   {
       reset_scanner();
       parse_tree = NULL;
       YYACCEPT;
    }
-#line 1494 "y.tab.c" /* yacc.c:1646  */
+#line 1574 "y.tab.c"
     break;
 
-  case 5:
-#line 191 "parse.y" /* yacc.c:1646  */
-    {
+  case 5: /* start: T_EOF  */
+#line 218 "parse.y"
+   {
       parse_tree = NULL;
       bExit = 1;
       YYACCEPT;
    }
-#line 1504 "y.tab.c" /* yacc.c:1646  */
+#line 1584 "y.tab.c"
     break;
 
-  case 9:
-#line 203 "parse.y" /* yacc.c:1646  */
-    {
+  case 9: /* command: nothing  */
+#line 230 "parse.y"
+   {
       (yyval.n) = NULL;
    }
-#line 1512 "y.tab.c" /* yacc.c:1646  */
+#line 1592 "y.tab.c"
     break;
 
-  case 26:
-#line 235 "parse.y" /* yacc.c:1646  */
-    {
+  case 28: /* queryplans: RW_QUERY_PLAN RW_ON  */
+#line 264 "parse.y"
+   {
       bQueryPlans = 1;
       cout << "Query plan display turned on.\n";
       (yyval.n) = NULL;
    }
-#line 1522 "y.tab.c" /* yacc.c:1646  */
+#line 1602 "y.tab.c"
     break;
 
-  case 27:
-#line 241 "parse.y" /* yacc.c:1646  */
-    {
+  case 29: /* queryplans: RW_QUERY_PLAN RW_OFF  */
+#line 270 "parse.y"
+   {
       bQueryPlans = 0;
       cout << "Query plan display turned off.\n";
       (yyval.n) = NULL;
    }
-#line 1532 "y.tab.c" /* yacc.c:1646  */
+#line 1612 "y.tab.c"
     break;
 
-  case 28:
-#line 252 "parse.y" /* yacc.c:1646  */
-    {
+  case 30: /* buffer: RW_RESET RW_BUFFER  */
+#line 281 "parse.y"
+   {
       if (pPfm->ClearBuffer())
          cout << "Trouble clearing buffer!  Things may be pinned.\n";
       else
          cout << "Everything kicked out of Buffer!\n";
       (yyval.n) = NULL;
    }
-#line 1544 "y.tab.c" /* yacc.c:1646  */
+#line 1624 "y.tab.c"
     break;
 
-  case 29:
-#line 260 "parse.y" /* yacc.c:1646  */
-    {
+  case 31: /* buffer: RW_PRINT RW_BUFFER  */
+#line 289 "parse.y"
+   {
       pPfm->PrintBuffer();
       (yyval.n) = NULL;
    }
-#line 1553 "y.tab.c" /* yacc.c:1646  */
+#line 1633 "y.tab.c"
     break;
 
-  case 30:
-#line 265 "parse.y" /* yacc.c:1646  */
-    {
+  case 32: /* buffer: RW_RESIZE RW_BUFFER T_INT  */
+#line 294 "parse.y"
+   {
       pPfm->ResizeBuffer((yyvsp[0].ival));
       (yyval.n) = NULL;
    }
-#line 1562 "y.tab.c" /* yacc.c:1646  */
+#line 1642 "y.tab.c"
     break;
 
-  case 31:
-#line 273 "parse.y" /* yacc.c:1646  */
-    {
+  case 33: /* statistics: RW_PRINT RW_IO  */
+#line 302 "parse.y"
+   {
       #ifdef PF_STATS
          cout << "Statistics\n";
          cout << "----------\n";
@@ -1573,12 +1653,12 @@ yyreduce:
       #endif
       (yyval.n) = NULL;
    }
-#line 1577 "y.tab.c" /* yacc.c:1646  */
+#line 1657 "y.tab.c"
     break;
 
-  case 32:
-#line 284 "parse.y" /* yacc.c:1646  */
-    {
+  case 34: /* statistics: RW_RESET RW_IO  */
+#line 313 "parse.y"
+   {
       #ifdef PF_STATS
          cout << "Statistics reset.\n";
          pStatisticsMgr->Reset();
@@ -1587,380 +1667,573 @@ yyreduce:
       #endif
       (yyval.n) = NULL;
    }
-#line 1591 "y.tab.c" /* yacc.c:1646  */
+#line 1671 "y.tab.c"
     break;
 
-  case 33:
-#line 297 "parse.y" /* yacc.c:1646  */
-    {
+  case 35: /* createtable: RW_CREATE RW_TABLE T_STRING '(' non_mt_attrtype_list ')' opt_distributed  */
+#line 326 "parse.y"
+   {
       (yyval.n) = create_table_node((yyvsp[-4].sval), (yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1599 "y.tab.c" /* yacc.c:1646  */
+#line 1679 "y.tab.c"
     break;
 
-  case 34:
-#line 304 "parse.y" /* yacc.c:1646  */
-    {
-      (yyval.n) = create_index_node((yyvsp[-3].sval), (yyvsp[-1].sval));
+  case 36: /* createindex: RW_CREATE RW_INDEX T_STRING '(' T_STRING ')' opt_index_type  */
+#line 333 "parse.y"
+   {
+      (yyval.n) = create_index_node((yyvsp[-4].sval), (yyvsp[-2].sval), (yyvsp[0].ival));
    }
-#line 1607 "y.tab.c" /* yacc.c:1646  */
+#line 1687 "y.tab.c"
     break;
 
-  case 35:
-#line 311 "parse.y" /* yacc.c:1646  */
-    {
+  case 37: /* droptable: RW_DROP RW_TABLE T_STRING  */
+#line 340 "parse.y"
+   {
       (yyval.n) = drop_table_node((yyvsp[0].sval));
    }
-#line 1615 "y.tab.c" /* yacc.c:1646  */
+#line 1695 "y.tab.c"
     break;
 
-  case 36:
-#line 318 "parse.y" /* yacc.c:1646  */
-    {
+  case 38: /* dropindex: RW_DROP RW_INDEX T_STRING '(' T_STRING ')'  */
+#line 347 "parse.y"
+   {
       (yyval.n) = drop_index_node((yyvsp[-3].sval), (yyvsp[-1].sval));
    }
-#line 1623 "y.tab.c" /* yacc.c:1646  */
+#line 1703 "y.tab.c"
     break;
 
-  case 37:
-#line 325 "parse.y" /* yacc.c:1646  */
-    {
+  case 39: /* load: RW_LOAD T_STRING '(' T_QSTRING ')'  */
+#line 354 "parse.y"
+   {
       (yyval.n) = load_node((yyvsp[-3].sval), (yyvsp[-1].sval));
    }
-#line 1631 "y.tab.c" /* yacc.c:1646  */
+#line 1711 "y.tab.c"
     break;
 
-  case 38:
-#line 333 "parse.y" /* yacc.c:1646  */
-    {
+  case 40: /* analyze: RW_ANALYZE T_STRING opt_sample_clause  */
+#line 361 "parse.y"
+   {
+      (yyval.n) = analyze_node((yyvsp[-1].sval), (yyvsp[0].ival));
+   }
+#line 1719 "y.tab.c"
+    break;
+
+  case 41: /* opt_sample_clause: RW_SAMPLE T_INT  */
+#line 368 "parse.y"
+   {
+      (yyval.ival) = (yyvsp[0].ival);
+   }
+#line 1727 "y.tab.c"
+    break;
+
+  case 42: /* opt_sample_clause: nothing  */
+#line 372 "parse.y"
+   {
+      (yyval.ival) = 100;
+   }
+#line 1735 "y.tab.c"
+    break;
+
+  case 43: /* set: RW_SET T_STRING T_EQ T_QSTRING  */
+#line 379 "parse.y"
+   {
       (yyval.n) = set_node((yyvsp[-2].sval), (yyvsp[0].sval));
    }
-#line 1639 "y.tab.c" /* yacc.c:1646  */
+#line 1743 "y.tab.c"
     break;
 
-  case 39:
-#line 340 "parse.y" /* yacc.c:1646  */
-    {
+  case 44: /* help: RW_HELP opt_relname  */
+#line 386 "parse.y"
+   {
       (yyval.n) = help_node((yyvsp[0].sval));
    }
-#line 1647 "y.tab.c" /* yacc.c:1646  */
+#line 1751 "y.tab.c"
     break;
 
-  case 40:
-#line 347 "parse.y" /* yacc.c:1646  */
-    {
+  case 45: /* print: RW_PRINT T_STRING  */
+#line 393 "parse.y"
+   {
       (yyval.n) = print_node((yyvsp[0].sval));
    }
-#line 1655 "y.tab.c" /* yacc.c:1646  */
+#line 1759 "y.tab.c"
     break;
 
-  case 41:
-#line 354 "parse.y" /* yacc.c:1646  */
-    {
+  case 46: /* exit: RW_EXIT  */
+#line 400 "parse.y"
+   {
       (yyval.n) = NULL;
       bExit = 1;
    }
-#line 1664 "y.tab.c" /* yacc.c:1646  */
+#line 1768 "y.tab.c"
     break;
 
-  case 42:
-#line 362 "parse.y" /* yacc.c:1646  */
-    {
-      (yyval.n) = query_node((yyvsp[-3].n), (yyvsp[-1].n), (yyvsp[0].n));
+  case 47: /* query: RW_SELECT non_mt_select_clause RW_FROM non_mt_relation_list opt_where_clause opt_group_by_clause opt_order_by_clause opt_limit_clause  */
+#line 409 "parse.y"
+   {
+      (yyval.n) = query_node((yyvsp[-6].n), (yyvsp[-4].n), (yyvsp[-3].n), (yyvsp[-2].n), (yyvsp[-1].n), (yyvsp[0].ival));
    }
-#line 1672 "y.tab.c" /* yacc.c:1646  */
+#line 1776 "y.tab.c"
     break;
 
-  case 43:
-#line 369 "parse.y" /* yacc.c:1646  */
-    {
+  case 48: /* explain: RW_EXPLAIN RW_ANALYZE query  */
+#line 416 "parse.y"
+   {
+      (yyval.n) = explain_node((yyvsp[0].n));
+   }
+#line 1784 "y.tab.c"
+    break;
+
+  case 49: /* insert: RW_INSERT RW_INTO T_STRING RW_VALUES '(' non_mt_value_list ')'  */
+#line 423 "parse.y"
+   {
       (yyval.n) = insert_node((yyvsp[-4].sval), (yyvsp[-1].n));
    }
-#line 1680 "y.tab.c" /* yacc.c:1646  */
+#line 1792 "y.tab.c"
     break;
 
-  case 44:
-#line 376 "parse.y" /* yacc.c:1646  */
-    {
+  case 50: /* delete: RW_DELETE RW_FROM T_STRING opt_where_clause  */
+#line 430 "parse.y"
+   {
       (yyval.n) = delete_node((yyvsp[-1].sval), (yyvsp[0].n));
    }
-#line 1688 "y.tab.c" /* yacc.c:1646  */
+#line 1800 "y.tab.c"
     break;
 
-  case 45:
-#line 383 "parse.y" /* yacc.c:1646  */
-    {
+  case 51: /* update: RW_UPDATE T_STRING RW_SET relattr T_EQ relattr_or_value opt_where_clause  */
+#line 437 "parse.y"
+   {
       (yyval.n) = update_node((yyvsp[-5].sval), (yyvsp[-3].n), (yyvsp[-1].n), (yyvsp[0].n));
    }
-#line 1696 "y.tab.c" /* yacc.c:1646  */
+#line 1808 "y.tab.c"
     break;
 
-  case 46:
-#line 390 "parse.y" /* yacc.c:1646  */
-    {
+  case 52: /* non_mt_attrtype_list: attrtype ',' non_mt_attrtype_list  */
+#line 444 "parse.y"
+   {
       (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1704 "y.tab.c" /* yacc.c:1646  */
+#line 1816 "y.tab.c"
     break;
 
-  case 47:
-#line 394 "parse.y" /* yacc.c:1646  */
-    {
+  case 53: /* non_mt_attrtype_list: attrtype  */
+#line 448 "parse.y"
+   {
       (yyval.n) = list_node((yyvsp[0].n));
    }
-#line 1712 "y.tab.c" /* yacc.c:1646  */
+#line 1824 "y.tab.c"
     break;
 
-  case 48:
-#line 401 "parse.y" /* yacc.c:1646  */
+  case 54: /* attrtype: T_STRING T_STRING  */
+#line 455 "parse.y"
     {
       (yyval.n) = attrtype_node((yyvsp[-1].sval), (yyvsp[0].sval));
    }
-#line 1720 "y.tab.c" /* yacc.c:1646  */
+#line 1832 "y.tab.c"
     break;
 
-  case 50:
-#line 409 "parse.y" /* yacc.c:1646  */
-    {
+  case 56: /* non_mt_select_clause: '*'  */
+#line 463 "parse.y"
+   {
        (yyval.n) = list_node(relattr_node(NULL, (char*)"*"));
    }
-#line 1728 "y.tab.c" /* yacc.c:1646  */
+#line 1840 "y.tab.c"
     break;
 
-  case 51:
-#line 416 "parse.y" /* yacc.c:1646  */
-    {
+  case 57: /* non_mt_select_list: select_attr ',' non_mt_select_list  */
+#line 469 "parse.y"
+   {
       (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1736 "y.tab.c" /* yacc.c:1646  */
+#line 1848 "y.tab.c"
     break;
 
-  case 52:
-#line 420 "parse.y" /* yacc.c:1646  */
-    {
+  case 58: /* non_mt_select_list: select_attr  */
+#line 473 "parse.y"
+   {
       (yyval.n) = list_node((yyvsp[0].n));
    }
-#line 1744 "y.tab.c" /* yacc.c:1646  */
+#line 1856 "y.tab.c"
     break;
 
-  case 53:
-#line 427 "parse.y" /* yacc.c:1646  */
-    {
+  case 60: /* select_attr: T_STRING '(' relattr ')'  */
+#line 481 "parse.y"
+   {
+      (yyval.n) = agg_relattr_node((yyvsp[-3].sval), (yyvsp[-1].n));
+   }
+#line 1864 "y.tab.c"
+    break;
+
+  case 61: /* select_attr: T_STRING '(' '*' ')'  */
+#line 485 "parse.y"
+   {
+      (yyval.n) = agg_relattr_node((yyvsp[-3].sval), relattr_node(NULL, (char*)"*"));
+   }
+#line 1872 "y.tab.c"
+    break;
+
+  case 62: /* non_mt_relattr_list: relattr ',' non_mt_relattr_list  */
+#line 493 "parse.y"
+   {
+      (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
+   }
+#line 1880 "y.tab.c"
+    break;
+
+  case 63: /* non_mt_relattr_list: relattr  */
+#line 497 "parse.y"
+   {
+      (yyval.n) = list_node((yyvsp[0].n));
+   }
+#line 1888 "y.tab.c"
+    break;
+
+  case 64: /* relattr: T_STRING '.' T_STRING  */
+#line 504 "parse.y"
+   {
       (yyval.n) = relattr_node((yyvsp[-2].sval), (yyvsp[0].sval));
    }
-#line 1752 "y.tab.c" /* yacc.c:1646  */
+#line 1896 "y.tab.c"
     break;
 
-  case 54:
-#line 431 "parse.y" /* yacc.c:1646  */
-    {
+  case 65: /* relattr: T_STRING  */
+#line 508 "parse.y"
+   {
       (yyval.n) = relattr_node(NULL, (yyvsp[0].sval));
    }
-#line 1760 "y.tab.c" /* yacc.c:1646  */
+#line 1904 "y.tab.c"
     break;
 
-  case 55:
-#line 438 "parse.y" /* yacc.c:1646  */
-    {
+  case 66: /* non_mt_relation_list: relation ',' non_mt_relation_list  */
+#line 515 "parse.y"
+   {
       (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1768 "y.tab.c" /* yacc.c:1646  */
+#line 1912 "y.tab.c"
     break;
 
-  case 56:
-#line 442 "parse.y" /* yacc.c:1646  */
-    {
+  case 67: /* non_mt_relation_list: relation  */
+#line 519 "parse.y"
+   {
       (yyval.n) = list_node((yyvsp[0].n));
    }
-#line 1776 "y.tab.c" /* yacc.c:1646  */
+#line 1920 "y.tab.c"
     break;
 
-  case 57:
-#line 449 "parse.y" /* yacc.c:1646  */
-    {
+  case 68: /* relation: T_STRING  */
+#line 526 "parse.y"
+   {
       (yyval.n) = relation_node((yyvsp[0].sval));
    }
-#line 1784 "y.tab.c" /* yacc.c:1646  */
+#line 1928 "y.tab.c"
     break;
 
-  case 58:
-#line 456 "parse.y" /* yacc.c:1646  */
-    {
+  case 69: /* opt_where_clause: RW_WHERE non_mt_cond_list  */
+#line 533 "parse.y"
+   {
       (yyval.n) = (yyvsp[0].n);
    }
-#line 1792 "y.tab.c" /* yacc.c:1646  */
+#line 1936 "y.tab.c"
     break;
 
-  case 59:
-#line 460 "parse.y" /* yacc.c:1646  */
-    {
+  case 70: /* opt_where_clause: nothing  */
+#line 537 "parse.y"
+   {
       (yyval.n) = NULL;
    }
-#line 1800 "y.tab.c" /* yacc.c:1646  */
+#line 1944 "y.tab.c"
     break;
 
-  case 60:
-#line 467 "parse.y" /* yacc.c:1646  */
-    {
+  case 71: /* opt_group_by_clause: RW_GROUP RW_BY non_mt_relattr_list  */
+#line 544 "parse.y"
+   {
+      (yyval.n) = (yyvsp[0].n);
+   }
+#line 1952 "y.tab.c"
+    break;
+
+  case 72: /* opt_group_by_clause: nothing  */
+#line 548 "parse.y"
+   {
+      (yyval.n) = NULL;
+   }
+#line 1960 "y.tab.c"
+    break;
+
+  case 73: /* opt_order_by_clause: RW_ORDER RW_BY non_mt_order_list  */
+#line 555 "parse.y"
+   {
+      (yyval.n) = (yyvsp[0].n);
+   }
+#line 1968 "y.tab.c"
+    break;
+
+  case 74: /* opt_order_by_clause: nothing  */
+#line 559 "parse.y"
+   {
+      (yyval.n) = NULL;
+   }
+#line 1976 "y.tab.c"
+    break;
+
+  case 75: /* non_mt_order_list: order_attr ',' non_mt_order_list  */
+#line 566 "parse.y"
+   {
       (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1808 "y.tab.c" /* yacc.c:1646  */
+#line 1984 "y.tab.c"
     break;
 
-  case 61:
-#line 471 "parse.y" /* yacc.c:1646  */
-    {
+  case 76: /* non_mt_order_list: order_attr  */
+#line 570 "parse.y"
+   {
       (yyval.n) = list_node((yyvsp[0].n));
    }
-#line 1816 "y.tab.c" /* yacc.c:1646  */
+#line 1992 "y.tab.c"
     break;
 
-  case 62:
-#line 478 "parse.y" /* yacc.c:1646  */
-    {
+  case 77: /* order_attr: relattr opt_order_direction  */
+#line 577 "parse.y"
+   {
+      (yyval.n) = order_attr_node((yyvsp[-1].n), (yyvsp[0].ival));
+   }
+#line 2000 "y.tab.c"
+    break;
+
+  case 78: /* opt_order_direction: RW_ASC  */
+#line 584 "parse.y"
+   {
+      (yyval.ival) = 0;
+   }
+#line 2008 "y.tab.c"
+    break;
+
+  case 79: /* opt_order_direction: RW_DESC  */
+#line 588 "parse.y"
+   {
+      (yyval.ival) = 1;
+   }
+#line 2016 "y.tab.c"
+    break;
+
+  case 80: /* opt_order_direction: nothing  */
+#line 592 "parse.y"
+   {
+      (yyval.ival) = 0;
+   }
+#line 2024 "y.tab.c"
+    break;
+
+  case 81: /* opt_limit_clause: RW_LIMIT T_INT  */
+#line 599 "parse.y"
+   {
+      (yyval.ival) = (yyvsp[0].ival);
+   }
+#line 2032 "y.tab.c"
+    break;
+
+  case 82: /* opt_limit_clause: nothing  */
+#line 603 "parse.y"
+   {
+      (yyval.ival) = -1;
+   }
+#line 2040 "y.tab.c"
+    break;
+
+  case 83: /* non_mt_cond_list: condition RW_AND non_mt_cond_list  */
+#line 610 "parse.y"
+   {
+      (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
+   }
+#line 2048 "y.tab.c"
+    break;
+
+  case 84: /* non_mt_cond_list: condition  */
+#line 614 "parse.y"
+   {
+      (yyval.n) = list_node((yyvsp[0].n));
+   }
+#line 2056 "y.tab.c"
+    break;
+
+  case 85: /* condition: relattr op relattr_or_value  */
+#line 621 "parse.y"
+   {
       (yyval.n) = condition_node((yyvsp[-2].n), (yyvsp[-1].cval), (yyvsp[0].n));
    }
-#line 1824 "y.tab.c" /* yacc.c:1646  */
+#line 2064 "y.tab.c"
     break;
 
-  case 63:
-#line 485 "parse.y" /* yacc.c:1646  */
-    {
+  case 86: /* relattr_or_value: relattr  */
+#line 628 "parse.y"
+   {
       (yyval.n) = relattr_or_value_node((yyvsp[0].n), NULL);
    }
-#line 1832 "y.tab.c" /* yacc.c:1646  */
+#line 2072 "y.tab.c"
     break;
 
-  case 64:
-#line 489 "parse.y" /* yacc.c:1646  */
-    {
+  case 87: /* relattr_or_value: value  */
+#line 632 "parse.y"
+   {
       (yyval.n) = relattr_or_value_node(NULL, (yyvsp[0].n));
    }
-#line 1840 "y.tab.c" /* yacc.c:1646  */
+#line 2080 "y.tab.c"
     break;
 
-  case 65:
-#line 496 "parse.y" /* yacc.c:1646  */
-    {
+  case 88: /* non_mt_value_list: value ',' non_mt_value_list  */
+#line 639 "parse.y"
+   {
       (yyval.n) = prepend((yyvsp[-2].n), (yyvsp[0].n));
    }
-#line 1848 "y.tab.c" /* yacc.c:1646  */
+#line 2088 "y.tab.c"
     break;
 
-  case 66:
-#line 500 "parse.y" /* yacc.c:1646  */
-    {
+  case 89: /* non_mt_value_list: value  */
+#line 643 "parse.y"
+   {
       (yyval.n) = list_node((yyvsp[0].n));
    }
-#line 1856 "y.tab.c" /* yacc.c:1646  */
+#line 2096 "y.tab.c"
     break;
 
-  case 67:
-#line 507 "parse.y" /* yacc.c:1646  */
-    {
+  case 90: /* value: T_QSTRING  */
+#line 650 "parse.y"
+   {
       (yyval.n) = value_node(STRING, (void *) (yyvsp[0].sval));
    }
-#line 1864 "y.tab.c" /* yacc.c:1646  */
+#line 2104 "y.tab.c"
     break;
 
-  case 68:
-#line 511 "parse.y" /* yacc.c:1646  */
-    {
+  case 91: /* value: T_INT  */
+#line 654 "parse.y"
+   {
       (yyval.n) = value_node(INT, (void *)& (yyvsp[0].ival));
    }
-#line 1872 "y.tab.c" /* yacc.c:1646  */
+#line 2112 "y.tab.c"
     break;
 
-  case 69:
-#line 515 "parse.y" /* yacc.c:1646  */
-    {
+  case 92: /* value: T_REAL  */
+#line 658 "parse.y"
+   {
       (yyval.n) = value_node(FLOAT, (void *)& (yyvsp[0].rval));
    }
-#line 1880 "y.tab.c" /* yacc.c:1646  */
+#line 2120 "y.tab.c"
     break;
 
-  case 70:
-#line 522 "parse.y" /* yacc.c:1646  */
-    {
+  case 93: /* opt_relname: T_STRING  */
+#line 665 "parse.y"
+   {
       (yyval.sval) = (yyvsp[0].sval);
    }
-#line 1888 "y.tab.c" /* yacc.c:1646  */
+#line 2128 "y.tab.c"
     break;
 
-  case 71:
-#line 526 "parse.y" /* yacc.c:1646  */
-    {
+  case 94: /* opt_relname: nothing  */
+#line 669 "parse.y"
+   {
       (yyval.sval) = NULL;
    }
-#line 1896 "y.tab.c" /* yacc.c:1646  */
+#line 2136 "y.tab.c"
     break;
 
-  case 72:
-#line 533 "parse.y" /* yacc.c:1646  */
-    {
+  case 95: /* op: T_LT  */
+#line 676 "parse.y"
+   {
       (yyval.cval) = LT_OP;
    }
-#line 1904 "y.tab.c" /* yacc.c:1646  */
+#line 2144 "y.tab.c"
     break;
 
-  case 73:
-#line 537 "parse.y" /* yacc.c:1646  */
-    {
+  case 96: /* op: T_LE  */
+#line 680 "parse.y"
+   {
       (yyval.cval) = LE_OP;
    }
-#line 1912 "y.tab.c" /* yacc.c:1646  */
+#line 2152 "y.tab.c"
     break;
 
-  case 74:
-#line 541 "parse.y" /* yacc.c:1646  */
-    {
+  case 97: /* op: T_GT  */
+#line 684 "parse.y"
+   {
       (yyval.cval) = GT_OP;
    }
-#line 1920 "y.tab.c" /* yacc.c:1646  */
+#line 2160 "y.tab.c"
     break;
 
-  case 75:
-#line 545 "parse.y" /* yacc.c:1646  */
-    {
+  case 98: /* op: T_GE  */
+#line 688 "parse.y"
+   {
       (yyval.cval) = GE_OP;
    }
-#line 1928 "y.tab.c" /* yacc.c:1646  */
+#line 2168 "y.tab.c"
     break;
 
-  case 76:
-#line 549 "parse.y" /* yacc.c:1646  */
-    {
+  case 99: /* op: T_EQ  */
+#line 692 "parse.y"
+   {
       (yyval.cval) = EQ_OP;
    }
-#line 1936 "y.tab.c" /* yacc.c:1646  */
+#line 2176 "y.tab.c"
     break;
 
-  case 77:
-#line 553 "parse.y" /* yacc.c:1646  */
-    {
+  case 100: /* op: T_NE  */
+#line 696 "parse.y"
+   {
       (yyval.cval) = NE_OP;
    }
-#line 1944 "y.tab.c" /* yacc.c:1646  */
+#line 2184 "y.tab.c"
     break;
 
-  case 78:
-#line 560 "parse.y" /* yacc.c:1646  */
-    {
-      (yyval.n) = distribute_node((yyvsp[-3].sval), (yyvsp[-1].n));
+  case 101: /* opt_distributed: RW_DISTRIBUTED T_STRING '(' non_mt_value_list ')'  */
+#line 703 "parse.y"
+   {
+      (yyval.n) = distribute_node((yyvsp[-3].sval), (yyvsp[-1].n), EX_RANGE_PARTITIONED);
    }
-#line 1952 "y.tab.c" /* yacc.c:1646  */
+#line 2192 "y.tab.c"
     break;
 
-  case 79:
-#line 564 "parse.y" /* yacc.c:1646  */
-    {
+  case 102: /* opt_distributed: RW_DISTRIBUTED RW_BY RW_HASH '(' T_STRING ')'  */
+#line 707 "parse.y"
+   {
+      (yyval.n) = distribute_node((yyvsp[-1].sval), NULL, EX_HASH_PARTITIONED);
+   }
+#line 2200 "y.tab.c"
+    break;
+
+  case 103: /* opt_distributed: RW_DISTRIBUTED RW_REPLICATED  */
+#line 711 "parse.y"
+   {
+      (yyval.n) = distribute_node(NULL, NULL, EX_REPLICATED);
+   }
+#line 2208 "y.tab.c"
+    break;
+
+  case 104: /* opt_distributed: nothing  */
+#line 715 "parse.y"
+   {
       (yyval.n) = NULL;
    }
-#line 1960 "y.tab.c" /* yacc.c:1646  */
+#line 2216 "y.tab.c"
     break;
 
+  case 105: /* opt_index_type: RW_USING RW_HASH  */
+#line 722 "parse.y"
+   {
+      (yyval.ival) = IX_HASH;
+   }
+#line 2224 "y.tab.c"
+    break;
+
+  case 106: /* opt_index_type: nothing  */
+#line 726 "parse.y"
+   {
+      (yyval.ival) = IX_BTREE;
+   }
+#line 2232 "y.tab.c"
+    break;
+
+
+#line 2236 "y.tab.c"
 
-#line 1964 "y.tab.c" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1974,25 +2247,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2003,50 +2274,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2075,12 +2310,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2097,13 +2331,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2117,7 +2352,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2129,7 +2364,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2140,26 +2375,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2175,20 +2414,18 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 573 "parse.y" /* yacc.c:1906  */
+
+#line 735 "parse.y"
 
 
 //
@@ -63,6 +63,8 @@ int bExit;                 // when to return from RBparse
 
 int bQueryPlans;           // When to print the query plans
 
+int bExplainAnalyze;       // While a query run by EXPLAIN ANALYZE executes
+
 PF_Manager *pPfm;          // PF component manager
 SM_Manager *pSmm;          // SM component manager
 QL_Manager *pQlm;          // QL component manager
@@ -112,6 +114,18 @@ QL_Manager *pQlm;          // QL component manager
       RW_ON
       RW_OFF
       RW_DISTRIBUTED
+      RW_USING
+      RW_HASH
+      RW_REPLICATED
+      RW_ORDER
+      RW_BY
+      RW_LIMIT
+      RW_ASC
+      RW_DESC
+      RW_GROUP
+      RW_ANALYZE
+      RW_SAMPLE
+      RW_EXPLAIN
 
 %token   <ival>   T_INT
 
@@ -123,6 +137,11 @@ QL_Manager *pQlm;          // QL component manager
 
 %type   <cval>   op
 
+%type   <ival>   opt_index_type
+      opt_order_direction
+      opt_limit_clause
+      opt_sample_clause
+
 %type   <sval>   opt_relname
 
 %type   <n>   command
@@ -134,11 +153,13 @@ QL_Manager *pQlm;          // QL component manager
       droptable
       dropindex
       load
+      analyze
       set
       help
       print
       exit
       query
+      explain
       insert
       delete
       update
@@ -146,10 +167,16 @@ QL_Manager *pQlm;          // QL component manager
       attrtype
       non_mt_relattr_list
       non_mt_select_clause
+      non_mt_select_list
+      select_attr
       relattr
       non_mt_relation_list
       relation
       opt_where_clause
+      opt_group_by_clause
+      opt_order_by_clause
+      non_mt_order_list
+      order_attr
       non_mt_cond_list
       condition
       relattr_or_value
@@ -214,6 +241,7 @@ ddl
 
 dml
    : query
+   | explain
    | insert
    | delete
    | update
@@ -221,6 +249,7 @@ dml
 
 utility
    : load
+   | analyze
    | exit
    | set
    | help
@@ -300,9 +329,9 @@ createtable
    ;
 
 createindex
-   : RW_CREATE RW_INDEX T_STRING '(' T_STRING ')'
+   : RW_CREATE RW_INDEX T_STRING '(' T_STRING ')' opt_index_type
    {
-      $$ = create_index_node($3, $5);
+      $$ = create_index_node($3, $5, $7);
    }
    ;
 
@@ -327,6 +356,23 @@ load
    }
    ;
 
+analyze
+   : RW_ANALYZE T_STRING opt_sample_clause
+   {
+      $$ = analyze_node($2, $3);
+   }
+   ;
+
+opt_sample_clause
+   : RW_SAMPLE T_INT
+   {
+      $$ = $2;
+   }
+   | nothing
+   {
+      $$ = 100;
+   }
+   ;
 
 set
    : RW_SET T_STRING T_EQ T_QSTRING
@@ -359,8 +405,16 @@ exit
 
 query
    : RW_SELECT non_mt_select_clause RW_FROM non_mt_relation_list opt_where_clause
+     opt_group_by_clause opt_order_by_clause opt_limit_clause
+   {
+      $$ = query_node($2, $4, $5, $6, $7, $8);
+   }
+   ;
+
+explain
+   : RW_EXPLAIN RW_ANALYZE query
    {
-      $$ = query_node($2, $4, $5);
+      $$ = explain_node($3);
    }
    ;
 
@@ -404,12 +458,35 @@ attrtype
    ;
 
 non_mt_select_clause
-   : non_mt_relattr_list
+   : non_mt_select_list
    | '*'
    {
        $$ = list_node(relattr_node(NULL, (char*)"*"));
    }
 
+non_mt_select_list
+   : select_attr ',' non_mt_select_list
+   {
+      $$ = prepend($1, $3);
+   }
+   | select_attr
+   {
+      $$ = list_node($1);
+   }
+   ;
+
+select_attr
+   : relattr
+   | T_STRING '(' relattr ')'
+   {
+      $$ = agg_relattr_node($1, $3);
+   }
+   | T_STRING '(' '*' ')'
+   {
+      $$ = agg_relattr_node($1, relattr_node(NULL, (char*)"*"));
+   }
+   ;
+
 
 non_mt_relattr_list
    : relattr ',' non_mt_relattr_list
@@ -462,6 +539,72 @@ opt_where_clause
    }
    ;
 
+opt_group_by_clause
+   : RW_GROUP RW_BY non_mt_relattr_list
+   {
+      $$ = $3;
+   }
+   | nothing
+   {
+      $$ = NULL;
+   }
+   ;
+
+opt_order_by_clause
+   : RW_ORDER RW_BY non_mt_order_list
+   {
+      $$ = $3;
+   }
+   | nothing
+   {
+      $$ = NULL;
+   }
+   ;
+
+non_mt_order_list
+   : order_attr ',' non_mt_order_list
+   {
+      $$ = prepend($1, $3);
+   }
+   | order_attr
+   {
+      $$ = list_node($1);
+   }
+   ;
+
+order_attr
+   : relattr opt_order_direction
+   {
+      $$ = order_attr_node($1, $2);
+   }
+   ;
+
+opt_order_direction
+   : RW_ASC
+   {
+      $$ = 0;
+   }
+   | RW_DESC
+   {
+      $$ = 1;
+   }
+   | nothing
+   {
+      $$ = 0;
+   }
+   ;
+
+opt_limit_clause
+   : RW_LIMIT T_INT
+   {
+      $$ = $2;
+   }
+   | nothing
+   {
+      $$ = -1;
+   }
+   ;
+
 non_mt_cond_list
    : condition RW_AND non_mt_cond_list
    {
@@ -558,7 +701,15 @@ op
 opt_distributed
    : RW_DISTRIBUTED T_STRING '(' non_mt_value_list ')'
    {
-      $$ = distribute_node($2, $4);
+      $$ = distribute_node($2, $4, EX_RANGE_PARTITIONED);
+   }
+   | RW_DISTRIBUTED RW_BY RW_HASH '(' T_STRING ')'
+   {
+      $$ = distribute_node($5, NULL, EX_HASH_PARTITIONED);
+   }
+   | RW_DISTRIBUTED RW_REPLICATED
+   {
+      $$ = distribute_node(NULL, NULL, EX_REPLICATED);
    }
    | nothing
    {
@@ -566,6 +717,17 @@ opt_distributed
    }
    ;
 
+opt_index_type
+   : RW_USING RW_HASH
+   {
+      $$ = IX_HASH;
+   }
+   | nothing
+   {
+      $$ = IX_BTREE;
+   }
+   ;
+
 nothing
    : /* epsilon */
    ;
@@ -27,6 +27,21 @@ struct RelAttr{
     friend std::ostream &operator<<(std::ostream &s, const RelAttr &ra);
 };
 
+// Aggregate functions in the select clause
+enum AggFun {
+    NO_F,                 /* no aggregate (plain attribute)   */
+    MIN_F,
+    MAX_F,
+    COUNT_F,              /* COUNT(*) has attrName "*"        */
+    SUM_F,
+    AVG_F
+};
+
+struct OrderAttr{
+    RelAttr  attr;        /* attribute to order by            */
+    int      bDescending; /* TRUE if in descending order      */
+};
+
 struct Value{
     AttrType type;         /* type of value               */
     void     *data;        /* value                       */
@@ -68,4 +83,9 @@ void PrintError(RC rc);
 // bQueryPlans is 0 then no query plan is shown.
 extern int bQueryPlans;
 
+// bExplainAnalyze is allocated by parse.y.  It is 1 while a query run by
+// EXPLAIN ANALYZE executes: the operators collect their runtime statistics,
+// which are printed in the query plan.
+extern int bExplainAnalyze;
+
 #endif
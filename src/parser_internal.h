@@ -49,6 +49,7 @@ typedef enum{
     N_DROPTABLE,
     N_DROPINDEX,
     N_LOAD,
+    N_ANALYZE,
     N_SET,
     N_HELP,
     N_PRINT,
@@ -64,7 +65,9 @@ typedef enum{
     N_RELATION,
     N_STATISTICS,
     N_LIST,
-    N_DISTRIBUTE
+    N_DISTRIBUTE,
+    N_ORDERATTR,
+    N_AGGRELATTR
 } NODEKIND;
 
 /*
@@ -86,6 +89,7 @@ typedef struct node{
       struct{
          char *relname;
          char *attrname;
+         int indextype;
       } CREATEINDEX;
 
       /* drop index node */
@@ -105,6 +109,12 @@ typedef struct node{
          char *filename;
       } LOAD;
 
+      /* analyze node */
+      struct{
+         char *relname;
+         int samplepercent;
+      } ANALYZE;
+
       /* set node */
       struct{
          char *paramName;
@@ -127,6 +137,10 @@ typedef struct node{
          struct node *relattrlist;
          struct node *rellist;
          struct node *conditionlist;
+         struct node *grouplist;
+         struct node *orderlist;
+         int limit;
+         int explain;
       } QUERY;
 
       /* insert node */
@@ -156,6 +170,18 @@ typedef struct node{
          char *attrname;
       } RELATTR;
 
+      /* aggregate function of a relation attribute */
+      struct{
+         char *function;
+         struct node *relattr;
+      } AGGRELATTR;
+
+      /* order by attribute node */
+      struct{
+         struct node *relattr;
+         int descending;
+      } ORDERATTR;
+
       /* condition node */
       struct{
          struct node *lhsRelattr;
@@ -199,6 +225,7 @@ typedef struct node{
       struct{
         char* attrName;
         struct node *value_list;
+        int partitioning;
       } DISTRIBUTE;
    } u;
 } NODE;
@@ -209,19 +236,24 @@ typedef struct node{
  */
 NODE *newnode(NODEKIND kind);
 NODE *create_table_node(char *relname, NODE *attrlist, NODE* distribute_data);
-NODE *create_index_node(char *relname, char *attrname);
+NODE *create_index_node(char *relname, char *attrname, int indextype);
 NODE *drop_index_node(char *relname, char *attrname);
 NODE *drop_table_node(char *relname);
 NODE *load_node(char *relname, char *filename);
+NODE *analyze_node(char *relname, int samplepercent);
 NODE *set_node(char *paramName, char *string);
 NODE *help_node(char *relname);
 NODE *print_node(char *relname);
-NODE *query_node(NODE *relattrlist, NODE *rellist, NODE *conditionlist);
+NODE *query_node(NODE *relattrlist, NODE *rellist, NODE *conditionlist,
+                 NODE *grouplist, NODE *orderlist, int limit);
+NODE *explain_node(NODE *query);
 NODE *insert_node(char *relname, NODE *valuelist);
 NODE *delete_node(char *relname, NODE *conditionlist);
 NODE *update_node(char *relname, NODE *relattr, NODE *value,
 		  NODE *conditionlist);
 NODE *relattr_node(char *relname, char *attrname);
+NODE *agg_relattr_node(char *function, NODE *relattr);
+NODE *order_attr_node(NODE *relattr, int descending);
 NODE *condition_node(NODE *lhsRelattr, CompOp op, NODE *rhsRelattrOrValue);
 NODE *value_node(AttrType type, void *value);
 NODE *relattr_or_value_node(NODE *relattr, NODE *value);
@@ -230,7 +262,7 @@ NODE *relation_node(char *relname);
 NODE *list_node(NODE *n);
 NODE *prepend(NODE *n, NODE *list);
 // EX
-NODE *distribute_node(char* attrName, NODE* value_list);
+NODE *distribute_node(char* attrName, NODE* value_list, int partitioning);
 
 void reset_scanner(void);
 void reset_charptr(void);
@@ -135,6 +135,14 @@ public:
    RC PrintBuffer   ();
    RC ResizeBuffer  (int iNewSize);
 
+   // Return the number of pages in the buffer pool, so that operators can
+   // size their memory after the "resize buffer" command
+   RC GetBufferSize (int &numPages) const;
+
+   // Write the dirty pages of all the files to disk, keeping them in the
+   // buffer pool (before forking a process that shares the files)
+   RC ForceAllPages ();
+
    // Three Methods for manipulating raw memory buffers.  These memory
    // locations are handled by the buffer manager, but are not
    // associated with a particular file.  These should be used if you
@@ -163,6 +171,12 @@ private:
 //
 void PF_PrintError(RC rc);
 
+//
+// Pages pinned and buffer misses (pages read from disk) of the calling
+// thread so far
+//
+void PF_GetPageCounts(int &pagesPinned, int &bufferMisses);
+
 #define PF_PAGEPINNED      (START_PF_WARN + 0) // page pinned in buffer
 #define PF_PAGENOTINBUF    (START_PF_WARN + 1) // page isn't pinned in buffer
 #define PF_INVALIDPAGE     (START_PF_WARN + 2) // invalid page number
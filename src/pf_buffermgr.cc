@@ -31,6 +31,24 @@ using namespace std;
 StatisticsMgr *pStatisticsMgr;
 #endif
 
+// Pages pinned and buffer misses of each thread (see PF_GetPageCounts)
+static thread_local int threadPagesPinned = 0;
+static thread_local int threadBufferMisses = 0;
+
+//
+// PF_GetPageCounts
+//
+// Desc: Return the pages pinned and the buffer misses of the calling
+//       thread so far.  Unlike the PF_STATS statistics these counters are
+//       always kept, and are cheap enough to read around each GetNext of
+//       the query operators.
+//
+void PF_GetPageCounts(int &pagesPinned, int &bufferMisses)
+{
+   pagesPinned = threadPagesPinned;
+   bufferMisses = threadBufferMisses;
+}
+
 #ifdef PF_LOG
 
 //
@@ -178,6 +196,8 @@ PF_BufferMgr::~PF_BufferMgr()
 RC PF_BufferMgr::GetPage(int fd, PageNum pageNum, char **ppBuffer,
       int bMultiplePins)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC  rc;     // return code
    int slot;   // buffer slot where page is located
 
@@ -223,6 +243,9 @@ RC PF_BufferMgr::GetPage(int fd, PageNum pageNum, char **ppBuffer,
 #ifdef PF_LOG
    WriteLog("Page not found in buffer. Loaded.\n");
 #endif
+
+      // Count the miss for the thread
+      threadBufferMisses++;
    }
    else {   // Page is in the buffer...
 
@@ -250,6 +273,9 @@ RC PF_BufferMgr::GetPage(int fd, PageNum pageNum, char **ppBuffer,
 
    // cout << "Page pinned: " << pageNum << " count: " << bufTable[slot].pinCount << endl;
 
+   // Count the pinned page for the thread
+   threadPagesPinned++;
+
    // Point ppBuffer to page
    *ppBuffer = bufTable[slot].pData;
 
@@ -268,6 +294,8 @@ RC PF_BufferMgr::GetPage(int fd, PageNum pageNum, char **ppBuffer,
 //
 RC PF_BufferMgr::AllocatePage(int fd, PageNum pageNum, char **ppBuffer)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC  rc;     // return code
    int slot;   // buffer slot where page is located
 
@@ -323,6 +351,8 @@ RC PF_BufferMgr::AllocatePage(int fd, PageNum pageNum, char **ppBuffer)
 //
 RC PF_BufferMgr::MarkDirty(int fd, PageNum pageNum)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC  rc;       // return code
    int slot;     // buffer slot where page is located
 
@@ -365,6 +395,8 @@ RC PF_BufferMgr::MarkDirty(int fd, PageNum pageNum)
 //
 RC PF_BufferMgr::UnpinPage(int fd, PageNum pageNum)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC  rc;       // return code
    int slot;     // buffer slot where page is located
 
@@ -412,6 +444,8 @@ RC PF_BufferMgr::UnpinPage(int fd, PageNum pageNum)
 //
 RC PF_BufferMgr::FlushPages(int fd)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC rc, rcWarn = 0;  // return codes
 
 #ifdef PF_LOG
@@ -483,6 +517,8 @@ RC PF_BufferMgr::FlushPages(int fd)
 //
 RC PF_BufferMgr::ForcePages(int fd, PageNum pageNum)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC rc;  // return codes
 
 #ifdef PF_LOG
@@ -524,6 +560,37 @@ WriteLog(psMessage);
 }
 
 
+//
+// ForceAllPages
+//
+// Desc: Write all the dirty pages in the buffer pool to the disk, but
+//       do not remove them.  Called before forking a process sharing
+//       the files, so that the copy of the pool in the new process only
+//       has clean pages and never writes back stale data.
+// In:   Nothing
+// Out:  Nothing
+// Ret:  PF return code
+//
+RC PF_BufferMgr::ForceAllPages()
+{
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
+   RC rc;  // return codes
+
+   int slot = first;
+   while (slot != INVALID_SLOT) {
+      if (bufTable[slot].bDirty) {
+         if ((rc = WritePage(bufTable[slot].fd, bufTable[slot].pageNum, bufTable[slot].pData)))
+            return (rc);
+         bufTable[slot].bDirty = FALSE;
+      }
+      slot = bufTable[slot].next;
+   }
+
+   return 0;
+}
+
+
 //
 // PrintBuffer
 //
@@ -535,6 +602,8 @@ WriteLog(psMessage);
 //
 RC PF_BufferMgr::PrintBuffer()
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    cout << "Buffer contains " << numPages << " pages of size "
       << pageSize <<".\n";
    cout << "Contents in order from most recently used to "
@@ -574,6 +643,8 @@ RC PF_BufferMgr::PrintBuffer()
 //       is called.
 RC PF_BufferMgr::ClearBuffer()
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC rc;
 
    int slot, next;
@@ -608,6 +679,8 @@ RC PF_BufferMgr::ClearBuffer()
 //
 RC PF_BufferMgr::ResizeBuffer(int iNewSize)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    int i;
    RC rc;
 
@@ -689,6 +762,22 @@ RC PF_BufferMgr::ResizeBuffer(int iNewSize)
    return 0;
 }
 
+//
+// GetBufferSize
+//
+// Desc: Return the number of pages in the buffer, as last set by the
+//       constructor or ResizeBuffer.
+// Out:  numPages - the number of pages in the buffer
+// Ret:  OK_RC
+//
+RC PF_BufferMgr::GetBufferSize(int &numPages) const
+{
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
+   numPages = this->numPages;
+   return OK_RC;
+}
+
 
 //
 // InsertFree
@@ -951,6 +1040,8 @@ RC PF_BufferMgr::GetBlockSize(int &length) const
 //
 RC PF_BufferMgr::AllocateBlock(char *&buffer)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    RC rc = OK_RC;
 
    // Get an empty slot from the buffer pool
@@ -984,5 +1075,7 @@ RC PF_BufferMgr::AllocateBlock(char *&buffer)
 //
 RC PF_BufferMgr::DisposeBlock(char* buffer)
 {
+   std::lock_guard<std::recursive_mutex> guard(bufferMutex);
+
    return UnpinPage(MEMORY_FD, buffer - (char*)0);
 }
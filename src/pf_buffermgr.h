@@ -17,6 +17,7 @@
 
 #include "pf_internal.h"
 #include "pf_hashtable.h"
+#include <mutex>
 
 //
 // Defines
@@ -64,6 +65,9 @@ public:
     // Force a page to the disk, but do not remove from the buffer pool
     RC ForcePages    (int fd, PageNum pageNum);
 
+    // Force the dirty pages of all the files to the disk, keeping them in the pool
+    RC ForceAllPages ();
+
 
     // Remove all entries from the Buffer Manager.
     RC  ClearBuffer  ();
@@ -73,6 +77,9 @@ public:
     // Attempts to resize the buffer to the new size
     RC ResizeBuffer  (int iNewSize);
 
+    // Return the number of pages in the buffer
+    RC GetBufferSize (int &numPages) const;
+
     // Three Methods for manipulating raw memory buffers.  These memory
     // locations are handled by the buffer manager, but are not
     // associated with a particular file.  These should be used if you
@@ -108,6 +115,10 @@ private:
     int            first;                         // MRU page slot
     int            last;                          // LRU page slot
     int            free;                          // head of free list
+
+    // Lock held by the public methods, so that the worker threads of a
+    // parallel scan can pin and unpin pages concurrently
+    mutable std::recursive_mutex bufferMutex;
 };
 
 #endif
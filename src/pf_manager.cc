@@ -258,6 +258,30 @@ RC PF_Manager::ResizeBuffer(int iNewSize)
    return pBufferMgr->ResizeBuffer(iNewSize);
 }
 
+//
+// GetBufferSize
+//
+// Desc: Return the number of pages in the buffer pool
+// Out:  numPages - the current buffer size
+// Ret:  Returns the result of PF_BufferMgr::GetBufferSize
+//
+RC PF_Manager::GetBufferSize(int &numPages) const
+{
+   return pBufferMgr->GetBufferSize(numPages);
+}
+
+//
+// ForceAllPages
+//
+// Desc: Write the dirty pages of all the files to disk, keeping them in
+//       the buffer pool
+// Ret:  Returns the result of PF_BufferMgr::ForceAllPages
+//
+RC PF_Manager::ForceAllPages()
+{
+   return pBufferMgr->ForceAllPages();
+}
+
 //------------------------------------------------------------------------------
 // Three Methods for manipulating raw memory buffers.  These memory
 // locations are handled by the buffer manager, but are not
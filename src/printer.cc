@@ -10,6 +10,14 @@
 #include <cstdlib>
 #include "printer.h"
 
+#ifndef min
+#define min(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
 using namespace std;
 
 //
@@ -24,6 +32,39 @@ void Spaces(int maxLength, int printedSoFar)
         cout << " ";
 }
 
+//
+// void GetQualifiedAttrName(const char *relName, const char *attrName, char *name)
+//
+// Name an attribute "relation.attribute". The relation of an aggregate
+// goes inside its parentheses, as in "SUM(relation.attribute)".
+//
+void GetQualifiedAttrName(const char *relName, const char *attrName, char *name)
+{
+    const char *open = strchr(attrName, '(');
+    if (relName == NULL || relName[0] == '\0' || (open != NULL && open[1] == '*'))
+        strcpy(name, attrName);
+    else if (open != NULL)
+        sprintf(name, "%.*s%s.%s", (int) (open + 1 - attrName), attrName, relName, open + 1);
+    else
+        sprintf(name, "%s.%s", relName, attrName);
+}
+
+//
+// void GetArgumentName(const char *attrName, char *name)
+//
+// Name the attribute an aggregate is computed on, as "attribute" for
+// "SUM(attribute)". Any other attribute keeps its name.
+//
+static void GetArgumentName(const char *attrName, char *name)
+{
+    const char *open = strchr(attrName, '(');
+    const char *close = strrchr(attrName, ')');
+    if (open != NULL && close != NULL && close > open)
+        sprintf(name, "%.*s", (int) (close - open - 1), open + 1);
+    else
+        strcpy(name, attrName);
+}
+
 //
 // ------------------------------------------------------------------------------
 //
@@ -50,7 +91,8 @@ Printer::Printer(const DataAttrInfo *attributes_, const int attrCount_)
 
     // Figure out what the header information will look like.  Normally,
     // we can just use the attribute name, but if that appears more than
-    // once, then we should use "relation.attribute".
+    // once, or an aggregate is computed on an attribute name of several
+    // relations, then we should use "relation.attribute".
 
     // this line broke when using CC
     // changing to use malloc and free instead of new and delete
@@ -66,17 +108,23 @@ Printer::Printer(const DataAttrInfo *attributes_, const int attrCount_)
         psHeader[i] = new char[MAXPRINTSTRING];
         memset(psHeader[i],0,MAXPRINTSTRING);
 
-        for (int j=0; j < attrCount; j++)
-            if (j != i &&
-                strcmp(attributes[i].attrName,
-                       attributes[j].attrName) == 0) {
+        char argName[MAXPRINTSTRING], otherArgName[MAXPRINTSTRING];
+        GetArgumentName(attributes[i].attrName, argName);
+        for (int j=0; j < attrCount; j++) {
+            if (j == i)
+                continue;
+            GetArgumentName(attributes[j].attrName, otherArgName);
+            if (strcmp(attributes[i].attrName,
+                       attributes[j].attrName) == 0 ||
+                (strcmp(argName, otherArgName) == 0 &&
+                 strcmp(attributes[i].relName, attributes[j].relName) != 0)) {
                 bFound = 1;
                 break;
             }
+        }
 
         if (bFound)
-            sprintf(psHeader[i], "%s.%s",
-                    attributes[i].relName, attributes[i].attrName);
+            GetQualifiedAttrName(attributes[i].relName, attributes[i].attrName, psHeader[i]);
         else
             strcpy(psHeader[i], attributes[i].attrName);
 
@@ -205,6 +253,9 @@ void Printer::Print(ostream &c, const void * const data[])
                 Spaces(12, strlen(strSpace));
             else
                 Spaces(strlen(psHeader[i]), strlen(strSpace));
+            // Keep a wide value apart from the next column
+            if (strlen(strSpace) >= 12 && strlen(strSpace) >= strlen(psHeader[i]))
+                c << " ";
         }
     }
     c << "\n";
@@ -269,6 +320,9 @@ void Printer::Print(ostream &c, const char * const data)
                 Spaces(12, strlen(strSpace));
             else
                 Spaces(strlen(psHeader[i]), strlen(strSpace));
+            // Keep a wide value apart from the next column
+            if (strlen(strSpace) >= 12 && strlen(strSpace) >= strlen(psHeader[i]))
+                c << " ";
         }
     }
     c << "\n";
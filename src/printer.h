@@ -37,6 +37,7 @@ struct DataAttrInfo
        attrType = d.attrType;
        attrLength = d.attrLength;
        indexNo = d.indexNo;
+       indexType = d.indexType;
     };
 
     DataAttrInfo& operator=(const DataAttrInfo &d) {
@@ -47,6 +48,7 @@ struct DataAttrInfo
           attrType = d.attrType;
           attrLength = d.attrLength;
           indexNo = d.indexNo;
+          indexType = d.indexType;
        }
        return (*this);
     };
@@ -57,11 +59,15 @@ struct DataAttrInfo
     AttrType attrType;              // Type of attribute
     int      attrLength;            // Length of attribute
     int      indexNo;               // Index number of attribute
+    int      indexType;             // Index type of attribute (IX_IndexType)
 };
 
 // Print some number of spaces
 void Spaces(int maxLength, int printedSoFar);
 
+// Name an attribute with its relation (at most MAXPRINTSTRING characters)
+void GetQualifiedAttrName(const char *relName, const char *attrName, char *name);
+
 class Printer {
 public:
     // Constructor.  Takes as arguments an array of attributes along with
@@ -93,13 +99,4 @@ private:
     int iCount;
 };
 
-
-#ifndef min
-#define min(a,b) (((a) < (b)) ? (a) : (b))
-#endif
-
-#ifndef max
-#define max(a,b) (((a) > (b)) ? (a) : (b))
-#endif
-
 #endif
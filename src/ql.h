@@ -27,10 +27,16 @@ public:
 
     RC Select  (int nSelAttrs,           // # attrs in select clause
         const RelAttr selAttrs[],        // attrs in select clause
+        const AggFun selAggFuns[],       // aggregate of each select attr (NO_F if none)
         int   nRelations,                // # relations in from clause
         const char * const relations[],  // relations in from clause
         int   nConditions,               // # conditions in where clause
-        const Condition conditions[]);   // conditions in where clause
+        const Condition conditions[],    // conditions in where clause
+        int   nGroupAttrs = 0,           // # attrs in group by clause
+        const RelAttr groupAttrs[] = NULL, // attrs in group by clause
+        int   nOrderAttrs = 0,           // # attrs in order by clause
+        const OrderAttr orderAttrs[] = NULL, // attrs in order by clause
+        int   limit = -1);               // limit on the tuples (-1 if none)
 
     RC Insert  (const char *relName,     // relation to insert into
         int   nValues,                   // # values
@@ -83,7 +89,8 @@ void QL_PrintError(RC rc);
 #define QL_INVALID_SELECT_ATTRIBUTES        (START_QL_WARN + 13) // Invalid select attributes
 #define QL_INVALID_FROM_CLAUSE              (START_QL_WARN + 14) // Invalid from clause in select
 #define QL_INVALID_ATTRIBUTE                (START_QL_WARN + 15) // Invalid attribute
-#define QL_LASTWARN                         QL_INVALID_ATTRIBUTE
+#define QL_INVALID_AGGREGATE                (START_QL_WARN + 16) // Invalid aggregate or group by
+#define QL_LASTWARN                         QL_INVALID_AGGREGATE
 
 // Errors
 #define QL_INVALID_DATABASE_NAME            (START_QL_ERR - 0) // Invalid database file name
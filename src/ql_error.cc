@@ -29,7 +29,8 @@ static char *QL_WarnMsg[] = {
   (char*)"end of file",
   (char*)"invalid select attributes",
   (char*)"invalid from clause in select",
-  (char*)"invalid attribute"
+  (char*)"invalid attribute",
+  (char*)"invalid aggregate or group by attribute"
 };
 
 static char *QL_ErrorMsg[] = {
@@ -10,6 +10,12 @@
 #include <string>
 #include <stdlib.h>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include "redbase.h"
 #include "parser.h"
 #include "printer.h"
@@ -18,18 +24,143 @@
 #include "sm.h"
 #include "ql.h"
 
+struct EX_Worker;
+class EX_WorkerStream;
+
+// Estimated matching entries of an index scan above which it collects its RIDs and
+// fetches the records in page order. Up to this many random page reads fit in the buffer pool.
+#define QL_SORTED_FETCH_THRESHOLD   40
+
+// Bytes of tuples a hash join keeps in memory before it spills both inputs
+// into partition files, and the number of partitions it spills into
+#define QL_HASH_JOIN_MEMORY         (64 * PF_PAGE_SIZE)
+#define QL_HASH_JOIN_PARTITIONS     16
+
+// Share of the buffer pool taken by the outer blocks of a nested loop join: it reads the outer
+// tuples in blocks of 1/QL_NL_JOIN_BUFFER_SHARE of the buffer pages (see "resize buffer") and
+// scans the inner child once per block
+#define QL_NL_JOIN_BUFFER_SHARE     2
+
+// Parallel scans of a QL_ExchangeOp: pages scanned by a worker at a time (a morsel), minimum
+// pages of a relation scanned in parallel, and tuples in a batch and batches queued between the
+// workers and the consumer
+#define QL_EXCHANGE_MORSEL_PAGES    8
+#define QL_EXCHANGE_MIN_PAGES       32
+#define QL_EXCHANGE_BATCH_TUPLES    256
+#define QL_EXCHANGE_QUEUE_BATCHES   16
+
+// Maximum number of sorted runs merged at once by an external sort
+#define QL_SORT_MERGE_FANIN         16
+
+// Bytes of groups a hash aggregation keeps in memory before it spills the tuples of new
+// groups into partition files, and the number of partitions it spills into
+#define QL_HASH_AGGREGATE_MEMORY        (64 * PF_PAGE_SIZE)
+#define QL_HASH_AGGREGATE_PARTITIONS    16
+
+// Cost model of the optimizer, in page reads
+// A tuple processed in memory costs a fraction of a page read, an index probe reads the
+// pages from the root to a leaf, and conditions without statistics get fixed selectivities
+#define QL_INDEX_PROBE_COST         2
+#define QL_TUPLE_CPU_COST           0.01
+#define QL_EQ_SELECTIVITY           0.1
+#define QL_RANGE_SELECTIVITY        (1.0 / 3)
+
+// Maximum number of relations joined in the order found by dynamic programming
+// (more relations are ordered greedily)
+#define QL_DP_JOIN_LIMIT            8
+
+// QL_AggregateMode
+// Part of an aggregation computed by a hash aggregate operator
+/*  1) QL_AGGREGATE_COMPLETE - Aggregate the tuples of the child
+    2) QL_AGGREGATE_PARTIAL - Aggregate the tuples of the child into partial aggregates
+       (AVG gives a sum and a count) that can be combined with the ones of other data nodes
+    3) QL_AGGREGATE_FINAL - Combine the partial aggregates returned by the child
+*/
+enum QL_AggregateMode {
+    QL_AGGREGATE_COMPLETE,
+    QL_AGGREGATE_PARTIAL,
+    QL_AGGREGATE_FINAL
+};
+
+// QL_CompiledCondition
+// Condition with its attributes resolved to offsets in a tuple layout
+/* Stores the following:
+    1) op - Comparison operator - CompOp
+    2) attrType - Type of the compared values - AttrType
+    3) lhsOffset, lhsLength - Offset and length of the LHS attribute - integers
+    4) rhsIsAttr - Flag whether the RHS is an attribute - integer
+    5) rhsOffset, rhsLength - Offset and length of the RHS attribute or value - integers
+    6) rhsValue - RHS constant value - char*
+*/
+struct QL_CompiledCondition {
+    CompOp op;
+    AttrType attrType;
+    int lhsOffset;
+    int lhsLength;
+    int rhsIsAttr;
+    int rhsOffset;
+    int rhsLength;
+    const char* rhsValue;
+};
+
+// QL_OpStatistics
+// Runtime statistics of an operator, collected for EXPLAIN ANALYZE
+/* Stores the following:
+    1) loops - Calls to Open() (an inner operator of a join is opened again for each rescan) - long
+    2) rows - Tuples returned by GetNext() - long
+    3) calls - Calls to GetNext() - long
+    4) nanoseconds - Wall time spent in Open(), GetNext() and Close(), including the
+       children operators - long long
+    5) pagesPinned, bufferMisses - Pages pinned and read from disk in these methods by the
+       thread running the operator, including the children operators - long
+*/
+struct QL_OpStatistics {
+    long loops;
+    long rows;
+    long calls;
+    long long nanoseconds;
+    long pagesPinned;
+    long bufferMisses;
+};
+
 // QL_Op
 // QL Operator abstract class
+/* Open(), GetNext() and Close() call the OpenOp(), GetNextOp() and CloseOp() methods of the
+   operator, and collect its runtime statistics when the query is run by EXPLAIN ANALYZE
+*/
 class QL_Op {
 public:
-    virtual RC Open() = 0;
-    virtual RC Close() = 0;
-    virtual RC GetNext(char* recordData) = 0;
+    QL_Op();
+    virtual ~QL_Op() {}
+
+    RC Open();
+    RC Close();
+    RC GetNext(char* recordData);
     virtual RC GetNext(RID &rid) { return QL_EOF; }
     virtual void Print(int indentationLevel) = 0;
 
     virtual void GetAttributeCount(int &attrCount) = 0;
     virtual void GetAttributeInfo(DataAttrInfo* attributes) = 0;
+
+    // Boolean whether the tuples are returned in ascending order of the attribute
+    virtual bool IsOrderedOn(const char* relName, const char* attrName) { return false; }
+    // Keep the order reported by IsOrderedOn when the operator is opened
+    virtual void KeepOrder() {}
+
+protected:
+    virtual RC OpenOp() = 0;
+    virtual RC CloseOp() = 0;
+    virtual RC GetNextOp(char* recordData) = 0;
+
+    // Print the runtime statistics after the operator in the query plan (EXPLAIN ANALYZE)
+    void PrintStatistics() const;
+
+private:
+    QL_OpStatistics statistics;
+    bool analyze;                   // Whether the statistics are collected
+
+    void StartMeasure(std::chrono::steady_clock::time_point &start, int &pagesPinned, int &bufferMisses) const;
+    void EndMeasure(const std::chrono::steady_clock::time_point &start, int pagesPinned, int bufferMisses);
 };
 
 
@@ -39,17 +170,26 @@ class QL_IndexScanOp : public QL_Op {
 public:
     QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
                    const char* relName, char* attrName, CompOp op, const Value* v);
+    QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                   const char* relName, char* attrName, CompOp lowerOp, const Value* lowerV,
+                   CompOp upperOp, const Value* upperV);
     ~QL_IndexScanOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     RC GetNext(RID &rid);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+    bool IsOrderedOn(const char* relName, const char* attrName);
+    void KeepOrder();
+    void FetchInPageOrder();
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
     IX_Manager* ixManager;
@@ -61,10 +201,20 @@ private:
     char attrName[MAXNAME+1];
     CompOp op;
     Value* v;
+    CompOp upperOp;
+    Value* upperV;
     int tupleLength;
     int attrCount;
     DataAttrInfo* attributes;
     int isOpen;
+    std::vector<RID> rids;              // RIDs collected from the index scan
+    unsigned int ridPosition;           // Position of the next RID to return
+    int pageOrder;                      // Flag whether to fetch the records in page order
+    int sortedFetch;                    // Flag whether the RIDs are collected and sorted by page
+    int keyOrder;                       // Flag whether the RIDs must stay in key order
+
+    RC CollectRIDs();
+    RC GetNextRID(RID &rid);
 };
 
 
@@ -77,15 +227,21 @@ public:
     QL_FileScanOp(SM_Manager* smManager, RM_Manager* rmManager, const char* relName, int attrCount, DataAttrInfo* attributes);
     ~QL_FileScanOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     RC GetNext(RID &rid);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+    // Page range scanned by an open operator (a morsel of a QL_ExchangeOp)
+    RC GetLastPageNum(PageNum &pageNum) const;
+    RC SetPageRange(PageNum startPage, PageNum endPage);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
     RM_Manager* rmManager;
@@ -99,6 +255,8 @@ private:
     int tupleLength;
     int attrCount;
     DataAttrInfo* attributes;
+    int* recordOffsets;                                 // Offset of each attribute in the records
+    int padded;                                         // Flag whether the records have padding
     int isOpen;
 };
 
@@ -110,20 +268,27 @@ public:
     QL_ProjectOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, int count, RelAttr relAttrs[]);
     ~QL_ProjectOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+    bool IsOrderedOn(const char* relName, const char* attrName);
+    void KeepOrder();
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
     std::shared_ptr<QL_Op> childOp;
     int relAttrCount;
     RelAttr* relAttrs;
     DataAttrInfo* attributes;
+    int* childOffsets;                  // Offset of each projected attribute in the child tuple
+    char* childData;                    // Child tuple
     int isOpen;
 };
 
@@ -134,18 +299,24 @@ public:
     QL_FilterOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, Condition filterCond);
     ~QL_FilterOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+    bool IsOrderedOn(const char* relName, const char* attrName);
+    void KeepOrder();
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
     std::shared_ptr<QL_Op> childOp;
     Condition filterCond;
+    QL_CompiledCondition compiledCond;  // Filter condition bound to the child tuple layout
     int attrCount;
     DataAttrInfo* attributes;
     int isOpen;
@@ -158,20 +329,24 @@ public:
     QL_CrossProductOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, std::shared_ptr<QL_Op> rightOp);
     ~QL_CrossProductOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
     std::shared_ptr<QL_Op> leftOp;
     std::shared_ptr<QL_Op> rightOp;
     int attrCount;
     DataAttrInfo* attributes;
+    int leftTupleLength;
+    int rightTupleLength;
     int firstTuple;
     char* leftData;
     char* rightData;
@@ -182,41 +357,530 @@ private:
 // Natural loop join operator class
 class QL_NLJoinOp : public QL_Op {
 public:
-    QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, std::shared_ptr<QL_Op> rightOp, Condition joinCond);
+    QL_NLJoinOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> leftOp,
+                std::shared_ptr<QL_Op> rightOp, Condition joinCond);
     ~QL_NLJoinOp();
 
-    RC Open();
-    RC Close();
-    RC GetNext(char* recordData);
     void Print(int indentationLevel);
 
     void GetAttributeCount(int &attrCount);
     void GetAttributeInfo(DataAttrInfo* attributes);
 
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
 private:
     SM_Manager* smManager;
+    RM_Manager* rmManager;
     std::shared_ptr<QL_Op> leftOp;
     std::shared_ptr<QL_Op> rightOp;
     Condition joinCond;
+    QL_CompiledCondition compiledCond;  // Join condition bound to the left and right tuples
+    bool lhsInLeft;                     // Whether the LHS attribute is in the left tuple
+    bool rhsInLeft;                     // Whether the RHS attribute is in the left tuple
     int attrCount;
     DataAttrInfo* attributes;
+    int leftTupleLength;
+    int rightTupleLength;
     int firstTuple;
-    char* leftData;
+    char* blockData;                    // Block of left tuples joined with each right tuple
+    int blockCapacity;                  // Number of left tuples in a full block
+    int blockCount;                     // Number of left tuples in the current block
+    int blockIndex;                     // Next left tuple of the block to join
+    bool leftEOF;                       // Whether the last block has been read
     char* rightData;
     int isOpen;
+
+    RC ReadBlock();
+};
+
+// QL_IndexNLJoinOp
+// Index nested loop join operator class
+// Probes the index on the join attribute of the inner relation with each outer tuple
+class QL_IndexNLJoinOp : public QL_Op {
+public:
+    QL_IndexNLJoinOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                     std::shared_ptr<QL_Op> leftOp, const char* innerRelName, Condition joinCond);
+    ~QL_IndexNLJoinOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    IX_Manager* ixManager;
+    RM_Manager* rmManager;
+    std::shared_ptr<QL_Op> leftOp;
+    IX_IndexHandle ixIH;
+    IX_IndexScan ixIS;
+    RM_FileHandle rmFH;
+    char innerRelName[MAXNAME+1];
+    char innerAttrName[MAXNAME+1];
+    Condition joinCond;
+    CompOp probeOp;
+    int innerIndexNo;
+    int outerOffset;
+    int outerLength;
+    int leftTupleLength;
+    int innerTupleLength;
+    int attrCount;
+    DataAttrInfo* attributes;
+    char* leftData;
+    char* probeValue;
+    int scanOpen;
+    int isOpen;
+    RC initRC;                          // Error getting the attributes in the constructor
+};
+
+// QL_HashSlot
+// Slot of the open addressing table of a hash join
+/* Stores the following:
+    1) hash - Hash of the key - unsigned integer
+    2) head - First build tuple with the key (-1 if the slot is empty) - integer
+*/
+struct QL_HashSlot {
+    unsigned int hash;
+    int head;
+};
+
+// QL_HashJoinOp
+// Hash join operator class
+// Builds an open addressing table on the smaller input and probes it with the other
+// (Grace hash join over temporary RM files if both inputs exceed the memory budget)
+class QL_HashJoinOp : public QL_Op {
+public:
+    QL_HashJoinOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> leftOp,
+                  std::shared_ptr<QL_Op> rightOp, Condition joinCond);
+    ~QL_HashJoinOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    RM_Manager* rmManager;
+    std::shared_ptr<QL_Op> leftOp;
+    std::shared_ptr<QL_Op> rightOp;
+    Condition joinCond;
+    int attrCount;
+    DataAttrInfo* attributes;
+    AttrType keyType;
+    int leftKeyOffset;
+    int leftKeyLength;
+    int rightKeyOffset;
+    int rightKeyLength;
+    int leftTupleLength;
+    int rightTupleLength;
+    int joinNumber;                                     // Number used in the partition file names
+    RC initRC;                                          // Error getting the attributes in the constructor
+
+    int buildIsLeft;                                    // Flag whether the left input is the build side
+    std::vector<char> buildTuples;                      // Tuples of the build side
+    std::vector<int> buildNext;                         // Next build tuple with the same key
+    std::vector<QL_HashSlot> slots;                     // Open addressing table on the build keys
+    std::vector<char> probeTuples;                      // Probe tuples read before the build side was known
+    unsigned int probePosition;                         // Position of the next buffered probe tuple
+    char* probeData;                                    // Current probe tuple
+    int matchPosition;                                  // Next build tuple matching the probe tuple
+
+    int spilled;                                        // Flag whether the inputs were partitioned
+    int partition;                                      // Partition being joined
+    RM_FileHandle leftPartitions[QL_HASH_JOIN_PARTITIONS];
+    RM_FileHandle rightPartitions[QL_HASH_JOIN_PARTITIONS];
+    int leftPartitionCount[QL_HASH_JOIN_PARTITIONS];
+    int rightPartitionCount[QL_HASH_JOIN_PARTITIONS];
+    RM_FileScan partitionScan;                          // Scan on the probe side of the partition
+    int partitionScanOpen;
+    int isOpen;
+
+    RC Partition(std::vector<char> &leftBuffer, std::vector<char> &rightBuffer,
+                 int leftDone, int rightDone);
+    RC OpenNextPartition();
+    RC GetNextProbeTuple();
+    void BuildHashTable();
+    int ProbeHashTable(const char* probeKey);
+    unsigned int HashKey(const char* key, int keyLength) const;
+    bool MatchKeys(const char* key1, int length1, const char* key2, int length2) const;
+    std::string PartitionFileName(bool left, int partition) const;
+};
+
+// QL_SortOp
+// External merge sort operator class
+// Generates sorted runs in temporary RM files with replacement selection and merges them
+// (sorts in memory if the input fits in the sortMemory budget)
+class QL_SortOp : public QL_Op {
+public:
+    QL_SortOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp,
+              int keyCount, const RelAttr keyAttrs[], const int keyDescending[] = NULL);
+    ~QL_SortOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+    bool IsOrderedOn(const char* relName, const char* attrName);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    RM_Manager* rmManager;
+    std::shared_ptr<QL_Op> childOp;
+    int keyCount;
+    RelAttr* keyAttrs;
+    AttrType* keyTypes;                                 // Bound type of each sort key
+    int* keyOffsets;                                    // Bound offset of each sort key
+    int* keyLengths;                                    // Bound length of each sort key
+    int* keyDescending;                                 // Flag whether each sort key is descending
+    int attrCount;
+    DataAttrInfo* attributes;
+    int tupleLength;
+    int sortNumber;                                     // Number used in the run file names
+    RC initRC;                                          // Error binding the sort keys in the constructor
+
+    std::vector<char> tuples;                           // Tuples held in memory
+    std::vector<int> runTags;                           // Run of each tuple held in memory
+    std::vector<int> heap;                              // Heap of tuple or run positions
+    std::vector<int> sortedTuples;                      // Sorted positions if sorted in memory
+    unsigned int position;                              // Next position in sortedTuples
+    char* inputData;                                    // Tuple read from the child
+
+    int inMemory;                                       // Flag whether the input was sorted in memory
+    int runCount;                                       // Number of runs created
+    std::vector<int> runs;                              // Runs left to merge
+    int mergeCount;                                     // Number of runs being merged
+    RM_FileHandle mergeFH[QL_SORT_MERGE_FANIN];
+    RM_FileScan mergeFS[QL_SORT_MERGE_FANIN];
+    std::vector<char> mergeTuples;                      // Current tuple of each run being merged
+    int isOpen;
+
+    RC GenerateRuns(int capacity);
+    RC OpenMerge(int count);
+    RC GetNextMerged(char* recordData);
+    RC CloseMerge();
+    RC GetNextFromRun(int i, bool &found);
+    int CompareTuples(const char* tuple1, const char* tuple2) const;
+    std::string RunFileName(int run) const;
+};
+
+// QL_HashAggregateOp
+// Hash aggregation operator class
+// Groups the child tuples in an open addressing table and computes COUNT, SUM, MIN, MAX and
+// AVG aggregates for each group (tuples of new groups past the memory budget are spilled into
+// temporary RM files that are aggregated in turn)
+class QL_HashAggregateOp : public QL_Op {
+public:
+    QL_HashAggregateOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp,
+                       int groupCount, const RelAttr groupAttrs[], int aggCount, const AggFun aggFuns[],
+                       const RelAttr aggAttrs[], QL_AggregateMode mode = QL_AGGREGATE_COMPLETE);
+    ~QL_HashAggregateOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    RM_Manager* rmManager;
+    std::shared_ptr<QL_Op> childOp;
+    QL_AggregateMode mode;
+    int groupCount;
+    RelAttr* groupAttrs;
+    int* groupOffsets;                                  // Bound offset of each group attribute
+    int groupLength;                                    // Length of the group attributes
+    int aggCount;
+    AggFun* aggFuns;
+    RelAttr* aggAttrs;
+    AttrType* inputTypes;                               // Bound type of each aggregated input
+    int* inputOffsets;                                  // Bound offset of each aggregated input
+    int* inputLengths;                                  // Bound length of each aggregated input
+    int* stateOffsets;                                  // Offset of each aggregate state in a group entry
+    int entryLength;                                    // Length of a group entry
+    int attrCount;
+    DataAttrInfo* attributes;
+    int tupleLength;
+    int inputLength;                                    // Length of a child tuple
+    int aggregateNumber;                                // Number used in the partition file names
+
+    std::vector<char> entries;                          // Group entries (group attributes and states)
+    std::vector<unsigned int> entryHashes;              // Hash of the group of each entry
+    std::vector<int> slots;                             // Open addressing table on the groups
+    int entryCount;                                     // Number of groups in the table
+    int position;                                       // Next group entry to return
+
+    int level;                                          // Number of times the input was partitioned
+    int fileCount;                                      // Number of partition files created
+    std::vector<std::pair<int, int> > partitions;       // Partition files left (file and level)
+    RM_FileHandle partitionFH;
+    RM_FileScan partitionFS;
+    int partitionScanOpen;
+    int isOpen;
+
+    RC Aggregate();
+    RC OpenNextPartition();
+    RC GetNextInput(char* inputData);
+    void UpdateEntry(char* entry, const char* inputData, bool first);
+    void GetResult(const char* entry, char* recordData);
+    unsigned int HashGroup(const char* groupData, int level) const;
+    bool MatchGroup(const char* groupData, const char* entry) const;
+    std::string PartitionFileName(int file) const;
+};
+
+// QL_TopNOp
+// Top-N operator class
+// Returns the first limit tuples of the child in the order of the sort keys, keeping only
+// them in memory in a bounded heap
+class QL_TopNOp : public QL_Op {
+public:
+    QL_TopNOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, int keyCount,
+              const RelAttr keyAttrs[], const int keyDescending[], int limit);
+    ~QL_TopNOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+    bool IsOrderedOn(const char* relName, const char* attrName);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    std::shared_ptr<QL_Op> childOp;
+    int keyCount;
+    RelAttr* keyAttrs;
+    AttrType* keyTypes;                                 // Bound type of each sort key
+    int* keyOffsets;                                    // Bound offset of each sort key
+    int* keyLengths;                                    // Bound length of each sort key
+    int* keyDescending;                                 // Flag whether each sort key is descending
+    int limit;
+    int attrCount;
+    DataAttrInfo* attributes;
+    int tupleLength;
+    RC initRC;                                          // Error binding the sort keys in the constructor
+
+    std::vector<char> tuples;                           // Tuples kept in the heap
+    std::vector<int> sequence;                          // Input position of each tuple kept
+    std::vector<int> heap;                              // Heap of tuple positions, largest on top
+    unsigned int position;                              // Next position in heap after sorting
+    int isOpen;
+
+    bool TupleBefore(int a, int b) const;
+    int CompareTuples(const char* tuple1, const char* tuple2) const;
+};
+
+// QL_LimitOp
+// Limit operator class
+// Returns at most limit tuples of the child and stops reading it after them
+class QL_LimitOp : public QL_Op {
+public:
+    QL_LimitOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, int limit);
+    ~QL_LimitOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+    bool IsOrderedOn(const char* relName, const char* attrName);
+    void KeepOrder();
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    std::shared_ptr<QL_Op> childOp;
+    int limit;
+    int tupleCount;                                     // Number of tuples returned
+    int isOpen;
+};
+
+// QL_MergeJoinOp
+// Merge join operator class
+// Joins two children ordered on their equality join attributes
+class QL_MergeJoinOp : public QL_Op {
+public:
+    QL_MergeJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, std::shared_ptr<QL_Op> rightOp, Condition joinCond);
+    ~QL_MergeJoinOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+    bool IsOrderedOn(const char* relName, const char* attrName);
+    void KeepOrder();
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    std::shared_ptr<QL_Op> leftOp;
+    std::shared_ptr<QL_Op> rightOp;
+    Condition joinCond;
+    const RelAttr* leftAttr;                            // Join attribute of the left child
+    const RelAttr* rightAttr;                           // Join attribute of the right child
+    int attrCount;
+    DataAttrInfo* attributes;
+    AttrType keyType;
+    int leftKeyOffset;
+    int leftKeyLength;
+    int rightKeyOffset;
+    int rightKeyLength;
+    int leftTupleLength;
+    int rightTupleLength;
+    RC initRC;                                          // Error getting the attributes in the constructor
+    char* leftData;                                     // Current left tuple
+    char* rightData;                                    // Next right tuple after the group
+    int rightValid;                                     // Flag whether rightData holds a tuple
+    std::vector<char> rightGroup;                       // Right tuples with the key of the left tuple
+    int groupCount;
+    int groupPosition;
+    int isOpen;
+
+    RC GetNextRight();
+};
+
+// QL_ExchangeWorker
+// Scan pipeline of an exchange operator run by one worker thread
+struct QL_ExchangeWorker {
+    std::shared_ptr<QL_FileScanOp> scanOp;              // Scan restarted on each morsel
+    std::shared_ptr<QL_Op> rootOp;                      // FilterOps and ProjectOp over the scan
+    std::deque<std::pair<PageNum, PageNum> > morsels;   // Page ranges left to scan
+    std::thread thread;
+};
+
+// QL_ExchangeOp
+// Exchange operator class
+// Scans a relation with copies of a scan pipeline on worker threads, each taking page range
+// morsels from its own queue and stealing from the others when it runs out, and merges the
+// tuples of the workers
+class QL_ExchangeOp : public QL_Op {
+public:
+    QL_ExchangeOp(SM_Manager* smManager, RM_Manager* rmManager, const char* relName,
+                  int scanAttrCount, DataAttrInfo* scanAttributes, int nConditions, const Condition conditions[],
+                  int nProjectAttrs, const RelAttr projectAttrs[], int workerCount);
+    ~QL_ExchangeOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    SM_Manager* smManager;
+    RM_Manager* rmManager;
+    int workerCount;
+    QL_ExchangeWorker* workers;
+    int attrCount;
+    DataAttrInfo* attributes;
+    int tupleLength;
+
+    std::mutex morselMutex;                             // Lock of the morsel queues
+    std::mutex batchMutex;                              // Lock of the batch queue and worker state
+    std::condition_variable batchReady;                 // Signaled when a batch is queued or a worker ends
+    std::condition_variable batchTaken;                 // Signaled when a batch is dequeued or on Close
+    std::deque<std::vector<char> > batches;             // Full batches of the workers
+    int runningWorkers;
+    int cancelled;                                      // Flag whether Close stops the workers
+    RC workerRC;                                        // First error of a worker
+    int exhausted;                                      // Flag whether the error was returned
+    std::vector<char> currentBatch;                     // Batch being returned
+    unsigned int batchPosition;                         // Offset of the next tuple in the batch
+    int isOpen;
+
+    void RunWorker(int worker);
+    bool GetNextMorsel(int worker, PageNum &startPage, PageNum &endPage);
+    bool PushBatch(std::vector<char> &batch);
 };
 
 // EX
+// QL_GatherDataOp
+// Operator returning the tuples streamed by the worker processes of the data nodes
+// (a single pass: the workers send the tuples once, so the operator cannot be reopened)
+class QL_GatherDataOp : public QL_Op {
+public:
+    QL_GatherDataOp(const char* relName, const std::vector<EX_Worker> &workers,
+                    int attrCount, const DataAttrInfo* attributes);
+    ~QL_GatherDataOp();
+
+    void Print(int indentationLevel);
+
+    void GetAttributeCount(int &attrCount);
+    void GetAttributeInfo(DataAttrInfo* attributes);
+
+protected:
+    RC OpenOp();
+    RC CloseOp();
+    RC GetNextOp(char* recordData);
+
+private:
+    char relName[MAXNAME+1];
+    EX_WorkerStream* stream;
+    std::vector<int> nodes;                             // Data nodes of the workers
+    int attrCount;
+    DataAttrInfo* attributes;
+    int isOpen;
+};
+
 // QL_ShuffleDataOp
 // Operator for shuffling data across nodes
+// (to the master node, or repartitioned to the data nodes by the value of an attribute)
 class QL_ShuffleDataOp {
 public:
     QL_ShuffleDataOp(RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp, int fromNode, int toNode);
+    QL_ShuffleDataOp(RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp, int fromNode, const RelAttr &partitionAttr,
+                     const EX_RoutingTable &routingTable, const std::vector<int> &nodeSockets);
+    QL_ShuffleDataOp(RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp, int fromNode, const std::vector<int> &toNodes,
+                     const std::vector<int> &nodeSockets);
     ~QL_ShuffleDataOp();
 
     RC Open();
     RC Close();
-    RC GetData(RM_FileHandle &rmFH);
+    RC SendData(int socket);                            // Send the tuples to the master node
+    int GetTupleLength() const;
+    const std::vector<int>& GetNodeSockets() const;
     void Print(int indentationLevel);
 
 private:
@@ -227,12 +891,125 @@ private:
     int fromNode;
     int toNode;
     int isOpen;
+
+    // Repartitioning
+    char partitionRelName[MAXNAME+1];
+    char partitionAttrName[MAXNAME+1];
+    DataAttrInfo partitionAttribute;                    // Partition attribute in the tuples of the child
+    EX_RoutingTable routingTable;                       // Data node of each partition
+    std::vector<int> toNodes;                           // Data nodes of the sockets
+    std::vector<int> nodeSockets;                       // Socket to the worker of each data node
+    bool broadcast;                                     // Whether every tuple is sent to every data node
+
+    RC SendPartitions();                                // Send the tuples to the data nodes of their partitions
+};
+
+// QL_AccessPath
+// Way the optimizer reads a relation
+struct QL_AccessPath {
+    int indexCondition;                                 // Condition evaluated by an index scan (-1 for a file scan)
+    int rangeCondition;                                 // Condition bounding the index scan from the other side (-1 if none)
+    double cost;                                        // Estimated page reads
+    double tupleCount;                                  // Estimated tuples satisfying the conditions on the relation
+    double pages;                                       // Estimated pages of the relation
+    double indexMatches;                                // Estimated entries read by the index scan
+};
+
+// QL_JoinPlan
+// Left-deep join order of some of the relations
+struct QL_JoinPlan {
+    double cost;                                        // Estimated page reads
+    double tupleCount;                                  // Estimated tuples of the join
+    int tupleLength;                                    // Length of the joined tuples
+    std::vector<int> order;                             // Relations in the order they are joined
+    std::vector<int> indexJoins;                        // Condition probing an index of each relation (-1 if none)
+};
+
+// QL_Optimizer
+// Cost based optimizer class
+// Chooses the access path of each relation and the left-deep join order and join algorithms
+// from the tuple and distinct value counts in the catalog, and forms the operator tree
+// (dynamic programming over the subsets of relations, greedy past QL_DP_JOIN_LIMIT relations)
+class QL_Optimizer {
+public:
+    QL_Optimizer(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                 int nRelations, const char* const relations[], SM_RelcatRecord* const rcRecords[],
+                 DataAttrInfo* const attributes[], int nConditions, const Condition conditions[],
+                 int nOutputAttrs, const RelAttr outputAttrs[],
+                 const int scanAttrCounts[], DataAttrInfo* const scanAttributes[]);
+    ~QL_Optimizer();
+
+    RC Optimize(std::shared_ptr<QL_Op> &rootOp);        // Form the cheapest operator tree
+
+private:
+    SM_Manager* smManager;
+    IX_Manager* ixManager;
+    RM_Manager* rmManager;
+    int nRelations;
+    const char* const* relations;
+    SM_RelcatRecord* const* rcRecords;
+    DataAttrInfo* const* attributes;
+    int nConditions;
+    const Condition* conditions;
+    int nOutputAttrs;                                   // Attributes needed above the joins
+    const RelAttr* outputAttrs;
+    const int* scanAttrCounts;                          // Layout of the fetched temporary file of each
+    DataAttrInfo* const* scanAttributes;                // relation (NULL for the catalog layout)
+
+    std::vector<int> lhsRelations;                      // Relation of the lhs attribute of each condition
+    std::vector<int> rhsRelations;                      // Relation of the rhs attribute of each condition (-1 for a value)
+    std::vector<double> selectivities;                  // Estimated selectivity of each condition
+    std::vector<QL_AccessPath> accessPaths;             // Access path of each relation
+    std::vector<std::vector<SM_StatcatRecord> > statistics; // statcat records of each analyzed relation
+    QL_JoinPlan joinPlan;                               // Chosen join order
+
+    int FindRelation(const char* relName) const;
+    RC EstimateSelectivity(int condition);
+    const SM_StatcatRecord* GetStatistics(int relation, const char* attrName) const;
+    void ChooseAccessPath(int relation);
+    bool JoinRelation(const QL_JoinPlan &outerPlan, int relation, bool crossProduct, QL_JoinPlan &plan);
+    void OrderJoinsDP();
+    void OrderJoinsGreedy();
+    bool IsJoinCondition(int condition, int relation, const std::vector<bool> &joined) const;
+    bool IsConditionCovered(int condition, const std::vector<bool> &joined) const;
+    void GetNeededAttrs(const std::vector<bool> &applied, std::vector<RelAttr> &neededAttrs) const;
+    std::shared_ptr<QL_Op> ProjectNeeded(std::shared_ptr<QL_Op> op, const std::vector<bool> &applied) const;
 };
 
 // Helper methods
 void PrintOperator(CompOp op);
 void PrintValue(const Value* v);
 RC GetAttrInfoFromArray(char* attributes, int attrCount, const char* relName, const char* attrName, char* attributeData);
+RC CompileCondition(const Condition &cond, DataAttrInfo* attributes, int attrCount, QL_CompiledCondition &compiledCond);
+bool EvaluateCondition(const QL_CompiledCondition &compiledCond, const char* lhsData, const char* rhsData);
+int CompareAttributeValues(AttrType attrType, const char* lhsValue, int lhsLength, const char* rhsValue, int rhsLength);
+RC ResolveAttribute(SM_Manager* smManager, int nRelations, const char* const relations[],
+                    RelAttr &relAttr, SM_AttrcatRecord* attributeData);
+int FindAttribute(const RelAttr relAttrs[], int nRelAttrs, const RelAttr &relAttr);
+int FindRelation(int nRelations, const char* const relations[], const char* relName);
+bool IndexSupportsCondition(const DataAttrInfo &attributeData, CompOp op);
+int FindRangeCondition(const Condition conditions[], int nConditions, int indexCondition);
+std::shared_ptr<QL_Op> CreateIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                         const char* relName, char* attrName, const Condition conditions[],
+                                         int indexCondition, int rangeCondition, double matches);
+std::shared_ptr<QL_Op> ChooseIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                         const char* relName, int attrCount, const DataAttrInfo attributes[],
+                                         int nConditions, const Condition conditions[], const char* skipAttrName,
+                                         int &indexCondition, int &rangeCondition);
+bool GetIndexProbe(const Condition &joinCond, const char* innerRelName, const RelAttr* &innerAttr,
+                   const RelAttr* &outerAttr, CompOp &probeOp);
+std::shared_ptr<QL_Op> CreateIndexNLJoinOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                           std::shared_ptr<QL_Op> outerOp, const char* innerRelName,
+                                           int innerAttrCount, DataAttrInfo* innerAttributes,
+                                           const Condition &joinCond);
+int GetJoinBlockPages(RM_Manager* rmManager);
+std::shared_ptr<QL_Op> CreateJoinOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> leftOp,
+                                    std::shared_ptr<QL_Op> rightOp, const Condition &joinCond);
+void GetAggregateAttrName(AggFun aggFun, const char* attrName, char* aggAttrName);
+std::shared_ptr<QL_Op> CreateOrderOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp,
+                                     int nOrderAttrs, const OrderAttr orderAttrs[], int limit);
+std::shared_ptr<QL_Op> CreateProjectOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp,
+                                       int nNeededAttrs, const RelAttr neededAttrs[]);
 
 template <typename T>
 bool matchRecord(T lhsValue, T rhsValue, CompOp op);
@@ -48,15 +48,19 @@ QL_Manager::~QL_Manager() {
     1) Check whether the database is open
     2) Obtain attribute information for the relations and check
     3) Validate the selection expressions
-    4) Validate the conditions
-    5) Form the physical operator tree
-    6) Get the tuples from the root node
-    7) Print the physical query plan
+    4) Validate the group by and order by attributes and the aggregates
+    5) Validate the conditions
+    6) Form the physical operator tree
+    7) Get the tuples from the root node
+    8) Print the physical query plan
 
 */
-RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
+RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[], const AggFun selAggFuns[],
                       int nRelations, const char * const relations[],
-                      int nConditions, const Condition conditions[]) {
+                      int nConditions, const Condition conditions[],
+                      int nGroupAttrs, const RelAttr groupAttrs[],
+                      int nOrderAttrs, const OrderAttr orderAttrs[],
+                      int limit) {
     // Check whether database is open
     if (!smManager->getOpenFlag()) {
         return QL_DATABASE_CLOSED;
@@ -96,8 +100,16 @@ RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
     }
 
     // Validate the select attributes
+    // (* selects all the attributes, unless it is counted)
     RelAttr* changedSelAttrs;
-    if (nSelAttrs == 1 && strcmp(selAttrs[0].attrName, "*") == 0) {
+    bool selectAll = nSelAttrs == 1 && strcmp(selAttrs[0].attrName, "*") == 0 && selAggFuns[0] == NO_F;
+    bool aggregate = nGroupAttrs > 0;
+    for (int i=0; i<nSelAttrs; i++) {
+        if (selAggFuns[i] != NO_F) {
+            aggregate = true;
+        }
+    }
+    if (selectAll) {
         // In case of *, select all attributes
         nSelAttrs = 0;
         for (int i=0; i<nRelations; i++) {
@@ -117,6 +129,11 @@ RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
         changedSelAttrs = (RelAttr*) selAttrs;
         SM_AttrcatRecord* attributeData = new SM_AttrcatRecord;
         for (int i=0; i<nSelAttrs; i++) {
+            // COUNT(*) does not refer to an attribute
+            if (strcmp(changedSelAttrs[i].attrName, "*") == 0) {
+                continue;
+            }
+
             // If relName is not specified, check if unique
             if (changedSelAttrs[i].relName == NULL) {
                 // Check all the relations in the relations array
@@ -161,6 +178,82 @@ RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
         delete attributeData;
     }
 
+    // Validate the group by attributes
+    RelAttr changedGroupAttrs[nGroupAttrs];
+    SM_AttrcatRecord* attributeData = new SM_AttrcatRecord;
+    rc = OK_RC;
+    for (int i=0; i<nGroupAttrs && !rc; i++) {
+        changedGroupAttrs[i] = groupAttrs[i];
+        rc = ResolveAttribute(smManager, nRelations, relations, changedGroupAttrs[i], attributeData);
+    }
+
+    // Validate the order by attributes
+    // (an aggregation can only be ordered on the group by attributes)
+    OrderAttr changedOrderAttrs[nOrderAttrs];
+    for (int i=0; i<nOrderAttrs && !rc; i++) {
+        changedOrderAttrs[i] = orderAttrs[i];
+        rc = ResolveAttribute(smManager, nRelations, relations, changedOrderAttrs[i].attr, attributeData);
+        if (!rc && aggregate && FindAttribute(changedGroupAttrs, nGroupAttrs, changedOrderAttrs[i].attr) == -1) {
+            rc = QL_INVALID_AGGREGATE;
+        }
+    }
+
+    // Validate the aggregates
+    /* Checks:
+        1) * is only counted
+        2) SUM and AVG are on numbers
+        3) Other selected attributes are group by attributes
+    */
+    if (!rc && aggregate && selectAll) {
+        rc = QL_INVALID_AGGREGATE;
+    }
+    for (int i=0; i<nSelAttrs && aggregate && !rc; i++) {
+        if (strcmp(changedSelAttrs[i].attrName, "*") == 0) {
+            if (selAggFuns[i] != COUNT_F) {
+                rc = QL_INVALID_AGGREGATE;
+            }
+        }
+        else if (selAggFuns[i] == SUM_F || selAggFuns[i] == AVG_F) {
+            if (!(rc = smManager->GetAttrInfo(changedSelAttrs[i].relName, changedSelAttrs[i].attrName, attributeData))) {
+                if (attributeData->attrType == STRING) {
+                    rc = QL_INVALID_AGGREGATE;
+                }
+            }
+        }
+        else if (selAggFuns[i] == NO_F && FindAttribute(changedGroupAttrs, nGroupAttrs, changedSelAttrs[i]) == -1) {
+            rc = QL_INVALID_AGGREGATE;
+        }
+    }
+    delete attributeData;
+
+    if (rc) {
+        for (int j=0; j<nRelations; j++) {
+            delete rcRecords[j];
+            delete[] attributes[j];
+        }
+        if (selectAll) {
+            delete[] changedSelAttrs;
+        }
+        return rc;
+    }
+
+    // Get the aggregates and the attributes projected from the aggregation
+    int nAggs = 0;
+    AggFun aggFuns[nSelAttrs];
+    RelAttr aggAttrs[nSelAttrs];
+    RelAttr projectAttrs[nSelAttrs];
+    char aggAttrNames[nSelAttrs][MAXNAME+1];
+    for (int i=0; i<nSelAttrs; i++) {
+        projectAttrs[i] = changedSelAttrs[i];
+        if (!selectAll && selAggFuns[i] != NO_F) {
+            aggFuns[nAggs] = selAggFuns[i];
+            aggAttrs[nAggs] = changedSelAttrs[i];
+            GetAggregateAttrName(selAggFuns[i], changedSelAttrs[i].attrName, aggAttrNames[i]);
+            projectAttrs[i].attrName = aggAttrNames[i];
+            nAggs++;
+        }
+    }
+
     // Validate the conditions
     Condition changedConditions[nConditions];
     for (int i=0; i<nConditions; i++) {
@@ -174,513 +267,748 @@ RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
         return rc;
     }
 
-    // EX - Get the data for the distributed relations
-    // Find if an efficient join in the data node is possible
-    int numberNodes = smManager->getNumberNodes();
-    EX_CommLayer commLayer(rmManager, ixManager);
-    bool joinPossible = false;
-    int joinCondition = -1;
-    int relationIndex = -1;
-    for (int i=0; i<nRelations-1; i++) {
-        if (rcRecords[i]->distributed && rcRecords[i+1]->distributed) {
-            if (strcmp(rcRecords[i]->attrName, rcRecords[i+1]->attrName) == 0) {
-                for (int j=0; j<nConditions; j++) {
-                    Condition cond = changedConditions[j];
-                    if (cond.bRhsIsAttr) {
-                        if (strcmp((cond.lhsAttr).relName, relations[i]) == 0 && strcmp((cond.lhsAttr).attrName, rcRecords[i]->attrName) == 0) {
-                            if (strcmp((cond.rhsAttr).relName, relations[i+1]) == 0 && strcmp((cond.rhsAttr).attrName, rcRecords[i+1]->attrName) == 0) {
-                                joinPossible = true;
-                                joinCondition = j;
-                                relationIndex = i;
-                                break;
-                            }
-                        }
-                        else if (strcmp((cond.lhsAttr).relName, relations[i+1]) == 0 && strcmp((cond.lhsAttr).attrName, rcRecords[i+1]->attrName) == 0) {
-                            if (strcmp((cond.rhsAttr).relName, relations[i]) == 0 && strcmp((cond.rhsAttr).attrName, rcRecords[i]->attrName) == 0) {
-                                joinPossible = true;
-                                joinCondition = j;
-                                relationIndex = i;
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
+    // Get the attributes needed above the scans
+    // (the output attributes first, then the attributes of the conditions)
+    int nOutputAttrs = 0;
+    RelAttr neededAttrs[nSelAttrs + nGroupAttrs + nOrderAttrs + 2*nConditions];
+    for (int i=0; i<nSelAttrs; i++) {
+        if (strcmp(changedSelAttrs[i].attrName, "*") != 0) {
+            neededAttrs[nOutputAttrs++] = changedSelAttrs[i];
         }
     }
-
-    // If a join is possible
-    if (joinPossible) {
-        // Get the attribute information about the join
-        int attrCount1 = rcRecords[relationIndex]->attrCount;
-        int attrCount2 = rcRecords[relationIndex+1]->attrCount;
-
-        int joinAttrCount = attrCount1 + attrCount2;
-        DataAttrInfo* joinAttrributes = new DataAttrInfo[joinAttrCount];
-        int joinTupleLength = 0;
-        for (int i=0; i<attrCount1; i++) {
-            joinAttrributes[i] = attributes[relationIndex][i];
-            joinTupleLength += joinAttrributes[i].attrLength;
-        }
-        for (int i=0; i<attrCount2; i++) {
-            joinAttrributes[attrCount1+i] = attributes[relationIndex+1][i];
-            joinAttrributes[attrCount1+i].offset = joinTupleLength;
-            joinTupleLength += joinAttrributes[attrCount1+i].attrLength;
+    for (int i=0; i<nGroupAttrs; i++) {
+        neededAttrs[nOutputAttrs++] = changedGroupAttrs[i];
+    }
+    for (int i=0; i<nOrderAttrs; i++) {
+        neededAttrs[nOutputAttrs++] = changedOrderAttrs[i].attr;
+    }
+    int nNeededAttrs = nOutputAttrs;
+    for (int i=0; i<nConditions; i++) {
+        neededAttrs[nNeededAttrs++] = changedConditions[i].lhsAttr;
+        if (changedConditions[i].bRhsIsAttr) {
+            neededAttrs[nNeededAttrs++] = changedConditions[i].rhsAttr;
         }
+    }
 
-        // Create a file to get the results
-        string joinFileName(rcRecords[relationIndex]->relName);
-        joinFileName += "_";
-        joinFileName += rcRecords[relationIndex+1]->relName;
-        if ((rc = rmManager->CreateFile(joinFileName.c_str(), joinTupleLength))) {
+    // EX - Join the co-partitioned relations in the data nodes
+    /* Relations partitioned alike (the same partitioning scheme and ranges) and joined by
+       equalities of their partition attributes keep all their matching tuples in the same node,
+       so the largest group of such relations, in any order in the from clause, is joined in
+       every data node with all the conditions on the group. The result of the join takes the
+       place of the group among the relations of the master node, streamed if it is the only
+       one, else in a temporary file named after the relations of the group.
+       Without such a group, two distributed relations joined by an equality are joined in the
+       data nodes by repartitioning: the data nodes send each other the tuples by their join
+       key, so that the matching tuples meet in the same node.
+       The replicated relations joined with the group, with a copy in every data node, join it
+       in place, and so do the relations of the master node small enough to be broadcast to
+       every data node.
+    */
+    int numberNodes = smManager->getNumberNodes();
+    EX_CommLayer &commLayer = *smManager->GetCommLayer();
+    int nQueryRelations = nRelations;
+    const char* const* queryRelations = relations;
+    int nQueryConditions = nConditions;
+    int groups[nRelations];
+    bool partitioned[nRelations];
+    int exchanges[nRelations];
+    for (int i=0; i<nRelations; i++) {
+        groups[i] = i;
+        partitioned[i] = rcRecords[i]->distributed && rcRecords[i]->distributed != EX_REPLICATED;
+        exchanges[i] = EX_IN_PLACE;
+    }
+    for (int i=0; i<nConditions; i++) {
+        const Condition &cond = changedConditions[i];
+        if (!cond.bRhsIsAttr || cond.op != EQ_OP) {
+            continue;
+        }
+        int lhs = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+        int rhs = FindRelation(nRelations, relations, (cond.rhsAttr).relName);
+        if (lhs == -1 || rhs == -1 || groups[lhs] == groups[rhs] || !partitioned[lhs] || !partitioned[rhs] ||
+            strcmp((cond.lhsAttr).attrName, rcRecords[lhs]->attrName) != 0 ||
+            strcmp((cond.rhsAttr).attrName, rcRecords[rhs]->attrName) != 0) {
+            continue;
+        }
+        DataAttrInfo attributeData;
+        if ((rc = GetAttrInfoFromArray((char*) attributes[lhs], attrCount[lhs], relations[lhs], (cond.lhsAttr).attrName, (char*) &attributeData))) {
             return rc;
         }
-        RM_FileHandle joinRMFH;
-        if ((rc = rmManager->OpenFile(joinFileName.c_str(), joinRMFH))) {
+        bool coPartitioned = false;
+        if ((rc = CheckCoPartitioned(smManager, relations[lhs], rcRecords[lhs]->attrName, relations[rhs], rcRecords[rhs]->attrName,
+                                      attributeData.attrType, coPartitioned))) {
             return rc;
         }
-
-        // Check whether the partition attribute is used in a condition
-        bool condExists = false;
-        int conditionNumber = -1;
-        for (int j=0; j<nConditions; j++) {
-            Condition currentCondition = changedConditions[j];
-            char* lhsRelName = (currentCondition.lhsAttr).relName;
-            char* lhsAttrName = (currentCondition.lhsAttr).attrName;
-            int rhsIsAttr = currentCondition.bRhsIsAttr;
-            if (!rhsIsAttr) {
-                if (strcmp(lhsRelName, rcRecords[relationIndex]->relName) == 0 && strcmp(lhsAttrName, rcRecords[relationIndex]->attrName) == 0) {
-                    condExists = true;
-                    conditionNumber = j;
-                    break;
+        if (coPartitioned) {
+            int mergedGroup = groups[rhs];
+            for (int j=0; j<nRelations; j++) {
+                if (groups[j] == mergedGroup) {
+                    groups[j] = groups[lhs];
                 }
             }
         }
+    }
 
-        // If condition exists, get the data node only from the required data nodes
-        if (condExists) {
-            for (int j=1; j<=numberNodes; j++) {
-                bool valid = false;
-                if ((rc = CheckDataNodeForCondition(rmManager, rcRecords[relationIndex]->relName, rcRecords[relationIndex]->attrName, changedConditions[conditionNumber], j, valid))) {
-                    return rc;
-                }
-                if (valid) {
-                    if ((rc = commLayer.JoinInDataNode(rcRecords[relationIndex]->relName, rcRecords[relationIndex+1]->relName, &changedConditions[joinCondition], j, joinRMFH, true, &changedConditions[conditionNumber], false, NULL))) {
-                        return rc;
-                    }
-                }
+    // Find the largest group
+    int joinGroup = -1;
+    int joinGroupSize = 1;
+    for (int i=0; i<nRelations; i++) {
+        int groupSize = 0;
+        for (int j=0; j<nRelations; j++) {
+            if (groups[j] == groups[i]) {
+                groupSize++;
             }
+        }
+        if (groupSize > joinGroupSize) {
+            joinGroup = groups[i];
+            joinGroupSize = groupSize;
+        }
+    }
 
-            // Remove the used condition
-            RemoveCondition(changedConditions, nConditions, conditionNumber);
+    // Else find two distributed relations joined by an equality to repartition
+    Condition repartitionCond;
+    bool repartition = false;
+    for (int i=0; i<nConditions && joinGroup == -1; i++) {
+        const Condition &cond = changedConditions[i];
+        if (!cond.bRhsIsAttr || cond.op != EQ_OP) {
+            continue;
+        }
+        int lhs = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+        int rhs = FindRelation(nRelations, relations, (cond.rhsAttr).relName);
+        if (lhs != rhs && partitioned[lhs] && partitioned[rhs]) {
+            repartitionCond = cond;
+            repartition = true;
+            groups[rhs] = groups[lhs];
+            joinGroup = groups[lhs];
+            joinGroupSize = 2;
+            exchanges[lhs] = EX_REPARTITIONED;
+            exchanges[rhs] = EX_REPARTITIONED;
         }
+    }
 
-        // Else get data from all nodes
-        else {
-            for (int j=1; j<=numberNodes; j++) {
-                if ((rc = commLayer.JoinInDataNode(rcRecords[relationIndex]->relName, rcRecords[relationIndex+1]->relName, &changedConditions[joinCondition], j, joinRMFH, false, NULL, false, NULL))) {
-                    return rc;
+    // Else start from a distributed relation joined with a replicated relation or a small
+    // relation of the master node, or from two replicated relations joined (in one data node)
+    double relationSizes[nRelations];
+    for (int i=0; i<nRelations; i++) {
+        relationSizes[i] = (double) rcRecords[i]->tupleCount * rcRecords[i]->tupleLength;
+    }
+    bool groupPartitioned = joinGroup != -1;
+    for (int pass=0; pass<2 && joinGroup == -1; pass++) {
+        for (int i=0; i<nConditions && joinGroup == -1; i++) {
+            const Condition &cond = changedConditions[i];
+            if (!cond.bRhsIsAttr) {
+                continue;
+            }
+            int lhs = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+            int rhs = FindRelation(nRelations, relations, (cond.rhsAttr).relName);
+            for (int side=0; side<2 && joinGroup == -1 && lhs != rhs; side++) {
+                int first = side == 0 ? lhs : rhs;
+                int second = side == 0 ? rhs : lhs;
+                bool replicated = rcRecords[second]->distributed == EX_REPLICATED;
+                bool small = !rcRecords[second]->distributed && numberNodes * relationSizes[second] <= relationSizes[first];
+                if ((pass == 0 && partitioned[first] && (replicated || small)) ||
+                    (pass == 1 && rcRecords[first]->distributed == EX_REPLICATED && replicated)) {
+                    joinGroup = groups[first];
+                    groupPartitioned = pass == 0;
                 }
             }
         }
+    }
 
-        // Close the file
-        if ((rc = rmManager->CloseFile(joinRMFH))) {
-            return rc;
+    // Add the replicated relations joined with the group, and the relations of the master
+    // node joined with it if sending them to every data node is less data than the
+    // distributed relations of the group
+    double groupSize = 0;
+    for (int i=0; i<nRelations; i++) {
+        if (joinGroup != -1 && groups[i] == joinGroup && partitioned[i]) {
+            groupSize += relationSizes[i];
+        }
+    }
+    bool added = joinGroup != -1;
+    while (added) {
+        added = false;
+        for (int i=0; i<nConditions; i++) {
+            const Condition &cond = changedConditions[i];
+            if (!cond.bRhsIsAttr) {
+                continue;
+            }
+            int lhs = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+            int rhs = FindRelation(nRelations, relations, (cond.rhsAttr).relName);
+            if ((groups[lhs] == joinGroup) == (groups[rhs] == joinGroup)) {
+                continue;
+            }
+            int relation = groups[lhs] == joinGroup ? rhs : lhs;
+            if (rcRecords[relation]->distributed == EX_REPLICATED) {
+                exchanges[relation] = EX_IN_PLACE;
+            }
+            else if (!rcRecords[relation]->distributed && groupPartitioned && numberNodes * relationSizes[relation] <= groupSize) {
+                exchanges[relation] = EX_BROADCAST;
+            }
+            else {
+                continue;
+            }
+            groups[relation] = joinGroup;
+            joinGroupSize++;
+            added = true;
         }
+    }
+    if (joinGroupSize == 1) {
+        joinGroup = -1;
+    }
 
-        RemoveCondition(changedConditions, nConditions, joinCondition);
+    bool exchange = false;
+    for (int i=0; i<nRelations; i++) {
+        if (joinGroup != -1 && groups[i] == joinGroup && exchanges[i] != EX_IN_PLACE) {
+            exchange = true;
+        }
+    }
+    int joinedRelation = -1;
+    bool streamJoin = false;
+    vector<EX_Worker> streamWorkers;
+    const char* planRelations[nRelations];
+    vector<SM_RelcatRecord*> groupRecords;
+    vector<DataAttrInfo*> groupAttributes;
+    int joinAttrCount = 0;
+    DataAttrInfo* joinAttributes = NULL;
+    if (joinGroup != -1) {
+        // Get the relations of the group and the conditions on them, and the name of the join
+        vector<const char*> groupRelations;
+        string joinName;
+        for (int i=0; i<nRelations; i++) {
+            if (groups[i] == joinGroup) {
+                groupRelations.push_back(relations[i]);
+                joinName += (joinName.empty() ? "" : "_") + string(relations[i]);
+            }
+        }
+        joinName = joinName.substr(0, MAXNAME);
+        vector<Condition> groupConditions;
+        for (int i=0; i<nConditions; ) {
+            const Condition &cond = changedConditions[i];
+            int lhs = FindRelation(nRelations, relations, (cond.lhsAttr).relName);
+            int rhs = cond.bRhsIsAttr ? FindRelation(nRelations, relations, (cond.rhsAttr).relName) : lhs;
+            if (groups[lhs] == joinGroup && groups[rhs] == joinGroup) {
+                groupConditions.push_back(cond);
+                RemoveCondition(changedConditions, nConditions, i);
+            }
+            else {
+                i++;
+            }
+        }
 
-        // Form the physical operator tree (physical query plan)
-        shared_ptr<QL_Op> lastOp;
+        // Get the attributes of the group needed above the join
+        // (the first attribute of the first relation if none, to count the tuples)
+        vector<RelAttr> joinAttrs;
+        for (int i=0; i<nOutputAttrs + 2*nConditions; i++) {
+            RelAttr relAttr;
+            if (i < nOutputAttrs) {
+                relAttr = neededAttrs[i];
+            }
+            else if ((i - nOutputAttrs) % 2 == 0) {
+                relAttr = changedConditions[(i - nOutputAttrs) / 2].lhsAttr;
+            }
+            else if (changedConditions[(i - nOutputAttrs) / 2].bRhsIsAttr) {
+                relAttr = changedConditions[(i - nOutputAttrs) / 2].rhsAttr;
+            }
+            else {
+                continue;
+            }
+            int relation = FindRelation(nRelations, relations, relAttr.relName);
+            if (groups[relation] == joinGroup && FindAttribute(joinAttrs.data(), joinAttrs.size(), relAttr) == -1) {
+                joinAttrs.push_back(relAttr);
+            }
+        }
+        if (joinAttrs.empty()) {
+            int first = FindRelation(nRelations, relations, groupRelations[0]);
+            RelAttr relAttr;
+            relAttr.relName = (char*) relations[first];
+            relAttr.attrName = attributes[first][0].attrName;
+            joinAttrs.push_back(relAttr);
+        }
 
-        // Scan ops - FileScans on the relations
-        shared_ptr<QL_Op> scanOps[nRelations-1];
-        for (int i=0; i<nRelations; i++) {
-            if (i < relationIndex) {
-                bool indexScan = false;
-                DataAttrInfo* attributeData = new DataAttrInfo;
-                for (int j=0; j<nConditions; j++) {
-                    Condition cond = changedConditions[j];
-                    if (strcmp((cond.lhsAttr).relName, relations[i]) == 0 && !cond.bRhsIsAttr) {
-                        if ((rc = GetAttrInfoFromArray((char*) attributes[i], rcRecords[i]->attrCount, rcRecords[i]->relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
-                            return rc;
-                        }
-                        if (attributeData->indexNo != -1) {
-                            scanOps[i].reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relations[i], (cond.lhsAttr).attrName, cond.op, &cond.rhsValue));
-                            RemoveCondition(changedConditions, nConditions, j);
-                            indexScan = true;
-                            break;
-                        }
+        // Get the layout of the result of the join
+        joinAttrCount = joinAttrs.size();
+        joinAttributes = new DataAttrInfo[joinAttrCount];
+        int joinTupleLength = 0;
+        for (int i=0; i<joinAttrCount; i++) {
+            int relation = FindRelation(nRelations, relations, joinAttrs[i].relName);
+            GetAttrInfoFromArray((char*) attributes[relation], attrCount[relation], relations[relation], joinAttrs[i].attrName, (char*) &joinAttributes[i]);
+            joinAttributes[i].offset = joinTupleLength;
+            joinTupleLength += joinAttributes[i].attrLength;
+        }
+
+        // Print message
+        if ((bQueryPlans || bExplainAnalyze) && !exchange) {
+            cout << "\n* Joining " << joinName << " in the data nodes *" << endl;
+        }
+
+        // Intersect the conditions on the partition attributes to join only in the required data nodes
+        // (the copies of the replicated relations are joined in the first data node only, and
+        // every data node joins when repartitioning, as the tuples may be sent to any of them)
+        bool joinNodes[numberNodes+1];
+        for (int j=1; j<=numberNodes; j++) {
+            joinNodes[j] = groupPartitioned || j == 1;
+        }
+        for (int i=0; i<(int) groupRelations.size() && groupPartitioned && !repartition && !rc; i++) {
+            int relation = FindRelation(nRelations, relations, groupRelations[i]);
+            vector<bool> relationNodes;
+            if (partitioned[relation]) {
+                rc = GetDataNodesForConditions(smManager, relations[relation], rcRecords[relation]->attrName,
+                                               groupConditions.size(), groupConditions.data(), relationNodes);
+                for (int j=1; j<=numberNodes && !rc; j++) {
+                    joinNodes[j] = joinNodes[j] && relationNodes[j];
+                }
+            }
+        }
+
+        // Join in the data nodes
+        // (the joins of the data nodes run concurrently till their results are gathered)
+        for (int j=1; j<=numberNodes && !rc && !exchange; j++) {
+            if (joinNodes[j]) {
+                rc = commLayer.JoinInDataNode(groupRelations.size(), groupRelations.data(), groupConditions.size(), groupConditions.data(),
+                                              joinAttrCount, joinAttrs.data(), j);
+            }
+        }
+
+        // Else repartition or broadcast the relations between the data nodes and join them there
+        /* A relation partitioned on its join attribute stays in place and the other one is sent
+           by its partition vector, else both are hashed into equal ranges of buckets of the
+           data nodes, like hash partitioned relations
+        */
+        if (exchange && !rc) {
+            int nGroupRelations = groupRelations.size();
+            RelAttr keyAttrs[nGroupRelations];
+            int groupExchanges[nGroupRelations];
+            int tupleCounts[nGroupRelations];
+            int placed = -1;
+            for (int k=0; k<nGroupRelations; k++) {
+                int relation = FindRelation(nRelations, relations, groupRelations[k]);
+                groupExchanges[k] = exchanges[relation];
+                tupleCounts[k] = rcRecords[relation]->tupleCount;
+                keyAttrs[k].relName = NULL;
+                keyAttrs[k].attrName = NULL;
+                if (groupExchanges[k] == EX_REPARTITIONED) {
+                    keyAttrs[k] = strcmp((repartitionCond.lhsAttr).relName, groupRelations[k]) == 0 ? repartitionCond.lhsAttr : repartitionCond.rhsAttr;
+                    if (placed == -1 && strcmp(keyAttrs[k].attrName, rcRecords[relation]->attrName) == 0) {
+                        placed = k;
                     }
                 }
-                if (!indexScan) {
-                    scanOps[i].reset(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
-                }
-                delete attributeData;
-            }
-            else if (i == relationIndex) {
-                scanOps[i].reset(new QL_FileScanOp(smManager, rmManager, joinFileName.c_str(), joinAttrCount, joinAttrributes));
             }
-            else if (i > relationIndex+1) {
-                bool indexScan = false;
-                DataAttrInfo* attributeData = new DataAttrInfo;
-                for (int j=0; j<nConditions; j++) {
-                    Condition cond = changedConditions[j];
-                    if (strcmp((cond.lhsAttr).relName, relations[i]) == 0 && !cond.bRhsIsAttr) {
-                        if ((rc = GetAttrInfoFromArray((char*) attributes[i], rcRecords[i]->attrCount, rcRecords[i]->relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
-                            return rc;
-                        }
-                        if (attributeData->indexNo != -1) {
-                            scanOps[i-1].reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relations[i], (cond.lhsAttr).attrName, cond.op, &cond.rhsValue));
-                            RemoveCondition(changedConditions, nConditions, j);
-                            indexScan = true;
-                            break;
-                        }
+            EX_RoutingTable routingTable;
+            if (repartition) {
+                DataAttrInfo keyData;
+                int keyRelation = FindRelation(nRelations, relations, (repartitionCond.lhsAttr).relName);
+                GetAttrInfoFromArray((char*) attributes[keyRelation], attrCount[keyRelation], relations[keyRelation], (repartitionCond.lhsAttr).attrName, (char*) &keyData);
+                if (placed != -1) {
+                    const EX_RoutingTable* partitionTable;
+                    if ((rc = smManager->GetRoutingTable(groupRelations[placed], keyAttrs[placed].attrName, keyData.attrType, partitionTable))) {
+                        return rc;
                     }
+                    routingTable = *partitionTable;
+                    groupExchanges[placed] = EX_IN_PLACE;
                 }
-                if (!indexScan) {
-                    scanOps[i-1].reset(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
+                else {
+                    memset(routingTable.relName, 0, MAXNAME+1);
+                    memset(routingTable.attrName, 0, MAXNAME+1);
+                    routingTable.attrType = keyData.attrType;
+                    routingTable.partitioning = EX_HASH_PARTITIONED;
+                    for (int i=1; i<=numberNodes; i++) {
+                        EX_IntPartitionVectorRecord range;
+                        range.node = i;
+                        range.startValue = (i-1) * EX_HASH_BUCKETS / numberNodes;
+                        range.endValue = i * EX_HASH_BUCKETS / numberNodes;
+                        routingTable.intRanges.push_back(range);
+                    }
                 }
-                delete attributeData;
             }
-        }
-        lastOp = scanOps[0];
-
-        // NLJoinOp or CrossProductOp on the scan ops
-        if (nRelations > 2) {
-            shared_ptr<QL_Op> joinOps[nRelations-2];
-            int relNumber = 1;
-            for (int i=0; i<nRelations-2; i++) {
-                // Get the attributes of the last op
-                int lastOpAttrCount;
-                lastOp->GetAttributeCount(lastOpAttrCount);
-                DataAttrInfo* lastOpAttributes = new DataAttrInfo[lastOpAttrCount];
-                lastOp->GetAttributeInfo(lastOpAttributes);
-                DataAttrInfo* attributeData = new DataAttrInfo;
 
-                // Check whether condition exists to perform a join
-                bool conditionFound = false;
-                if (i == relationIndex) {
-                    relNumber++;
-                }
-
-                for (int j=0; j<nConditions; j++) {
-                    Condition cond = changedConditions[j];
-                    if (cond.bRhsIsAttr) {
-                        if (strcmp((cond.lhsAttr).relName, relations[relNumber]) == 0) {
-                            if (!(rc = GetAttrInfoFromArray((char*) lastOpAttributes, lastOpAttrCount, (cond.rhsAttr).relName, (cond.rhsAttr).attrName, (char*) attributeData))) {
-                                joinOps[i].reset(new QL_NLJoinOp(smManager, scanOps[i+1], lastOp, cond));
-                                RemoveCondition(changedConditions, nConditions, j);
-                                conditionFound = true;
-                                break;
-                            }
-                        }
-                        else if (strcmp((cond.rhsAttr).relName, relations[relNumber]) == 0) {
-                            if (!(rc = GetAttrInfoFromArray((char*) lastOpAttributes, lastOpAttrCount, (cond.lhsAttr).relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
-                                joinOps[i].reset(new QL_NLJoinOp(smManager, lastOp, scanOps[i+1], cond));
-                                RemoveCondition(changedConditions, nConditions, j);
-                                conditionFound = true;
-                                break;
+            // Print message
+            if (bQueryPlans || bExplainAnalyze) {
+                cout << "\n* Joining " << joinName << " in the data nodes";
+                for (int exchanged = EX_REPARTITIONED; exchanged <= EX_BROADCAST; exchanged++) {
+                    bool first = true;
+                    for (int k=0; k<nGroupRelations; k++) {
+                        if (groupExchanges[k] == exchanged) {
+                            if (first) {
+                                cout << (exchanged == EX_REPARTITIONED ? ", repartitioning" : ", broadcasting");
+                                first = false;
                             }
+                            cout << " " << groupRelations[k];
                         }
                     }
                 }
-
-                if (!conditionFound) {
-                    joinOps[i].reset(new QL_CrossProductOp(smManager, lastOp, scanOps[i+1]));
-                }
-
-                lastOp = joinOps[i];
-                relNumber++;
-
-                delete[] lastOpAttributes;
-                delete attributeData;
-            }
-        }
-
-        // FilterOps
-        if (nConditions > 0) {
-            shared_ptr<QL_Op> filterOps[nConditions];
-            for (int i=0; i<nConditions; i++) {
-                filterOps[i].reset(new QL_FilterOp(smManager, lastOp, changedConditions[i]));
-                lastOp = filterOps[i];
+                cout << " *" << endl;
             }
-        }
-
-        // Root node - ProjectOp
-        shared_ptr<QL_Op> rootOp;
-        rootOp.reset(new QL_ProjectOp(smManager, lastOp, nSelAttrs, changedSelAttrs));
-
-        int finalAttrCount;
-        rootOp->GetAttributeCount(finalAttrCount);
-        DataAttrInfo* finalAttributes = new DataAttrInfo[finalAttrCount];
-        rootOp->GetAttributeInfo(finalAttributes);
-        int tupleLength = 0;
-        for (int i=0; i<finalAttrCount; i++) {
-            tupleLength += finalAttributes[i].attrLength;
-        }
-
-        Printer p(finalAttributes, finalAttrCount);
-        p.PrintHeader(cout);
 
-        // Get the tuples from the root node
-        char* recordData = new char[tupleLength];
-        rootOp->Open();
-        while((rc = rootOp->GetNext(recordData)) != QL_EOF) {
-            p.Print(cout, recordData);
+            rc = commLayer.RepartitionJoin(nGroupRelations, groupRelations.data(), keyAttrs, groupExchanges, tupleCounts, routingTable,
+                                           groupConditions.size(), groupConditions.data(), joinAttrCount, joinAttrs.data(), joinNodes);
         }
-        rootOp->Close();
 
-        p.PrintFooter(cout);
-
-        // Print the physical query plan
-        if (bQueryPlans) {
-            cout << "\nPhysical Query Plan:" << endl;
-            rootOp->Print(0);
+        // Stream the result of the join if it is the only relation
+        int joinTupleCount = 0;
+        streamJoin = joinGroupSize == nRelations;
+        if (streamJoin) {
+            commLayer.TakeWorkers(streamWorkers);
+            if (rc) {
+                EX_EndWorkers(streamWorkers);
+                return rc;
+            }
         }
 
-        // Clean up
-        delete[] recordData;
-        delete[] finalAttributes;
-
-        if ((rc = rmManager->DestroyFile(joinFileName.c_str()))) {
-            return rc;
+        // Else gather the result of the join in a temporary file
+        // (also after an error, ending the workers)
+        else {
+            RM_FileHandle joinRMFH;
+            if (!rc && !(rc = rmManager->CreateFile(joinName.c_str(), joinTupleLength))) {
+                rc = rmManager->OpenFile(joinName.c_str(), joinRMFH);
+            }
+            if (rc) {
+                commLayer.GatherFromWorkers(joinRMFH);
+                return rc;
+            }
+            int gatherRC = commLayer.GatherFromWorkers(joinRMFH, &joinTupleCount);
+            if ((rc = gatherRC) || (rc = rmManager->CloseFile(joinRMFH))) {
+                return rc;
+            }
         }
-        delete[] joinAttrributes;
-    }
 
-    // Else get the data in the master node
-    else {
+        // Replace the relations of the group by the result of the join
+        SM_RelcatRecord* joinRecord = new SM_RelcatRecord;
+        memset(joinRecord, 0, sizeof(SM_RelcatRecord));
+        strcpy(joinRecord->relName, joinName.c_str());
+        joinRecord->tupleLength = joinTupleLength;
+        joinRecord->attrCount = joinAttrCount;
+        joinRecord->distributed = EX_NOT_DISTRIBUTED;
+        strcpy(joinRecord->attrName, "NA");
+        joinRecord->tupleCount = joinTupleCount;
+        int planCount = 0;
         for (int i=0; i<nRelations; i++) {
-            if (rcRecords[i]->distributed) {
-                char partitionAttrName[MAXNAME+1];
-                strcpy(partitionAttrName, rcRecords[i]->attrName);
+            if (groups[i] != joinGroup) {
+                planRelations[planCount] = relations[i];
+                rcRecords[planCount] = rcRecords[i];
+                attributes[planCount] = attributes[i];
+                attrCount[planCount] = attrCount[i];
+                planCount++;
+                continue;
+            }
+            groupRecords.push_back(rcRecords[i]);
+            groupAttributes.push_back(attributes[i]);
+            if (joinedRelation == -1) {
+                joinedRelation = planCount;
+                planRelations[planCount] = joinRecord->relName;
+                rcRecords[planCount] = joinRecord;
+                attributes[planCount] = new DataAttrInfo[joinAttrCount];
+                for (int j=0; j<joinAttrCount; j++) {
+                    attributes[planCount][j] = joinAttributes[j];
+                }
+                attrCount[planCount] = joinAttrCount;
+                planCount++;
+            }
+        }
+        nRelations = planCount;
+        relations = planRelations;
+    }
 
-                // Print message
-                if (bQueryPlans) {
-                    cout << "\n* Getting data for " << relations[i] << " *" << endl;
+    // Get the data of the distributed relations in the master node
+    // (an aggregation of a single distributed relation is done partially in each data node,
+    // the master node only combining the partial aggregates, and otherwise the data nodes only
+    // send the needed attributes of the tuples)
+    // The tuples of a single distributed relation are read once, so they are streamed from
+    // the data nodes into the operator tree; for joins they are stored in temporary files,
+    // which the join operators may scan several times
+    bool aggregatePushdown = aggregate && nRelations == 1 && rcRecords[0]->distributed;
+    bool streamData = nRelations == 1 && rcRecords[0]->distributed;
+    int partialAttrCount = 0;
+    DataAttrInfo* partialAttributes = NULL;
+    int scanAttrCounts[nRelations];
+    DataAttrInfo* scanAttributes[nRelations];
+    for (int i=0; i<nRelations; i++) {
+        scanAttrCounts[i] = rcRecords[i]->attrCount;
+        scanAttributes[i] = NULL;
+    }
+    if (joinedRelation != -1) {
+        scanAttributes[joinedRelation] = joinAttributes;
+    }
+    for (int i=0; i<nRelations; i++) {
+        if (rcRecords[i]->distributed) {
+            char partitionAttrName[MAXNAME+1];
+            strcpy(partitionAttrName, rcRecords[i]->attrName);
+
+            // Print message
+            if (bQueryPlans || bExplainAnalyze) {
+                cout << "\n* Getting data for " << relations[i] << " *" << endl;
+            }
+
+            // Get the layout of the partial aggregates
+            int tempTupleLength = rcRecords[i]->tupleLength;
+            if (aggregatePushdown) {
+                shared_ptr<QL_Op> scanOp(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
+                QL_HashAggregateOp partialOp(smManager, rmManager, scanOp, nGroupAttrs, changedGroupAttrs, nAggs, aggFuns, aggAttrs, QL_AGGREGATE_PARTIAL);
+                partialOp.GetAttributeCount(partialAttrCount);
+                partialAttributes = new DataAttrInfo[partialAttrCount];
+                partialOp.GetAttributeInfo(partialAttributes);
+                tempTupleLength = 0;
+                for (int j=0; j<partialAttrCount; j++) {
+                    tempTupleLength += partialAttributes[j].attrLength;
+                }
+            }
+
+            // Else get the layout of the needed attributes
+            int nFetchAttrs = 0;
+            RelAttr fetchAttrs[rcRecords[i]->attrCount];
+            if (!aggregatePushdown) {
+                shared_ptr<QL_Op> scanOp(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
+                shared_ptr<QL_Op> projectOp = CreateProjectOp(smManager, scanOp, nNeededAttrs, neededAttrs);
+                if (projectOp != scanOp) {
+                    projectOp->GetAttributeCount(scanAttrCounts[i]);
+                    scanAttributes[i] = new DataAttrInfo[scanAttrCounts[i]];
+                    projectOp->GetAttributeInfo(scanAttributes[i]);
+                    tempTupleLength = 0;
+                    for (int j=0; j<scanAttrCounts[i]; j++) {
+                        fetchAttrs[j].relName = scanAttributes[i][j].relName;
+                        fetchAttrs[j].attrName = scanAttributes[i][j].attrName;
+                        tempTupleLength += scanAttributes[i][j].attrLength;
+                    }
+                    nFetchAttrs = scanAttrCounts[i];
                 }
+            }
 
-                // Get the data for the distributed relation in a temporary file
-                RM_FileHandle tempRMFH;
-                if ((rc = rmManager->CreateFile(relations[i], rcRecords[i]->tupleLength))) {
+            // Get the data for the distributed relation in a temporary file unless streamed
+            RM_FileHandle tempRMFH;
+            if (!streamData) {
+                if ((rc = rmManager->CreateFile(relations[i], tempTupleLength))) {
                     return rc;
                 }
                 if ((rc = rmManager->OpenFile(relations[i], tempRMFH))) {
                     return rc;
                 }
+            }
 
-                // Check whether the partition attribute is used in a condition
-                bool condExists = false;
-                int conditionNumber = -1;
-                for (int j=0; j<nConditions; j++) {
-                    Condition currentCondition = changedConditions[j];
-                    char* lhsRelName = (currentCondition.lhsAttr).relName;
-                    char* lhsAttrName = (currentCondition.lhsAttr).attrName;
-                    int rhsIsAttr = currentCondition.bRhsIsAttr;
-                    if (!rhsIsAttr) {
-                        if (strcmp(lhsRelName, relations[i]) == 0 && strcmp(lhsAttrName, partitionAttrName) == 0) {
-                            condExists = true;
-                            conditionNumber = j;
-                            break;
-                        }
+            // Check whether the partition attribute is used in a condition
+            // (a replicated relation is read from its copy in the first data node)
+            bool condExists = false;
+            int conditionNumber = -1;
+            bool replicated = rcRecords[i]->distributed == EX_REPLICATED;
+            for (int j=0; j<nConditions && !replicated; j++) {
+                Condition currentCondition = changedConditions[j];
+                char* lhsRelName = (currentCondition.lhsAttr).relName;
+                char* lhsAttrName = (currentCondition.lhsAttr).attrName;
+                int rhsIsAttr = currentCondition.bRhsIsAttr;
+                if (!rhsIsAttr) {
+                    if (strcmp(lhsRelName, relations[i]) == 0 && strcmp(lhsAttrName, partitionAttrName) == 0) {
+                        condExists = true;
+                        conditionNumber = j;
+                        break;
                     }
                 }
+            }
 
-                // If condition exists, get the data node only from the required data nodes
-                if (condExists) {
-                    for (int j=1; j<=numberNodes; j++) {
-                        bool valid = false;
-                        if ((rc = CheckDataNodeForCondition(rmManager, relations[i], partitionAttrName, changedConditions[conditionNumber], j, valid))) {
-                            return rc;
+            // If condition exists, get the data node only from the data nodes allowed by all the
+            // conditions on the partition attribute
+            // (the fragments of the data nodes run concurrently till their data is gathered)
+            if (condExists) {
+                vector<bool> validNodes;
+                rc = GetDataNodesForConditions(smManager, relations[i], partitionAttrName, nConditions, changedConditions, validNodes);
+                for (int j=1; j<=numberNodes && !rc; j++) {
+                    if (validNodes[j]) {
+                        if (aggregatePushdown) {
+                            rc = commLayer.AggregateInDataNode(relations[i], j, nConditions, changedConditions, nGroupAttrs, changedGroupAttrs, nAggs, aggFuns, aggAttrs);
                         }
-                        if (valid) {
-                            if ((rc = commLayer.GetDataFromDataNode(relations[i], tempRMFH, j, true, &changedConditions[conditionNumber], changedConditions, nConditions))) {
-                                return rc;
-                            }
+                        else {
+                            rc = commLayer.GetDataFromDataNode(relations[i], j, true, &changedConditions[conditionNumber], changedConditions, nConditions, nFetchAttrs, fetchAttrs);
                         }
                     }
-
-                    // Remove the used condition
-                    RemoveCondition(changedConditions, nConditions, conditionNumber);
                 }
+            }
 
-                // Else get data from all nodes
-                else {
-                    for (int j=1; j<=numberNodes; j++) {
-                        if ((rc = commLayer.GetDataFromDataNode(relations[i], tempRMFH, j, false, NULL, changedConditions, nConditions))) {
-                            return rc;
-                        }
+            // Else get data from all nodes
+            else {
+                int dataNodes = replicated ? 1 : numberNodes;
+                for (int j=1; j<=dataNodes && !rc; j++) {
+                    if (aggregatePushdown) {
+                        rc = commLayer.AggregateInDataNode(relations[i], j, nConditions, changedConditions, nGroupAttrs, changedGroupAttrs, nAggs, aggFuns, aggAttrs);
+                    }
+                    else {
+                        rc = commLayer.GetDataFromDataNode(relations[i], j, false, NULL, changedConditions, nConditions, nFetchAttrs, fetchAttrs);
                     }
                 }
+            }
+
+            // Keep the workers for the stream of the operator tree
+            if (streamData) {
+                commLayer.TakeWorkers(streamWorkers);
+                if (rc) {
+                    EX_EndWorkers(streamWorkers);
+                    return rc;
+                }
+            }
+
+            // Else gather the data of the data nodes (also after an error, ending the workers)
+            else {
+                int gatherRC = commLayer.GatherFromWorkers(tempRMFH);
+                if (rc || (rc = gatherRC)) {
+                    return rc;
+                }
 
                 // Close the temporary file
                 if ((rc = rmManager->CloseFile(tempRMFH))) {
                     return rc;
                 }
             }
+            if (condExists) {
+                // Remove the used condition
+                RemoveCondition(changedConditions, nConditions, conditionNumber);
+            }
         }
+    }
 
-        // Form the physical operator tree (physical query plan)
+    // The conditions were checked in the data nodes for a pushed down aggregation
+    if (aggregatePushdown) {
+        nConditions = 0;
+    }
 
-        /** No optimizations
-            1) FileScanOps as leaf nodes
-            2) CrossProductOps on the leaf nodes
-            3) FilterOps on top
-            4) ProjectOp as the root
-        **/
-        shared_ptr<QL_Op> lastOp;
-        if (!smManager->getOptimizeFlag()) {
-            // Scan ops - FileScans on the relations
-            shared_ptr<QL_Op> scanOps[nRelations];
-            for (int i=0; i<nRelations; i++) {
+    // Form the physical operator tree (physical query plan)
+
+    /** No optimizations
+        1) FileScanOps as leaf nodes, projected on the needed attributes
+        2) CrossProductOps on the leaf nodes
+        3) FilterOps on top
+        4) ProjectOp as the root
+    **/
+    shared_ptr<QL_Op> lastOp;
+    if (aggregatePushdown) {
+        // Stream the partial aggregates of the data nodes
+        lastOp.reset(new QL_GatherDataOp(relations[0], streamWorkers, partialAttrCount, partialAttributes));
+    }
+    else if (streamJoin) {
+        // Stream the result of the join of the data nodes
+        lastOp.reset(new QL_GatherDataOp(relations[0], streamWorkers, joinAttrCount, joinAttributes));
+    }
+    else if (streamData) {
+        // Stream the needed attributes of the tuples of the data nodes
+        if (scanAttributes[0] != NULL) {
+            lastOp.reset(new QL_GatherDataOp(relations[0], streamWorkers, scanAttrCounts[0], scanAttributes[0]));
+        }
+        else {
+            lastOp.reset(new QL_GatherDataOp(relations[0], streamWorkers, rcRecords[0]->attrCount, attributes[0]));
+        }
+    }
+    else if (!smManager->getOptimizeFlag()) {
+        // Scan ops - FileScans on the relations
+        shared_ptr<QL_Op> scanOps[nRelations];
+        for (int i=0; i<nRelations; i++) {
+            if (scanAttributes[i] != NULL) {
+                scanOps[i].reset(new QL_FileScanOp(smManager, rmManager, relations[i], scanAttrCounts[i], scanAttributes[i]));
+            }
+            else {
                 scanOps[i].reset(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
             }
-            lastOp = scanOps[0];
-
-            // CrossProductOps on the scan ops
             if (nRelations > 1) {
-                shared_ptr<QL_Op> cpOps[nRelations-1];
-                for (int i=0; i<nRelations-1; i++) {
-                    cpOps[i].reset(new QL_CrossProductOp(smManager, lastOp, scanOps[i+1]));
-                    lastOp = cpOps[i];
-                }
+                scanOps[i] = CreateProjectOp(smManager, scanOps[i], nNeededAttrs, neededAttrs);
             }
         }
+        lastOp = scanOps[0];
 
-        /** Optimizations when possible -
-            1) IndexScanOp at leaf nodes in place of FileScanOp
-            2) NLJoinOp in place of CrossProductOp
-        **/
-        else {
-            // Scan ops - FileScans or IndexScans on the relations
-            shared_ptr<QL_Op> scanOps[nRelations];
-            for (int i=0; i<nRelations; i++) {
-                // Check the conditions if an index scan can be done
-                bool indexScan = false;
-                DataAttrInfo* attributeData = new DataAttrInfo;
-                for (int j=0; j<nConditions; j++) {
-                    Condition cond = changedConditions[j];
-                    if (strcmp((cond.lhsAttr).relName, relations[i]) == 0 && !cond.bRhsIsAttr) {
-                        if ((rc = GetAttrInfoFromArray((char*) attributes[i], rcRecords[i]->attrCount, rcRecords[i]->relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
-                            return rc;
-                        }
-                        if (attributeData->indexNo != -1) {
-                            scanOps[i].reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relations[i], (cond.lhsAttr).attrName, cond.op, &cond.rhsValue));
-                            RemoveCondition(changedConditions, nConditions, j);
-                            indexScan = true;
-                            break;
-                        }
-                    }
-                }
-                if (!indexScan) {
-                    scanOps[i].reset(new QL_FileScanOp(smManager, rmManager, relations[i], false, NULL, NO_OP, NULL));
-                }
-                delete attributeData;
+        // CrossProductOps on the scan ops
+        if (nRelations > 1) {
+            shared_ptr<QL_Op> cpOps[nRelations-1];
+            for (int i=0; i<nRelations-1; i++) {
+                cpOps[i].reset(new QL_CrossProductOp(smManager, lastOp, scanOps[i+1]));
+                lastOp = cpOps[i];
             }
-            lastOp = scanOps[0];
-
-            // Join ops - CrossProductOps or NLJoinOps on the scan ops
-            if (nRelations > 1) {
-                shared_ptr<QL_Op> joinOps[nRelations-1];
-                for (int i=0; i<nRelations-1; i++) {
-                    // Get the attributes of the last op
-                    int lastOpAttrCount;
-                    lastOp->GetAttributeCount(lastOpAttrCount);
-                    DataAttrInfo* lastOpAttributes = new DataAttrInfo[lastOpAttrCount];
-                    lastOp->GetAttributeInfo(lastOpAttributes);
-                    DataAttrInfo* attributeData = new DataAttrInfo;
-
-                    // Check whether condition exists to perform a join
-                    bool conditionFound = false;
-                    for (int j=0; j<nConditions; j++) {
-                        Condition cond = changedConditions[j];
-                        if (cond.bRhsIsAttr) {
-                            if (strcmp((cond.lhsAttr).relName, relations[i+1]) == 0) {
-                                if (!(rc = GetAttrInfoFromArray((char*) lastOpAttributes, lastOpAttrCount, (cond.rhsAttr).relName, (cond.rhsAttr).attrName, (char*) attributeData))) {
-                                    joinOps[i].reset(new QL_NLJoinOp(smManager, scanOps[i+1], lastOp, cond));
-                                    RemoveCondition(changedConditions, nConditions, j);
-                                    conditionFound = true;
-                                    break;
-                                }
-                            }
-                            else if (strcmp((cond.rhsAttr).relName, relations[i+1]) == 0) {
-                                if (!(rc = GetAttrInfoFromArray((char*) lastOpAttributes, lastOpAttrCount, (cond.lhsAttr).relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
-                                    joinOps[i].reset(new QL_NLJoinOp(smManager, lastOp, scanOps[i+1], cond));
-                                    RemoveCondition(changedConditions, nConditions, j);
-                                    conditionFound = true;
-                                    break;
-                                }
-                            }
-                        }
-                    }
+        }
+    }
 
-                    if (!conditionFound) {
-                        joinOps[i].reset(new QL_CrossProductOp(smManager, lastOp, scanOps[i+1]));
-                    }
+    /** Cost based optimizations -
+        1) IndexScanOp at leaf nodes in place of FileScanOp, FilterOps right above them
+        2) Join order chosen from the catalog statistics
+        3) IndexNLJoinOp, HashJoinOp, MergeJoinOp or NLJoinOp in place of CrossProductOp
+        4) ProjectOps on the needed attributes below the joins
+    **/
+    else {
+        QL_Optimizer optimizer(smManager, ixManager, rmManager, nRelations, relations, rcRecords, attributes, nConditions, changedConditions,
+                               nOutputAttrs, neededAttrs, scanAttrCounts, scanAttributes);
+        if ((rc = optimizer.Optimize(lastOp))) {
+            return rc;
+        }
 
-                    lastOp = joinOps[i];
+        // All the conditions are applied in the operator tree
+        nConditions = 0;
+    }
 
-                    delete[] lastOpAttributes;
-                    delete attributeData;
-                }
-            }
+    // FilterOps
+    if (nConditions > 0) {
+        shared_ptr<QL_Op> filterOps[nConditions];
+        for (int i=0; i<nConditions; i++) {
+            filterOps[i].reset(new QL_FilterOp(smManager, lastOp, changedConditions[i]));
+            lastOp = filterOps[i];
         }
+    }
 
-        // FilterOps
-        if (nConditions > 0) {
-            shared_ptr<QL_Op> filterOps[nConditions];
-            for (int i=0; i<nConditions; i++) {
-                filterOps[i].reset(new QL_FilterOp(smManager, lastOp, changedConditions[i]));
-                lastOp = filterOps[i];
-            }
-        }
+    // Aggregation - HashAggregateOp
+    // (combining the partial aggregates of the data nodes if pushed down)
+    if (aggregate) {
+        QL_AggregateMode mode = aggregatePushdown ? QL_AGGREGATE_FINAL : QL_AGGREGATE_COMPLETE;
+        lastOp.reset(new QL_HashAggregateOp(smManager, rmManager, lastOp, nGroupAttrs, changedGroupAttrs, nAggs, aggFuns, aggAttrs, mode));
+    }
 
-        // Root node - ProjectOp
-        shared_ptr<QL_Op> rootOp;
-        rootOp.reset(new QL_ProjectOp(smManager, lastOp, nSelAttrs, changedSelAttrs));
+    // Order by and limit ops - TopNOp, SortOp or LimitOp
+    lastOp = CreateOrderOp(smManager, rmManager, lastOp, nOrderAttrs, changedOrderAttrs, limit);
 
-        int finalAttrCount;
-        rootOp->GetAttributeCount(finalAttrCount);
-        DataAttrInfo* finalAttributes = new DataAttrInfo[finalAttrCount];
-        rootOp->GetAttributeInfo(finalAttributes);
-        int tupleLength = 0;
-        for (int i=0; i<finalAttrCount; i++) {
-            tupleLength += finalAttributes[i].attrLength;
-        }
+    // Root node - ProjectOp
+    shared_ptr<QL_Op> rootOp;
+    rootOp.reset(new QL_ProjectOp(smManager, lastOp, nSelAttrs, projectAttrs));
 
-        Printer p(finalAttributes, finalAttrCount);
-        p.PrintHeader(cout);
+    int finalAttrCount;
+    rootOp->GetAttributeCount(finalAttrCount);
+    DataAttrInfo* finalAttributes = new DataAttrInfo[finalAttrCount];
+    rootOp->GetAttributeInfo(finalAttributes);
+    int tupleLength = 0;
+    for (int i=0; i<finalAttrCount; i++) {
+        tupleLength += finalAttributes[i].attrLength;
+    }
 
-        // Get the tuples from the root node
-        char* recordData = new char[tupleLength];
-        rootOp->Open();
-        while((rc = rootOp->GetNext(recordData)) != QL_EOF) {
-            p.Print(cout, recordData);
-        }
-        rootOp->Close();
+    Printer p(finalAttributes, finalAttrCount);
+    p.PrintHeader(cout);
 
-        p.PrintFooter(cout);
+    // Get the tuples from the root node
+    // (stopping at the first error, e.g. of a data node worker)
+    char* recordData = new char[tupleLength];
+    RC queryRC = rootOp->Open();
+    while(queryRC == OK_RC && (queryRC = rootOp->GetNext(recordData)) == OK_RC) {
+        p.Print(cout, recordData);
+    }
+    rootOp->Close();
+    if (queryRC == QL_EOF) {
+        queryRC = OK_RC;
+    }
 
-        // Print the physical query plan
-        if (bQueryPlans) {
-            cout << "\nPhysical Query Plan:" << endl;
-            rootOp->Print(0);
-        }
+    p.PrintFooter(cout);
 
-        // Destroy the temporary files
-        for (int i=0; i<nRelations; i++) {
-            if (rcRecords[i]->distributed) {
-                if ((rc = rmManager->DestroyFile(relations[i]))) {
-                    return rc;
-                }
+    // Print the physical query plan
+    if (queryRC == OK_RC && (bQueryPlans || bExplainAnalyze)) {
+        cout << "\nPhysical Query Plan:" << endl;
+        rootOp->Print(0);
+    }
+
+    // Destroy the temporary files
+    for (int i=0; i<nRelations && !streamData; i++) {
+        if (rcRecords[i]->distributed) {
+            if ((rc = rmManager->DestroyFile(relations[i]))) {
+                return rc;
             }
         }
+    }
+    if (joinedRelation != -1 && !streamJoin) {
+        if ((rc = rmManager->DestroyFile(relations[joinedRelation]))) {
+            return rc;
+        }
+    }
 
-        // Clean up
-        delete[] recordData;
-        delete[] finalAttributes;
+    // Clean up
+    delete[] recordData;
+    delete[] finalAttributes;
+    delete[] partialAttributes;
+    for (int i=0; i<nRelations; i++) {
+        delete[] scanAttributes[i];
     }
 
     // Print the command
@@ -690,24 +1018,36 @@ RC QL_Manager::Select(int nSelAttrs, const RelAttr selAttrs[],
         cout << "   nSelAttrs = " << nSelAttrs << "\n";
         for (i = 0; i < nSelAttrs; i++)
             cout << "   selAttrs[" << i << "]:" << selAttrs[i] << "\n";
-        cout << "   nRelations = " << nRelations << "\n";
-        for (i = 0; i < nRelations; i++)
-            cout << "   relations[" << i << "] " << relations[i] << "\n";
-        cout << "   nCondtions = " << nConditions << "\n";
-        for (i = 0; i < nConditions; i++)
+        cout << "   nRelations = " << nQueryRelations << "\n";
+        for (i = 0; i < nQueryRelations; i++)
+            cout << "   relations[" << i << "] " << queryRelations[i] << "\n";
+        cout << "   nCondtions = " << nQueryConditions << "\n";
+        for (i = 0; i < nQueryConditions; i++)
             cout << "   conditions[" << i << "]:" << conditions[i] << "\n";
+        cout << "   nGroupAttrs = " << nGroupAttrs << "\n";
+        for (i = 0; i < nGroupAttrs; i++)
+            cout << "   groupAttrs[" << i << "]:" << groupAttrs[i] << "\n";
+        cout << "   nOrderAttrs = " << nOrderAttrs << "\n";
+        for (i = 0; i < nOrderAttrs; i++)
+            cout << "   orderAttrs[" << i << "]:" << orderAttrs[i].attr
+                 << (orderAttrs[i].bDescending ? " DESC" : "") << "\n";
+        cout << "   limit = " << limit << "\n";
     }
 
     for (int i=0; i<nRelations; i++) {
         delete rcRecords[i];
         delete[] attributes[i];
     }
-    if (strcmp(selAttrs[0].attrName, "*") == 0) {
+    for (int i=0; i<(int) groupRecords.size(); i++) {
+        delete groupRecords[i];
+        delete[] groupAttributes[i];
+    }
+    if (selectAll) {
         delete[] changedSelAttrs;
     }
 
-    // Return OK
-    return OK_RC;
+    // Return the error of the query, if any
+    return queryRC;
 }
 
 
@@ -737,7 +1077,7 @@ RC QL_Manager::Insert(const char *relName,
         return QL_DATABASE_CLOSED;
     }
 
-    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0) {
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
         return QL_SYSTEM_CATALOG;
     }
 
@@ -784,8 +1124,20 @@ RC QL_Manager::Insert(const char *relName,
         }
     }
 
+    // EX - Replicated relation case
+    if (distributedRelation == EX_REPLICATED) {
+        // Insert into every data node, keeping the copies in sync
+        int numberNodes = smManager->getNumberNodes();
+        EX_CommLayer &commLayer = *smManager->GetCommLayer();
+        for (int i=1; i<=numberNodes; i++) {
+            if ((rc = commLayer.InsertInDataNode(relName, nValues, values, i))) {
+                return rc;
+            }
+        }
+    }
+
     // EX - Distributed relation case
-    if (distributedRelation) {
+    else if (distributedRelation) {
         // Find the key for the partition vector
         Value key;
         bool found = false;
@@ -803,7 +1155,7 @@ RC QL_Manager::Insert(const char *relName,
         // Find the correct node to insert
         int numberNodes = smManager->getNumberNodes();
         int dataNode = 0;
-        if ((rc = GetDataNodeForTuple(rmManager, key, relName, partitionAttrName, dataNode))) {
+        if ((rc = GetDataNodeForTuple(smManager, key, relName, partitionAttrName, dataNode))) {
             return rc;
         }
         if (dataNode <= 0 || dataNode > numberNodes) {
@@ -811,7 +1163,7 @@ RC QL_Manager::Insert(const char *relName,
         }
 
         // Insert into the corresponding data node
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *smManager->GetCommLayer();
         if ((rc = commLayer.InsertInDataNode(relName, nValues, values, dataNode))) {
             return rc;
         }
@@ -917,6 +1269,11 @@ RC QL_Manager::Insert(const char *relName,
         delete[] ixIH;
     }
 
+    // Update the tuple count in the catalog
+    if ((rc = smManager->UpdateTupleCount(relName, 1))) {
+        return rc;
+    }
+
     // Clean up
     delete rcRecord;
     delete[] attributes;
@@ -959,7 +1316,7 @@ RC QL_Manager::Delete(const char *relName,
         return QL_DATABASE_CLOSED;
     }
 
-    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0) {
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
         return QL_SYSTEM_CATALOG;
     }
 
@@ -999,18 +1356,17 @@ RC QL_Manager::Delete(const char *relName,
     }
 
     // EX - Distributed relation case
+    // (every copy of a replicated relation is changed, as it has no partition attribute)
     if (distributedRelation) {
         // Check whether the partition attribute is used in a condition
         bool condExists = false;
-        int conditionNumber = -1;
-        for (int i=0; i<nConditions; i++) {
+        for (int i=0; i<nConditions && distributedRelation != EX_REPLICATED; i++) {
             Condition currentCondition = conditions[i];
             char* lhs = (currentCondition.lhsAttr).attrName;
             int rhsIsAttr = currentCondition.bRhsIsAttr;
             if (!rhsIsAttr) {
                 if (strcmp(lhs, partitionAttrName) == 0) {
                     condExists = true;
-                    conditionNumber = i;
                     break;
                 }
             }
@@ -1018,15 +1374,15 @@ RC QL_Manager::Delete(const char *relName,
 
         // If condition on partition attribute exists
         int numberNodes = smManager->getNumberNodes();
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *smManager->GetCommLayer();
         if (condExists) {
-            // Find the nodes to pass the query
+            // Find the nodes to pass the query from all the conditions on the partition attribute
+            vector<bool> validNodes;
+            if ((rc = GetDataNodesForConditions(smManager, relName, partitionAttrName, nConditions, conditions, validNodes))) {
+                return rc;
+            }
             for (int i=1; i<=numberNodes; i++) {
-                bool valid = false;
-                if ((rc = CheckDataNodeForCondition(rmManager, relName, partitionAttrName, conditions[conditionNumber], i, valid))) {
-                    return rc;
-                }
-                if (valid) {
+                if (validNodes[i]) {
                     // Pass the query to the node
                     if ((rc = commLayer.DeleteInDataNode(relName, nConditions, conditions, i))) {
                         return rc;
@@ -1052,42 +1408,15 @@ RC QL_Manager::Delete(const char *relName,
         cout << "Deleted tuples:" << endl;
         Printer p(attributes, attrCount);
         p.PrintHeader(cout);
+        int deletedCount = 0;
 
-        // Find whether index exists on some condition
-        bool indexExists = false;
-        int indexCondition = -1;
-        for (int i=0; i<nConditions; i++) {
-            if (indexExists) break;
-            Condition currentCondition = conditions[i];
-            char* lhs = (currentCondition.lhsAttr).attrName;
-            int rhsIsAttr = currentCondition.bRhsIsAttr;
-            if (!rhsIsAttr) {
-                for (int j=0; j<attrCount; j++) {
-                    if (strcmp(attributes[j].attrName, lhs) == 0) {
-                        if (attributes[j].indexNo != -1) {
-                            indexExists = true;
-                            indexCondition = i;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        // Declare a scan operator
-        shared_ptr<QL_Op> scanOp;
+        // Find an index scan for some condition (bounded on both sides if possible)
+        int indexCondition, rangeCondition;
+        shared_ptr<QL_Op> scanOp = ChooseIndexScanOp(smManager, ixManager, rmManager, relName, attrCount, attributes,
+                                                     nConditions, conditions, NULL, indexCondition, rangeCondition);
 
         // If index exists
-        if (indexExists) {
-            // Get the index attribute information
-            char* lhsRelName = (conditions[indexCondition].lhsAttr).relName;
-            char* lhsAttrName = (conditions[indexCondition].lhsAttr).attrName;
-            CompOp op = conditions[indexCondition].op;
-            DataAttrInfo* attributeData = new DataAttrInfo;
-            if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, lhsRelName, lhsAttrName, (char*) attributeData))) {
-                return rc;
-            }
-
+        if (scanOp) {
             // Open the RM file
             RM_FileHandle rmFH;
             RID rid;
@@ -1098,7 +1427,6 @@ RC QL_Manager::Delete(const char *relName,
             }
 
             // Open the index scan
-            scanOp.reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relName, attributeData->attrName, op, &conditions[indexCondition].rhsValue));
             if ((rc = scanOp->Open())) {
                 return rc;
             }
@@ -1135,6 +1463,7 @@ RC QL_Manager::Delete(const char *relName,
                     if ((rc = rmFH.DeleteRec(rid))) {
                         return rc;
                     }
+                    deletedCount++;
 
                     // Delete entries from all indexes
                     for (int i=0; i<attrCount; i++) {
@@ -1159,7 +1488,6 @@ RC QL_Manager::Delete(const char *relName,
                 }
             }
             delete[] ixIHs;
-            delete attributeData;
 
             // Close the scan and RM file
             if ((rc = scanOp->Close())) {
@@ -1253,6 +1581,7 @@ RC QL_Manager::Delete(const char *relName,
                     if ((rc = rmFH.DeleteRec(rid))) {
                         return rc;
                     }
+                    deletedCount++;
 
                     // Delete entries from all indexes
                     for (int i=0; i<attrCount; i++) {
@@ -1290,6 +1619,11 @@ RC QL_Manager::Delete(const char *relName,
         // Print the footer
         p.PrintFooter(cout);
 
+        // Update the tuple count in the catalog
+        if ((rc = smManager->UpdateTupleCount(relName, -deletedCount))) {
+            return rc;
+        }
+
         // Print the query plan
         if (bQueryPlans) {
             cout << "\nPhysical Query Plan :" << endl;
@@ -1350,7 +1684,7 @@ RC QL_Manager::Update(const char *relName,
         return QL_DATABASE_CLOSED;
     }
 
-    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0) {
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
         return QL_SYSTEM_CATALOG;
     }
 
@@ -1453,35 +1787,34 @@ RC QL_Manager::Update(const char *relName,
     }
 
     // EX - Distributed relation case
+    // (every copy of a replicated relation is changed, as it has no partition attribute)
     if (distributedRelation) {
         // Check whether the partition attribute is used in a condition
         bool condExists = false;
-        int conditionNumber = -1;
-        for (int i=0; i<nConditions; i++) {
+        for (int i=0; i<nConditions && distributedRelation != EX_REPLICATED; i++) {
             Condition currentCondition = conditions[i];
             char* lhs = (currentCondition.lhsAttr).attrName;
             int rhsIsAttr = currentCondition.bRhsIsAttr;
             if (!rhsIsAttr) {
                 if (strcmp(lhs, partitionAttrName) == 0) {
                     condExists = true;
-                    conditionNumber = i;
                     break;
                 }
             }
         }
 
         // If condition on partition attribute exists
-        bool reshuffle = (strcmp(partitionAttrName, updAttr.attrName) == 0);
+        bool reshuffle = distributedRelation != EX_REPLICATED && strcmp(partitionAttrName, updAttr.attrName) == 0;
         int numberNodes = smManager->getNumberNodes();
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *smManager->GetCommLayer();
         if (condExists) {
-            // Find the nodes to pass the query
+            // Find the nodes to pass the query from all the conditions on the partition attribute
+            vector<bool> validNodes;
+            if ((rc = GetDataNodesForConditions(smManager, relName, partitionAttrName, nConditions, conditions, validNodes))) {
+                return rc;
+            }
             for (int i=1; i<=numberNodes; i++) {
-                bool valid = false;
-                if ((rc = CheckDataNodeForCondition(rmManager, relName, partitionAttrName, conditions[conditionNumber], i, valid))) {
-                    return rc;
-                }
-                if (valid) {
+                if (validNodes[i]) {
                     // Pass the query to the node
                     if ((rc = commLayer.UpdateInDataNode(relName, updAttr, bIsValue, rhsRelAttr, rhsValue, nConditions, conditions, i, reshuffle))) {
                         return rc;
@@ -1512,42 +1845,14 @@ RC QL_Manager::Update(const char *relName,
         Printer p(attributes, attrCount);
         p.PrintHeader(cout);
 
-        // Find whether index exists on some condition
-        bool indexExists = false;
-        int indexCondition = -1;
-        for (int i=0; i<nConditions; i++) {
-            if (indexExists) break;
-            Condition currentCondition = conditions[i];
-            char* lhs = (currentCondition.lhsAttr).attrName;
-            int rhsIsAttr = currentCondition.bRhsIsAttr;
-            if (!rhsIsAttr) {
-                for (int j=0; j<attrCount; j++) {
-                    if (strcmp(attributes[j].attrName, lhs) == 0) {
-                        // Do not consider an index on the update attribute
-                        if (strcmp(attributes[j].attrName, updAttrName) != 0 && attributes[j].indexNo != -1) {
-                            indexExists = true;
-                            indexCondition = i;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        // Create a QL_Op object
-        shared_ptr<QL_Op> scanOp;
+        // Find an index scan for some condition (bounded on both sides if possible)
+        // (not on the update attribute)
+        int indexCondition, rangeCondition;
+        shared_ptr<QL_Op> scanOp = ChooseIndexScanOp(smManager, ixManager, rmManager, relName, attrCount, attributes,
+                                                     nConditions, conditions, updAttrName, indexCondition, rangeCondition);
 
         // If index exists
-        if (indexExists) {
-            // Get the index attribute information
-            char* lhsRelName = (conditions[indexCondition].lhsAttr).relName;
-            char* lhsAttrName = (conditions[indexCondition].lhsAttr).attrName;
-            CompOp op = conditions[indexCondition].op;
-            DataAttrInfo* attributeData = new DataAttrInfo;
-            if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, lhsRelName, lhsAttrName, (char*) attributeData))) {
-                return rc;
-            }
-
+        if (scanOp) {
             // Open the RM file
             RM_FileHandle rmFH;
             RID rid;
@@ -1558,7 +1863,6 @@ RC QL_Manager::Update(const char *relName,
             }
 
             // Open the IndexScan operator
-            scanOp.reset(new QL_IndexScanOp(smManager, ixManager, rmManager, relName, attributeData->attrName, op, &conditions[indexCondition].rhsValue));
             if ((rc = scanOp->Open())) {
                 return rc;
             }
@@ -1657,7 +1961,6 @@ RC QL_Manager::Update(const char *relName,
             }
 
             // Clean up
-            delete attributeData;
             delete updAttrData;
 
             // Close the scan and file
@@ -2148,6 +2451,60 @@ RC QL_Manager::ValidateConditionsMultipleRelations(SM_RelcatRecord* rcRecords[],
 }
 
 
+// Method: ResolveAttribute(SM_Manager* smManager, int nRelations, const char* const relations[],
+//                          RelAttr &relAttr, SM_AttrcatRecord* attributeData)
+// Check that the attribute is in one of the relations, setting its relName if not specified
+// (the attribute must then be in a single relation)
+RC ResolveAttribute(SM_Manager* smManager, int nRelations, const char* const relations[],
+                    RelAttr &relAttr, SM_AttrcatRecord* attributeData) {
+    // If relName is not specified, find the only relation with the attribute
+    if (relAttr.relName == NULL) {
+        for (int i=0; i<nRelations; i++) {
+            if (smManager->GetAttrInfo(relations[i], relAttr.attrName, attributeData) == 0) {
+                if (relAttr.relName != NULL) {
+                    relAttr.relName = NULL;
+                    break;
+                }
+                relAttr.relName = (char*) relations[i];
+            }
+        }
+        return relAttr.relName == NULL ? QL_INVALID_ATTRIBUTE : OK_RC;
+    }
+
+    // Else check if the attribute exists in one of the relations
+    for (int i=0; i<nRelations; i++) {
+        if (strcmp(relAttr.relName, relations[i]) == 0) {
+            return smManager->GetAttrInfo(relations[i], relAttr.attrName, attributeData);
+        }
+    }
+    return QL_INVALID_ATTRIBUTE;
+}
+
+
+// Method: FindAttribute(const RelAttr relAttrs[], int nRelAttrs, const RelAttr &relAttr)
+// Get the position of a resolved attribute in an array of resolved attributes (-1 if absent)
+int FindAttribute(const RelAttr relAttrs[], int nRelAttrs, const RelAttr &relAttr) {
+    for (int i=0; i<nRelAttrs; i++) {
+        if (strcmp(relAttrs[i].relName, relAttr.relName) == 0 && strcmp(relAttrs[i].attrName, relAttr.attrName) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+// Method: FindRelation(int nRelations, const char* const relations[], const char* relName)
+// Get the position of a relation in the relations array (-1 if absent)
+int FindRelation(int nRelations, const char* const relations[], const char* relName) {
+    for (int i=0; i<nRelations; i++) {
+        if (strcmp(relations[i], relName) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
 // Method: RemoveCondition(Condition conditions[], int nConditions, int index)
 // Remove a condition from the conditions array
 void RemoveCondition(Condition conditions[], int &nConditions, int index) {
@@ -2156,3 +2513,384 @@ void RemoveCondition(Condition conditions[], int &nConditions, int index) {
     }
     nConditions--;
 }
+
+
+// Method: IndexSupportsCondition(const DataAttrInfo &attributeData, CompOp op)
+// Boolean whether the index on the attribute can evaluate the comparison
+// Hash indexes only support equality
+bool IndexSupportsCondition(const DataAttrInfo &attributeData, CompOp op) {
+    if (attributeData.indexNo == -1 || op == NE_OP || op == NO_OP) {
+        return false;
+    }
+    if (attributeData.indexType == IX_HASH) {
+        return op == EQ_OP;
+    }
+    return true;
+}
+
+// Method: FindRangeCondition(const Condition conditions[], int nConditions, int indexCondition)
+// Find a condition bounding the same attribute as the index condition from the other side
+// Return -1 if the index condition cannot be turned into a range
+int FindRangeCondition(const Condition conditions[], int nConditions, int indexCondition) {
+    const Condition &indexCond = conditions[indexCondition];
+    bool lowerBound = (indexCond.op == GT_OP || indexCond.op == GE_OP);
+    bool upperBound = (indexCond.op == LT_OP || indexCond.op == LE_OP);
+    if (!lowerBound && !upperBound) {
+        return -1;
+    }
+
+    for (int i=0; i<nConditions; i++) {
+        const Condition &cond = conditions[i];
+        if (i == indexCondition || cond.bRhsIsAttr) continue;
+        if (strcmp((cond.lhsAttr).attrName, (indexCond.lhsAttr).attrName) != 0) continue;
+        if ((cond.lhsAttr).relName != NULL && (indexCond.lhsAttr).relName != NULL &&
+            strcmp((cond.lhsAttr).relName, (indexCond.lhsAttr).relName) != 0) continue;
+
+        // Check that the condition gives the other bound
+        if (lowerBound && (cond.op == LT_OP || cond.op == LE_OP)) {
+            return i;
+        }
+        if (upperBound && (cond.op == GT_OP || cond.op == GE_OP)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Method: CreateIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+//                           const char* relName, char* attrName, const Condition conditions[],
+//                           int indexCondition, int rangeCondition, double matches)
+// Create an index scan for the index condition
+// If rangeCondition is not -1, the scan is bounded by both conditions
+// The records are fetched in page order if more than QL_SORTED_FETCH_THRESHOLD entries are
+// estimated to match, else streamed in key order
+shared_ptr<QL_Op> CreateIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                    const char* relName, char* attrName, const Condition conditions[],
+                                    int indexCondition, int rangeCondition, double matches) {
+    QL_IndexScanOp* scanOp;
+    const Condition &indexCond = conditions[indexCondition];
+
+    // Single condition scan
+    if (rangeCondition == -1) {
+        scanOp = new QL_IndexScanOp(smManager, ixManager, rmManager, relName, attrName, indexCond.op, &indexCond.rhsValue);
+    }
+    // Range scan with the lower bound first
+    else if (indexCond.op == GT_OP || indexCond.op == GE_OP) {
+        const Condition &rangeCond = conditions[rangeCondition];
+        scanOp = new QL_IndexScanOp(smManager, ixManager, rmManager, relName, attrName,
+                                    indexCond.op, &indexCond.rhsValue, rangeCond.op, &rangeCond.rhsValue);
+    }
+    else {
+        const Condition &rangeCond = conditions[rangeCondition];
+        scanOp = new QL_IndexScanOp(smManager, ixManager, rmManager, relName, attrName,
+                                    rangeCond.op, &rangeCond.rhsValue, indexCond.op, &indexCond.rhsValue);
+    }
+
+    if (matches > QL_SORTED_FETCH_THRESHOLD) {
+        scanOp->FetchInPageOrder();
+    }
+    return shared_ptr<QL_Op>(scanOp);
+}
+
+// Method: EstimateIndexMatches(SM_Manager* smManager, const char* relName, const Condition conditions[],
+//                              int indexCondition, int rangeCondition, double &matches)
+// Estimate the entries an index scan for the conditions reads, from the catalog counts
+// (1 / distinct values for an equality, QL_RANGE_SELECTIVITY for each other condition)
+static RC EstimateIndexMatches(SM_Manager* smManager, const char* relName, const Condition conditions[],
+                               int indexCondition, int rangeCondition, double &matches) {
+    int rc;
+    SM_RelcatRecord* rcRecord = new SM_RelcatRecord;
+    memset(rcRecord, 0, sizeof(SM_RelcatRecord));
+    if ((rc = smManager->GetRelInfo(relName, rcRecord))) {
+        delete rcRecord;
+        return rc;
+    }
+    matches = rcRecord->tupleCount;
+    delete rcRecord;
+
+    const Condition &indexCond = conditions[indexCondition];
+    if (indexCond.op == EQ_OP) {
+        SM_AttrcatRecord* attributeData = new SM_AttrcatRecord;
+        memset(attributeData, 0, sizeof(SM_AttrcatRecord));
+        if ((rc = smManager->GetAttrInfo(relName, (indexCond.lhsAttr).attrName, attributeData))) {
+            delete attributeData;
+            return rc;
+        }
+        matches *= attributeData->distinctCount > 0 ? 1.0 / attributeData->distinctCount : QL_EQ_SELECTIVITY;
+        delete attributeData;
+    }
+    else {
+        matches *= QL_RANGE_SELECTIVITY;
+    }
+    if (rangeCondition != -1) {
+        matches *= QL_RANGE_SELECTIVITY;
+    }
+
+    return OK_RC;
+}
+
+// Method: ChooseIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+//                           const char* relName, int attrCount, const DataAttrInfo attributes[],
+//                           int nConditions, const Condition conditions[], const char* skipAttrName,
+//                           int &indexCondition, int &rangeCondition)
+// Create an index scan of the relation for the first condition on a value of an indexed attribute
+// (other than skipAttrName if not NULL), bounded from the other side by a second condition on the
+// attribute if any (rangeCondition, else -1)
+// Return NULL with indexCondition -1 if no condition allows an index scan
+shared_ptr<QL_Op> ChooseIndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                    const char* relName, int attrCount, const DataAttrInfo attributes[],
+                                    int nConditions, const Condition conditions[], const char* skipAttrName,
+                                    int &indexCondition, int &rangeCondition) {
+    indexCondition = -1;
+    rangeCondition = -1;
+    for (int i=0; i<nConditions && indexCondition == -1; i++) {
+        const Condition &cond = conditions[i];
+        if (cond.bRhsIsAttr) continue;
+        for (int j=0; j<attrCount; j++) {
+            if (strcmp(attributes[j].attrName, (cond.lhsAttr).attrName) == 0) {
+                if ((skipAttrName == NULL || strcmp(attributes[j].attrName, skipAttrName) != 0) &&
+                    IndexSupportsCondition(attributes[j], cond.op)) {
+                    indexCondition = i;
+                }
+                break;
+            }
+        }
+    }
+    if (indexCondition == -1) {
+        return shared_ptr<QL_Op>();
+    }
+
+    rangeCondition = FindRangeCondition(conditions, nConditions, indexCondition);
+    double matches;
+    if (EstimateIndexMatches(smManager, relName, conditions, indexCondition, rangeCondition, matches)) {
+        matches = 0;
+    }
+    return CreateIndexScanOp(smManager, ixManager, rmManager, relName, (conditions[indexCondition].lhsAttr).attrName,
+                             conditions, indexCondition, rangeCondition, matches);
+}
+
+// Method: GetIndexProbe(const Condition &joinCond, const char* innerRelName, const RelAttr* &innerAttr,
+//                       const RelAttr* &outerAttr, CompOp &probeOp)
+// Get the inner and outer attributes of a join condition and the operator to probe an index
+// on the inner attribute with an outer value
+// Return false if the condition does not compare an inner attribute
+bool GetIndexProbe(const Condition &joinCond, const char* innerRelName, const RelAttr* &innerAttr,
+                   const RelAttr* &outerAttr, CompOp &probeOp) {
+    if (!joinCond.bRhsIsAttr || joinCond.op == NE_OP || joinCond.op == NO_OP) {
+        return false;
+    }
+
+    // inner op outer
+    if (strcmp((joinCond.lhsAttr).relName, innerRelName) == 0) {
+        innerAttr = &joinCond.lhsAttr;
+        outerAttr = &joinCond.rhsAttr;
+        probeOp = joinCond.op;
+        return true;
+    }
+
+    // outer op inner, so the operator is flipped for the inner attribute
+    if (strcmp((joinCond.rhsAttr).relName, innerRelName) == 0) {
+        innerAttr = &joinCond.rhsAttr;
+        outerAttr = &joinCond.lhsAttr;
+        switch (joinCond.op) {
+            case LT_OP: probeOp = GT_OP; break;
+            case LE_OP: probeOp = GE_OP; break;
+            case GT_OP: probeOp = LT_OP; break;
+            case GE_OP: probeOp = LE_OP; break;
+            default: probeOp = joinCond.op;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// Method: CreateIndexNLJoinOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+//                             shared_ptr<QL_Op> outerOp, const char* innerRelName,
+//                             int innerAttrCount, DataAttrInfo* innerAttributes, const Condition &joinCond)
+// Create an index nested loop join of the outer operator with the inner relation
+// Return a null operator if the inner join attribute has no index usable for the condition
+shared_ptr<QL_Op> CreateIndexNLJoinOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                      shared_ptr<QL_Op> outerOp, const char* innerRelName,
+                                      int innerAttrCount, DataAttrInfo* innerAttributes,
+                                      const Condition &joinCond) {
+    shared_ptr<QL_Op> joinOp;
+
+    // Get the inner join attribute
+    const RelAttr* innerAttr;
+    const RelAttr* outerAttr;
+    CompOp probeOp;
+    if (!GetIndexProbe(joinCond, innerRelName, innerAttr, outerAttr, probeOp)) {
+        return joinOp;
+    }
+
+    // Check the index on the inner join attribute
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    if (GetAttrInfoFromArray((char*) innerAttributes, innerAttrCount, innerRelName, innerAttr->attrName, (char*) attributeData) == OK_RC &&
+        IndexSupportsCondition(*attributeData, probeOp)) {
+        joinOp.reset(new QL_IndexNLJoinOp(smManager, ixManager, rmManager, outerOp, innerRelName, joinCond));
+    }
+    delete attributeData;
+
+    return joinOp;
+}
+
+// Method: GetJoinBlockPages(RM_Manager* rmManager)
+// Pages of outer tuples a nested loop join keeps in memory, a share of the buffer pool
+int GetJoinBlockPages(RM_Manager* rmManager) {
+    int bufferPages = 0;
+    if (rmManager->GetBufferSize(bufferPages)) {
+        return 1;
+    }
+    int blockPages = bufferPages / QL_NL_JOIN_BUFFER_SHARE;
+    return blockPages < 1 ? 1 : blockPages;
+}
+
+// Method: CreateJoinOp(SM_Manager* smManager, RM_Manager* rmManager, shared_ptr<QL_Op> leftOp,
+//                      shared_ptr<QL_Op> rightOp, const Condition &joinCond)
+// Create a join of the two operators on the join condition
+/* Steps:
+    1) Join on conditions other than equality with a (block) nested loop join
+    2) If either operator is already ordered on its join attribute (e.g. by an index scan),
+       merge join the operators, sorting only the operator that is not ordered
+    3) Otherwise hash join the operators
+*/
+shared_ptr<QL_Op> CreateJoinOp(SM_Manager* smManager, RM_Manager* rmManager, shared_ptr<QL_Op> leftOp,
+                               shared_ptr<QL_Op> rightOp, const Condition &joinCond) {
+    shared_ptr<QL_Op> joinOp;
+    if (joinCond.op != EQ_OP) {
+        joinOp.reset(new QL_NLJoinOp(smManager, rmManager, leftOp, rightOp, joinCond));
+        return joinOp;
+    }
+
+    // Get the join attribute of the left operator
+    int leftAttrCount;
+    leftOp->GetAttributeCount(leftAttrCount);
+    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
+    leftOp->GetAttributeInfo(leftAttributes);
+    const RelAttr* leftAttr = &joinCond.lhsAttr;
+    const RelAttr* rightAttr = &joinCond.rhsAttr;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    if (GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, leftAttr->relName, leftAttr->attrName, (char*) attributeData)) {
+        leftAttr = &joinCond.rhsAttr;
+        rightAttr = &joinCond.lhsAttr;
+    }
+    delete[] leftAttributes;
+    delete attributeData;
+
+    // Merge join if an operator is ordered on its join attribute
+    bool leftOrdered = leftOp->IsOrderedOn(leftAttr->relName, leftAttr->attrName);
+    bool rightOrdered = rightOp->IsOrderedOn(rightAttr->relName, rightAttr->attrName);
+    if (leftOrdered || rightOrdered) {
+        if (!leftOrdered) {
+            leftOp.reset(new QL_SortOp(smManager, rmManager, leftOp, 1, leftAttr));
+        }
+        if (!rightOrdered) {
+            rightOp.reset(new QL_SortOp(smManager, rmManager, rightOp, 1, rightAttr));
+        }
+        joinOp.reset(new QL_MergeJoinOp(smManager, leftOp, rightOp, joinCond));
+    }
+    else {
+        joinOp.reset(new QL_HashJoinOp(smManager, rmManager, leftOp, rightOp, joinCond));
+    }
+    return joinOp;
+}
+
+// Method: CreateOrderOp(SM_Manager* smManager, RM_Manager* rmManager, shared_ptr<QL_Op> childOp,
+//                       int nOrderAttrs, const OrderAttr orderAttrs[], int limit)
+// Order the tuples of the operator on the ORDER BY attributes and stop after LIMIT tuples
+/* Steps:
+    1) If there are no order attributes, or the operator is already in ascending order of
+       the only order attribute (e.g. by an index scan), keep its order
+    2) If the limit tuples fit in the sortMemory budget, keep only them in a TopNOp
+    3) Otherwise sort the tuples with a SortOp
+    4) Stop reading the tuples after the limit with a LimitOp
+*/
+shared_ptr<QL_Op> CreateOrderOp(SM_Manager* smManager, RM_Manager* rmManager, shared_ptr<QL_Op> childOp,
+                                int nOrderAttrs, const OrderAttr orderAttrs[], int limit) {
+    shared_ptr<QL_Op> orderOp = childOp;
+    if (nOrderAttrs > 0) {
+        RelAttr keyAttrs[nOrderAttrs];
+        int keyDescending[nOrderAttrs];
+        for (int i=0; i<nOrderAttrs; i++) {
+            keyAttrs[i] = orderAttrs[i].attr;
+            keyDescending[i] = orderAttrs[i].bDescending;
+        }
+
+        // Keep the order of the operator
+        if (nOrderAttrs == 1 && !keyDescending[0] && childOp->IsOrderedOn(keyAttrs[0].relName, keyAttrs[0].attrName)) {
+            childOp->KeepOrder();
+        }
+
+        // Top-N if the limit tuples fit in memory
+        else {
+            int attrCount;
+            childOp->GetAttributeCount(attrCount);
+            DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+            childOp->GetAttributeInfo(attributes);
+            int tupleLength = 0;
+            for (int i=0; i<attrCount; i++) {
+                tupleLength += attributes[i].attrLength;
+            }
+            delete[] attributes;
+
+            if (limit >= 0 && limit <= smManager->getSortMemory() * PF_PAGE_SIZE / tupleLength) {
+                orderOp.reset(new QL_TopNOp(smManager, childOp, nOrderAttrs, keyAttrs, keyDescending, limit));
+                return orderOp;
+            }
+            orderOp.reset(new QL_SortOp(smManager, rmManager, childOp, nOrderAttrs, keyAttrs, keyDescending));
+        }
+    }
+
+    // Stop after the limit
+    if (limit >= 0) {
+        orderOp.reset(new QL_LimitOp(smManager, orderOp, limit));
+    }
+    return orderOp;
+}
+
+// Method: CreateProjectOp(SM_Manager* smManager, shared_ptr<QL_Op> childOp,
+//                         int nNeededAttrs, const RelAttr neededAttrs[])
+// Project the tuples of the operator on the attributes needed by the operators above it
+/* Steps:
+    1) Keep the attributes of the operator that are needed, in their order
+    2) If no attribute is needed (e.g. only counted), keep the shortest one
+    3) If all the attributes are needed, keep the operator, else add a ProjectOp over it
+*/
+shared_ptr<QL_Op> CreateProjectOp(SM_Manager* smManager, shared_ptr<QL_Op> childOp,
+                                  int nNeededAttrs, const RelAttr neededAttrs[]) {
+    int attrCount;
+    childOp->GetAttributeCount(attrCount);
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    childOp->GetAttributeInfo(attributes);
+
+    // Find the needed attributes
+    RelAttr projectAttrs[attrCount];
+    int nProjectAttrs = 0;
+    int shortest = 0;
+    for (int i=0; i<attrCount; i++) {
+        RelAttr relAttr;
+        relAttr.relName = attributes[i].relName;
+        relAttr.attrName = attributes[i].attrName;
+        if (FindAttribute(neededAttrs, nNeededAttrs, relAttr) != -1) {
+            projectAttrs[nProjectAttrs++] = relAttr;
+        }
+        if (attributes[i].attrLength < attributes[shortest].attrLength) {
+            shortest = i;
+        }
+    }
+    if (nProjectAttrs == 0) {
+        projectAttrs[nProjectAttrs].relName = attributes[shortest].relName;
+        projectAttrs[nProjectAttrs].attrName = attributes[shortest].attrName;
+        nProjectAttrs++;
+    }
+
+    // Project only if some attribute is not needed
+    shared_ptr<QL_Op> projectOp = childOp;
+    if (nProjectAttrs < attrCount) {
+        projectOp.reset(new QL_ProjectOp(smManager, childOp, nProjectAttrs, projectAttrs));
+    }
+    delete[] attributes;
+    return projectOp;
+}
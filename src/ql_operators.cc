@@ -8,6 +8,7 @@
 #include <iostream>
 #include <unistd.h>
 #include <memory>
+#include <algorithm>
 #include "redbase.h"
 #include "ql.h"
 #include "ql_internal.h"
@@ -16,15 +17,110 @@
 #include "rm.h"
 #include "printer.h"
 #include "parser.h"
+#include "ex.h"
 
 using namespace std;
 
 
+/********** QL_Op class **********/
+
+// Constructor
+QL_Op::QL_Op() {
+    memset(&statistics, 0, sizeof(QL_OpStatistics));
+    analyze = false;
+}
+
+// Open the operator
+// (the statistics are collected if the query is run by EXPLAIN ANALYZE)
+RC QL_Op::Open() {
+    analyze = bExplainAnalyze;
+    if (!analyze) {
+        return OpenOp();
+    }
+
+    chrono::steady_clock::time_point start;
+    int pagesPinned, bufferMisses;
+    StartMeasure(start, pagesPinned, bufferMisses);
+    RC rc = OpenOp();
+    EndMeasure(start, pagesPinned, bufferMisses);
+    statistics.loops++;
+    return rc;
+}
+
+// Close the operator
+RC QL_Op::Close() {
+    if (!analyze) {
+        return CloseOp();
+    }
+
+    chrono::steady_clock::time_point start;
+    int pagesPinned, bufferMisses;
+    StartMeasure(start, pagesPinned, bufferMisses);
+    RC rc = CloseOp();
+    EndMeasure(start, pagesPinned, bufferMisses);
+    return rc;
+}
+
+// Get the next tuple
+RC QL_Op::GetNext(char* recordData) {
+    if (!analyze) {
+        return GetNextOp(recordData);
+    }
+
+    chrono::steady_clock::time_point start;
+    int pagesPinned, bufferMisses;
+    StartMeasure(start, pagesPinned, bufferMisses);
+    RC rc = GetNextOp(recordData);
+    EndMeasure(start, pagesPinned, bufferMisses);
+    statistics.calls++;
+    if (rc == OK_RC) {
+        statistics.rows++;
+    }
+    return rc;
+}
+
+// Print the runtime statistics after the operator in the query plan
+void QL_Op::PrintStatistics() const {
+    if (!bExplainAnalyze) {
+        return;
+    }
+
+    char buffer[200];
+    sprintf(buffer, " (loops=%ld rows=%ld calls=%ld time=%.3f ms pages=%ld misses=%ld)",
+            statistics.loops, statistics.rows, statistics.calls, statistics.nanoseconds / 1e6,
+            statistics.pagesPinned, statistics.bufferMisses);
+    cout << buffer;
+}
+
+// Read the clock and the page counters of the thread before a method of the operator
+void QL_Op::StartMeasure(chrono::steady_clock::time_point &start, int &pagesPinned, int &bufferMisses) const {
+    PF_GetPageCounts(pagesPinned, bufferMisses);
+    start = chrono::steady_clock::now();
+}
+
+// Add the time and pages of a method of the operator to its statistics
+void QL_Op::EndMeasure(const chrono::steady_clock::time_point &start, int pagesPinned, int bufferMisses) {
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    int endPagesPinned, endBufferMisses;
+    PF_GetPageCounts(endPagesPinned, endBufferMisses);
+    statistics.nanoseconds += chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+    statistics.pagesPinned += endPagesPinned - pagesPinned;
+    statistics.bufferMisses += endBufferMisses - bufferMisses;
+}
+
+
 /********** QL_IndexScanOp class **********/
 
 // Constructor
 QL_IndexScanOp::QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
-                               const char* relName, char* attrName, CompOp op, const Value* v) {
+                               const char* relName, char* attrName, CompOp op, const Value* v)
+    : QL_IndexScanOp(smManager, ixManager, rmManager, relName, attrName, op, v, NO_OP, NULL) {
+}
+
+// Constructor for a range scan between a lower and an upper bound
+QL_IndexScanOp::QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                               const char* relName, char* attrName, CompOp lowerOp, const Value* lowerV,
+                               CompOp upperOp, const Value* upperV) {
     // Store the objects
     this->smManager = smManager;
     this->ixManager = ixManager;
@@ -33,10 +129,17 @@ QL_IndexScanOp::QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_
     strcpy(this->relName, relName);
     memset(this->attrName, 0, MAXNAME+1);
     strcpy(this->attrName, attrName);
-    this->op = op;
+    this->op = lowerOp;
     this->v = new Value;
-    (this->v)->type = v->type;
-    (this->v)->data = v->data;
+    (this->v)->type = lowerV->type;
+    (this->v)->data = lowerV->data;
+    this->upperOp = upperOp;
+    this->upperV = NULL;
+    if (upperOp != NO_OP) {
+        this->upperV = new Value;
+        (this->upperV)->type = upperV->type;
+        (this->upperV)->data = upperV->data;
+    }
 
     // Get the relation information
     SM_RelcatRecord* rcRecord = new SM_RelcatRecord;
@@ -52,6 +155,10 @@ QL_IndexScanOp::QL_IndexScanOp(SM_Manager* smManager, IX_Manager* ixManager, RM_
 
     // Set open flag to FALSE
     isOpen = FALSE;
+    pageOrder = FALSE;
+    sortedFetch = FALSE;
+    keyOrder = FALSE;
+    ridPosition = 0;
 }
 
 // Destructor
@@ -59,10 +166,11 @@ QL_IndexScanOp::~QL_IndexScanOp() {
     // Delete the attrributes array
     delete[] attributes;
     delete v;
+    delete upperV;
 }
 
 // Open the operator
-RC QL_IndexScanOp::Open() {
+RC QL_IndexScanOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -85,7 +193,21 @@ RC QL_IndexScanOp::Open() {
     if ((rc = ixManager->OpenIndex(relName, attrIndexNo, ixIH))) {
         return rc;
     }
-    if ((rc = ixIS.OpenScan(ixIH, op, v->data))) {
+    if (upperOp == NO_OP) {
+        if ((rc = ixIS.OpenScan(ixIH, op, v->data))) {
+            return rc;
+        }
+    }
+    else {
+        if ((rc = ixIS.OpenScan(ixIH, op, v->data, upperOp, upperV->data))) {
+            return rc;
+        }
+    }
+
+    // Collect the RIDs in page order if chosen (unless a parent operator relies on the
+    // key order), else stream them from the index scan
+    sortedFetch = pageOrder && !keyOrder;
+    if (sortedFetch && (rc = CollectRIDs())) {
         return rc;
     }
 
@@ -99,7 +221,7 @@ RC QL_IndexScanOp::Open() {
 }
 
 // Close the operator
-RC QL_IndexScanOp::Close() {
+RC QL_IndexScanOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -120,18 +242,77 @@ RC QL_IndexScanOp::Close() {
         return rc;
     }
 
+    // Clear the RIDs
+    rids.clear();
+    ridPosition = 0;
+
     // Set the flag
     isOpen = FALSE;
 
     return OK_RC;
 }
 
+// Compare two RIDs by page number and then slot number
+static bool CompareRIDsByPage(const RID &rid1, const RID &rid2) {
+    PageNum pageNum1, pageNum2;
+    SlotNum slotNum1, slotNum2;
+    rid1.GetPageNum(pageNum1);
+    rid1.GetSlotNum(slotNum1);
+    rid2.GetPageNum(pageNum2);
+    rid2.GetSlotNum(slotNum2);
+    if (pageNum1 != pageNum2) return pageNum1 < pageNum2;
+    return slotNum1 < slotNum2;
+}
+
+// Collect the RIDs from the index scan
+/* Steps:
+    1) Get all the RIDs from the index scan in key order
+    2) Sort them by page so that each page of the relation is read once instead of at random
+*/
+RC QL_IndexScanOp::CollectRIDs() {
+    int rc;
+    RID rid;
+
+    rids.clear();
+    ridPosition = 0;
+
+    // Get the RIDs from the scan
+    while ((rc = ixIS.GetNextEntry(rid)) != IX_EOF) {
+        if (rc) {
+            return rc;
+        }
+        rids.push_back(rid);
+    }
+
+    // Sort the RIDs by page
+    sort(rids.begin(), rids.end(), CompareRIDsByPage);
+
+    return OK_RC;
+}
+
+// Get the next RID - from the collected RIDs, or else from the index scan
+RC QL_IndexScanOp::GetNextRID(RID &rid) {
+    if (sortedFetch) {
+        if (ridPosition == rids.size()) {
+            return QL_EOF;
+        }
+        rid = rids[ridPosition++];
+        return OK_RC;
+    }
+
+    int rc = ixIS.GetNextEntry(rid);
+    if (rc == IX_EOF) {
+        return QL_EOF;
+    }
+    return rc;
+}
+
 // Get the next data
 /* Steps:
-    1) Get the next record from the index scan
-    2) Copy the data to the return parameter
+    1) Get the next RID
+    2) Get the record and copy the data to the return parameter
 */
-RC QL_IndexScanOp::GetNext(char* recordData) {
+RC QL_IndexScanOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -142,22 +323,17 @@ RC QL_IndexScanOp::GetNext(char* recordData) {
     RM_Record rec;
     char* data;
 
-    // Get the next record from the scan
-    rc = ixIS.GetNextEntry(rid);
-    if (rc == IX_EOF) {
-        return QL_EOF;
+    // Get the next RID
+    if ((rc = GetNextRID(rid))) {
+        return rc;
     }
-    else if (rc) {
+
+    // Get the record from the file
+    if ((rc = rmFH.GetRec(rid, rec))) {
         return rc;
     }
-    else {
-        // Get the record from the file
-        if ((rc = rmFH.GetRec(rid, rec))) {
-            return rc;
-        }
-        if ((rc = rec.GetData(data))) {
-            return rc;
-        }
+    if ((rc = rec.GetData(data))) {
+        return rc;
     }
 
     // Copy the data to the return parameter
@@ -173,19 +349,8 @@ RC QL_IndexScanOp::GetNext(RID &rid) {
         return QL_OPERATOR_CLOSED;
     }
 
-    int rc;
-    RM_Record rec;
-
-    // Get the next record from the scan
-    rc = ixIS.GetNextEntry(rid);
-    if (rc == IX_EOF) {
-        return QL_EOF;
-    }
-    else if (rc) {
-        return rc;
-    }
-
-    return OK_RC;
+    // Get the next RID
+    return GetNextRID(rid);
 }
 
 // Get the attribute count
@@ -200,6 +365,24 @@ void QL_IndexScanOp::GetAttributeInfo(DataAttrInfo* attributes) {
     }
 }
 
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_IndexScanOp::IsOrderedOn(const char* relName, const char* attrName) {
+    if (relName != NULL && strcmp(relName, this->relName) != 0) {
+        return false;
+    }
+    return strcmp(attrName, this->attrName) == 0;
+}
+
+// Keep the key order of the index scan
+void QL_IndexScanOp::KeepOrder() {
+    keyOrder = TRUE;
+}
+
+// Fetch the records in page order (chosen when many entries are estimated to match)
+void QL_IndexScanOp::FetchInPageOrder() {
+    pageOrder = TRUE;
+}
+
 // Print the physical query plan
 void QL_IndexScanOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
@@ -208,7 +391,17 @@ void QL_IndexScanOp::Print(int indentationLevel) {
     cout << relName << ", " << attrName;
     PrintOperator(op);
     PrintValue(v);
-    cout << ")" << endl;
+    if (upperOp != NO_OP) {
+        cout << ", " << attrName;
+        PrintOperator(upperOp);
+        PrintValue(upperV);
+    }
+    if (sortedFetch) {
+        cout << ", sorted RIDs";
+    }
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 }
 
 
@@ -244,6 +437,18 @@ QL_FileScanOp::QL_FileScanOp(SM_Manager* smManager, RM_Manager* rmManager, const
     attributes = new DataAttrInfo[attrCount];
     smManager->GetAttrInfo(relName, attrCount, (char*) attributes);
 
+    // Lay out the attributes contiguously in the returned tuples
+    // (the records of the system catalogs have padding between the attributes)
+    recordOffsets = new int[attrCount];
+    int compactLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        recordOffsets[i] = attributes[i].offset;
+        attributes[i].offset = compactLength;
+        compactLength += attributes[i].attrLength;
+    }
+    padded = compactLength != tupleLength;
+    tupleLength = compactLength;
+
     // Set open flag to FALSE
     isOpen = FALSE;
 }
@@ -260,11 +465,14 @@ QL_FileScanOp::QL_FileScanOp(SM_Manager* smManager, RM_Manager* rmManager, const
     // Store the attributes information
     this->attrCount = attrCount;
     this->attributes = new DataAttrInfo[attrCount];
+    this->recordOffsets = new int[attrCount];
     this->tupleLength = 0;
     for (int i=0; i<attrCount; i++) {
         this->attributes[i] = attributes[i];
+        this->recordOffsets[i] = attributes[i].offset;
         this->tupleLength += attributes[i].attrLength;
     }
+    padded = FALSE;
 
     // Set open flag to FALSE
     isOpen = FALSE;
@@ -274,13 +482,14 @@ QL_FileScanOp::QL_FileScanOp(SM_Manager* smManager, RM_Manager* rmManager, const
 QL_FileScanOp::~QL_FileScanOp() {
     // Delete the attributes array
     delete[] attributes;
+    delete[] recordOffsets;
     if (cond) {
         delete v;
     }
 }
 
 // Open the operator
-RC QL_FileScanOp::Open() {
+RC QL_FileScanOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -295,14 +504,18 @@ RC QL_FileScanOp::Open() {
     // Open the RM file scan
     if (cond) {
         // Get the scan attribute information
-        DataAttrInfo* attributeData = new DataAttrInfo;
-        if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, relName, attrName, (char*) attributeData))) {
-            return rc;
+        int scanAttr = -1;
+        for (int i=0; i<attrCount; i++) {
+            if (strcmp(attributes[i].attrName, attrName) == 0) {
+                scanAttr = i;
+            }
         }
-        if ((rc = rmFS.OpenScan(rmFH, attributeData->attrType, attributeData->attrLength, attributeData->offset, op, v->data))) {
+        if (scanAttr == -1) {
+            return QL_ATTRIBUTE_NOT_FOUND;
+        }
+        if ((rc = rmFS.OpenScan(rmFH, attributes[scanAttr].attrType, attributes[scanAttr].attrLength, recordOffsets[scanAttr], op, v->data))) {
             return rc;
         }
-        delete attributeData;
     }
     else {
         if ((rc = rmFS.OpenScan(rmFH, INT, 4, 0, NO_OP, NULL))) {
@@ -317,7 +530,7 @@ RC QL_FileScanOp::Open() {
 }
 
 // Close the operator
-RC QL_FileScanOp::Close() {
+RC QL_FileScanOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -344,7 +557,7 @@ RC QL_FileScanOp::Close() {
     1) Get the next record from the file scan
     2) Copy the data to the return parameter
 */
-RC QL_FileScanOp::GetNext(char* recordData) {
+RC QL_FileScanOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -371,7 +584,14 @@ RC QL_FileScanOp::GetNext(char* recordData) {
     }
 
     // Copy the data to the return parameter
-    memcpy(recordData, data, tupleLength);
+    if (padded) {
+        for (int i=0; i<attrCount; i++) {
+            memcpy(recordData + attributes[i].offset, data + recordOffsets[i], attributes[i].attrLength);
+        }
+    }
+    else {
+        memcpy(recordData, data, tupleLength);
+    }
 
     return OK_RC;
 }
@@ -404,6 +624,24 @@ RC QL_FileScanOp::GetNext(RID &rid) {
     return OK_RC;
 }
 
+// Get the number of the last page of the open file
+RC QL_FileScanOp::GetLastPageNum(PageNum &pageNum) const {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+    return rmFH.GetLastPageNum(pageNum);
+}
+
+// Restart the scan on the pages [startPage, endPage)
+RC QL_FileScanOp::SetPageRange(PageNum startPage, PageNum endPage) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+    return rmFS.SetPageRange(startPage, endPage);
+}
+
 // Get the attribute count
 void QL_FileScanOp::GetAttributeCount(int &attrCount) {
     attrCount = this->attrCount;
@@ -420,14 +658,23 @@ void QL_FileScanOp::GetAttributeInfo(DataAttrInfo* attributes) {
 void QL_FileScanOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
 
+    // EX - A file of tuples received from the other data nodes is named after its relation
+    // with a leading dot
     cout << "FileScanOp (";
-    cout << relName;
+    if (relName[0] == '.' && attrCount > 0) {
+        cout << attributes[0].relName << ", received";
+    }
+    else {
+        cout << relName;
+    }
     if (cond) {
         cout << ", " << attrName;
         PrintOperator(op);
         PrintValue(v);
     }
-    cout << ")" << endl;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 }
 
 
@@ -440,29 +687,43 @@ QL_ProjectOp::QL_ProjectOp(SM_Manager* smManager, shared_ptr<QL_Op> childOp, int
     this->childOp = childOp;
     this->relAttrCount = count;
 
-    // Copy the relAttrs array
-    this->relAttrs = new RelAttr[count];
-    for (int i=0; i<count; i++) {
-        this->relAttrs[i].relName = relAttrs[i].relName;
-        this->relAttrs[i].attrName = relAttrs[i].attrName;
-    }
-
     // Create the attributes array
+    // (types and lengths come from the child, whose attributes may not be in the catalog,
+    // e.g. aggregates)
+    int childAttrCount;
+    childOp->GetAttributeCount(childAttrCount);
+    DataAttrInfo* childAttributes = new DataAttrInfo[childAttrCount];
+    childOp->GetAttributeInfo(childAttributes);
     attributes = new DataAttrInfo[count];
-    SM_AttrcatRecord* acRecord = new SM_AttrcatRecord;
+    DataAttrInfo* childAttrData = new DataAttrInfo;
     int currentOffset = 0;
     for (int i=0; i<count; i++) {
-        smManager->GetAttrInfo(relAttrs[i].relName, relAttrs[i].attrName, acRecord);
+        GetAttrInfoFromArray((char*) childAttributes, childAttrCount, relAttrs[i].relName, relAttrs[i].attrName, (char*) childAttrData);
         if (relAttrs[i].relName == NULL) attributes[i].relName[0] = '\0';
         else strcpy(attributes[i].relName, relAttrs[i].relName);
         strcpy(attributes[i].attrName, relAttrs[i].attrName);
         attributes[i].offset = currentOffset;
-        attributes[i].attrType = acRecord->attrType;
-        attributes[i].attrLength = acRecord->attrLength;
+        attributes[i].attrType = childAttrData->attrType;
+        attributes[i].attrLength = childAttrData->attrLength;
         attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
         currentOffset += attributes[i].attrLength;
     }
-    delete acRecord;
+    delete childAttrData;
+    delete[] childAttributes;
+
+    // Copy the relAttrs array
+    // (the names point to the attributes array, so that the projected attributes may come from
+    // a temporary array of the caller)
+    this->relAttrs = new RelAttr[count];
+    for (int i=0; i<count; i++) {
+        this->relAttrs[i].relName = relAttrs[i].relName == NULL ? NULL : attributes[i].relName;
+        this->relAttrs[i].attrName = attributes[i].attrName;
+    }
+
+    // The child layout is bound when the operator is opened
+    childOffsets = NULL;
+    childData = NULL;
 
     // Set open flag to FALSE
     isOpen = FALSE;
@@ -470,13 +731,20 @@ QL_ProjectOp::QL_ProjectOp(SM_Manager* smManager, shared_ptr<QL_Op> childOp, int
 
 // Destructor
 QL_ProjectOp::~QL_ProjectOp() {
-    // Delete the relAttrs and attributes array
+    // Delete the relAttrs, attributes, childOffsets and childData arrays
     delete[] relAttrs;
     delete[] attributes;
+    delete[] childOffsets;
+    delete[] childData;
 }
 
 // Open the operator
-RC QL_ProjectOp::Open() {
+/* Steps:
+    1) Open the child operator
+    2) Bind the offset of each projected attribute in the child tuple
+    3) Allocate the child tuple
+*/
+RC QL_ProjectOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -488,6 +756,35 @@ RC QL_ProjectOp::Open() {
         return rc;
     }
 
+    // Get the child attribute information
+    int childAttrCount;
+    childOp->GetAttributeCount(childAttrCount);
+    DataAttrInfo* childAttributes = new DataAttrInfo[childAttrCount];
+    childOp->GetAttributeInfo(childAttributes);
+    int childTupleLength = 0;
+    for (int i=0; i<childAttrCount; i++) {
+        childTupleLength += childAttributes[i].attrLength;
+    }
+
+    // Bind the offsets of the projected attributes
+    delete[] childOffsets;
+    childOffsets = new int[relAttrCount];
+    DataAttrInfo* originalAttrData = new DataAttrInfo;
+    for (int i=0; i<relAttrCount; i++) {
+        if ((rc = GetAttrInfoFromArray((char*) childAttributes, childAttrCount, attributes[i].relName, attributes[i].attrName, (char*) originalAttrData))) {
+            delete[] childAttributes;
+            delete originalAttrData;
+            return rc;
+        }
+        childOffsets[i] = originalAttrData->offset;
+    }
+    delete[] childAttributes;
+    delete originalAttrData;
+
+    // Allocate the child tuple
+    delete[] childData;
+    childData = new char[childTupleLength];
+
     // Set the flag
     isOpen = TRUE;
 
@@ -495,7 +792,7 @@ RC QL_ProjectOp::Open() {
 }
 
 // Close the operator
-RC QL_ProjectOp::Close() {
+RC QL_ProjectOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -515,47 +812,25 @@ RC QL_ProjectOp::Close() {
 
 // Get the next data
 /* Steps:
-    1) Get the child attribute information
-    2) Get the next data tuple from the child
-    3) Construct a new tuple for the required attributes
-    4) Copy the tuple to the return parameter
+    1) Get the next data tuple from the child
+    2) Copy the required attributes from their bound offsets to the return parameter
 */
-RC QL_ProjectOp::GetNext(char* recordData) {
+RC QL_ProjectOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    // Get the child attribute information
-    int rc;
-    int childAttrCount;
-    childOp->GetAttributeCount(childAttrCount);
-    DataAttrInfo* childAttributes = new DataAttrInfo[childAttrCount];
-    childOp->GetAttributeInfo(childAttributes);
-    int tupleLength = 0;
-    for (int i=0; i<childAttrCount; i++) {
-        tupleLength += childAttributes[i].attrLength;
-    }
-    char* data = new char[tupleLength];
-
     // Get the next record data from the child
-    if ((rc = childOp->GetNext(data))) {
-        delete[] childAttributes;
-        delete[] data;
+    int rc;
+    if ((rc = childOp->GetNext(childData))) {
         return rc;
     }
 
     // Create the new tuple for the required attributes
-    DataAttrInfo* originalAttrData = new DataAttrInfo;
     for (int i=0; i<relAttrCount; i++) {
-        if ((rc = GetAttrInfoFromArray((char*) childAttributes, childAttrCount, attributes[i].relName, attributes[i].attrName, (char*) originalAttrData))) {
-            return rc;
-        }
-        memcpy(recordData + attributes[i].offset, data + originalAttrData->offset, attributes[i].attrLength);
+        memcpy(recordData + attributes[i].offset, childData + childOffsets[i], attributes[i].attrLength);
     }
-    delete[] childAttributes;
-    delete originalAttrData;
-    delete[] data;
 
     return OK_RC;
 }
@@ -572,17 +847,30 @@ void QL_ProjectOp::GetAttributeInfo(DataAttrInfo* attributes) {
     }
 }
 
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_ProjectOp::IsOrderedOn(const char* relName, const char* attrName) {
+    return childOp->IsOrderedOn(relName, attrName);
+}
+
+// Keep the order of the child operator
+void QL_ProjectOp::KeepOrder() {
+    childOp->KeepOrder();
+}
+
 // Print the physical query plan
 void QL_ProjectOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
 
     cout << "ProjectOp (";
     for (int i=0; i<relAttrCount; i++) {
-        if (relAttrs[i].relName != NULL) cout << relAttrs[i].relName << ".";
-        cout << relAttrs[i].attrName;
+        char name[MAXPRINTSTRING];
+        GetQualifiedAttrName(relAttrs[i].relName, relAttrs[i].attrName, name);
+        cout << name;
         if (i != relAttrCount-1) cout << ", ";
     }
-    cout << ")" << endl;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "[" << endl;
@@ -617,7 +905,11 @@ QL_FilterOp::~QL_FilterOp() {
 }
 
 // Open the operator
-RC QL_FilterOp::Open() {
+/* Steps:
+    1) Open the child operator
+    2) Bind the filter condition to the child tuple layout
+*/
+RC QL_FilterOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -629,6 +921,11 @@ RC QL_FilterOp::Open() {
         return rc;
     }
 
+    // Bind the filter condition
+    if ((rc = CompileCondition(filterCond, attributes, attrCount, compiledCond))) {
+        return rc;
+    }
+
     // Set the flag
     isOpen = TRUE;
 
@@ -636,7 +933,7 @@ RC QL_FilterOp::Open() {
 }
 
 // Close the operator
-RC QL_FilterOp::Close() {
+RC QL_FilterOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -656,112 +953,25 @@ RC QL_FilterOp::Close() {
 
 // Get the next data
 /* Steps:
-    1) Get the next data tuple from the child
-    2) Check the required condition on the tuple
-    3) If satisfied, copy the tuple to the return parameter
-    4) Else go to step 1 till QL_EOF
+    1) Get the next data tuple from the child into the return parameter
+    2) Check the bound condition on the tuple
+    3) If not satisfied, go to step 1 till QL_EOF
 */
-RC QL_FilterOp::GetNext(char* recordData) {
+RC QL_FilterOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    DataAttrInfo* lhsData = new DataAttrInfo;
-    DataAttrInfo* rhsData = new DataAttrInfo;
-    bool match = false;
-
-    // Get the next record data from the child
+    // Check the condition on the next records
     int rc;
-    int tupleLength = 0;
-    for (int i=0; i<attrCount; i++) {
-        tupleLength += attributes[i].attrLength;
-    }
-    char* data = new char[tupleLength];
-
-    // Check the required condition on the next record
-    while((rc = childOp->GetNext(data)) != QL_EOF) {
-        if (rc) {
-            delete[] data;
-            return rc;
-        }
-
-        // Get the information about the LHS attribute
-        char* lhsRelName = (filterCond.lhsAttr).relName;
-        char* lhsAttrName = (filterCond.lhsAttr).attrName;
-        if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, lhsRelName, lhsAttrName, (char*) lhsData))) {
-            return rc;
-        }
-
-        // If the RHS is also an attribute
-        if (filterCond.bRhsIsAttr) {
-            char* rhsRelName = (filterCond.rhsAttr).relName;
-            char* rhsAttrName = (filterCond.rhsAttr).attrName;
-            if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, rhsRelName, rhsAttrName, (char*) rhsData))) {
-                return rc;
-            }
-
-            if (lhsData->attrType == INT) {
-                int lhsValue, rhsValue;
-                memcpy(&lhsValue, data + (lhsData->offset), sizeof(lhsValue));
-                memcpy(&rhsValue, data + (rhsData->offset), sizeof(rhsValue));
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
-            else if (lhsData->attrType == FLOAT) {
-                float lhsValue, rhsValue;
-                memcpy(&lhsValue, data + (lhsData->offset), sizeof(lhsValue));
-                memcpy(&rhsValue, data + (rhsData->offset), sizeof(rhsValue));
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
-            else {
-                string lhsValue(data + (lhsData->offset));
-                string rhsValue(data + (rhsData->offset));
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
+    while (!(rc = childOp->GetNext(recordData))) {
+        if (EvaluateCondition(compiledCond, recordData, recordData)) {
+            return OK_RC;
         }
-
-        // Else if the RHS is a constant value
-        else {
-            if (lhsData->attrType == INT) {
-                int lhsValue;
-                memcpy(&lhsValue, data + (lhsData->offset), sizeof(lhsValue));
-                int rhsValue = *static_cast<int*>((filterCond.rhsValue).data);
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
-            else if (lhsData->attrType == FLOAT) {
-                float lhsValue;
-                memcpy(&lhsValue, data + (lhsData->offset), sizeof(lhsValue));
-                float rhsValue = *static_cast<float*>((filterCond.rhsValue).data);
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
-            else {
-                string lhsValue(data + (lhsData->offset));
-                char* rhsValueChar = static_cast<char*>((filterCond.rhsValue).data);
-                string rhsValue(rhsValueChar);
-                match = matchRecord(lhsValue, rhsValue, filterCond.op);
-            }
-        }
-
-        if (match) break;
     }
 
-    // If condition is not satisfied, return QL_EOF
-    if (!match || rc == QL_EOF) {
-        delete lhsData;
-        delete rhsData;
-        delete[] data;
-        return QL_EOF;
-    }
-    else {
-        memcpy(recordData, data, tupleLength);
-    }
-
-    // Clean up
-    delete lhsData;
-    delete rhsData;
-    delete[] data;
-
-    return OK_RC;
+    return rc;
 }
 
 // Get the attribute count
@@ -776,6 +986,16 @@ void QL_FilterOp::GetAttributeInfo(DataAttrInfo* attributes) {
     }
 }
 
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_FilterOp::IsOrderedOn(const char* relName, const char* attrName) {
+    return childOp->IsOrderedOn(relName, attrName);
+}
+
+// Keep the order of the child operator
+void QL_FilterOp::KeepOrder() {
+    childOp->KeepOrder();
+}
+
 // Print the physical query plan
 void QL_FilterOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
@@ -802,7 +1022,9 @@ void QL_FilterOp::Print(int indentationLevel) {
             cout << value;
         }
     }
-    cout << ")" << endl;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "[" << endl;
@@ -835,12 +1057,14 @@ QL_CrossProductOp::QL_CrossProductOp(SM_Manager* smManager, std::shared_ptr<QL_O
 
     // Construct the attributes information
     int currentOffset = 0;
-    int leftTupleLength = 0, rightTupleLength = 0;
+    leftTupleLength = 0;
+    rightTupleLength = 0;
     this->attrCount = leftAttrCount + rightAttrCount;
     attributes = new DataAttrInfo[this->attrCount];
     for (int i=0; i<leftAttrCount; i++) {
         attributes[i] = leftAttributes[i];
         attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
         attributes[i].offset = currentOffset;
         currentOffset += leftAttributes[i].attrLength;
         leftTupleLength += leftAttributes[i].attrLength;
@@ -848,6 +1072,7 @@ QL_CrossProductOp::QL_CrossProductOp(SM_Manager* smManager, std::shared_ptr<QL_O
     for (int i=0; i<rightAttrCount; i++) {
         attributes[leftAttrCount+i] = rightAttributes[i];
         attributes[leftAttrCount+i].indexNo = -1;
+        attributes[leftAttrCount+i].indexType = -1;
         attributes[leftAttrCount+i].offset = currentOffset;
         currentOffset += rightAttributes[i].attrLength;
         rightTupleLength += rightAttributes[i].attrLength;
@@ -873,7 +1098,7 @@ QL_CrossProductOp::~QL_CrossProductOp() {
 }
 
 // Open the operator
-RC QL_CrossProductOp::Open() {
+RC QL_CrossProductOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -888,14 +1113,15 @@ RC QL_CrossProductOp::Open() {
         return rc;
     }
 
-    // Set the flag
+    // Set the flags
+    firstTuple = TRUE;
     isOpen = TRUE;
 
     return OK_RC;
 }
 
 // Close the operator
-RC QL_CrossProductOp::Close() {
+RC QL_CrossProductOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -926,32 +1152,12 @@ RC QL_CrossProductOp::Close() {
             - If QL_EOF, return QL_EOF
     3) Construct new tuple by joining left and right data tuples
 */
-RC QL_CrossProductOp::GetNext(char* recordData) {
+RC QL_CrossProductOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    // Get attribute information of left child
-    int leftAttrCount;
-    leftOp->GetAttributeCount(leftAttrCount);
-    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
-    leftOp->GetAttributeInfo(leftAttributes);
-    int leftTupleLength = 0;
-    for (int i=0; i<leftAttrCount; i++) {
-        leftTupleLength += leftAttributes[i].attrLength;
-    }
-
-    // Get attribute information of right child
-    int rightAttrCount;
-    rightOp->GetAttributeCount(rightAttrCount);
-    DataAttrInfo* rightAttributes = new DataAttrInfo[rightAttrCount];
-    rightOp->GetAttributeInfo(rightAttributes);
-    int rightTupleLength = 0;
-    for (int i=0; i<rightAttrCount; i++) {
-        rightTupleLength += rightAttributes[i].attrLength;
-    }
-
     // Check if first tuple
     int rc;
     if (firstTuple) {
@@ -965,8 +1171,6 @@ RC QL_CrossProductOp::GetNext(char* recordData) {
     if ((rc = rightOp->GetNext(rightData)) == QL_EOF) {
         // Get next tuple from left child
         if ((rc = leftOp->GetNext(leftData))) {
-            delete[] leftAttributes;
-            delete[] rightAttributes;
             return rc;
         }
 
@@ -978,14 +1182,10 @@ RC QL_CrossProductOp::GetNext(char* recordData) {
             return rc;
         }
         if ((rc = rightOp->GetNext(rightData))) {
-            delete[] leftAttributes;
-            delete[] rightAttributes;
             return rc;
         }
     }
     else if (rc) {
-        delete[] leftAttributes;
-        delete[] rightAttributes;
         return rc;
     }
 
@@ -993,10 +1193,6 @@ RC QL_CrossProductOp::GetNext(char* recordData) {
     memcpy(recordData, leftData, leftTupleLength);
     memcpy(recordData + leftTupleLength, rightData, rightTupleLength);
 
-    // Clean up
-    delete[] leftAttributes;
-    delete[] rightAttributes;
-
     return OK_RC;
 }
 
@@ -1016,7 +1212,9 @@ void QL_CrossProductOp::GetAttributeInfo(DataAttrInfo* attributes) {
 void QL_CrossProductOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
 
-    cout << "CrossProductOp" << endl;
+    cout << "CrossProductOp";
+    PrintStatistics();
+    cout << endl;
 
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "[" << endl;
@@ -1030,9 +1228,11 @@ void QL_CrossProductOp::Print(int indentationLevel) {
 /********** QL_NLJoinOp class **********/
 
 // Constructor
-QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, std::shared_ptr<QL_Op> rightOp, Condition joinCond) {
+QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> leftOp,
+                         std::shared_ptr<QL_Op> rightOp, Condition joinCond) {
     // Store the objects
     this->smManager = smManager;
+    this->rmManager = rmManager;
     this->leftOp = leftOp;
     this->rightOp = rightOp;
     this->joinCond = joinCond;
@@ -1051,12 +1251,14 @@ QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, s
 
     // Construct the attributes information
     int currentOffset = 0;
-    int leftTupleLength = 0, rightTupleLength = 0;
+    leftTupleLength = 0;
+    rightTupleLength = 0;
     this->attrCount = leftAttrCount + rightAttrCount;
     attributes = new DataAttrInfo[this->attrCount];
     for (int i=0; i<leftAttrCount; i++) {
         attributes[i] = leftAttributes[i];
         attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
         attributes[i].offset = currentOffset;
         currentOffset += leftAttributes[i].attrLength;
         leftTupleLength += leftAttributes[i].attrLength;
@@ -1064,6 +1266,7 @@ QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, s
     for (int i=0; i<rightAttrCount; i++) {
         attributes[leftAttrCount+i] = rightAttributes[i];
         attributes[leftAttrCount+i].indexNo = -1;
+        attributes[leftAttrCount+i].indexType = -1;
         attributes[leftAttrCount+i].offset = currentOffset;
         currentOffset += rightAttributes[i].attrLength;
         rightTupleLength += rightAttributes[i].attrLength;
@@ -1071,9 +1274,13 @@ QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, s
     delete[] leftAttributes;
     delete[] rightAttributes;
 
-    // Initialize leftData and rightData
+    // The block is sized when the operator is opened
     firstTuple = TRUE;
-    leftData = new char[leftTupleLength];
+    blockData = NULL;
+    blockCapacity = 0;
+    blockCount = 0;
+    blockIndex = 0;
+    leftEOF = false;
     rightData = new char[rightTupleLength];
 
     // Set open flag to FALSE
@@ -1082,14 +1289,19 @@ QL_NLJoinOp::QL_NLJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, s
 
 // Destructor
 QL_NLJoinOp::~QL_NLJoinOp() {
-    // Delete the attributes, leftData and rightData arrays
+    // Delete the attributes, blockData and rightData arrays
     delete[] attributes;
-    delete[] leftData;
+    delete[] blockData;
     delete[] rightData;
 }
 
 // Open the operator
-RC QL_NLJoinOp::Open() {
+/* Steps:
+    1) Open the children operators
+    2) Bind the join condition to the offsets in the left and right tuples
+    3) Allocate the block of left tuples, from the current buffer pool size
+*/
+RC QL_NLJoinOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
@@ -1104,14 +1316,45 @@ RC QL_NLJoinOp::Open() {
         return rc;
     }
 
-    // Set the flag
+    // Bind the join condition to the joined tuple layout and
+    // move the attributes of the right child to the right tuple
+    if ((rc = CompileCondition(joinCond, attributes, attrCount, compiledCond))) {
+        return rc;
+    }
+    lhsInLeft = true;
+    if (compiledCond.lhsOffset >= leftTupleLength) {
+        lhsInLeft = false;
+        compiledCond.lhsOffset -= leftTupleLength;
+    }
+    rhsInLeft = true;
+    if (compiledCond.rhsOffset >= leftTupleLength) {
+        rhsInLeft = false;
+        compiledCond.rhsOffset -= leftTupleLength;
+    }
+
+    // Allocate the block
+    int capacity = GetJoinBlockPages(rmManager) * PF_PAGE_SIZE / (leftTupleLength > 0 ? leftTupleLength : 1);
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    if (capacity != blockCapacity) {
+        delete[] blockData;
+        blockData = new char[capacity * leftTupleLength];
+        blockCapacity = capacity;
+    }
+
+    // Set the flags
+    firstTuple = TRUE;
+    leftEOF = false;
+    blockCount = 0;
+    blockIndex = 0;
     isOpen = TRUE;
 
     return OK_RC;
 }
 
 // Close the operator
-RC QL_NLJoinOp::Close() {
+RC QL_NLJoinOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
@@ -1132,67 +1375,78 @@ RC QL_NLJoinOp::Close() {
     return OK_RC;
 }
 
+// Method: ReadBlock()
+// Read the next block of tuples from the left child (blockCount is 0 after the last one)
+RC QL_NLJoinOp::ReadBlock() {
+    int rc;
+    blockCount = 0;
+    blockIndex = 0;
+    while (!leftEOF && blockCount < blockCapacity) {
+        if ((rc = leftOp->GetNext(blockData + blockCount * leftTupleLength)) == QL_EOF) {
+            leftEOF = true;
+        }
+        else if (rc) {
+            return rc;
+        }
+        else {
+            blockCount++;
+        }
+    }
+    return OK_RC;
+}
+
 // Get the next data
 /* Steps:
-    1) Check leftData
-        - If NULL, get next data tuple from left child
-    2) Get next data tuple from right child
-        - If QL_EOF, get next data tuple from left child
-                     and first tuple from right child
-            - If QL_EOF, return QL_EOF
-    3) Check if the current tuple satisfies the condition
-    4) Construct new tuple by joining left and right data tuples
+    1) On the first call, read the first block of left tuples and the first right tuple
+    2) Join the current right tuple with the next left tuple of the block
+    3) When the block is done, get the next right tuple and start the block again
+        - If QL_EOF, read the next block of left tuples and scan the right child again
+            - If there is no left tuple left, return QL_EOF
+    4) Construct new tuple by joining the left and right data tuples that satisfy the condition
 */
-RC QL_NLJoinOp::GetNext(char* recordData) {
+RC QL_NLJoinOp::GetNextOp(char* recordData) {
     // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    // Get attribute information of left child
-    int leftAttrCount;
-    leftOp->GetAttributeCount(leftAttrCount);
-    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
-    leftOp->GetAttributeInfo(leftAttributes);
-    int leftTupleLength = 0;
-    for (int i=0; i<leftAttrCount; i++) {
-        leftTupleLength += leftAttributes[i].attrLength;
-    }
-
-    // Get attribute information of right child
-    int rightAttrCount;
-    rightOp->GetAttributeCount(rightAttrCount);
-    DataAttrInfo* rightAttributes = new DataAttrInfo[rightAttrCount];
-    rightOp->GetAttributeInfo(rightAttributes);
-    int rightTupleLength = 0;
-    for (int i=0; i<rightAttrCount; i++) {
-        rightTupleLength += rightAttributes[i].attrLength;
-    }
-
     // Check if first tuple
     int rc;
     if (firstTuple) {
-        if ((rc = leftOp->GetNext(leftData))) {
+        if ((rc = ReadBlock())) {
+            return rc;
+        }
+        if (blockCount == 0) {
+            return QL_EOF;
+        }
+        if ((rc = rightOp->GetNext(rightData))) {
             return rc;
         }
         firstTuple = FALSE;
     }
 
-    DataAttrInfo* lhsAttribute = new DataAttrInfo;
-    DataAttrInfo* rhsAttribute = new DataAttrInfo;
-    bool match = false;
+    while (true) {
+        // Join the right tuple with the rest of the block
+        while (blockIndex < blockCount) {
+            const char* leftData = blockData + blockIndex * leftTupleLength;
+            blockIndex++;
+            if (EvaluateCondition(compiledCond, lhsInLeft ? leftData : rightData, rhsInLeft ? leftData : rightData)) {
+                // Construct new tuple by joining left and right data tuples
+                memcpy(recordData, leftData, leftTupleLength);
+                memcpy(recordData + leftTupleLength, rightData, rightTupleLength);
+                return OK_RC;
+            }
+        }
 
-    while (!match) {
         // Get the next tuple from the right child
         if ((rc = rightOp->GetNext(rightData)) == QL_EOF) {
-            // Get next tuple from left child
-            if ((rc = leftOp->GetNext(leftData))) {
-                delete[] leftAttributes;
-                delete[] rightAttributes;
-                delete lhsAttribute;
-                delete rhsAttribute;
+            // Get next block from left child
+            if ((rc = ReadBlock())) {
                 return rc;
             }
+            if (blockCount == 0) {
+                return QL_EOF;
+            }
 
             // Get first tuple from right child
             if ((rc = rightOp->Close())) {
@@ -1202,66 +1456,14 @@ RC QL_NLJoinOp::GetNext(char* recordData) {
                 return rc;
             }
             if ((rc = rightOp->GetNext(rightData))) {
-                delete[] leftAttributes;
-                delete[] rightAttributes;
-                delete lhsAttribute;
-                delete rhsAttribute;
                 return rc;
             }
         }
         else if (rc) {
-            delete[] leftAttributes;
-            delete[] rightAttributes;
-            delete lhsAttribute;
-            delete rhsAttribute;
-            return rc;
-        }
-
-        // Construct new tuple by joining left and right data tuples
-        memcpy(recordData, leftData, leftTupleLength);
-        memcpy(recordData + leftTupleLength, rightData, rightTupleLength);
-
-        // Get the information about the LHS attribute
-        char* lhsRelName = (joinCond.lhsAttr).relName;
-        char* lhsAttrName = (joinCond.lhsAttr).attrName;
-        if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, lhsRelName, lhsAttrName, (char*) lhsAttribute))) {
-            return rc;
-        }
-
-        // Get the information about the RHS attribute
-        char* rhsRelName = (joinCond.rhsAttr).relName;
-        char* rhsAttrName = (joinCond.rhsAttr).attrName;
-        if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, rhsRelName, rhsAttrName, (char*) rhsAttribute))) {
             return rc;
         }
-
-        // Check the tuple for the join condition
-        if (lhsAttribute->attrType == INT) {
-            int lhsValue, rhsValue;
-            memcpy(&lhsValue, recordData + (lhsAttribute->offset), sizeof(lhsValue));
-            memcpy(&rhsValue, recordData + (rhsAttribute->offset), sizeof(rhsValue));
-            match = matchRecord(lhsValue, rhsValue, joinCond.op);
-        }
-        else if (lhsAttribute->attrType == FLOAT) {
-            float lhsValue, rhsValue;
-            memcpy(&lhsValue, recordData + (lhsAttribute->offset), sizeof(lhsValue));
-            memcpy(&rhsValue, recordData + (rhsAttribute->offset), sizeof(rhsValue));
-            match = matchRecord(lhsValue, rhsValue, joinCond.op);
-        }
-        else {
-            string lhsValue(recordData + (lhsAttribute->offset));
-            string rhsValue(recordData + (rhsAttribute->offset));
-            match = matchRecord(lhsValue, rhsValue, joinCond.op);
-        }
+        blockIndex = 0;
     }
-
-    // Clean up
-    delete[] leftAttributes;
-    delete[] rightAttributes;
-    delete lhsAttribute;
-    delete rhsAttribute;
-
-    return OK_RC;
 }
 
 // Get the attribute count
@@ -1286,7 +1488,9 @@ void QL_NLJoinOp::Print(int indentationLevel) {
     PrintOperator(joinCond.op);
     cout << (joinCond.rhsAttr).relName << ".";
     cout << (joinCond.rhsAttr).attrName;
-    cout << ")" << endl;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "[" << endl;
@@ -1297,66 +1501,184 @@ void QL_NLJoinOp::Print(int indentationLevel) {
 }
 
 
-/********** QL_ShuffleDataOp **********/
+/********** QL_IndexNLJoinOp class **********/
 
 // Constructor
-QL_ShuffleDataOp::QL_ShuffleDataOp(RM_Manager* rmManager, shared_ptr<QL_Op> childOp, int fromNode, int toNode) {
-    // Copy the members
+QL_IndexNLJoinOp::QL_IndexNLJoinOp(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                                   std::shared_ptr<QL_Op> leftOp, const char* innerRelName, Condition joinCond) {
+    // Store the objects
+    this->smManager = smManager;
+    this->ixManager = ixManager;
     this->rmManager = rmManager;
-    this->rmFH = rmFH;
-    this->childOp = childOp;
-    this->fromNode = fromNode;
-    this->toNode = toNode;
+    this->leftOp = leftOp;
+    this->joinCond = joinCond;
+    memset(this->innerRelName, 0, MAXNAME+1);
+    strcpy(this->innerRelName, innerRelName);
 
-    // Find the tuple length
-    int attrCount;
-    childOp->GetAttributeCount(attrCount);
-    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
-    childOp->GetAttributeInfo(attributes);
-    tupleLength = 0;
-    for (int i=0; i<attrCount; i++) {
-        tupleLength += attributes[i].attrLength;
+    // The first error is kept and returned when the operator is opened
+    int rc;
+    initRC = OK_RC;
+
+    // Get the inner join attribute and the operator to probe its index with
+    const RelAttr* innerAttr = NULL;
+    const RelAttr* outerAttr = NULL;
+    memset(this->innerAttrName, 0, MAXNAME+1);
+    probeOp = NO_OP;
+    if (GetIndexProbe(joinCond, innerRelName, innerAttr, outerAttr, probeOp)) {
+        strcpy(this->innerAttrName, innerAttr->attrName);
+    }
+    else {
+        initRC = QL_INVALID_CONDITION;
     }
-    delete[] attributes;
 
-    // Set open flag to FALSE
+    // Get the attribute information for the left operator
+    int leftAttrCount;
+    leftOp->GetAttributeCount(leftAttrCount);
+    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
+    leftOp->GetAttributeInfo(leftAttributes);
+
+    // Get the attribute information for the inner relation
+    SM_RelcatRecord* rcRecord = new SM_RelcatRecord;
+    memset(rcRecord, 0, sizeof(SM_RelcatRecord));
+    if (!initRC && (rc = smManager->GetRelInfo(innerRelName, rcRecord))) {
+        initRC = rc;
+    }
+    int innerAttrCount = rcRecord->attrCount;
+    innerTupleLength = rcRecord->tupleLength;
+    delete rcRecord;
+    DataAttrInfo* innerAttributes = new DataAttrInfo[innerAttrCount];
+    if (!initRC && (rc = smManager->GetAttrInfo(innerRelName, innerAttrCount, (char*) innerAttributes))) {
+        initRC = rc;
+    }
+
+    // Get the position of the outer join attribute and the index of the inner one
+    outerOffset = 0;
+    outerLength = 0;
+    innerIndexNo = -1;
+    int probeLength = 1;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    if (!initRC && (rc = GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, outerAttr->relName,
+                                              outerAttr->attrName, (char*) attributeData))) {
+        initRC = rc;
+    }
+    if (!initRC) {
+        outerOffset = attributeData->offset;
+        outerLength = attributeData->attrLength;
+    }
+    if (!initRC && (rc = GetAttrInfoFromArray((char*) innerAttributes, innerAttrCount, innerRelName,
+                                              innerAttr->attrName, (char*) attributeData))) {
+        initRC = rc;
+    }
+    if (!initRC) {
+        innerIndexNo = attributeData->indexNo;
+        probeLength = (outerLength > attributeData->attrLength ? outerLength : attributeData->attrLength) + 1;
+    }
+    delete attributeData;
+
+    // Construct the attributes information
+    int currentOffset = 0;
+    leftTupleLength = 0;
+    this->attrCount = leftAttrCount + innerAttrCount;
+    attributes = new DataAttrInfo[this->attrCount];
+    for (int i=0; i<leftAttrCount; i++) {
+        attributes[i] = leftAttributes[i];
+        attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
+        attributes[i].offset = currentOffset;
+        currentOffset += leftAttributes[i].attrLength;
+        leftTupleLength += leftAttributes[i].attrLength;
+    }
+    for (int i=0; i<innerAttrCount; i++) {
+        attributes[leftAttrCount+i] = innerAttributes[i];
+        attributes[leftAttrCount+i].indexNo = -1;
+        attributes[leftAttrCount+i].indexType = -1;
+        attributes[leftAttrCount+i].offset = currentOffset;
+        currentOffset += innerAttributes[i].attrLength;
+    }
+    delete[] leftAttributes;
+    delete[] innerAttributes;
+
+    // Initialize leftData and the probe value
+    leftData = new char[leftTupleLength];
+    probeValue = new char[probeLength];
+    memset(probeValue, 0, probeLength);
+
+    // Set open flags to FALSE
+    scanOpen = FALSE;
     isOpen = FALSE;
 }
 
 // Destructor
-QL_ShuffleDataOp::~QL_ShuffleDataOp() {
-    // Nothing to free
+QL_IndexNLJoinOp::~QL_IndexNLJoinOp() {
+    // Delete the attributes, leftData and probeValue arrays
+    delete[] attributes;
+    delete[] leftData;
+    delete[] probeValue;
 }
 
 // Open the operator
-RC QL_ShuffleDataOp::Open() {
+/* Steps:
+    1) Open the left child
+    2) Open the inner relation and its index
+*/
+RC QL_IndexNLJoinOp::OpenOp() {
     // Check if already open
     if (isOpen) {
         return QL_OPERATOR_OPEN;
     }
 
-    // Open the child operator
+    // Return the error of the constructor
+    if (initRC) {
+        return initRC;
+    }
+
+    // Open the left child
     int rc;
-    if ((rc = childOp->Open())) {
+    if ((rc = leftOp->Open())) {
         return rc;
     }
 
-    // Set the flag
+    // Open the inner relation and its index
+    if ((rc = rmManager->OpenFile(innerRelName, rmFH))) {
+        return rc;
+    }
+    if ((rc = ixManager->OpenIndex(innerRelName, innerIndexNo, ixIH))) {
+        return rc;
+    }
+
+    // Set the flags
+    scanOpen = FALSE;
     isOpen = TRUE;
 
     return OK_RC;
 }
 
 // Close the operator
-RC QL_ShuffleDataOp::Close() {
+RC QL_IndexNLJoinOp::CloseOp() {
     // Check if already closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    // Close the child operator
+    // Close the index scan of the current outer tuple
     int rc;
-    if ((rc = childOp->Close())) {
+    if (scanOpen) {
+        if ((rc = ixIS.CloseScan())) {
+            return rc;
+        }
+        scanOpen = FALSE;
+    }
+
+    // Close the index and the inner relation
+    if ((rc = ixManager->CloseIndex(ixIH))) {
+        return rc;
+    }
+    if ((rc = rmManager->CloseFile(rmFH))) {
+        return rc;
+    }
+
+    // Close the left child
+    if ((rc = leftOp->Close())) {
         return rc;
     }
 
@@ -1366,80 +1688,3282 @@ RC QL_ShuffleDataOp::Close() {
     return OK_RC;
 }
 
-// Get the data from the child operator
+// Get the next data
 /* Steps:
-    1) Check if operator is open
-    2) Insert the records from the child operator
+    1) If no index scan is open, get the next tuple from the left child
+       and open an index scan with its join attribute value
+        - If QL_EOF, return QL_EOF
+    2) Get the next RID from the index scan
+        - If IX_EOF, close the scan and go to the next left tuple
+    3) Construct new tuple by joining the left tuple and the inner record
 */
-RC QL_ShuffleDataOp::GetData(RM_FileHandle &rmFH) {
-    // Check if open
+RC QL_IndexNLJoinOp::GetNextOp(char* recordData) {
+    // Check if closed
     if (!isOpen) {
         return QL_OPERATOR_CLOSED;
     }
 
-    // Insert the records from the child operator
     int rc;
     RID rid;
-    char* recordData = new char[tupleLength];
-    while ((rc = childOp->GetNext(recordData)) != QL_EOF) {
-        if ((rc = rmFH.InsertRec(recordData, rid))) {
+    while (true) {
+        // Probe the index with the next left tuple
+        if (!scanOpen) {
+            if ((rc = leftOp->GetNext(leftData))) {
+                return rc;
+            }
+            memcpy(probeValue, leftData + outerOffset, outerLength);
+            if ((rc = ixIS.OpenScan(ixIH, probeOp, probeValue))) {
+                return rc;
+            }
+            scanOpen = TRUE;
+        }
+
+        // Get the next matching RID
+        if ((rc = ixIS.GetNextEntry(rid)) == IX_EOF) {
+            if ((rc = ixIS.CloseScan())) {
+                return rc;
+            }
+            scanOpen = FALSE;
+            continue;
+        }
+        else if (rc) {
             return rc;
         }
+        break;
+    }
+
+    // Get the inner record
+    RM_Record rec;
+    char* innerData;
+    if ((rc = rmFH.GetRec(rid, rec))) {
+        return rc;
+    }
+    if ((rc = rec.GetData(innerData))) {
+        return rc;
     }
-    delete[] recordData;
+
+    // Construct new tuple by joining left and inner data tuples
+    memcpy(recordData, leftData, leftTupleLength);
+    memcpy(recordData + leftTupleLength, innerData, innerTupleLength);
 
     return OK_RC;
 }
 
-// Print the operator
-void QL_ShuffleDataOp::Print(int indentationLevel) {
+// Get the attribute count
+void QL_IndexNLJoinOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_IndexNLJoinOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_IndexNLJoinOp::Print(int indentationLevel) {
     for (int i=0; i<indentationLevel; i++) cout << "\t";
 
-    cout << "ShuffleDataOp (";
-    cout << fromNode << ", " << toNode;
-    cout << ")" << endl;
+    cout << "IndexNLJoinOp (";
+    cout << (joinCond.lhsAttr).relName << ".";
+    cout << (joinCond.lhsAttr).attrName;
+    PrintOperator(joinCond.op);
+    cout << (joinCond.rhsAttr).relName << ".";
+    cout << (joinCond.rhsAttr).attrName;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
 
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "[" << endl;
-    childOp->Print(indentationLevel+1);
+    leftOp->Print(indentationLevel+1);
+    for (int i=0; i<=indentationLevel; i++) cout << "\t";
+    cout << "IndexProbe (" << innerRelName << ", " << innerAttrName << ")" << endl;
     for (int i=0; i<indentationLevel; i++) cout << "\t";
     cout << "]" << endl;
 }
 
 
-/********** Helper Methods **********/
-
-// Get the string form of the operator
-void PrintOperator(CompOp op) {
-    switch(op) {
-        case EQ_OP:
-            cout << " = ";
-            break;
-        case LT_OP:
-            cout << " < ";
-            break;
-        case GT_OP:
-            cout << " > ";
-            break;
-        case LE_OP:
-            cout << " <= ";
-            break;
-        case GE_OP:
-            cout << " >= ";
-            break;
-        case NE_OP:
-            cout << " != ";
-            break;
-        default:
-            cout << " NO_OP ";
-    }
-}
+/********** QL_HashJoinOp class **********/
 
-// Get the value in a string for printing
-void PrintValue(const Value* v) {
-    AttrType vType = v->type;
-    if (vType == INT) {
-        int value = *static_cast<int*>(v->data);
+// Constructor
+QL_HashJoinOp::QL_HashJoinOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> leftOp,
+                             std::shared_ptr<QL_Op> rightOp, Condition joinCond) {
+    // Store the objects
+    this->smManager = smManager;
+    this->rmManager = rmManager;
+    this->leftOp = leftOp;
+    this->rightOp = rightOp;
+    this->joinCond = joinCond;
+
+    // Number the operator so that its partition files have unique names
+    static int joinCount = 0;
+    joinNumber = joinCount++;
+
+    // Get the attribute information for the left operator
+    int leftAttrCount;
+    leftOp->GetAttributeCount(leftAttrCount);
+    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
+    leftOp->GetAttributeInfo(leftAttributes);
+
+    // Get the attribute information for the right operator
+    int rightAttrCount;
+    rightOp->GetAttributeCount(rightAttrCount);
+    DataAttrInfo* rightAttributes = new DataAttrInfo[rightAttrCount];
+    rightOp->GetAttributeInfo(rightAttributes);
+
+    // Get the join attribute of each input
+    // (the first error is kept and returned when the operator is opened)
+    int rc;
+    initRC = OK_RC;
+    const RelAttr* leftAttr = &joinCond.lhsAttr;
+    const RelAttr* rightAttr = &joinCond.rhsAttr;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    if (GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, leftAttr->relName, leftAttr->attrName, (char*) attributeData)) {
+        leftAttr = &joinCond.rhsAttr;
+        rightAttr = &joinCond.lhsAttr;
+        if ((rc = GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, leftAttr->relName, leftAttr->attrName, (char*) attributeData))) {
+            initRC = rc;
+        }
+    }
+    keyType = INT;
+    leftKeyOffset = 0;
+    leftKeyLength = 0;
+    if (!initRC) {
+        keyType = attributeData->attrType;
+        leftKeyOffset = attributeData->offset;
+        leftKeyLength = attributeData->attrLength;
+    }
+    rightKeyOffset = 0;
+    rightKeyLength = 0;
+    if (!initRC && (rc = GetAttrInfoFromArray((char*) rightAttributes, rightAttrCount, rightAttr->relName, rightAttr->attrName, (char*) attributeData))) {
+        initRC = rc;
+    }
+    if (!initRC) {
+        rightKeyOffset = attributeData->offset;
+        rightKeyLength = attributeData->attrLength;
+    }
+    delete attributeData;
+
+    // Construct the attributes information
+    int currentOffset = 0;
+    leftTupleLength = 0;
+    rightTupleLength = 0;
+    this->attrCount = leftAttrCount + rightAttrCount;
+    attributes = new DataAttrInfo[this->attrCount];
+    for (int i=0; i<leftAttrCount; i++) {
+        attributes[i] = leftAttributes[i];
+        attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
+        attributes[i].offset = currentOffset;
+        currentOffset += leftAttributes[i].attrLength;
+        leftTupleLength += leftAttributes[i].attrLength;
+    }
+    for (int i=0; i<rightAttrCount; i++) {
+        attributes[leftAttrCount+i] = rightAttributes[i];
+        attributes[leftAttrCount+i].indexNo = -1;
+        attributes[leftAttrCount+i].indexType = -1;
+        attributes[leftAttrCount+i].offset = currentOffset;
+        currentOffset += rightAttributes[i].attrLength;
+        rightTupleLength += rightAttributes[i].attrLength;
+    }
+    delete[] leftAttributes;
+    delete[] rightAttributes;
+
+    // Initialize the probe tuple
+    probeData = new char[leftTupleLength > rightTupleLength ? leftTupleLength : rightTupleLength];
+
+    // Set open flags to FALSE
+    spilled = FALSE;
+    partitionScanOpen = FALSE;
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_HashJoinOp::~QL_HashJoinOp() {
+    // Delete the attributes and probeData arrays
+    delete[] attributes;
+    delete[] probeData;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the children operators
+    2) Read tuples from the two children alternately
+        - The child that runs out of tuples first is the smaller input and becomes the build side
+        - If the tuples read exceed the memory budget first, partition both inputs into
+          temporary RM files (Grace hash join)
+    3) Build the hash table on the build side, or on the build side of the first partition
+*/
+RC QL_HashJoinOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Return the error of the constructor
+    if (initRC) {
+        return initRC;
+    }
+
+    // Open the children operators
+    int rc;
+    if ((rc = leftOp->Open())) {
+        return rc;
+    }
+    if ((rc = rightOp->Open())) {
+        return rc;
+    }
+
+    // Read the children alternately until one runs out or the memory budget is exceeded
+    vector<char> leftBuffer, rightBuffer;
+    int leftDone = FALSE, rightDone = FALSE;
+    while (!leftDone && !rightDone) {
+        if (leftBuffer.size() + rightBuffer.size() > QL_HASH_JOIN_MEMORY) {
+            break;
+        }
+        if ((rc = leftOp->GetNext(probeData)) == QL_EOF) {
+            leftDone = TRUE;
+            break;
+        }
+        else if (rc) {
+            return rc;
+        }
+        leftBuffer.insert(leftBuffer.end(), probeData, probeData + leftTupleLength);
+        if ((rc = rightOp->GetNext(probeData)) == QL_EOF) {
+            rightDone = TRUE;
+            break;
+        }
+        else if (rc) {
+            return rc;
+        }
+        rightBuffer.insert(rightBuffer.end(), probeData, probeData + rightTupleLength);
+    }
+
+    matchPosition = -1;
+    spilled = FALSE;
+    partitionScanOpen = FALSE;
+    isOpen = TRUE;
+
+    // Both inputs exceed the memory budget - partition them
+    if (!leftDone && !rightDone) {
+        if ((rc = Partition(leftBuffer, rightBuffer, leftDone, rightDone))) {
+            return rc;
+        }
+        partition = -1;
+        if ((rc = OpenNextPartition()) && rc != QL_EOF) {
+            return rc;
+        }
+        return OK_RC;
+    }
+
+    // Build the hash table on the exhausted input and probe with the other
+    buildIsLeft = leftDone;
+    if (buildIsLeft) {
+        buildTuples.swap(leftBuffer);
+        probeTuples.swap(rightBuffer);
+    }
+    else {
+        buildTuples.swap(rightBuffer);
+        probeTuples.swap(leftBuffer);
+    }
+    probePosition = 0;
+    BuildHashTable();
+
+    return OK_RC;
+}
+
+// Close the operator
+/* Steps:
+    1) Close and destroy the partition files
+    2) Free the hash table
+    3) Close the children operators
+*/
+RC QL_HashJoinOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Close and destroy the partition files
+    int rc;
+    if (spilled) {
+        if (partitionScanOpen) {
+            if ((rc = partitionScan.CloseScan())) {
+                return rc;
+            }
+            partitionScanOpen = FALSE;
+        }
+        for (int i=0; i<QL_HASH_JOIN_PARTITIONS; i++) {
+            if ((rc = rmManager->CloseFile(leftPartitions[i]))) {
+                return rc;
+            }
+            if ((rc = rmManager->DestroyFile(PartitionFileName(true, i).c_str()))) {
+                return rc;
+            }
+            if ((rc = rmManager->CloseFile(rightPartitions[i]))) {
+                return rc;
+            }
+            if ((rc = rmManager->DestroyFile(PartitionFileName(false, i).c_str()))) {
+                return rc;
+            }
+        }
+        spilled = FALSE;
+    }
+
+    // Free the hash table
+    vector<char>().swap(buildTuples);
+    vector<int>().swap(buildNext);
+    vector<QL_HashSlot>().swap(slots);
+    vector<char>().swap(probeTuples);
+
+    // Close the children operators
+    if ((rc = leftOp->Close())) {
+        return rc;
+    }
+    if ((rc = rightOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+/* Steps:
+    1) If build tuples match the current probe tuple, join the next one with it
+    2) Otherwise get the next probe tuple and look up its key in the hash table
+        - If QL_EOF, return QL_EOF
+*/
+RC QL_HashJoinOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    int rc;
+    while (matchPosition == -1) {
+        if ((rc = GetNextProbeTuple())) {
+            return rc;
+        }
+        matchPosition = ProbeHashTable(probeData);
+    }
+
+    // Construct new tuple by joining left and right data tuples
+    if (buildIsLeft) {
+        memcpy(recordData, &buildTuples[matchPosition * leftTupleLength], leftTupleLength);
+        memcpy(recordData + leftTupleLength, probeData, rightTupleLength);
+    }
+    else {
+        memcpy(recordData, probeData, leftTupleLength);
+        memcpy(recordData + leftTupleLength, &buildTuples[matchPosition * rightTupleLength], rightTupleLength);
+    }
+    matchPosition = buildNext[matchPosition];
+
+    return OK_RC;
+}
+
+// Method: Partition(vector<char> &leftBuffer, vector<char> &rightBuffer, int leftDone, int rightDone)
+// Partition both inputs into temporary RM files by the hash of the join attribute
+/* Steps:
+    1) Create and open a file for each partition of each input
+    2) Write the buffered tuples to their partitions
+    3) Write the remaining tuples of the children to their partitions
+*/
+RC QL_HashJoinOp::Partition(vector<char> &leftBuffer, vector<char> &rightBuffer, int leftDone, int rightDone) {
+    // Create and open the partition files
+    int rc;
+    for (int i=0; i<QL_HASH_JOIN_PARTITIONS; i++) {
+        if ((rc = rmManager->CreateFile(PartitionFileName(true, i).c_str(), leftTupleLength))) {
+            return rc;
+        }
+        if ((rc = rmManager->OpenFile(PartitionFileName(true, i).c_str(), leftPartitions[i]))) {
+            return rc;
+        }
+        if ((rc = rmManager->CreateFile(PartitionFileName(false, i).c_str(), rightTupleLength))) {
+            return rc;
+        }
+        if ((rc = rmManager->OpenFile(PartitionFileName(false, i).c_str(), rightPartitions[i]))) {
+            return rc;
+        }
+        leftPartitionCount[i] = 0;
+        rightPartitionCount[i] = 0;
+    }
+    spilled = TRUE;
+
+    // Write the tuples of each input to their partitions
+    // The partition is taken from the high bits of the hash so that the
+    // hash table of a partition still gets well distributed low bits
+    RID rid;
+    for (int side=0; side<2; side++) {
+        bool left = (side == 0);
+        shared_ptr<QL_Op> childOp = left ? leftOp : rightOp;
+        vector<char> &buffer = left ? leftBuffer : rightBuffer;
+        int tupleLength = left ? leftTupleLength : rightTupleLength;
+        int keyOffset = left ? leftKeyOffset : rightKeyOffset;
+        int keyLength = left ? leftKeyLength : rightKeyLength;
+        RM_FileHandle* partitions = left ? leftPartitions : rightPartitions;
+        int* partitionCount = left ? leftPartitionCount : rightPartitionCount;
+        int done = left ? leftDone : rightDone;
+
+        unsigned int position = 0;
+        while (true) {
+            char* tuple;
+            if (position < buffer.size()) {
+                tuple = &buffer[position];
+                position += tupleLength;
+            }
+            else if (done) {
+                break;
+            }
+            else if ((rc = childOp->GetNext(probeData)) == QL_EOF) {
+                break;
+            }
+            else if (rc) {
+                return rc;
+            }
+            else {
+                tuple = probeData;
+            }
+
+            int p = (HashKey(tuple + keyOffset, keyLength) >> 28) % QL_HASH_JOIN_PARTITIONS;
+            if ((rc = partitions[p].InsertRec(tuple, rid))) {
+                return rc;
+            }
+            partitionCount[p]++;
+        }
+        vector<char>().swap(buffer);
+    }
+
+    return OK_RC;
+}
+
+// Method: OpenNextPartition()
+// Build the hash table for the next partition and open a scan on its probe side
+/* Steps:
+    1) Skip the partitions where either side is empty
+    2) Load the smaller side of the partition into memory and build the hash table
+    3) Open a scan on the other side
+    4) Return QL_EOF if no partitions are left
+*/
+RC QL_HashJoinOp::OpenNextPartition() {
+    int rc;
+    if (partitionScanOpen) {
+        if ((rc = partitionScan.CloseScan())) {
+            return rc;
+        }
+        partitionScanOpen = FALSE;
+    }
+
+    // Skip the partitions without matches
+    do {
+        partition++;
+        if (partition >= QL_HASH_JOIN_PARTITIONS) {
+            return QL_EOF;
+        }
+    } while (leftPartitionCount[partition] == 0 || rightPartitionCount[partition] == 0);
+
+    // Load the smaller side into memory
+    // (a skewed partition larger than the memory budget is still joined in memory,
+    // since partitioning it again cannot separate equal keys)
+    buildIsLeft = leftPartitionCount[partition] <= rightPartitionCount[partition];
+    RM_FileHandle &buildFH = buildIsLeft ? leftPartitions[partition] : rightPartitions[partition];
+    RM_FileHandle &probeFH = buildIsLeft ? rightPartitions[partition] : leftPartitions[partition];
+    int buildTupleLength = buildIsLeft ? leftTupleLength : rightTupleLength;
+    buildTuples.clear();
+    RM_FileScan buildScan;
+    RM_Record rec;
+    char* data;
+    if ((rc = buildScan.OpenScan(buildFH, INT, 4, 0, NO_OP, NULL))) {
+        return rc;
+    }
+    while ((rc = buildScan.GetNextRec(rec)) != RM_EOF) {
+        if (rc) {
+            return rc;
+        }
+        if ((rc = rec.GetData(data))) {
+            return rc;
+        }
+        buildTuples.insert(buildTuples.end(), data, data + buildTupleLength);
+    }
+    if ((rc = buildScan.CloseScan())) {
+        return rc;
+    }
+    BuildHashTable();
+
+    // Open the scan on the probe side
+    if ((rc = partitionScan.OpenScan(probeFH, INT, 4, 0, NO_OP, NULL))) {
+        return rc;
+    }
+    partitionScanOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Method: GetNextProbeTuple()
+// Get the next tuple of the probe side into probeData
+RC QL_HashJoinOp::GetNextProbeTuple() {
+    int rc;
+    int probeTupleLength = buildIsLeft ? rightTupleLength : leftTupleLength;
+
+    // Probe with the partition files
+    if (spilled) {
+        if (!partitionScanOpen) {
+            return QL_EOF;
+        }
+        RM_Record rec;
+        char* data;
+        while ((rc = partitionScan.GetNextRec(rec)) == RM_EOF) {
+            if ((rc = OpenNextPartition())) {
+                return rc;
+            }
+            probeTupleLength = buildIsLeft ? rightTupleLength : leftTupleLength;
+        }
+        if (rc) {
+            return rc;
+        }
+        if ((rc = rec.GetData(data))) {
+            return rc;
+        }
+        memcpy(probeData, data, probeTupleLength);
+        return OK_RC;
+    }
+
+    // Nothing can match an empty build side
+    if (buildTuples.empty()) {
+        return QL_EOF;
+    }
+
+    // Probe with the tuples buffered while reading the build side, then with the child
+    if (probePosition < probeTuples.size()) {
+        memcpy(probeData, &probeTuples[probePosition], probeTupleLength);
+        probePosition += probeTupleLength;
+        return OK_RC;
+    }
+    return buildIsLeft ? rightOp->GetNext(probeData) : leftOp->GetNext(probeData);
+}
+
+// Method: BuildHashTable()
+// Build the open addressing table on the build tuples
+/* Steps:
+    1) Size the table to a power of two at least twice the number of tuples
+    2) Insert the tuples in reverse order
+        - A tuple with a key already in the table is put at the head of the key's chain,
+          so that each chain lists its tuples in input order
+        - Otherwise the tuple takes the next empty slot (linear probing)
+*/
+void QL_HashJoinOp::BuildHashTable() {
+    int buildTupleLength = buildIsLeft ? leftTupleLength : rightTupleLength;
+    int keyOffset = buildIsLeft ? leftKeyOffset : rightKeyOffset;
+    int keyLength = buildIsLeft ? leftKeyLength : rightKeyLength;
+    int tupleCount = buildTuples.size() / buildTupleLength;
+
+    // Size the table
+    unsigned int capacity = 16;
+    while (capacity < 2 * (unsigned int) tupleCount) {
+        capacity *= 2;
+    }
+    QL_HashSlot emptySlot = { 0, -1 };
+    slots.assign(capacity, emptySlot);
+    buildNext.assign(tupleCount, -1);
+    unsigned int mask = capacity - 1;
+
+    // Insert the tuples
+    for (int i=tupleCount-1; i>=0; i--) {
+        char* key = &buildTuples[i * buildTupleLength] + keyOffset;
+        unsigned int hash = HashKey(key, keyLength);
+        unsigned int slot = hash & mask;
+        while (slots[slot].head != -1) {
+            char* slotKey = &buildTuples[slots[slot].head * buildTupleLength] + keyOffset;
+            if (slots[slot].hash == hash && MatchKeys(slotKey, keyLength, key, keyLength)) {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        buildNext[i] = slots[slot].head;
+        slots[slot].hash = hash;
+        slots[slot].head = i;
+    }
+}
+
+// Method: ProbeHashTable(const char* probeTuple)
+// Get the first build tuple with the key of the probe tuple (-1 if none)
+int QL_HashJoinOp::ProbeHashTable(const char* probeTuple) {
+    int buildTupleLength = buildIsLeft ? leftTupleLength : rightTupleLength;
+    int buildKeyOffset = buildIsLeft ? leftKeyOffset : rightKeyOffset;
+    int buildKeyLength = buildIsLeft ? leftKeyLength : rightKeyLength;
+    const char* probeKey = probeTuple + (buildIsLeft ? rightKeyOffset : leftKeyOffset);
+    int probeKeyLength = buildIsLeft ? rightKeyLength : leftKeyLength;
+
+    unsigned int mask = slots.size() - 1;
+    unsigned int hash = HashKey(probeKey, probeKeyLength);
+    unsigned int slot = hash & mask;
+    while (slots[slot].head != -1) {
+        char* slotKey = &buildTuples[slots[slot].head * buildTupleLength] + buildKeyOffset;
+        if (slots[slot].hash == hash && MatchKeys(slotKey, buildKeyLength, probeKey, probeKeyLength)) {
+            return slots[slot].head;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// Method: HashKey(const char* key, int keyLength)
+// Hash a value of the join attribute (as the keys of a hash index)
+unsigned int QL_HashJoinOp::HashKey(const char* key, int keyLength) const {
+    return IX_IndexHandle::HashValue(key, keyType, keyLength);
+}
+
+// Method: MatchKeys(const char* key1, int length1, const char* key2, int length2)
+// Boolean whether two values of the join attribute are equal
+// (strings of the two inputs may have different lengths)
+bool QL_HashJoinOp::MatchKeys(const char* key1, int length1, const char* key2, int length2) const {
+    if (keyType == INT) {
+        int value1, value2;
+        memcpy(&value1, key1, sizeof(int));
+        memcpy(&value2, key2, sizeof(int));
+        return value1 == value2;
+    }
+    else if (keyType == FLOAT) {
+        float value1, value2;
+        memcpy(&value1, key1, sizeof(float));
+        memcpy(&value2, key2, sizeof(float));
+        return value1 == value2;
+    }
+    else {
+        int length = length1 < length2 ? length1 : length2;
+        if (strncmp(key1, key2, length) != 0) {
+            return false;
+        }
+        if (length1 > length && key1[length] != '\0') {
+            return false;
+        }
+        if (length2 > length && key2[length] != '\0') {
+            return false;
+        }
+        return true;
+    }
+}
+
+// Method: PartitionFileName(bool left, int partition)
+// Get the name of a partition file
+// (names contain a '.' so they cannot clash with relation names)
+string QL_HashJoinOp::PartitionFileName(bool left, int partition) const {
+    string fileName("hashjoin.");
+    fileName += to_string(getpid()) + "." + to_string(joinNumber);
+    fileName += left ? ".l." : ".r.";
+    fileName += to_string(partition);
+    return fileName;
+}
+
+// Get the attribute count
+void QL_HashJoinOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_HashJoinOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_HashJoinOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "HashJoinOp (";
+    cout << (joinCond.lhsAttr).relName << ".";
+    cout << (joinCond.lhsAttr).attrName;
+    PrintOperator(joinCond.op);
+    cout << (joinCond.rhsAttr).relName << ".";
+    cout << (joinCond.rhsAttr).attrName;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    leftOp->Print(indentationLevel+1);
+    rightOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+/********** QL_SortOp class **********/
+
+// Constructor
+QL_SortOp::QL_SortOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp,
+                     int keyCount, const RelAttr keyAttrs[], const int keyDescending[]) {
+    // Store the objects
+    this->smManager = smManager;
+    this->rmManager = rmManager;
+    this->childOp = childOp;
+    this->keyCount = keyCount;
+
+    // Number the operator so that its run files have unique names
+    static int sortCount = 0;
+    sortNumber = sortCount++;
+
+    // Get the attribute information from the child operator
+    childOp->GetAttributeCount(this->attrCount);
+    attributes = new DataAttrInfo[this->attrCount];
+    childOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+
+    // Copy the sort keys and bind them to the child tuple layout
+    // (the first error is kept and returned when the operator is opened)
+    int rc;
+    initRC = OK_RC;
+    this->keyAttrs = new RelAttr[keyCount];
+    keyTypes = new AttrType[keyCount];
+    keyOffsets = new int[keyCount];
+    keyLengths = new int[keyCount];
+    this->keyDescending = new int[keyCount];
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    for (int i=0; i<keyCount; i++) {
+        this->keyAttrs[i].relName = keyAttrs[i].relName;
+        this->keyAttrs[i].attrName = keyAttrs[i].attrName;
+        keyTypes[i] = INT;
+        keyOffsets[i] = 0;
+        keyLengths[i] = 0;
+        if (!initRC && (rc = GetAttrInfoFromArray((char*) attributes, attrCount, keyAttrs[i].relName, keyAttrs[i].attrName, (char*) attributeData))) {
+            initRC = rc;
+        }
+        if (!initRC) {
+            keyTypes[i] = attributeData->attrType;
+            keyOffsets[i] = attributeData->offset;
+            keyLengths[i] = attributeData->attrLength;
+        }
+        this->keyDescending[i] = keyDescending != NULL && keyDescending[i];
+    }
+    delete attributeData;
+
+    // Initialize the input tuple
+    inputData = new char[tupleLength];
+
+    // Set open flag to FALSE
+    inMemory = TRUE;
+    mergeCount = 0;
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_SortOp::~QL_SortOp() {
+    // Delete the attributes, keys and inputData arrays
+    delete[] attributes;
+    delete[] keyAttrs;
+    delete[] keyTypes;
+    delete[] keyOffsets;
+    delete[] keyLengths;
+    delete[] keyDescending;
+    delete[] inputData;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the child operator
+    2) Read the child tuples into memory, up to the sortMemory budget
+        - If the child runs out of tuples, sort them in memory
+        - Otherwise generate sorted runs and merge them
+*/
+RC QL_SortOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Return the error of the constructor
+    if (initRC) {
+        return initRC;
+    }
+
+    // Open the child operator
+    int rc;
+    if ((rc = childOp->Open())) {
+        return rc;
+    }
+
+    // Read the child tuples into memory
+    int capacity = smManager->getSortMemory() * PF_PAGE_SIZE / tupleLength;
+    if (capacity < 2) {
+        capacity = 2;
+    }
+    tuples.clear();
+    int tupleCount = 0;
+    while (tupleCount < capacity) {
+        if ((rc = childOp->GetNext(inputData)) == QL_EOF) {
+            break;
+        }
+        else if (rc) {
+            return rc;
+        }
+        tuples.insert(tuples.end(), inputData, inputData + tupleLength);
+        tupleCount++;
+    }
+
+    isOpen = TRUE;
+    runCount = 0;
+    mergeCount = 0;
+
+    // Sort in memory if the child ran out of tuples
+    if (rc == QL_EOF) {
+        inMemory = TRUE;
+        sortedTuples.resize(tupleCount);
+        for (int i=0; i<tupleCount; i++) {
+            sortedTuples[i] = i;
+        }
+        stable_sort(sortedTuples.begin(), sortedTuples.end(), [this](int a, int b) {
+            return CompareTuples(&tuples[a * tupleLength], &tuples[b * tupleLength]) < 0;
+        });
+        position = 0;
+        return OK_RC;
+    }
+
+    // Generate the sorted runs
+    inMemory = FALSE;
+    if ((rc = GenerateRuns(capacity))) {
+        return rc;
+    }
+    vector<char>().swap(tuples);
+    vector<int>().swap(runTags);
+
+    // Merge the runs till all of them can be merged at once
+    RID rid;
+    while (runs.size() > QL_SORT_MERGE_FANIN) {
+        int run = runCount++;
+        RM_FileHandle runFH;
+        if ((rc = rmManager->CreateFile(RunFileName(run).c_str(), tupleLength))) {
+            return rc;
+        }
+        if ((rc = rmManager->OpenFile(RunFileName(run).c_str(), runFH))) {
+            return rc;
+        }
+        if ((rc = OpenMerge(QL_SORT_MERGE_FANIN))) {
+            return rc;
+        }
+        while ((rc = GetNextMerged(inputData)) != QL_EOF) {
+            if (rc) {
+                return rc;
+            }
+            if ((rc = runFH.InsertRec(inputData, rid))) {
+                return rc;
+            }
+        }
+        if ((rc = CloseMerge())) {
+            return rc;
+        }
+        if ((rc = rmManager->CloseFile(runFH))) {
+            return rc;
+        }
+        runs.push_back(run);
+    }
+
+    // Open the final merge
+    return OpenMerge(runs.size());
+}
+
+// Close the operator
+/* Steps:
+    1) Close and destroy the runs being merged
+    2) Free the tuples held in memory
+    3) Close the child operator
+*/
+RC QL_SortOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Close and destroy the runs
+    int rc;
+    if ((rc = CloseMerge())) {
+        return rc;
+    }
+
+    // Free the tuples held in memory
+    vector<char>().swap(tuples);
+    vector<int>().swap(runTags);
+    vector<int>().swap(heap);
+    vector<int>().swap(sortedTuples);
+
+    // Close the child operator
+    if ((rc = childOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+/* Steps:
+    1) If sorted in memory, return the next sorted tuple
+    2) Otherwise return the smallest current tuple of the runs being merged
+*/
+RC QL_SortOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Get the next tuple sorted in memory
+    if (inMemory) {
+        if (position == sortedTuples.size()) {
+            return QL_EOF;
+        }
+        memcpy(recordData, &tuples[sortedTuples[position++] * tupleLength], tupleLength);
+        return OK_RC;
+    }
+
+    // Get the next merged tuple
+    return GetNextMerged(recordData);
+}
+
+// Method: GenerateRuns(int capacity)
+// Write the input to sorted runs with replacement selection
+/* Steps:
+    1) Make a heap of the tuples in memory, ordered by run and then by key
+    2) Write the smallest tuple to the current run, starting a new run when the
+       smallest tuple belongs to the next one
+    3) Replace it by the next child tuple
+        - If its key is not smaller than the tuple written, it goes to the current run
+        - Otherwise it goes to the next run
+    4) Repeat till the heap is empty
+    The runs are about twice the memory budget on average, and a single run for sorted input
+*/
+RC QL_SortOp::GenerateRuns(int capacity) {
+    int rc;
+    RID rid;
+
+    // Make a heap of the tuples in memory
+    auto heapCompare = [this](int a, int b) {
+        if (runTags[a] != runTags[b]) {
+            return runTags[a] > runTags[b];
+        }
+        return CompareTuples(&tuples[a * tupleLength], &tuples[b * tupleLength]) > 0;
+    };
+    runTags.assign(capacity, 0);
+    heap.resize(capacity);
+    for (int i=0; i<capacity; i++) {
+        heap[i] = i;
+    }
+    make_heap(heap.begin(), heap.end(), heapCompare);
+
+    // Write the runs
+    runs.clear();
+    int currentRun = -1;
+    RM_FileHandle runFH;
+    bool childDone = false;
+    while (!heap.empty()) {
+        // Get the smallest tuple
+        pop_heap(heap.begin(), heap.end(), heapCompare);
+        int slot = heap.back();
+        heap.pop_back();
+        char* tuple = &tuples[slot * tupleLength];
+
+        // Start a new run
+        if (runTags[slot] != currentRun) {
+            if (currentRun != -1) {
+                if ((rc = rmManager->CloseFile(runFH))) {
+                    return rc;
+                }
+            }
+            currentRun = runTags[slot];
+            int run = runCount++;
+            if ((rc = rmManager->CreateFile(RunFileName(run).c_str(), tupleLength))) {
+                return rc;
+            }
+            if ((rc = rmManager->OpenFile(RunFileName(run).c_str(), runFH))) {
+                return rc;
+            }
+            runs.push_back(run);
+        }
+
+        // Write the tuple to the run
+        if ((rc = runFH.InsertRec(tuple, rid))) {
+            return rc;
+        }
+
+        // Replace it by the next child tuple
+        if (!childDone) {
+            if ((rc = childOp->GetNext(inputData)) == QL_EOF) {
+                childDone = true;
+            }
+            else if (rc) {
+                return rc;
+            }
+            else {
+                runTags[slot] = CompareTuples(inputData, tuple) >= 0 ? currentRun : currentRun + 1;
+                memcpy(tuple, inputData, tupleLength);
+                heap.push_back(slot);
+                push_heap(heap.begin(), heap.end(), heapCompare);
+            }
+        }
+    }
+    if ((rc = rmManager->CloseFile(runFH))) {
+        return rc;
+    }
+
+    return OK_RC;
+}
+
+// Method: OpenMerge(int count)
+// Open the first count runs and make a heap of their first tuples
+RC QL_SortOp::OpenMerge(int count) {
+    int rc;
+    mergeTuples.resize(count * tupleLength);
+    heap.clear();
+    for (int i=0; i<count; i++) {
+        if ((rc = rmManager->OpenFile(RunFileName(runs[i]).c_str(), mergeFH[i]))) {
+            return rc;
+        }
+        if ((rc = mergeFS[i].OpenScan(mergeFH[i], INT, 4, 0, NO_OP, NULL))) {
+            return rc;
+        }
+        mergeCount = i + 1;
+        bool found;
+        if ((rc = GetNextFromRun(i, found))) {
+            return rc;
+        }
+        if (found) {
+            heap.push_back(i);
+        }
+    }
+    make_heap(heap.begin(), heap.end(), [this](int a, int b) {
+        return CompareTuples(&mergeTuples[a * tupleLength], &mergeTuples[b * tupleLength]) > 0;
+    });
+
+    return OK_RC;
+}
+
+// Method: GetNextMerged(char* recordData)
+// Get the smallest current tuple of the runs being merged
+RC QL_SortOp::GetNextMerged(char* recordData) {
+    if (heap.empty()) {
+        return QL_EOF;
+    }
+    auto heapCompare = [this](int a, int b) {
+        return CompareTuples(&mergeTuples[a * tupleLength], &mergeTuples[b * tupleLength]) > 0;
+    };
+
+    // Return the smallest tuple and replace it by the next tuple of its run
+    int rc;
+    pop_heap(heap.begin(), heap.end(), heapCompare);
+    int i = heap.back();
+    heap.pop_back();
+    memcpy(recordData, &mergeTuples[i * tupleLength], tupleLength);
+    bool found;
+    if ((rc = GetNextFromRun(i, found))) {
+        return rc;
+    }
+    if (found) {
+        heap.push_back(i);
+        push_heap(heap.begin(), heap.end(), heapCompare);
+    }
+
+    return OK_RC;
+}
+
+// Method: CloseMerge()
+// Close and destroy the runs being merged and remove them from the runs left
+RC QL_SortOp::CloseMerge() {
+    int rc;
+    for (int i=0; i<mergeCount; i++) {
+        if ((rc = mergeFS[i].CloseScan())) {
+            return rc;
+        }
+        if ((rc = rmManager->CloseFile(mergeFH[i]))) {
+            return rc;
+        }
+        if ((rc = rmManager->DestroyFile(RunFileName(runs[i]).c_str()))) {
+            return rc;
+        }
+    }
+    runs.erase(runs.begin(), runs.begin() + mergeCount);
+    mergeCount = 0;
+    heap.clear();
+
+    return OK_RC;
+}
+
+// Method: GetNextFromRun(int i, bool &found)
+// Read the next tuple of the i-th run being merged
+RC QL_SortOp::GetNextFromRun(int i, bool &found) {
+    int rc;
+    RM_Record rec;
+    char* data;
+    found = false;
+    if ((rc = mergeFS[i].GetNextRec(rec)) == RM_EOF) {
+        return OK_RC;
+    }
+    else if (rc) {
+        return rc;
+    }
+    if ((rc = rec.GetData(data))) {
+        return rc;
+    }
+    memcpy(&mergeTuples[i * tupleLength], data, tupleLength);
+    found = true;
+
+    return OK_RC;
+}
+
+// Method: CompareTuples(const char* tuple1, const char* tuple2)
+// Compare two tuples on the sort keys (negative, zero or positive)
+int QL_SortOp::CompareTuples(const char* tuple1, const char* tuple2) const {
+    for (int i=0; i<keyCount; i++) {
+        int comparison = CompareAttributeValues(keyTypes[i], tuple1 + keyOffsets[i], keyLengths[i],
+                                                tuple2 + keyOffsets[i], keyLengths[i]);
+        if (comparison != 0) {
+            return keyDescending[i] ? -comparison : comparison;
+        }
+    }
+    return 0;
+}
+
+// Method: RunFileName(int run)
+// Get the name of a run file
+// (names contain a '.' so they cannot clash with relation names)
+string QL_SortOp::RunFileName(int run) const {
+    string fileName("sort.");
+    fileName += to_string(getpid()) + "." + to_string(sortNumber) + "." + to_string(run);
+    return fileName;
+}
+
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_SortOp::IsOrderedOn(const char* relName, const char* attrName) {
+    if (keyDescending[0]) {
+        return false;
+    }
+    if (relName != NULL && keyAttrs[0].relName != NULL && strcmp(relName, keyAttrs[0].relName) != 0) {
+        return false;
+    }
+    return strcmp(attrName, keyAttrs[0].attrName) == 0;
+}
+
+// Get the attribute count
+void QL_SortOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_SortOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_SortOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "SortOp (";
+    for (int i=0; i<keyCount; i++) {
+        if (keyAttrs[i].relName != NULL) cout << keyAttrs[i].relName << ".";
+        cout << keyAttrs[i].attrName;
+        if (keyDescending[i]) cout << " DESC";
+        if (i != keyCount-1) cout << ", ";
+    }
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    childOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** QL_HashAggregateOp class **********/
+
+// Constructor
+/* The group entries hold the group attributes (laid out as in the result tuples) followed by
+   the state of each aggregate:
+    - COUNT - count - integer
+    - SUM, AVG - sum and count - double, integer
+    - MIN, MAX - value - attribute
+   A partial aggregation returns these states, each as an attribute with the type of the
+   aggregated attribute and the length of the state, and the final aggregation combines them
+*/
+QL_HashAggregateOp::QL_HashAggregateOp(SM_Manager* smManager, RM_Manager* rmManager, std::shared_ptr<QL_Op> childOp,
+                                       int groupCount, const RelAttr groupAttrs[], int aggCount, const AggFun aggFuns[],
+                                       const RelAttr aggAttrs[], QL_AggregateMode mode) {
+    // Store the objects
+    this->smManager = smManager;
+    this->rmManager = rmManager;
+    this->childOp = childOp;
+    this->mode = mode;
+    this->groupCount = groupCount;
+    this->aggCount = aggCount;
+
+    // Number the operator so that its partition files have unique names
+    static int aggregateCount = 0;
+    aggregateNumber = aggregateCount++;
+
+    // Get the attribute information from the child operator
+    int childAttrCount;
+    childOp->GetAttributeCount(childAttrCount);
+    DataAttrInfo* childAttributes = new DataAttrInfo[childAttrCount];
+    childOp->GetAttributeInfo(childAttributes);
+    inputLength = 0;
+    for (int i=0; i<childAttrCount; i++) {
+        inputLength += childAttributes[i].attrLength;
+    }
+
+    // Bind the group attributes to the child tuple layout
+    attrCount = groupCount + aggCount;
+    attributes = new DataAttrInfo[attrCount];
+    this->groupAttrs = new RelAttr[groupCount];
+    groupOffsets = new int[groupCount];
+    groupLength = 0;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    for (int i=0; i<groupCount; i++) {
+        this->groupAttrs[i].relName = groupAttrs[i].relName;
+        this->groupAttrs[i].attrName = groupAttrs[i].attrName;
+        GetAttrInfoFromArray((char*) childAttributes, childAttrCount, groupAttrs[i].relName, groupAttrs[i].attrName, (char*) attributeData);
+        groupOffsets[i] = attributeData->offset;
+        attributes[i] = *attributeData;
+        attributes[i].offset = groupLength;
+        attributes[i].indexNo = -1;
+        groupLength += attributeData->attrLength;
+    }
+
+    // Bind the aggregated attributes
+    // (the partial states follow the group attributes in the tuples of a final aggregation)
+    this->aggFuns = new AggFun[aggCount];
+    this->aggAttrs = new RelAttr[aggCount];
+    inputTypes = new AttrType[aggCount];
+    inputOffsets = new int[aggCount];
+    inputLengths = new int[aggCount];
+    stateOffsets = new int[aggCount];
+    entryLength = groupLength;
+    tupleLength = groupLength;
+    for (int i=0; i<aggCount; i++) {
+        this->aggFuns[i] = aggFuns[i];
+        this->aggAttrs[i].relName = aggAttrs[i].relName;
+        this->aggAttrs[i].attrName = aggAttrs[i].attrName;
+        inputTypes[i] = INT;
+        inputOffsets[i] = 0;
+        inputLengths[i] = sizeof(int);
+        if (mode == QL_AGGREGATE_FINAL) {
+            DataAttrInfo &partialAttr = childAttributes[groupCount + i];
+            inputTypes[i] = partialAttr.attrType;
+            inputOffsets[i] = partialAttr.offset;
+            inputLengths[i] = partialAttr.attrLength;
+        }
+        else if (strcmp(aggAttrs[i].attrName, "*") != 0) {
+            GetAttrInfoFromArray((char*) childAttributes, childAttrCount, aggAttrs[i].relName, aggAttrs[i].attrName, (char*) attributeData);
+            inputTypes[i] = attributeData->attrType;
+            inputOffsets[i] = attributeData->offset;
+            inputLengths[i] = attributeData->attrLength;
+        }
+
+        // Lay out the state in the group entries
+        int stateLength;
+        switch (aggFuns[i]) {
+            case SUM_F:
+            case AVG_F:
+                stateLength = sizeof(double) + sizeof(int);
+                break;
+            case MIN_F:
+            case MAX_F:
+                stateLength = inputLengths[i];
+                break;
+            default:
+                stateLength = sizeof(int);
+                break;
+        }
+        stateOffsets[i] = entryLength;
+        entryLength += stateLength;
+
+        // Describe the result attribute
+        DataAttrInfo &aggAttr = attributes[groupCount + i];
+        if (aggAttrs[i].relName != NULL) {
+            strncpy(aggAttr.relName, aggAttrs[i].relName, MAXNAME);
+        }
+        GetAggregateAttrName(aggFuns[i], aggAttrs[i].attrName, aggAttr.attrName);
+        aggAttr.offset = tupleLength;
+        aggAttr.indexNo = -1;
+        if (mode == QL_AGGREGATE_PARTIAL) {
+            aggAttr.attrType = inputTypes[i];
+            aggAttr.attrLength = stateLength;
+        }
+        else if (aggFuns[i] == COUNT_F) {
+            aggAttr.attrType = INT;
+            aggAttr.attrLength = sizeof(int);
+        }
+        else if (aggFuns[i] == AVG_F) {
+            aggAttr.attrType = FLOAT;
+            aggAttr.attrLength = sizeof(float);
+        }
+        else if (aggFuns[i] == SUM_F) {
+            aggAttr.attrType = inputTypes[i];
+            aggAttr.attrLength = sizeof(int);
+        }
+        else {
+            aggAttr.attrType = inputTypes[i];
+            aggAttr.attrLength = inputLengths[i];
+        }
+        tupleLength += aggAttr.attrLength;
+    }
+    delete attributeData;
+    delete[] childAttributes;
+
+    // Set open flag to FALSE
+    entryCount = 0;
+    position = 0;
+    partitionScanOpen = FALSE;
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_HashAggregateOp::~QL_HashAggregateOp() {
+    // Delete the attributes, groups and aggregates arrays
+    delete[] attributes;
+    delete[] groupAttrs;
+    delete[] groupOffsets;
+    delete[] aggFuns;
+    delete[] aggAttrs;
+    delete[] inputTypes;
+    delete[] inputOffsets;
+    delete[] inputLengths;
+    delete[] stateOffsets;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the child operator
+    2) Aggregate the child tuples
+    3) Without group attributes, return a single group even for an empty input
+       (except for a partial aggregation, whose empty result is combined with the others)
+*/
+RC QL_HashAggregateOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Open the child operator
+    int rc;
+    if ((rc = childOp->Open())) {
+        return rc;
+    }
+    isOpen = TRUE;
+
+    // Aggregate the child tuples
+    level = 0;
+    fileCount = 0;
+    partitions.clear();
+    if ((rc = Aggregate())) {
+        return rc;
+    }
+
+    // Return a single group for an empty input
+    if (groupCount == 0 && entryCount == 0 && mode != QL_AGGREGATE_PARTIAL) {
+        entries.assign(entryLength, 0);
+        entryCount = 1;
+    }
+
+    return OK_RC;
+}
+
+// Close the operator
+/* Steps:
+    1) Close the partition being aggregated and destroy the partitions left
+    2) Free the group entries
+    3) Close the child operator
+*/
+RC QL_HashAggregateOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Destroy the partitions left
+    int rc;
+    if (partitionScanOpen) {
+        if ((rc = partitionFS.CloseScan())) {
+            return rc;
+        }
+        if ((rc = rmManager->CloseFile(partitionFH))) {
+            return rc;
+        }
+        partitionScanOpen = FALSE;
+    }
+    for (unsigned int i=0; i<partitions.size(); i++) {
+        if ((rc = rmManager->DestroyFile(PartitionFileName(partitions[i].first).c_str()))) {
+            return rc;
+        }
+    }
+    partitions.clear();
+
+    // Free the group entries
+    vector<char>().swap(entries);
+    vector<unsigned int>().swap(entryHashes);
+    vector<int>().swap(slots);
+    entryCount = 0;
+
+    // Close the child operator
+    if ((rc = childOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+/* Steps:
+    1) If all the groups in the table are returned, aggregate the next partition
+    2) Return the result of the next group
+*/
+RC QL_HashAggregateOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Aggregate the next partition
+    int rc;
+    while (position == entryCount) {
+        if (partitions.empty()) {
+            return QL_EOF;
+        }
+        if ((rc = OpenNextPartition())) {
+            return rc;
+        }
+    }
+
+    // Return the result of the next group
+    GetResult(&entries[(position++) * entryLength], recordData);
+
+    return OK_RC;
+}
+
+// Method: Aggregate()
+// Aggregate the input tuples (child tuples, or the tuples of the partition being aggregated)
+/* Steps:
+    1) Find the group of each input tuple in the open addressing table (linear probing)
+    2) Update the group entry if found
+    3) Otherwise add a group entry if the table holds less than QL_HASH_AGGREGATE_MEMORY
+       bytes of entries, or write the tuple to a partition file chosen by the hash of its group
+       (so that all the tuples of a group spilled go to the same partition)
+*/
+RC QL_HashAggregateOp::Aggregate() {
+    int rc;
+    RID rid;
+
+    // Size the table for the memory budget
+    int capacity = QL_HASH_AGGREGATE_MEMORY / entryLength;
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    unsigned int slotCount = 1;
+    while (slotCount < 2 * (unsigned int) capacity) {
+        slotCount <<= 1;
+    }
+    unsigned int mask = slotCount - 1;
+    entries.clear();
+    entryHashes.clear();
+    slots.assign(slotCount, -1);
+    entryCount = 0;
+    position = 0;
+
+    // Partition files of this pass
+    RM_FileHandle spillFH[QL_HASH_AGGREGATE_PARTITIONS];
+    int spillOpen[QL_HASH_AGGREGATE_PARTITIONS];
+    for (int i=0; i<QL_HASH_AGGREGATE_PARTITIONS; i++) {
+        spillOpen[i] = FALSE;
+    }
+
+    char* inputData = new char[inputLength];
+    char* groupData = new char[groupLength + 1];
+    while ((rc = GetNextInput(inputData)) != QL_EOF) {
+        if (rc) {
+            delete[] inputData;
+            delete[] groupData;
+            return rc;
+        }
+
+        // Get the group attributes of the tuple
+        for (int i=0; i<groupCount; i++) {
+            memcpy(groupData + attributes[i].offset, inputData + groupOffsets[i], attributes[i].attrLength);
+        }
+
+        // Find the group in the table
+        unsigned int hash = HashGroup(groupData, level);
+        unsigned int slot = hash & mask;
+        int entry = -1;
+        while (slots[slot] != -1) {
+            if (entryHashes[slots[slot]] == hash && MatchGroup(groupData, &entries[slots[slot] * entryLength])) {
+                entry = slots[slot];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        // Update the group entry
+        if (entry != -1) {
+            UpdateEntry(&entries[entry * entryLength], inputData, false);
+        }
+
+        // Add a group entry
+        else if (entryCount < capacity) {
+            entries.resize((entryCount + 1) * entryLength);
+            char* newEntry = &entries[entryCount * entryLength];
+            memcpy(newEntry, groupData, groupLength);
+            UpdateEntry(newEntry, inputData, true);
+            entryHashes.push_back(hash);
+            slots[slot] = entryCount++;
+        }
+
+        // Spill the tuple to a partition
+        else {
+            int partition = (hash >> 24) % QL_HASH_AGGREGATE_PARTITIONS;
+            if (!spillOpen[partition]) {
+                int file = fileCount++;
+                if ((rc = rmManager->CreateFile(PartitionFileName(file).c_str(), inputLength)) ||
+                    (rc = rmManager->OpenFile(PartitionFileName(file).c_str(), spillFH[partition]))) {
+                    delete[] inputData;
+                    delete[] groupData;
+                    return rc;
+                }
+                partitions.push_back(make_pair(file, level + 1));
+                spillOpen[partition] = TRUE;
+            }
+            if ((rc = spillFH[partition].InsertRec(inputData, rid))) {
+                delete[] inputData;
+                delete[] groupData;
+                return rc;
+            }
+        }
+    }
+    delete[] inputData;
+    delete[] groupData;
+
+    // Close the partition files
+    for (int i=0; i<QL_HASH_AGGREGATE_PARTITIONS; i++) {
+        if (spillOpen[i]) {
+            if ((rc = rmManager->CloseFile(spillFH[i]))) {
+                return rc;
+            }
+        }
+    }
+
+    return OK_RC;
+}
+
+// Method: OpenNextPartition()
+// Aggregate the tuples of the next partition file and destroy it
+RC QL_HashAggregateOp::OpenNextPartition() {
+    int rc;
+    int file = partitions.front().first;
+    level = partitions.front().second;
+    partitions.erase(partitions.begin());
+
+    // Aggregate the tuples of the partition
+    if ((rc = rmManager->OpenFile(PartitionFileName(file).c_str(), partitionFH))) {
+        return rc;
+    }
+    if ((rc = partitionFS.OpenScan(partitionFH, INT, 4, 0, NO_OP, NULL))) {
+        return rc;
+    }
+    partitionScanOpen = TRUE;
+    if ((rc = Aggregate())) {
+        return rc;
+    }
+
+    // Destroy the partition
+    if ((rc = partitionFS.CloseScan())) {
+        return rc;
+    }
+    if ((rc = rmManager->CloseFile(partitionFH))) {
+        return rc;
+    }
+    partitionScanOpen = FALSE;
+    if ((rc = rmManager->DestroyFile(PartitionFileName(file).c_str()))) {
+        return rc;
+    }
+
+    return OK_RC;
+}
+
+// Method: GetNextInput(char* inputData)
+// Get the next child tuple, or the next tuple of the partition being aggregated
+RC QL_HashAggregateOp::GetNextInput(char* inputData) {
+    if (!partitionScanOpen) {
+        return childOp->GetNext(inputData);
+    }
+
+    int rc;
+    RM_Record rec;
+    char* data;
+    if ((rc = partitionFS.GetNextRec(rec)) == RM_EOF) {
+        return QL_EOF;
+    }
+    else if (rc) {
+        return rc;
+    }
+    if ((rc = rec.GetData(data))) {
+        return rc;
+    }
+    memcpy(inputData, data, inputLength);
+
+    return OK_RC;
+}
+
+// Method: UpdateEntry(char* entry, const char* inputData, bool first)
+// Update the aggregate states of a group entry with an input tuple
+// (first if the tuple starts the group)
+void QL_HashAggregateOp::UpdateEntry(char* entry, const char* inputData, bool first) {
+    for (int i=0; i<aggCount; i++) {
+        char* state = entry + stateOffsets[i];
+        const char* input = inputData + inputOffsets[i];
+        switch (aggFuns[i]) {
+            case MIN_F:
+            case MAX_F:
+            {
+                int comparison = first ? 0 : CompareAttributeValues(inputTypes[i], input, inputLengths[i], state, inputLengths[i]);
+                if (first || (aggFuns[i] == MIN_F && comparison < 0) || (aggFuns[i] == MAX_F && comparison > 0)) {
+                    memcpy(state, input, inputLengths[i]);
+                }
+                break;
+            }
+            case SUM_F:
+            case AVG_F:
+            {
+                double sum = 0;
+                int count = 0;
+                if (!first) {
+                    memcpy(&sum, state, sizeof(double));
+                    memcpy(&count, state + sizeof(double), sizeof(int));
+                }
+                if (mode == QL_AGGREGATE_FINAL) {
+                    double partialSum;
+                    int partialCount;
+                    memcpy(&partialSum, input, sizeof(double));
+                    memcpy(&partialCount, input + sizeof(double), sizeof(int));
+                    sum += partialSum;
+                    count += partialCount;
+                }
+                else {
+                    if (inputTypes[i] == INT) {
+                        int value;
+                        memcpy(&value, input, sizeof(int));
+                        sum += value;
+                    }
+                    else {
+                        float value;
+                        memcpy(&value, input, sizeof(float));
+                        sum += value;
+                    }
+                    count++;
+                }
+                memcpy(state, &sum, sizeof(double));
+                memcpy(state + sizeof(double), &count, sizeof(int));
+                break;
+            }
+            default:
+            {
+                int count = 0;
+                if (!first) {
+                    memcpy(&count, state, sizeof(int));
+                }
+                if (mode == QL_AGGREGATE_FINAL) {
+                    int partialCount;
+                    memcpy(&partialCount, input, sizeof(int));
+                    count += partialCount;
+                }
+                else {
+                    count++;
+                }
+                memcpy(state, &count, sizeof(int));
+                break;
+            }
+        }
+    }
+}
+
+// Method: GetResult(const char* entry, char* recordData)
+// Get the result tuple of a group entry
+// (the aggregate states themselves for a partial aggregation)
+void QL_HashAggregateOp::GetResult(const char* entry, char* recordData) {
+    memcpy(recordData, entry, groupLength);
+    for (int i=0; i<aggCount; i++) {
+        const char* state = entry + stateOffsets[i];
+        DataAttrInfo &aggAttr = attributes[groupCount + i];
+        char* result = recordData + aggAttr.offset;
+        if (mode == QL_AGGREGATE_PARTIAL || aggFuns[i] == MIN_F || aggFuns[i] == MAX_F || aggFuns[i] == COUNT_F) {
+            memcpy(result, state, aggAttr.attrLength);
+            continue;
+        }
+
+        double sum;
+        int count;
+        memcpy(&sum, state, sizeof(double));
+        memcpy(&count, state + sizeof(double), sizeof(int));
+        if (aggFuns[i] == AVG_F) {
+            float value = count == 0 ? 0 : sum / count;
+            memcpy(result, &value, sizeof(float));
+        }
+        else if (aggAttr.attrType == INT) {
+            int value = (int) (long long) sum;
+            memcpy(result, &value, sizeof(int));
+        }
+        else {
+            float value = sum;
+            memcpy(result, &value, sizeof(float));
+        }
+    }
+}
+
+// Method: HashGroup(const char* groupData, int level)
+// Get the hash of the group attributes
+// (seeded by the partitioning level so that a partition spreads over new partitions)
+unsigned int QL_HashAggregateOp::HashGroup(const char* groupData, int level) const {
+    // FNV-1a over the attribute values
+    unsigned int hash = 2166136261u ^ (level * 0x9e3779b9u);
+    for (int i=0; i<groupCount; i++) {
+        const char* value = groupData + attributes[i].offset;
+        int length = attributes[i].attrLength;
+        float floatValue;
+        if (attributes[i].attrType == FLOAT) {
+            // Negative and positive zero are the same group
+            memcpy(&floatValue, value, sizeof(float));
+            if (floatValue == 0) {
+                floatValue = 0;
+            }
+            value = (const char*) &floatValue;
+        }
+        for (int j=0; j<length; j++) {
+            if (attributes[i].attrType == STRING && value[j] == '\0') {
+                break;
+            }
+            hash ^= (unsigned char) value[j];
+            hash *= 16777619u;
+        }
+    }
+
+    // Mix the bits so that the high bits depend on the whole group
+    hash ^= hash >> 16;
+    hash *= 0x7feb352du;
+    hash ^= hash >> 15;
+    hash *= 0x846ca68bu;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Method: MatchGroup(const char* groupData, const char* entry)
+// Boolean whether the group attributes are the ones of the group entry
+bool QL_HashAggregateOp::MatchGroup(const char* groupData, const char* entry) const {
+    for (int i=0; i<groupCount; i++) {
+        int offset = attributes[i].offset;
+        int length = attributes[i].attrLength;
+        if (CompareAttributeValues(attributes[i].attrType, groupData + offset, length, entry + offset, length) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Method: PartitionFileName(int file)
+// Get the name of a partition file
+// (names contain a '.' so they cannot clash with relation names)
+string QL_HashAggregateOp::PartitionFileName(int file) const {
+    string fileName("hashagg.");
+    fileName += to_string(getpid()) + "." + to_string(aggregateNumber) + "." + to_string(file);
+    return fileName;
+}
+
+// Get the attribute count
+void QL_HashAggregateOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_HashAggregateOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_HashAggregateOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "HashAggregateOp (";
+    if (mode == QL_AGGREGATE_PARTIAL) cout << "partial; ";
+    if (mode == QL_AGGREGATE_FINAL) cout << "final; ";
+    if (groupCount > 0) {
+        cout << "group by ";
+        for (int i=0; i<groupCount; i++) {
+            if (groupAttrs[i].relName != NULL) cout << groupAttrs[i].relName << ".";
+            cout << groupAttrs[i].attrName;
+            cout << (i != groupCount-1 ? ", " : "; ");
+        }
+    }
+    for (int i=0; i<aggCount; i++) {
+        char name[MAXPRINTSTRING];
+        GetQualifiedAttrName(attributes[groupCount + i].relName, attributes[groupCount + i].attrName, name);
+        cout << name;
+        if (i != aggCount-1) cout << ", ";
+    }
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    childOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** QL_TopNOp class **********/
+
+// Constructor
+QL_TopNOp::QL_TopNOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, int keyCount,
+                     const RelAttr keyAttrs[], const int keyDescending[], int limit) {
+    // Store the objects
+    this->smManager = smManager;
+    this->childOp = childOp;
+    this->keyCount = keyCount;
+    this->limit = limit;
+
+    // Get the attribute information from the child operator
+    childOp->GetAttributeCount(this->attrCount);
+    attributes = new DataAttrInfo[this->attrCount];
+    childOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+
+    // Copy the sort keys and bind them to the child tuple layout
+    // (the first error is kept and returned when the operator is opened)
+    int rc;
+    initRC = OK_RC;
+    this->keyAttrs = new RelAttr[keyCount];
+    keyTypes = new AttrType[keyCount];
+    keyOffsets = new int[keyCount];
+    keyLengths = new int[keyCount];
+    this->keyDescending = new int[keyCount];
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    for (int i=0; i<keyCount; i++) {
+        this->keyAttrs[i].relName = keyAttrs[i].relName;
+        this->keyAttrs[i].attrName = keyAttrs[i].attrName;
+        keyTypes[i] = INT;
+        keyOffsets[i] = 0;
+        keyLengths[i] = 0;
+        if (!initRC && (rc = GetAttrInfoFromArray((char*) attributes, attrCount, keyAttrs[i].relName, keyAttrs[i].attrName, (char*) attributeData))) {
+            initRC = rc;
+        }
+        if (!initRC) {
+            keyTypes[i] = attributeData->attrType;
+            keyOffsets[i] = attributeData->offset;
+            keyLengths[i] = attributeData->attrLength;
+        }
+        this->keyDescending[i] = keyDescending != NULL && keyDescending[i];
+    }
+    delete attributeData;
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_TopNOp::~QL_TopNOp() {
+    // Delete the attributes and keys arrays
+    delete[] attributes;
+    delete[] keyAttrs;
+    delete[] keyTypes;
+    delete[] keyOffsets;
+    delete[] keyLengths;
+    delete[] keyDescending;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the child operator
+    2) Fill a heap with the first limit child tuples, the largest one on top
+    3) Replace the top of the heap by every later child tuple that comes before it
+    4) Sort the tuples left in the heap
+    Ties are broken by the input position, so the result is the one of a stable sort
+*/
+RC QL_TopNOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Return the error of the constructor
+    if (initRC) {
+        return initRC;
+    }
+
+    // Open the child operator
+    int rc;
+    if ((rc = childOp->Open())) {
+        return rc;
+    }
+
+    // Read the child tuples through the bounded heap
+    auto heapCompare = [this](int a, int b) { return TupleBefore(a, b); };
+    tuples.resize(limit * tupleLength);
+    sequence.resize(limit);
+    heap.clear();
+    char* inputData = new char[tupleLength];
+    for (int count = 0; limit > 0; count++) {
+        if ((rc = childOp->GetNext(inputData)) == QL_EOF) {
+            break;
+        }
+        else if (rc) {
+            delete[] inputData;
+            return rc;
+        }
+
+        // Fill the heap
+        if ((int) heap.size() < limit) {
+            int slot = heap.size();
+            memcpy(&tuples[slot * tupleLength], inputData, tupleLength);
+            sequence[slot] = count;
+            heap.push_back(slot);
+            push_heap(heap.begin(), heap.end(), heapCompare);
+        }
+
+        // Replace the largest tuple if the new tuple comes before it
+        else if (CompareTuples(inputData, &tuples[heap.front() * tupleLength]) < 0) {
+            pop_heap(heap.begin(), heap.end(), heapCompare);
+            int slot = heap.back();
+            memcpy(&tuples[slot * tupleLength], inputData, tupleLength);
+            sequence[slot] = count;
+            push_heap(heap.begin(), heap.end(), heapCompare);
+        }
+    }
+    delete[] inputData;
+
+    // Sort the tuples kept
+    sort_heap(heap.begin(), heap.end(), heapCompare);
+    position = 0;
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+/* Steps:
+    1) Free the tuples kept
+    2) Close the child operator
+*/
+RC QL_TopNOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Free the tuples kept
+    vector<char>().swap(tuples);
+    vector<int>().swap(sequence);
+    vector<int>().swap(heap);
+
+    // Close the child operator
+    int rc;
+    if ((rc = childOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+RC QL_TopNOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Get the next sorted tuple
+    if (position == heap.size()) {
+        return QL_EOF;
+    }
+    memcpy(recordData, &tuples[heap[position++] * tupleLength], tupleLength);
+
+    return OK_RC;
+}
+
+// Method: TupleBefore(int a, int b)
+// Boolean whether the tuple in slot a comes before the one in slot b
+bool QL_TopNOp::TupleBefore(int a, int b) const {
+    int comparison = CompareTuples(&tuples[a * tupleLength], &tuples[b * tupleLength]);
+    if (comparison != 0) {
+        return comparison < 0;
+    }
+    return sequence[a] < sequence[b];
+}
+
+// Method: CompareTuples(const char* tuple1, const char* tuple2)
+// Compare two tuples on the sort keys (negative, zero or positive)
+int QL_TopNOp::CompareTuples(const char* tuple1, const char* tuple2) const {
+    for (int i=0; i<keyCount; i++) {
+        int comparison = CompareAttributeValues(keyTypes[i], tuple1 + keyOffsets[i], keyLengths[i],
+                                                tuple2 + keyOffsets[i], keyLengths[i]);
+        if (comparison != 0) {
+            return keyDescending[i] ? -comparison : comparison;
+        }
+    }
+    return 0;
+}
+
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_TopNOp::IsOrderedOn(const char* relName, const char* attrName) {
+    if (keyDescending[0]) {
+        return false;
+    }
+    if (relName != NULL && keyAttrs[0].relName != NULL && strcmp(relName, keyAttrs[0].relName) != 0) {
+        return false;
+    }
+    return strcmp(attrName, keyAttrs[0].attrName) == 0;
+}
+
+// Get the attribute count
+void QL_TopNOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_TopNOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_TopNOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "TopNOp (" << limit << "; ";
+    for (int i=0; i<keyCount; i++) {
+        if (keyAttrs[i].relName != NULL) cout << keyAttrs[i].relName << ".";
+        cout << keyAttrs[i].attrName;
+        if (keyDescending[i]) cout << " DESC";
+        if (i != keyCount-1) cout << ", ";
+    }
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    childOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** QL_LimitOp class **********/
+
+// Constructor
+QL_LimitOp::QL_LimitOp(SM_Manager* smManager, std::shared_ptr<QL_Op> childOp, int limit) {
+    // Store the objects
+    this->smManager = smManager;
+    this->childOp = childOp;
+    this->limit = limit;
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_LimitOp::~QL_LimitOp() {
+}
+
+// Open the operator
+RC QL_LimitOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Open the child operator
+    int rc;
+    if ((rc = childOp->Open())) {
+        return rc;
+    }
+    tupleCount = 0;
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+RC QL_LimitOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Close the child operator
+    int rc;
+    if ((rc = childOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+// (the child is not asked for more tuples once the limit is reached)
+RC QL_LimitOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Check the limit
+    if (tupleCount == limit) {
+        return QL_EOF;
+    }
+
+    int rc;
+    if ((rc = childOp->GetNext(recordData))) {
+        return rc;
+    }
+    tupleCount++;
+
+    return OK_RC;
+}
+
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_LimitOp::IsOrderedOn(const char* relName, const char* attrName) {
+    return childOp->IsOrderedOn(relName, attrName);
+}
+
+// Keep the order of the child operator
+void QL_LimitOp::KeepOrder() {
+    childOp->KeepOrder();
+}
+
+// Get the attribute count
+void QL_LimitOp::GetAttributeCount(int &attrCount) {
+    childOp->GetAttributeCount(attrCount);
+}
+
+// Get the attribute information
+void QL_LimitOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    childOp->GetAttributeInfo(attributes);
+}
+
+// Print the physical query plan
+void QL_LimitOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "LimitOp (" << limit << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    childOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** QL_MergeJoinOp class **********/
+
+// Constructor
+QL_MergeJoinOp::QL_MergeJoinOp(SM_Manager* smManager, std::shared_ptr<QL_Op> leftOp, std::shared_ptr<QL_Op> rightOp, Condition joinCond) {
+    // Store the objects
+    this->smManager = smManager;
+    this->leftOp = leftOp;
+    this->rightOp = rightOp;
+    this->joinCond = joinCond;
+
+    // Get the attribute information for the left operator
+    int leftAttrCount;
+    leftOp->GetAttributeCount(leftAttrCount);
+    DataAttrInfo* leftAttributes = new DataAttrInfo[leftAttrCount];
+    leftOp->GetAttributeInfo(leftAttributes);
+
+    // Get the attribute information for the right operator
+    int rightAttrCount;
+    rightOp->GetAttributeCount(rightAttrCount);
+    DataAttrInfo* rightAttributes = new DataAttrInfo[rightAttrCount];
+    rightOp->GetAttributeInfo(rightAttributes);
+
+    // Get the join attribute of each child
+    // (the first error is kept and returned when the operator is opened)
+    int rc;
+    initRC = OK_RC;
+    leftAttr = &(this->joinCond).lhsAttr;
+    rightAttr = &(this->joinCond).rhsAttr;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    if (GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, leftAttr->relName, leftAttr->attrName, (char*) attributeData)) {
+        leftAttr = &(this->joinCond).rhsAttr;
+        rightAttr = &(this->joinCond).lhsAttr;
+        if ((rc = GetAttrInfoFromArray((char*) leftAttributes, leftAttrCount, leftAttr->relName, leftAttr->attrName, (char*) attributeData))) {
+            initRC = rc;
+        }
+    }
+    keyType = INT;
+    leftKeyOffset = 0;
+    leftKeyLength = 0;
+    if (!initRC) {
+        keyType = attributeData->attrType;
+        leftKeyOffset = attributeData->offset;
+        leftKeyLength = attributeData->attrLength;
+    }
+    rightKeyOffset = 0;
+    rightKeyLength = 0;
+    if (!initRC && (rc = GetAttrInfoFromArray((char*) rightAttributes, rightAttrCount, rightAttr->relName, rightAttr->attrName, (char*) attributeData))) {
+        initRC = rc;
+    }
+    if (!initRC) {
+        rightKeyOffset = attributeData->offset;
+        rightKeyLength = attributeData->attrLength;
+    }
+    delete attributeData;
+
+    // Construct the attributes information
+    int currentOffset = 0;
+    leftTupleLength = 0;
+    rightTupleLength = 0;
+    this->attrCount = leftAttrCount + rightAttrCount;
+    attributes = new DataAttrInfo[this->attrCount];
+    for (int i=0; i<leftAttrCount; i++) {
+        attributes[i] = leftAttributes[i];
+        attributes[i].indexNo = -1;
+        attributes[i].indexType = -1;
+        attributes[i].offset = currentOffset;
+        currentOffset += leftAttributes[i].attrLength;
+        leftTupleLength += leftAttributes[i].attrLength;
+    }
+    for (int i=0; i<rightAttrCount; i++) {
+        attributes[leftAttrCount+i] = rightAttributes[i];
+        attributes[leftAttrCount+i].indexNo = -1;
+        attributes[leftAttrCount+i].indexType = -1;
+        attributes[leftAttrCount+i].offset = currentOffset;
+        currentOffset += rightAttributes[i].attrLength;
+        rightTupleLength += rightAttributes[i].attrLength;
+    }
+    delete[] leftAttributes;
+    delete[] rightAttributes;
+
+    // The children have to stay ordered on the join attributes
+    leftOp->KeepOrder();
+    rightOp->KeepOrder();
+
+    // Initialize leftData and rightData
+    leftData = new char[leftTupleLength];
+    rightData = new char[rightTupleLength];
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_MergeJoinOp::~QL_MergeJoinOp() {
+    // Delete the attributes, leftData and rightData arrays
+    delete[] attributes;
+    delete[] leftData;
+    delete[] rightData;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the children operators
+    2) Get the first tuple of the right child
+*/
+RC QL_MergeJoinOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Return the error of the constructor
+    if (initRC) {
+        return initRC;
+    }
+
+    // Open the children operators
+    int rc;
+    if ((rc = leftOp->Open())) {
+        return rc;
+    }
+    if ((rc = rightOp->Open())) {
+        return rc;
+    }
+
+    // Get the first right tuple
+    if ((rc = GetNextRight())) {
+        return rc;
+    }
+    groupCount = 0;
+    groupPosition = 0;
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+RC QL_MergeJoinOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Close the children operators
+    int rc;
+    if ((rc = leftOp->Close())) {
+        return rc;
+    }
+    if ((rc = rightOp->Close())) {
+        return rc;
+    }
+
+    // Free the right group
+    vector<char>().swap(rightGroup);
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+/* Steps:
+    1) Join the left tuple with the next tuple of the right group
+    2) When the group is done, get the next left tuple
+        - If its key is the key of the group, join it with the group again
+        - Otherwise skip the right tuples with smaller keys and collect the
+          right tuples with its key into the group
+    3) Return QL_EOF when either child runs out of tuples that can match
+*/
+RC QL_MergeJoinOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    int rc;
+    while (groupPosition == groupCount) {
+        // Get the next left tuple
+        if ((rc = leftOp->GetNext(leftData))) {
+            return rc;
+        }
+        char* leftKey = leftData + leftKeyOffset;
+
+        // Join it with the same group again if the key is unchanged
+        if (groupCount > 0 && CompareAttributeValues(keyType, leftKey, leftKeyLength, &rightGroup[rightKeyOffset], rightKeyLength) == 0) {
+            groupPosition = 0;
+            continue;
+        }
+
+        // Skip the right tuples with smaller keys
+        groupCount = 0;
+        groupPosition = 0;
+        rightGroup.clear();
+        while (rightValid && CompareAttributeValues(keyType, rightData + rightKeyOffset, rightKeyLength, leftKey, leftKeyLength) < 0) {
+            if ((rc = GetNextRight())) {
+                return rc;
+            }
+        }
+        if (!rightValid) {
+            return QL_EOF;
+        }
+
+        // Collect the right tuples with the key
+        while (rightValid && CompareAttributeValues(keyType, rightData + rightKeyOffset, rightKeyLength, leftKey, leftKeyLength) == 0) {
+            rightGroup.insert(rightGroup.end(), rightData, rightData + rightTupleLength);
+            groupCount++;
+            if ((rc = GetNextRight())) {
+                return rc;
+            }
+        }
+    }
+
+    // Construct new tuple by joining left and right data tuples
+    memcpy(recordData, leftData, leftTupleLength);
+    memcpy(recordData + leftTupleLength, &rightGroup[groupPosition * rightTupleLength], rightTupleLength);
+    groupPosition++;
+
+    return OK_RC;
+}
+
+// Method: GetNextRight()
+// Get the next tuple of the right child into rightData
+RC QL_MergeJoinOp::GetNextRight() {
+    int rc;
+    if ((rc = rightOp->GetNext(rightData)) == QL_EOF) {
+        rightValid = FALSE;
+        return OK_RC;
+    }
+    else if (rc) {
+        return rc;
+    }
+    rightValid = TRUE;
+    return OK_RC;
+}
+
+// Boolean whether the tuples are returned in ascending order of the attribute
+bool QL_MergeJoinOp::IsOrderedOn(const char* relName, const char* attrName) {
+    return leftOp->IsOrderedOn(relName, attrName) ||
+           (strcmp(attrName, rightAttr->attrName) == 0 &&
+            (relName == NULL || strcmp(relName, rightAttr->relName) == 0));
+}
+
+// Keep the order of the left child
+void QL_MergeJoinOp::KeepOrder() {
+    leftOp->KeepOrder();
+}
+
+// Get the attribute count
+void QL_MergeJoinOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_MergeJoinOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_MergeJoinOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "MergeJoinOp (";
+    cout << (joinCond.lhsAttr).relName << ".";
+    cout << (joinCond.lhsAttr).attrName;
+    PrintOperator(joinCond.op);
+    cout << (joinCond.rhsAttr).relName << ".";
+    cout << (joinCond.rhsAttr).attrName;
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    leftOp->Print(indentationLevel+1);
+    rightOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+/********** QL_ExchangeOp class **********/
+
+// Constructor
+/* Steps:
+    1) Form the scan pipeline of each worker - a FileScanOp (on the catalog layout, or on
+       scanAttributes for a fetched temporary file), the FilterOps of the conditions, and a
+       ProjectOp on the projected attributes unless nProjectAttrs is -1
+    2) Get the attributes of the tuples from the first pipeline
+*/
+QL_ExchangeOp::QL_ExchangeOp(SM_Manager* smManager, RM_Manager* rmManager, const char* relName,
+                             int scanAttrCount, DataAttrInfo* scanAttributes, int nConditions, const Condition conditions[],
+                             int nProjectAttrs, const RelAttr projectAttrs[], int workerCount) {
+    // Store the objects
+    this->smManager = smManager;
+    this->rmManager = rmManager;
+    this->workerCount = workerCount < 1 ? 1 : workerCount;
+
+    // Form the pipelines
+    workers = new QL_ExchangeWorker[this->workerCount];
+    for (int i=0; i<this->workerCount; i++) {
+        if (scanAttributes != NULL) {
+            workers[i].scanOp.reset(new QL_FileScanOp(smManager, rmManager, relName, scanAttrCount, scanAttributes));
+        }
+        else {
+            workers[i].scanOp.reset(new QL_FileScanOp(smManager, rmManager, relName, false, NULL, NO_OP, NULL));
+        }
+        workers[i].rootOp = workers[i].scanOp;
+        for (int j=0; j<nConditions; j++) {
+            workers[i].rootOp.reset(new QL_FilterOp(smManager, workers[i].rootOp, conditions[j]));
+        }
+        if (nProjectAttrs >= 0) {
+            workers[i].rootOp = CreateProjectOp(smManager, workers[i].rootOp, nProjectAttrs, projectAttrs);
+        }
+    }
+
+    // Get the attributes of the tuples
+    workers[0].rootOp->GetAttributeCount(attrCount);
+    attributes = new DataAttrInfo[attrCount];
+    workers[0].rootOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+
+    // Set open flag to FALSE
+    runningWorkers = 0;
+    cancelled = FALSE;
+    workerRC = OK_RC;
+    exhausted = FALSE;
+    batchPosition = 0;
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_ExchangeOp::~QL_ExchangeOp() {
+    // Stop the workers of an operator that is still open
+    if (isOpen) {
+        Close();
+    }
+
+    // Delete the workers and attributes arrays
+    delete[] workers;
+    delete[] attributes;
+}
+
+// Open the operator
+/* Steps:
+    1) Open the pipelines of the workers (the files are opened on this thread)
+    2) Split the pages of the file into morsels of QL_EXCHANGE_MORSEL_PAGES pages, queueing
+       a contiguous run of morsels to each worker
+    3) Start the worker threads
+*/
+RC QL_ExchangeOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Open the pipelines (closing the ones already open on an error)
+    int rc = OK_RC;
+    int openCount = 0;
+    while (openCount < workerCount && !(rc = workers[openCount].rootOp->Open())) {
+        openCount++;
+    }
+
+    // Queue the morsels (the header is page 0)
+    PageNum lastPage;
+    if (openCount == workerCount) {
+        rc = workers[0].scanOp->GetLastPageNum(lastPage);
+    }
+    if (rc) {
+        for (int i=0; i<openCount; i++) {
+            workers[i].rootOp->Close();
+        }
+        return rc;
+    }
+    int morselCount = (lastPage + QL_EXCHANGE_MORSEL_PAGES - 1) / QL_EXCHANGE_MORSEL_PAGES;
+    for (int i=0; i<morselCount; i++) {
+        PageNum startPage = 1 + i * QL_EXCHANGE_MORSEL_PAGES;
+        int worker = (int) ((long long) i * workerCount / morselCount);
+        workers[worker].morsels.push_back(make_pair(startPage, startPage + QL_EXCHANGE_MORSEL_PAGES));
+    }
+
+    // Reset the batches
+    batches.clear();
+    currentBatch.clear();
+    batchPosition = 0;
+    runningWorkers = workerCount;
+    cancelled = FALSE;
+    workerRC = OK_RC;
+    exhausted = FALSE;
+
+    // Start the workers
+    for (int i=0; i<workerCount; i++) {
+        workers[i].thread = thread(&QL_ExchangeOp::RunWorker, this, i);
+    }
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+/* Steps:
+    1) Stop the workers after their current morsel, waking up those waiting for room in the
+       batch queue
+    2) Wait for the worker threads to end
+    3) Close the pipelines and drop the batches left
+*/
+RC QL_ExchangeOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Stop the workers
+    {
+        lock_guard<mutex> lock(morselMutex);
+        for (int i=0; i<workerCount; i++) {
+            workers[i].morsels.clear();
+        }
+    }
+    {
+        lock_guard<mutex> lock(batchMutex);
+        cancelled = TRUE;
+    }
+    batchTaken.notify_all();
+    for (int i=0; i<workerCount; i++) {
+        if (workers[i].thread.joinable()) {
+            workers[i].thread.join();
+        }
+    }
+
+    // Close the pipelines
+    int rc;
+    for (int i=0; i<workerCount; i++) {
+        if ((rc = workers[i].rootOp->Close())) {
+            return rc;
+        }
+    }
+    batches.clear();
+    currentBatch.clear();
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next data
+/* Steps:
+    1) If the current batch is done, wait for the next batch of the workers
+        - If the batch queue is empty and all the workers ended, return QL_EOF (or the error of
+          a worker, once)
+    2) Copy the next tuple of the batch to the return parameter
+*/
+RC QL_ExchangeOp::GetNextOp(char* recordData) {
+    // Check if closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+    if (exhausted) {
+        return QL_EOF;
+    }
+
+    // Get the next batch
+    while (batchPosition >= currentBatch.size()) {
+        unique_lock<mutex> lock(batchMutex);
+        while (batches.empty() && runningWorkers > 0) {
+            batchReady.wait(lock);
+        }
+        if (batches.empty()) {
+            exhausted = TRUE;
+            return workerRC ? workerRC : QL_EOF;
+        }
+        currentBatch.swap(batches.front());
+        batches.pop_front();
+        batchPosition = 0;
+        batchTaken.notify_one();
+    }
+
+    // Copy the tuple
+    memcpy(recordData, &currentBatch[batchPosition], tupleLength);
+    batchPosition += tupleLength;
+
+    return OK_RC;
+}
+
+// Method: RunWorker(int worker)
+// Run the pipeline of the worker on the morsels it gets, queueing its tuples in batches
+void QL_ExchangeOp::RunWorker(int worker) {
+    int rc = OK_RC;
+    char* recordData = new char[tupleLength];
+    vector<char> batch;
+    batch.reserve(QL_EXCHANGE_BATCH_TUPLES * tupleLength);
+    bool stopped = false;
+    PageNum startPage, endPage;
+    while (!stopped && GetNextMorsel(worker, startPage, endPage)) {
+        // Restart the scan on the morsel
+        if ((rc = workers[worker].scanOp->SetPageRange(startPage, endPage))) {
+            break;
+        }
+
+        // Batch the tuples of the pipeline
+        while ((rc = workers[worker].rootOp->GetNext(recordData)) == OK_RC) {
+            batch.insert(batch.end(), recordData, recordData + tupleLength);
+            if (batch.size() >= (unsigned int) (QL_EXCHANGE_BATCH_TUPLES * tupleLength)) {
+                if (!PushBatch(batch)) {
+                    stopped = true;
+                    break;
+                }
+            }
+        }
+        if (rc != QL_EOF && !stopped) {
+            break;
+        }
+        rc = OK_RC;
+    }
+    if (rc == OK_RC && !stopped && !batch.empty()) {
+        PushBatch(batch);
+    }
+    delete[] recordData;
+
+    // End the worker
+    lock_guard<mutex> lock(batchMutex);
+    if (rc && workerRC == OK_RC) {
+        workerRC = rc;
+    }
+    runningWorkers--;
+    batchReady.notify_all();
+}
+
+// Method: GetNextMorsel(int worker, PageNum &startPage, PageNum &endPage)
+// Take the next morsel of the queue of the worker, or steal the last morsel of the longest
+// queue of the other workers; return false when no morsel is left
+bool QL_ExchangeOp::GetNextMorsel(int worker, PageNum &startPage, PageNum &endPage) {
+    lock_guard<mutex> lock(morselMutex);
+    deque<pair<PageNum, PageNum> > &morsels = workers[worker].morsels;
+    if (!morsels.empty()) {
+        startPage = morsels.front().first;
+        endPage = morsels.front().second;
+        morsels.pop_front();
+        return true;
+    }
+
+    // Steal from the longest queue
+    int victim = -1;
+    unsigned int longest = 0;
+    for (int i=0; i<workerCount; i++) {
+        if (workers[i].morsels.size() > longest) {
+            victim = i;
+            longest = workers[i].morsels.size();
+        }
+    }
+    if (victim == -1) {
+        return false;
+    }
+    startPage = workers[victim].morsels.back().first;
+    endPage = workers[victim].morsels.back().second;
+    workers[victim].morsels.pop_back();
+    return true;
+}
+
+// Method: PushBatch(vector<char> &batch)
+// Queue a full batch of a worker, waiting while QL_EXCHANGE_QUEUE_BATCHES batches are queued;
+// return false if the operator is being closed
+bool QL_ExchangeOp::PushBatch(vector<char> &batch) {
+    unique_lock<mutex> lock(batchMutex);
+    while (batches.size() >= QL_EXCHANGE_QUEUE_BATCHES && !cancelled) {
+        batchTaken.wait(lock);
+    }
+    if (cancelled) {
+        return false;
+    }
+    batches.push_back(vector<char>());
+    batches.back().swap(batch);
+    batch.reserve(QL_EXCHANGE_BATCH_TUPLES * tupleLength);
+    batchReady.notify_one();
+    return true;
+}
+
+// Get the attribute count
+void QL_ExchangeOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute information
+void QL_ExchangeOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+// Print the physical query plan
+void QL_ExchangeOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "ExchangeOp (" << workerCount << " workers)";
+    PrintStatistics();
+    cout << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    workers[0].rootOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** QL_GatherDataOp **********/
+
+// Constructor
+QL_GatherDataOp::QL_GatherDataOp(const char* relName, const vector<EX_Worker> &workers,
+                                 int attrCount, const DataAttrInfo* attributes) {
+    // Copy the members
+    memset(this->relName, 0, MAXNAME+1);
+    strcpy(this->relName, relName);
+    this->attrCount = attrCount;
+    this->attributes = new DataAttrInfo[attrCount];
+    for (int i=0; i<attrCount; i++) {
+        this->attributes[i] = attributes[i];
+    }
+
+    // The stream ends the workers when deleted
+    // (a node running several workers is listed once)
+    stream = new EX_WorkerStream(workers);
+    for (int i=0; i<(int) workers.size(); i++) {
+        if (find(nodes.begin(), nodes.end(), workers[i].node) == nodes.end()) {
+            nodes.push_back(workers[i].node);
+        }
+    }
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_GatherDataOp::~QL_GatherDataOp() {
+    delete stream;
+    delete[] attributes;
+}
+
+// Open the operator
+RC QL_GatherDataOp::OpenOp() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+// The workers are ended, keeping the plans they sent for Print
+RC QL_GatherDataOp::CloseOp() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // End the workers
+    int rc;
+    if ((rc = stream->End())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Get the next record
+RC QL_GatherDataOp::GetNextOp(char* recordData) {
+    // Check if open
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Get the next tuple of the workers
+    int rc = stream->GetNext(recordData);
+    if (rc == EX_EOF) {
+        return QL_EOF;
+    }
+    return rc;
+}
+
+// Print the operator
+void QL_GatherDataOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "GatherDataOp (" << relName << ";";
+    for (int i=0; i<(int) nodes.size(); i++) {
+        cout << " " << nodes[i];
+    }
+    // (the conditions of the query may prune every data node)
+    if (nodes.empty()) {
+        cout << " no data nodes";
+    }
+    cout << ")";
+    PrintStatistics();
+    cout << endl;
+    if (nodes.empty()) {
+        return;
+    }
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    stream->PrintPlans(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+// Get the attribute count
+void QL_GatherDataOp::GetAttributeCount(int &attrCount) {
+    attrCount = this->attrCount;
+}
+
+// Get the attribute info
+void QL_GatherDataOp::GetAttributeInfo(DataAttrInfo* attributes) {
+    for (int i=0; i<attrCount; i++) {
+        attributes[i] = this->attributes[i];
+    }
+}
+
+
+/********** QL_ShuffleDataOp **********/
+
+// Constructor
+QL_ShuffleDataOp::QL_ShuffleDataOp(RM_Manager* rmManager, shared_ptr<QL_Op> childOp, int fromNode, int toNode) {
+    // Copy the members
+    this->rmManager = rmManager;
+    this->rmFH = rmFH;
+    this->childOp = childOp;
+    this->fromNode = fromNode;
+    this->toNode = toNode;
+    broadcast = false;
+
+    // Find the tuple length
+    int attrCount;
+    childOp->GetAttributeCount(attrCount);
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    childOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+    delete[] attributes;
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Constructor - repartition the tuples to the data nodes by the value of partitionAttr
+// (the data node of a value is found in routingTable, and nodeSockets[j-1] goes to node j)
+QL_ShuffleDataOp::QL_ShuffleDataOp(RM_Manager* rmManager, shared_ptr<QL_Op> childOp, int fromNode, const RelAttr &partitionAttr,
+                                   const EX_RoutingTable &routingTable, const vector<int> &nodeSockets) {
+    // Copy the members
+    this->rmManager = rmManager;
+    this->childOp = childOp;
+    this->fromNode = fromNode;
+    this->toNode = 0;
+    memset(partitionRelName, 0, MAXNAME+1);
+    strcpy(partitionRelName, partitionAttr.relName);
+    memset(partitionAttrName, 0, MAXNAME+1);
+    strcpy(partitionAttrName, partitionAttr.attrName);
+    this->routingTable = routingTable;
+    this->nodeSockets = nodeSockets;
+    for (int i=1; i<=(int) nodeSockets.size(); i++) {
+        toNodes.push_back(i);
+    }
+    broadcast = false;
+
+    // Find the tuple length and the partition attribute
+    int attrCount;
+    childOp->GetAttributeCount(attrCount);
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    childOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+    GetAttrInfoFromArray((char*) attributes, attrCount, partitionRelName, partitionAttrName, (char*) &partitionAttribute);
+    delete[] attributes;
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Constructor - broadcast every tuple to the data nodes toNodes (nodeSockets[i] goes to toNodes[i])
+QL_ShuffleDataOp::QL_ShuffleDataOp(RM_Manager* rmManager, shared_ptr<QL_Op> childOp, int fromNode,
+                                   const vector<int> &toNodes, const vector<int> &nodeSockets) {
+    // Copy the members
+    this->rmManager = rmManager;
+    this->childOp = childOp;
+    this->fromNode = fromNode;
+    this->toNode = 0;
+    memset(partitionRelName, 0, MAXNAME+1);
+    memset(partitionAttrName, 0, MAXNAME+1);
+    partitionAttribute.attrType = INT;
+    partitionAttribute.attrLength = 0;
+    partitionAttribute.offset = 0;
+    this->toNodes = toNodes;
+    this->nodeSockets = nodeSockets;
+    broadcast = true;
+
+    // Find the tuple length
+    int attrCount;
+    childOp->GetAttributeCount(attrCount);
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    childOp->GetAttributeInfo(attributes);
+    tupleLength = 0;
+    for (int i=0; i<attrCount; i++) {
+        tupleLength += attributes[i].attrLength;
+    }
+    delete[] attributes;
+
+    // Set open flag to FALSE
+    isOpen = FALSE;
+}
+
+// Destructor
+QL_ShuffleDataOp::~QL_ShuffleDataOp() {
+    // Nothing to free
+}
+
+// Open the operator
+RC QL_ShuffleDataOp::Open() {
+    // Check if already open
+    if (isOpen) {
+        return QL_OPERATOR_OPEN;
+    }
+
+    // Open the child operator
+    int rc;
+    if ((rc = childOp->Open())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = TRUE;
+
+    return OK_RC;
+}
+
+// Close the operator
+RC QL_ShuffleDataOp::Close() {
+    // Check if already closed
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+
+    // Close the child operator
+    int rc;
+    if ((rc = childOp->Close())) {
+        return rc;
+    }
+
+    // Set the flag
+    isOpen = FALSE;
+
+    return OK_RC;
+}
+
+// Send the data from the child operator through the socket of the worker process
+/* Steps:
+    1) Check if operator is open
+    2) Collect the records from the child operator in a buffer
+    3) Send a tuples message whenever the buffer is full, and at the end
+*/
+RC QL_ShuffleDataOp::SendData(int socket) {
+    // Check if open
+    if (!isOpen) {
+        return QL_OPERATOR_CLOSED;
+    }
+    if (!nodeSockets.empty()) {
+        return SendPartitions();
+    }
+
+    // Collect the records from the child operator
+    int rc;
+    int bufferTuples = EX_MESSAGE_SIZE / tupleLength;
+    if (bufferTuples < 1) {
+        bufferTuples = 1;
+    }
+    char* buffer = new char[bufferTuples * tupleLength];
+    int nTuples = 0;
+    while ((rc = childOp->GetNext(buffer + nTuples*tupleLength)) != QL_EOF) {
+        if (rc) {
+            delete[] buffer;
+            return rc;
+        }
+        if (++nTuples == bufferTuples) {
+            if ((rc = EX_WriteMessage(socket, EX_TUPLES_MESSAGE, buffer, nTuples*tupleLength))) {
+                delete[] buffer;
+                return rc;
+            }
+            nTuples = 0;
+        }
+    }
+
+    // Send the remaining records
+    rc = OK_RC;
+    if (nTuples > 0) {
+        rc = EX_WriteMessage(socket, EX_TUPLES_MESSAGE, buffer, nTuples*tupleLength);
+    }
+    delete[] buffer;
+
+    return rc;
+}
+
+// Send the tuples from the child operator to the data nodes of their partitions
+/* Steps:
+    1) Find the data node of each record from the value of its partition attribute
+       (every data node when broadcasting)
+    2) Send a tuples message to a data node whenever its buffer is full, and at the end
+    3) Send the end message with the return code to every data node
+*/
+RC QL_ShuffleDataOp::SendPartitions() {
+    int rc;
+    int nNodes = nodeSockets.size();
+    int bufferTuples = EX_MESSAGE_SIZE / tupleLength;
+    if (bufferTuples < 1) {
+        bufferTuples = 1;
+    }
+    vector<vector<char> > buffers(nNodes, vector<char>(bufferTuples * tupleLength));
+    vector<int> nTuples(nNodes, 0);
+    char* recordData = new char[tupleLength];
+    char* keyData = new char[partitionAttribute.attrLength + 1];
+    Value key;
+    key.type = partitionAttribute.attrType;
+    key.data = keyData;
+    while ((rc = childOp->GetNext(recordData)) != QL_EOF) {
+        if (rc) {
+            break;
+        }
+
+        // Find the data node of the record
+        // (a value outside the ranges matches no tuple of a relation partitioned by them)
+        int node = 0;
+        if (!broadcast) {
+            memset(keyData, 0, partitionAttribute.attrLength + 1);
+            memcpy(keyData, recordData + partitionAttribute.offset, partitionAttribute.attrLength);
+            if ((rc = GetDataNodeForKey(routingTable, key, node)) == EX_INCONSISTENT_PV) {
+                rc = OK_RC;
+                continue;
+            }
+            if (rc) {
+                break;
+            }
+            if (node < 1 || node > nNodes) {
+                rc = EX_INCONSISTENT_PV;
+                break;
+            }
+        }
+
+        // Add the record to the buffer of the data node, or of every data node
+        for (int j = broadcast ? 0 : node - 1; j < (broadcast ? nNodes : node) && !rc; j++) {
+            memcpy(&buffers[j][nTuples[j]*tupleLength], recordData, tupleLength);
+            if (++nTuples[j] == bufferTuples) {
+                rc = EX_WriteMessage(nodeSockets[j], EX_TUPLES_MESSAGE, &buffers[j][0], nTuples[j]*tupleLength);
+                nTuples[j] = 0;
+            }
+        }
+        if (rc) {
+            break;
+        }
+    }
+    delete[] recordData;
+    delete[] keyData;
+    if (rc == QL_EOF) {
+        rc = OK_RC;
+    }
+
+    // Send the remaining records
+    for (int j=0; j<nNodes && !rc; j++) {
+        if (nTuples[j] > 0) {
+            rc = EX_WriteMessage(nodeSockets[j], EX_TUPLES_MESSAGE, &buffers[j][0], nTuples[j]*tupleLength);
+        }
+    }
+
+    // End the stream of every data node
+    for (int j=0; j<nNodes; j++) {
+        EX_WriteMessage(nodeSockets[j], EX_END_MESSAGE, (const char*) &rc, sizeof(int));
+    }
+
+    return rc;
+}
+
+// Get the length of the tuples sent to the master node
+// (none when repartitioning to the data nodes)
+int QL_ShuffleDataOp::GetTupleLength() const {
+    if (!nodeSockets.empty()) {
+        return 0;
+    }
+    return tupleLength;
+}
+
+// Get the sockets to the data nodes of a repartitioning
+const vector<int>& QL_ShuffleDataOp::GetNodeSockets() const {
+    return nodeSockets;
+}
+
+// Print the operator
+void QL_ShuffleDataOp::Print(int indentationLevel) {
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+
+    cout << "ShuffleDataOp (";
+    if (!nodeSockets.empty()) {
+        cout << fromNode << ",";
+        for (int i=0; i<(int) toNodes.size(); i++) {
+            cout << " " << toNodes[i];
+        }
+        if (!broadcast) {
+            cout << "; " << partitionRelName << "." << partitionAttrName;
+        }
+    }
+    else {
+        cout << fromNode << ", " << toNode;
+    }
+    cout << ")" << endl;
+
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "[" << endl;
+    childOp->Print(indentationLevel+1);
+    for (int i=0; i<indentationLevel; i++) cout << "\t";
+    cout << "]" << endl;
+}
+
+
+/********** Helper Methods **********/
+
+// Get the string form of the operator
+void PrintOperator(CompOp op) {
+    switch(op) {
+        case EQ_OP:
+            cout << " = ";
+            break;
+        case LT_OP:
+            cout << " < ";
+            break;
+        case GT_OP:
+            cout << " > ";
+            break;
+        case LE_OP:
+            cout << " <= ";
+            break;
+        case GE_OP:
+            cout << " >= ";
+            break;
+        case NE_OP:
+            cout << " != ";
+            break;
+        default:
+            cout << " NO_OP ";
+    }
+}
+
+// Get the value in a string for printing
+void PrintValue(const Value* v) {
+    AttrType vType = v->type;
+    if (vType == INT) {
+        int value = *static_cast<int*>(v->data);
         cout << value;
     }
     else if (vType == FLOAT) {
@@ -1466,6 +4990,7 @@ RC GetAttrInfoFromArray(char* attributes, int attrCount, const char* relName, co
                 attribute->attrType = attributesArray[i].attrType;
                 attribute->attrLength = attributesArray[i].attrLength;
                 attribute->indexNo = attributesArray[i].indexNo;
+                attribute->indexType = attributesArray[i].indexType;
                 found = true;
                 break;
             }
@@ -1479,6 +5004,111 @@ RC GetAttrInfoFromArray(char* attributes, int attrCount, const char* relName, co
     return OK_RC;
 }
 
+// Bind a condition to the offsets of its attributes in a tuple layout
+RC CompileCondition(const Condition &cond, DataAttrInfo* attributes, int attrCount, QL_CompiledCondition &compiledCond) {
+    int rc;
+    DataAttrInfo* attributeData = new DataAttrInfo;
+
+    // Get the information about the LHS attribute
+    if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, (cond.lhsAttr).relName, (cond.lhsAttr).attrName, (char*) attributeData))) {
+        delete attributeData;
+        return rc;
+    }
+    compiledCond.op = cond.op;
+    compiledCond.attrType = attributeData->attrType;
+    compiledCond.lhsOffset = attributeData->offset;
+    compiledCond.lhsLength = attributeData->attrLength;
+
+    // Get the information about the RHS attribute or value
+    compiledCond.rhsIsAttr = cond.bRhsIsAttr;
+    if (cond.bRhsIsAttr) {
+        if ((rc = GetAttrInfoFromArray((char*) attributes, attrCount, (cond.rhsAttr).relName, (cond.rhsAttr).attrName, (char*) attributeData))) {
+            delete attributeData;
+            return rc;
+        }
+        compiledCond.rhsOffset = attributeData->offset;
+        compiledCond.rhsLength = attributeData->attrLength;
+        compiledCond.rhsValue = NULL;
+    }
+    else {
+        compiledCond.rhsOffset = 0;
+        compiledCond.rhsValue = static_cast<const char*>((cond.rhsValue).data);
+        if (compiledCond.attrType == STRING) {
+            compiledCond.rhsLength = strlen(compiledCond.rhsValue);
+        }
+        else {
+            compiledCond.rhsLength = sizeof(int);
+        }
+    }
+    delete attributeData;
+
+    return OK_RC;
+}
+
+// Check a bound condition on the tuples holding its LHS and RHS attributes
+bool EvaluateCondition(const QL_CompiledCondition &compiledCond, const char* lhsData, const char* rhsData) {
+    const char* lhsValue = lhsData + compiledCond.lhsOffset;
+    const char* rhsValue = compiledCond.rhsIsAttr ? rhsData + compiledCond.rhsOffset : compiledCond.rhsValue;
+    int comparison = CompareAttributeValues(compiledCond.attrType, lhsValue, compiledCond.lhsLength, rhsValue, compiledCond.rhsLength);
+    return matchRecord(comparison, 0, compiledCond.op);
+}
+
+// Compare two attribute values (negative, zero or positive)
+// Strings end at the attribute length or the first null character
+int CompareAttributeValues(AttrType attrType, const char* lhsValue, int lhsLength, const char* rhsValue, int rhsLength) {
+    if (attrType == INT) {
+        int lhs, rhs;
+        memcpy(&lhs, lhsValue, sizeof(int));
+        memcpy(&rhs, rhsValue, sizeof(int));
+        return (lhs > rhs) - (lhs < rhs);
+    }
+    else if (attrType == FLOAT) {
+        float lhs, rhs;
+        memcpy(&lhs, lhsValue, sizeof(float));
+        memcpy(&rhs, rhsValue, sizeof(float));
+        return (lhs > rhs) - (lhs < rhs);
+    }
+    else {
+        int length = lhsLength < rhsLength ? lhsLength : rhsLength;
+        for (int i=0; i<length; i++) {
+            unsigned char lhs = lhsValue[i];
+            unsigned char rhs = rhsValue[i];
+            if (lhs != rhs) {
+                return lhs < rhs ? -1 : 1;
+            }
+            if (lhs == '\0') {
+                return 0;
+            }
+        }
+        if (lhsLength > length && lhsValue[length] != '\0') {
+            return 1;
+        }
+        if (rhsLength > length && rhsValue[length] != '\0') {
+            return -1;
+        }
+        return 0;
+    }
+}
+
+// Get the name of the result attribute of an aggregate (e.g. "COUNT(*)" or "SUM(num)")
+void GetAggregateAttrName(AggFun aggFun, const char* attrName, char* aggAttrName) {
+    string name;
+    switch (aggFun) {
+        case MIN_F: name = "MIN("; break;
+        case MAX_F: name = "MAX("; break;
+        case COUNT_F: name = "COUNT("; break;
+        case SUM_F: name = "SUM("; break;
+        case AVG_F: name = "AVG("; break;
+        default: break;
+    }
+    name += attrName;
+    if (aggFun != NO_F) {
+        name += ")";
+    }
+    memset(aggAttrName, 0, MAXNAME+1);
+    strncpy(aggAttrName, name.c_str(), MAXNAME);
+}
+
 // Template function to compare two values
 template <typename T>
 bool matchRecord(T lhsValue, T rhsValue, CompOp op) {
@@ -1507,3 +5137,9 @@ bool matchRecord(T lhsValue, T rhsValue, CompOp op) {
     }
     return recordMatch;
 }
+
+// Instantiations used by the QL manager
+template bool matchRecord<int>(int lhsValue, int rhsValue, CompOp op);
+template bool matchRecord<float>(float lhsValue, float rhsValue, CompOp op);
+template bool matchRecord<string>(string lhsValue, string rhsValue, CompOp op);
+
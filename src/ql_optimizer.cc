@@ -0,0 +1,605 @@
+//
+// File:        ql_optimizer.cc
+// Description: QL_Optimizer class implementation
+// Authors:     Aditya Bhandari (adityasb@stanford.edu)
+//
+
+#include <cstdio>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "redbase.h"
+#include "ql.h"
+#include "ql_internal.h"
+#include "sm.h"
+#include "ix.h"
+#include "rm.h"
+#include "printer.h"
+#include "parser.h"
+
+using namespace std;
+
+
+// Method: EstimatePages(double tupleCount, int tupleLength)
+// Estimated number of pages of the tuples
+static double EstimatePages(double tupleCount, int tupleLength) {
+    double pages = ceil(tupleCount * tupleLength / PF_PAGE_SIZE);
+    return pages < 1 ? 1 : pages;
+}
+
+
+/********** QL_Optimizer class **********/
+
+// Constructor
+QL_Optimizer::QL_Optimizer(SM_Manager* smManager, IX_Manager* ixManager, RM_Manager* rmManager,
+                           int nRelations, const char* const relations[], SM_RelcatRecord* const rcRecords[],
+                           DataAttrInfo* const attributes[], int nConditions, const Condition conditions[],
+                           int nOutputAttrs, const RelAttr outputAttrs[],
+                           const int scanAttrCounts[], DataAttrInfo* const scanAttributes[]) {
+    this->smManager = smManager;
+    this->ixManager = ixManager;
+    this->rmManager = rmManager;
+    this->nRelations = nRelations;
+    this->relations = relations;
+    this->rcRecords = rcRecords;
+    this->attributes = attributes;
+    this->nConditions = nConditions;
+    this->conditions = conditions;
+    this->nOutputAttrs = nOutputAttrs;
+    this->outputAttrs = outputAttrs;
+    this->scanAttrCounts = scanAttrCounts;
+    this->scanAttributes = scanAttributes;
+
+    // Get the relations of the conditions
+    lhsRelations.resize(nConditions, -1);
+    rhsRelations.resize(nConditions, -1);
+    for (int i=0; i<nConditions; i++) {
+        lhsRelations[i] = FindRelation((conditions[i].lhsAttr).relName);
+        if (conditions[i].bRhsIsAttr) {
+            rhsRelations[i] = FindRelation((conditions[i].rhsAttr).relName);
+        }
+    }
+    selectivities.resize(nConditions, 1);
+    accessPaths.resize(nRelations);
+
+    // Get the statistics of the analyzed relations
+    statistics.resize(nRelations);
+    for (int i=0; i<nRelations; i++) {
+        int attrCount = rcRecords[i]->attrCount;
+        vector<SM_StatcatRecord> relationStatistics(attrCount);
+        int found = FALSE;
+        if (attrCount > 0 && smManager->GetStatInfo(relations[i], attrCount, &relationStatistics[0], found) == OK_RC && found) {
+            statistics[i] = relationStatistics;
+        }
+    }
+}
+
+// Destructor
+QL_Optimizer::~QL_Optimizer() {
+    // Nothing to free
+}
+
+// Method: FindRelation(const char* relName)
+// Get the relation holding the attributes of relName (a fetched temporary file holds the
+// attributes of several relations if they were joined in the data nodes)
+int QL_Optimizer::FindRelation(const char* relName) const {
+    for (int i=0; i<nRelations; i++) {
+        if (strcmp(relName, relations[i]) == 0) {
+            return i;
+        }
+        for (int j=0; scanAttributes[i] != NULL && j<scanAttrCounts[i]; j++) {
+            if (strcmp(relName, scanAttributes[i][j].relName) == 0) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+// Method: Optimize(shared_ptr<QL_Op> &rootOp)
+// Form the cheapest operator tree of the join of the relations with all the conditions applied
+/* Steps:
+    1) Estimate the selectivity of each condition
+    2) Choose the access path of each relation
+    3) Choose the join order
+    4) Form the operator tree in the join order
+        - Read the first relation with its access path
+        - Join each next relation, probing its index with an IndexNLJoinOp, or reading it with
+          its access path in a join chosen by CreateJoinOp or a CrossProductOp
+        - Apply the conditions on each relation right above its scan, and the other conditions
+          as soon as all their relations are joined
+        - Project each scan and index join on the attributes still needed above it, so that
+          the joins only carry those attributes
+        - Scan, filter and project a large relation read by a file scan on the worker threads
+          of an ExchangeOp if the parallelism system parameter allows
+*/
+RC QL_Optimizer::Optimize(shared_ptr<QL_Op> &rootOp) {
+    int rc;
+
+    // Estimate the selectivities
+    for (int i=0; i<nConditions; i++) {
+        if ((rc = EstimateSelectivity(i))) {
+            return rc;
+        }
+    }
+
+    // Choose the access paths
+    for (int i=0; i<nRelations; i++) {
+        ChooseAccessPath(i);
+    }
+
+    // Choose the join order
+    if (nRelations <= QL_DP_JOIN_LIMIT) {
+        OrderJoinsDP();
+    }
+    else {
+        OrderJoinsGreedy();
+    }
+
+    // Form the operator tree
+    vector<bool> applied(nConditions, false);
+    vector<bool> joined(nRelations, false);
+    shared_ptr<QL_Op> lastOp;
+    for (unsigned int k=0; k<joinPlan.order.size(); k++) {
+        int relation = joinPlan.order[k];
+        int attrCount = rcRecords[relation]->attrCount;
+
+        // Probe the index of the relation with each tuple of the last op
+        shared_ptr<QL_Op> joinOp;
+        int indexJoin = joinPlan.indexJoins[k];
+        if (indexJoin != -1) {
+            joinOp = CreateIndexNLJoinOp(smManager, ixManager, rmManager, lastOp, relations[relation],
+                                         attrCount, attributes[relation], conditions[indexJoin]);
+            if (joinOp) {
+                applied[indexJoin] = true;
+                // (the output of the last join is projected by the root of the query)
+                if (k + 1 < joinPlan.order.size()) {
+                    joinOp = ProjectNeeded(joinOp, applied);
+                }
+            }
+        }
+
+        // Else read the relation with its access path
+        if (!joinOp) {
+            shared_ptr<QL_Op> scanOp;
+            const QL_AccessPath &accessPath = accessPaths[relation];
+            if (accessPath.indexCondition != -1) {
+                scanOp = CreateIndexScanOp(smManager, ixManager, rmManager, relations[relation],
+                                           (conditions[accessPath.indexCondition].lhsAttr).attrName, conditions,
+                                           accessPath.indexCondition, accessPath.rangeCondition, accessPath.indexMatches);
+                applied[accessPath.indexCondition] = true;
+                if (accessPath.rangeCondition != -1) {
+                    applied[accessPath.rangeCondition] = true;
+                }
+            }
+            else if (smManager->getParallelism() > 1 && accessPath.pages >= QL_EXCHANGE_MIN_PAGES) {
+                vector<Condition> scanConditions;
+                for (int i=0; i<nConditions; i++) {
+                    if (lhsRelations[i] == relation && (rhsRelations[i] == -1 || rhsRelations[i] == relation)) {
+                        scanConditions.push_back(conditions[i]);
+                        applied[i] = true;
+                    }
+                }
+                vector<RelAttr> neededAttrs;
+                GetNeededAttrs(applied, neededAttrs);
+                scanOp.reset(new QL_ExchangeOp(smManager, rmManager, relations[relation], scanAttrCounts[relation], scanAttributes[relation],
+                                               scanConditions.size(), scanConditions.data(),
+                                               nRelations < 2 ? -1 : (int) neededAttrs.size(), neededAttrs.data(),
+                                               smManager->getParallelism()));
+            }
+            else if (scanAttributes[relation] != NULL) {
+                scanOp.reset(new QL_FileScanOp(smManager, rmManager, relations[relation], scanAttrCounts[relation], scanAttributes[relation]));
+            }
+            else {
+                scanOp.reset(new QL_FileScanOp(smManager, rmManager, relations[relation], false, NULL, NO_OP, NULL));
+            }
+
+            // Filter the relation before the join
+            for (int i=0; i<nConditions; i++) {
+                if (!applied[i] && lhsRelations[i] == relation && (rhsRelations[i] == -1 || rhsRelations[i] == relation)) {
+                    scanOp.reset(new QL_FilterOp(smManager, scanOp, conditions[i]));
+                    applied[i] = true;
+                }
+            }
+            scanOp = ProjectNeeded(scanOp, applied);
+
+            // Join with the last op, on an equality if possible
+            if (!lastOp) {
+                joinOp = scanOp;
+            }
+            else {
+                int joinCondition = -1;
+                for (int i=0; i<nConditions; i++) {
+                    if (!applied[i] && IsJoinCondition(i, relation, joined)) {
+                        if (joinCondition == -1 || (conditions[i].op == EQ_OP && conditions[joinCondition].op != EQ_OP)) {
+                            joinCondition = i;
+                        }
+                    }
+                }
+                if (joinCondition != -1) {
+                    joinOp = CreateJoinOp(smManager, rmManager, lastOp, scanOp, conditions[joinCondition]);
+                    applied[joinCondition] = true;
+                }
+                else {
+                    joinOp.reset(new QL_CrossProductOp(smManager, lastOp, scanOp));
+                }
+            }
+        }
+        lastOp = joinOp;
+        joined[relation] = true;
+
+        // Apply the conditions on the joined relations
+        for (int i=0; i<nConditions; i++) {
+            if (!applied[i] && IsConditionCovered(i, joined)) {
+                lastOp.reset(new QL_FilterOp(smManager, lastOp, conditions[i]));
+                applied[i] = true;
+            }
+        }
+    }
+
+    rootOp = lastOp;
+    return OK_RC;
+}
+
+// Method: GetStatistics(int relation, const char* attrName)
+// The statcat record of an attribute of the relation, or NULL if it was not analyzed
+const SM_StatcatRecord* QL_Optimizer::GetStatistics(int relation, const char* attrName) const {
+    if (relation == -1) {
+        return NULL;
+    }
+    for (unsigned int i=0; i<statistics[relation].size(); i++) {
+        if (strcmp(statistics[relation][i].attrName, attrName) == 0) {
+            return &statistics[relation][i];
+        }
+    }
+    return NULL;
+}
+
+// Method: EstimateSelectivity(int condition)
+// Estimate the fraction of the tuples satisfying the condition
+/* Estimates:
+    1) attr = value - 1 / distinct values of the attribute
+    2) attr1 = attr2 - 1 / distinct values of the attribute with more of them
+    3) <> - 1 - estimate of =
+    4) attr <, <=, >, >= value - the fraction of the histogram of the attribute on that side
+       of the value
+    5) Other <, <=, >, >= - QL_RANGE_SELECTIVITY
+    The distinct counts of statcat (ANALYZE) are preferred to those of attrcat; an equality
+    without distinct value counts gets QL_EQ_SELECTIVITY
+*/
+RC QL_Optimizer::EstimateSelectivity(int condition) {
+    const Condition &cond = conditions[condition];
+    const SM_StatcatRecord* lhsStatistics = GetStatistics(lhsRelations[condition], (cond.lhsAttr).attrName);
+    double selectivity = 1;
+    if (cond.op == EQ_OP || cond.op == NE_OP) {
+        // (a relation broadcast to a data node is missing from its attrcat, so the distinct
+        // counts of its attributes are unknown)
+        int rc;
+        SM_AttrcatRecord* attributeData = new SM_AttrcatRecord;
+        memset(attributeData, 0, sizeof(SM_AttrcatRecord));
+        if ((rc = smManager->GetAttrInfo((cond.lhsAttr).relName, (cond.lhsAttr).attrName, attributeData)) && rc != SM_INVALID_ATTRIBUTE) {
+            delete attributeData;
+            return rc;
+        }
+        int distinctCount = lhsStatistics ? lhsStatistics->distinctCount : attributeData->distinctCount;
+        if (cond.bRhsIsAttr) {
+            memset(attributeData, 0, sizeof(SM_AttrcatRecord));
+            if ((rc = smManager->GetAttrInfo((cond.rhsAttr).relName, (cond.rhsAttr).attrName, attributeData)) && rc != SM_INVALID_ATTRIBUTE) {
+                delete attributeData;
+                return rc;
+            }
+            const SM_StatcatRecord* rhsStatistics = GetStatistics(rhsRelations[condition], (cond.rhsAttr).attrName);
+            int rhsDistinctCount = rhsStatistics ? rhsStatistics->distinctCount : attributeData->distinctCount;
+            if (rhsDistinctCount > distinctCount) {
+                distinctCount = rhsDistinctCount;
+            }
+        }
+        delete attributeData;
+
+        selectivity = distinctCount > 0 ? 1.0 / distinctCount : QL_EQ_SELECTIVITY;
+        if (cond.op == NE_OP) {
+            selectivity = 1 - selectivity;
+        }
+    }
+    else if (cond.op != NO_OP && lhsStatistics && lhsStatistics->tupleCount > 0 && !cond.bRhsIsAttr) {
+        SM_AttrcatRecord* attributeData = new SM_AttrcatRecord;
+        int rc;
+        if ((rc = smManager->GetAttrInfo((cond.lhsAttr).relName, (cond.lhsAttr).attrName, attributeData))) {
+            delete attributeData;
+            return rc;
+        }
+        float key = SM_HistogramKey(attributeData->attrType, attributeData->attrLength, (char*) (cond.rhsValue).data);
+        delete attributeData;
+
+        double below = SM_HistogramFraction(*lhsStatistics, key);
+        selectivity = (cond.op == LT_OP || cond.op == LE_OP) ? below : 1 - below;
+
+        // Never estimate fewer than one tuple
+        double minimum = 1.0 / lhsStatistics->tupleCount;
+        if (selectivity < minimum) {
+            selectivity = minimum;
+        }
+    }
+    else if (cond.op != NO_OP) {
+        selectivity = QL_RANGE_SELECTIVITY;
+    }
+
+    selectivities[condition] = selectivity;
+    return OK_RC;
+}
+
+// Method: ChooseAccessPath(int relation)
+// Choose the cheapest way to read the relation
+/* Steps:
+    1) Cost a file scan - all the pages (counted by ANALYZE if available) and tuples
+    2) Cost an index scan for each condition on an indexed attribute (bounded from the
+       other side if possible) - the probe, and a page for each matching tuple up to all
+       the pages since the records are fetched in page order when more than
+       QL_SORTED_FETCH_THRESHOLD entries are estimated to match
+    3) Estimate the tuples left after all the conditions on the relation
+*/
+void QL_Optimizer::ChooseAccessPath(int relation) {
+    QL_AccessPath &accessPath = accessPaths[relation];
+    double tupleCount = rcRecords[relation]->tupleCount;
+    double pages = EstimatePages(tupleCount, rcRecords[relation]->tupleLength);
+    if (!statistics[relation].empty() && statistics[relation][0].pageCount > 0) {
+        pages = statistics[relation][0].pageCount;
+    }
+
+    // File scan
+    accessPath.indexCondition = -1;
+    accessPath.rangeCondition = -1;
+    accessPath.cost = pages + QL_TUPLE_CPU_COST * tupleCount;
+    accessPath.tupleCount = tupleCount;
+    accessPath.pages = pages;
+    accessPath.indexMatches = 0;
+
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    for (int i=0; i<nConditions; i++) {
+        const Condition &cond = conditions[i];
+        if (lhsRelations[i] != relation || cond.bRhsIsAttr) continue;
+        accessPath.tupleCount *= selectivities[i];
+
+        // Index scan
+        if (GetAttrInfoFromArray((char*) attributes[relation], rcRecords[relation]->attrCount, relations[relation],
+                                 (cond.lhsAttr).attrName, (char*) attributeData) == OK_RC &&
+            IndexSupportsCondition(*attributeData, cond.op)) {
+            int rangeCondition = FindRangeCondition(conditions, nConditions, i);
+            double matches = tupleCount * selectivities[i];
+            if (rangeCondition != -1) {
+                matches *= selectivities[rangeCondition];
+            }
+            double cost = QL_INDEX_PROBE_COST + (matches < pages ? matches : pages) + QL_TUPLE_CPU_COST * matches;
+            if (cost < accessPath.cost) {
+                accessPath.indexCondition = i;
+                accessPath.rangeCondition = rangeCondition;
+                accessPath.cost = cost;
+                accessPath.indexMatches = matches;
+            }
+        }
+    }
+    delete attributeData;
+}
+
+// Method: JoinRelation(const QL_JoinPlan &outerPlan, int relation, bool crossProduct, QL_JoinPlan &plan)
+// Cost the join of the relation after the relations of the outer plan with the cheapest join
+// Return false if no condition joins the relation, unless a cross product is allowed
+/* Join costs:
+    1) NLJoinOp - the relation is read again for each block of outer tuples (a share of the
+       buffer pool), CrossProductOp - the relation is read again for each outer tuple
+    2) Join on an equality (hash or merge join) - the relation is read once, and both
+       inputs are written and read again if the smaller one does not fit in memory
+    3) IndexNLJoinOp - a probe of the index of the relation, and a page for each match,
+       for each outer tuple
+*/
+bool QL_Optimizer::JoinRelation(const QL_JoinPlan &outerPlan, int relation, bool crossProduct, QL_JoinPlan &plan) {
+    vector<bool> joined(nRelations, false);
+    for (unsigned int k=0; k<outerPlan.order.size(); k++) {
+        joined[outerPlan.order[k]] = true;
+    }
+
+    // Get the conditions joining the relation
+    double selectivity = 1;
+    bool connected = false;
+    bool equality = false;
+    for (int i=0; i<nConditions; i++) {
+        if (IsJoinCondition(i, relation, joined)) {
+            selectivity *= selectivities[i];
+            connected = true;
+            equality = equality || conditions[i].op == EQ_OP;
+        }
+    }
+    if (!connected && !crossProduct) {
+        return false;
+    }
+
+    double outerCount = outerPlan.tupleCount;
+    double innerCount = accessPaths[relation].tupleCount;
+    int innerLength = rcRecords[relation]->tupleLength;
+    double outerPages = EstimatePages(outerCount, outerPlan.tupleLength);
+    double innerPages = EstimatePages(innerCount, innerLength);
+
+    // Nested loop join or cross product
+    double rescans = outerCount > 1 ? outerCount : 1;
+    if (connected) {
+        rescans = ceil(outerPages / GetJoinBlockPages(rmManager));
+    }
+    double cost = rescans * accessPaths[relation].cost + QL_TUPLE_CPU_COST * outerCount * innerCount;
+    int indexJoin = -1;
+
+    // Join on an equality
+    if (equality) {
+        double joinCost = accessPaths[relation].cost + QL_TUPLE_CPU_COST * (outerCount + innerCount);
+        double outerBytes = outerCount * outerPlan.tupleLength;
+        double innerBytes = innerCount * innerLength;
+        if ((outerBytes < innerBytes ? outerBytes : innerBytes) > QL_HASH_JOIN_MEMORY / 2) {
+            joinCost += 2 * (outerPages + innerPages);
+        }
+        if (joinCost < cost) {
+            cost = joinCost;
+        }
+    }
+
+    // Index nested loop join
+    DataAttrInfo* attributeData = new DataAttrInfo;
+    double tupleCount = rcRecords[relation]->tupleCount;
+    double pages = EstimatePages(tupleCount, innerLength);
+    for (int i=0; i<nConditions; i++) {
+        if (!IsJoinCondition(i, relation, joined)) continue;
+        const RelAttr* innerAttr;
+        const RelAttr* outerAttr;
+        CompOp probeOp;
+        if (GetIndexProbe(conditions[i], relations[relation], innerAttr, outerAttr, probeOp) &&
+            GetAttrInfoFromArray((char*) attributes[relation], rcRecords[relation]->attrCount, relations[relation],
+                                 innerAttr->attrName, (char*) attributeData) == OK_RC &&
+            IndexSupportsCondition(*attributeData, probeOp)) {
+            double matches = tupleCount * selectivities[i];
+            double joinCost = outerCount * (QL_INDEX_PROBE_COST + (matches < pages ? matches : pages)) +
+                              QL_TUPLE_CPU_COST * outerCount * matches;
+            if (joinCost < cost) {
+                cost = joinCost;
+                indexJoin = i;
+            }
+        }
+    }
+    delete attributeData;
+
+    // Form the plan
+    plan = outerPlan;
+    plan.order.push_back(relation);
+    plan.indexJoins.push_back(indexJoin);
+    plan.tupleCount = outerCount * innerCount * selectivity;
+    plan.tupleLength = outerPlan.tupleLength + innerLength;
+    plan.cost = outerPlan.cost + cost + QL_TUPLE_CPU_COST * plan.tupleCount;
+    return true;
+}
+
+// Method: OrderJoinsDP()
+// Find the cheapest left-deep join order with dynamic programming over the subsets of relations
+/* Steps:
+    1) The plan of a single relation is its access path
+    2) For each larger subset, join each of its relations after the best plan of the others
+       and keep the cheapest, avoiding cross products when a condition joins a relation
+*/
+void QL_Optimizer::OrderJoinsDP() {
+    int subsetCount = 1 << nRelations;
+    vector<QL_JoinPlan> plans(subsetCount);
+    vector<bool> found(subsetCount, false);
+
+    // Plans of a single relation
+    for (int i=0; i<nRelations; i++) {
+        QL_JoinPlan &plan = plans[1 << i];
+        plan.cost = accessPaths[i].cost;
+        plan.tupleCount = accessPaths[i].tupleCount;
+        plan.tupleLength = rcRecords[i]->tupleLength;
+        plan.order.push_back(i);
+        plan.indexJoins.push_back(-1);
+        found[1 << i] = true;
+    }
+
+    // Plans of the larger subsets (in increasing order, so the smaller subsets are done first)
+    for (int subset=1; subset<subsetCount; subset++) {
+        if (found[subset]) continue;
+        for (int crossProduct=0; crossProduct<2 && !found[subset]; crossProduct++) {
+            // The last relations are tried first to keep the FROM order on ties
+            for (int i=nRelations-1; i>=0; i--) {
+                int outerSubset = subset & ~(1 << i);
+                if (outerSubset == subset || !found[outerSubset]) continue;
+                QL_JoinPlan plan;
+                if (JoinRelation(plans[outerSubset], i, crossProduct, plan) &&
+                    (!found[subset] || plan.cost < plans[subset].cost)) {
+                    plans[subset] = plan;
+                    found[subset] = true;
+                }
+            }
+        }
+    }
+
+    joinPlan = plans[subsetCount-1];
+}
+
+// Method: OrderJoinsGreedy()
+// Find a left-deep join order greedily
+/* Steps:
+    1) Start with the relation with the fewest tuples after its conditions
+    2) Repeatedly join the relation giving the cheapest plan, avoiding cross products
+       when a condition joins a relation
+*/
+void QL_Optimizer::OrderJoinsGreedy() {
+    int first = 0;
+    for (int i=1; i<nRelations; i++) {
+        if (accessPaths[i].tupleCount < accessPaths[first].tupleCount) {
+            first = i;
+        }
+    }
+    joinPlan.cost = accessPaths[first].cost;
+    joinPlan.tupleCount = accessPaths[first].tupleCount;
+    joinPlan.tupleLength = rcRecords[first]->tupleLength;
+    joinPlan.order.assign(1, first);
+    joinPlan.indexJoins.assign(1, -1);
+
+    vector<bool> joined(nRelations, false);
+    joined[first] = true;
+    for (int k=1; k<nRelations; k++) {
+        QL_JoinPlan bestPlan;
+        int bestRelation = -1;
+        for (int crossProduct=0; crossProduct<2 && bestRelation == -1; crossProduct++) {
+            for (int i=0; i<nRelations; i++) {
+                if (joined[i]) continue;
+                QL_JoinPlan plan;
+                if (JoinRelation(joinPlan, i, crossProduct, plan) &&
+                    (bestRelation == -1 || plan.cost < bestPlan.cost)) {
+                    bestPlan = plan;
+                    bestRelation = i;
+                }
+            }
+        }
+        joinPlan = bestPlan;
+        joined[bestRelation] = true;
+    }
+}
+
+// Method: IsJoinCondition(int condition, int relation, const vector<bool> &joined)
+// Boolean whether the condition compares an attribute of the relation with one of a joined relation
+bool QL_Optimizer::IsJoinCondition(int condition, int relation, const vector<bool> &joined) const {
+    int lhsRelation = lhsRelations[condition];
+    int rhsRelation = rhsRelations[condition];
+    if (rhsRelation == -1 || lhsRelation == rhsRelation) {
+        return false;
+    }
+    return (lhsRelation == relation && joined[rhsRelation]) || (rhsRelation == relation && joined[lhsRelation]);
+}
+
+// Method: IsConditionCovered(int condition, const vector<bool> &joined)
+// Boolean whether all the relations of the condition are joined
+bool QL_Optimizer::IsConditionCovered(int condition, const vector<bool> &joined) const {
+    int lhsRelation = lhsRelations[condition];
+    int rhsRelation = rhsRelations[condition];
+    return joined[lhsRelation] && (rhsRelation == -1 || joined[rhsRelation]);
+}
+
+// Method: GetNeededAttrs(const vector<bool> &applied, vector<RelAttr> &neededAttrs)
+// The output attributes and the attributes of the conditions not yet applied
+void QL_Optimizer::GetNeededAttrs(const vector<bool> &applied, vector<RelAttr> &neededAttrs) const {
+    neededAttrs.assign(outputAttrs, outputAttrs + nOutputAttrs);
+    for (int i=0; i<nConditions; i++) {
+        if (!applied[i]) {
+            neededAttrs.push_back(conditions[i].lhsAttr);
+            if (conditions[i].bRhsIsAttr) {
+                neededAttrs.push_back(conditions[i].rhsAttr);
+            }
+        }
+    }
+}
+
+// Method: ProjectNeeded(shared_ptr<QL_Op> op, const vector<bool> &applied)
+// Project a scan or join of a multi-relation query on the attributes still needed above it
+shared_ptr<QL_Op> QL_Optimizer::ProjectNeeded(shared_ptr<QL_Op> op, const vector<bool> &applied) const {
+    if (nRelations < 2) {
+        return op;
+    }
+    vector<RelAttr> neededAttrs;
+    GetNeededAttrs(applied, neededAttrs);
+    return CreateProjectOp(smManager, op, neededAttrs.size(), neededAttrs.data());
+}
@@ -95,6 +95,10 @@ public:
     // from the buffer pool to disk.  Default value forces all pages.
     RC ForcePages (PageNum pageNum = ALL_PAGES);
 
+    // Return the number of data pages and the number of the last page
+    RC GetNumPages   (int &numberPages) const;
+    RC GetLastPageNum(PageNum &pageNum) const;
+
 private:
     PF_FileHandle pfFH;             // PF file handle
     int isOpen;                     // File handle open flag
@@ -125,10 +129,13 @@ public:
                   void       *value,
                   ClientHint pinHint = NO_HINT); // Initialize a file scan
     RC GetNextRec(RM_Record &rec);               // Get next matching record
+    RC SetPageRange(PageNum startPage,           // Restrict the scan to the
+                    PageNum endPage);            //   pages in [start, end)
     RC CloseScan ();                             // Close the scan
 
 private:
     PageNum pageNumber;                                 // Current page number
+    PageNum endPage;                                    // Page at which the scan stops (-1 if none)
     SlotNum slotNumber;                                 // Current slot number
     RM_FileHandle fileHandle;                           // File handle for the file
     AttrType attrType;                                  // Attribute type
@@ -163,6 +170,9 @@ public:
 
     RC CloseFile  (RM_FileHandle &fileHandle);
 
+    RC GetBufferSize(int &numPages) const;   // Pages in the buffer pool
+    RC ForceAllPages();                      // Write all dirty pages to disk
+
 private:
     PF_Manager* pfManager;                   // PF_Manager object
     int findNumberRecords(int recordSize);
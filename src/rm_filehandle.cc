@@ -564,6 +564,47 @@ RC RM_FileHandle::ForcePages(PageNum pageNum) {
 }
 
 
+// Method: GetNumPages(int &numberPages)
+// Return the number of data pages in the file
+RC RM_FileHandle::GetNumPages(int &numberPages) const {
+    // Check that the file is open
+    if (!isOpen) {
+        return RM_FILE_CLOSED;
+    }
+
+    numberPages = fileHeader.numberPages;
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: GetLastPageNum(PageNum &pageNum)
+// Return the number of the last page in the file (0 if it has no data pages)
+RC RM_FileHandle::GetLastPageNum(PageNum &pageNum) const {
+    // Check that the file is open
+    if (!isOpen) {
+        return RM_FILE_CLOSED;
+    }
+
+    // Get the last page using the PF FileHandle
+    int rc;
+    PF_PageHandle pfPH;
+    if ((rc = pfFH.GetLastPage(pfPH))) {
+        return rc;
+    }
+    if ((rc = pfPH.GetPageNum(pageNum))) {
+        return rc;
+    }
+    if ((rc = pfFH.UnpinPage(pageNum))) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
 // Method: getRecordOffset(int slotNumber)
 // Calculate the record offset given the slot number
 int RM_FileHandle::getRecordOffset(int slotNumber) const {
@@ -118,6 +118,7 @@ RC RM_FileScan::OpenScan(const RM_FileHandle &fileHandle, AttrType attrType, int
     // Set the page and slot numbers
     this->pageNumber = pageNumber;
     this->slotNumber = 1;
+    this->endPage = RM_NO_FREE_PAGE;
 
     // Unpin the header and data page
     if ((rc = pfFH.UnpinPage(headerPageNumber))) {
@@ -176,10 +177,13 @@ RC RM_FileScan::GetNextRec(RM_Record &rec) {
     char* pageData;
     char* bitmap;
 
-    // If the file is empty
+    // If the file is empty or the page range is exhausted
     if (pageNumber == RM_NO_FREE_PAGE) {
         return RM_EOF;
     }
+    if (endPage != RM_NO_FREE_PAGE && pageNumber >= endPage) {
+        return RM_EOF;
+    }
 
     // Get the page corresponding to the page number
     if ((rc = pfFH.GetThisPage(pageNumber, pfPH))) {
@@ -219,7 +223,8 @@ RC RM_FileScan::GetNextRec(RM_Record &rec) {
             }
             // If the attribute is string
             else if (attrType == STRING) {
-                string recordValue(recordData + attrOffset);
+                // A value of the full attribute length is not null terminated
+                string recordValue(recordData + attrOffset, strnlen(recordData + attrOffset, attrLength));
                 char* givenValueChar = static_cast<char*>(value);
                 string givenValue(givenValueChar);
                 recordMatch = matchRecord(recordValue, givenValue);
@@ -272,6 +277,16 @@ RC RM_FileScan::GetNextRec(RM_Record &rec) {
                 return rc;
             }
 
+            // Stop at the end of the page range
+            if (endPage != RM_NO_FREE_PAGE && pageNumber >= endPage) {
+                if ((rc = pfFH.UnpinPage(pageNumber))) {
+                    return rc;
+                }
+                pageNumber = RM_NO_FREE_PAGE;
+                if (recordMatch) return OK_RC;
+                else return RM_EOF;
+            }
+
             // Set slot number to 1
             slotNumber = 1;
 
@@ -300,6 +315,56 @@ RC RM_FileScan::GetNextRec(RM_Record &rec) {
     return OK_RC;
 }
 
+// Method: SetPageRange(PageNum startPage, PageNum endPage)
+// Restrict an open scan to the data pages numbered in [startPage, endPage)
+/* Steps:
+    1) Return error if the scan is not open
+    2) Find the first used page at or after startPage
+    3) Reset the slot number and store the end page
+*/
+RC RM_FileScan::SetPageRange(PageNum startPage, PageNum endPage) {
+    // Return error if the scan is not open
+    if (!scanOpen) {
+        return RM_SCAN_CLOSED;
+    }
+
+    // The header is page 0, so data pages start at 1
+    if (startPage < 1) {
+        startPage = 1;
+    }
+    if (endPage != RM_NO_FREE_PAGE && endPage <= startPage) {
+        pageNumber = RM_NO_FREE_PAGE;
+        return OK_RC;
+    }
+
+    // Get the first used page at or after the start page
+    int rc;
+    PF_FileHandle pfFH = fileHandle.pfFH;
+    PF_PageHandle pfPH;
+    rc = pfFH.GetNextPage(startPage-1, pfPH);
+    if (rc == PF_EOF || rc == PF_INVALIDPAGE) {
+        pageNumber = RM_NO_FREE_PAGE;
+        return OK_RC;
+    }
+    else if (rc) {
+        return rc;
+    }
+    if ((rc = pfPH.GetPageNum(pageNumber))) {
+        return rc;
+    }
+    if ((rc = pfFH.UnpinPage(pageNumber))) {
+        return rc;
+    }
+
+    // Set the slot number and the end of the range
+    slotNumber = 1;
+    this->endPage = endPage;
+
+    // Return OK
+    return OK_RC;
+}
+
+
 // Method: CloseScan()
 // Close the file scan
 /* Steps:
@@ -285,6 +285,11 @@ RC RM_Manager::CloseFile(RM_FileHandle &fileHandle) {
         char* pD = (char*) &fileHandle.fileHeader;
         memcpy(pData, pD, sizeof(RM_FileHeaderPage));
 
+        // Mark the header page dirty, or the flush skips it
+        if ((rc = pfFH.MarkDirty(pNum))) {
+            // Return the error from the PF FileHandle
+            return rc;
+        }
 
         // Flush the modified header page
         if ((rc = pfFH.ForcePages(pNum))) {
@@ -314,6 +319,20 @@ RC RM_Manager::CloseFile(RM_FileHandle &fileHandle) {
 }
 
 
+// Method: GetBufferSize(int &numPages)
+// Get the number of pages in the buffer pool of the PF Manager
+RC RM_Manager::GetBufferSize(int &numPages) const {
+    return pfManager->GetBufferSize(numPages);
+}
+
+
+// Method: ForceAllPages()
+// Write the dirty pages of all the files in the buffer pool to disk
+RC RM_Manager::ForceAllPages() {
+    return pfManager->ForceAllPages();
+}
+
+
 // Method: findNumberRecords(int recordSize)
 // Find the number of records that can fit in a page
 int RM_Manager::findNumberRecords(int recordSize) {
@@ -8,6 +8,10 @@
  *
  * 1997 Changes: "print", "buffer", "reset" and "io" added.
  * 1998 Changes: "resize", "queryplans", "on" and "off" added.
+ * "order", "by", "asc", "desc" and "limit" added for ORDER BY and LIMIT.
+ * "group" added for GROUP BY.
+ * "analyze" and "sample" added for ANALYZE.
+ * "explain" added for EXPLAIN ANALYZE.
  *
  *
  * This file is not compiled separately; it is #included into lex.yy.c .
@@ -92,6 +96,10 @@ static int get_id(char *s)
       return yylval.ival = RW_TABLE;
    if(!strcmp(string, "index"))
       return yylval.ival = RW_INDEX;
+   if(!strcmp(string, "using"))
+      return yylval.ival = RW_USING;
+   if(!strcmp(string, "hash"))
+      return yylval.ival = RW_HASH;
    if(!strcmp(string, "load"))
       return yylval.ival = RW_LOAD;
    if(!strcmp(string, "help"))
@@ -125,11 +133,32 @@ static int get_id(char *s)
       return yylval.ival = RW_DELETE;
    if(!strcmp(string, "update"))
       return yylval.ival = RW_UPDATE;
+   if(!strcmp(string, "order"))
+      return yylval.ival = RW_ORDER;
+   if(!strcmp(string, "by"))
+      return yylval.ival = RW_BY;
+   if(!strcmp(string, "asc"))
+      return yylval.ival = RW_ASC;
+   if(!strcmp(string, "desc"))
+      return yylval.ival = RW_DESC;
+   if(!strcmp(string, "limit"))
+      return yylval.ival = RW_LIMIT;
+   if(!strcmp(string, "group"))
+      return yylval.ival = RW_GROUP;
+   if(!strcmp(string, "analyze"))
+      return yylval.ival = RW_ANALYZE;
+   if(!strcmp(string, "sample"))
+      return yylval.ival = RW_SAMPLE;
+   if(!strcmp(string, "explain"))
+      return yylval.ival = RW_EXPLAIN;
 
    /* EX lexemes */
    if (!strcmp(string, "distribute")) {
       return yylval.ival = RW_DISTRIBUTED;
    }
+   if (!strcmp(string, "replicated")) {
+      return yylval.ival = RW_REPLICATED;
+   }
 
    /* IO Statistics lexemes */
    if(!strcmp(string, "reset"))
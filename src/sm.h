@@ -16,6 +16,13 @@
 #include "ix.h"
 #include "ex.h"
 
+// Default number of pages a sort keeps in memory
+#define SM_DEFAULT_SORT_MEMORY  64
+
+// Default and maximum number of worker threads scanning a relation in parallel
+#define SM_DEFAULT_PARALLELISM  1
+#define SM_MAX_PARALLELISM      64
+
 // Data structures
 
 // SM_RelcatRecord - Records stored in the relcat relation
@@ -24,8 +31,9 @@
     2) tupleLength - length of the tuples - integer
     3) attrCount - number of attributes - integer
     4) indexCount - number of indexes - integer
-    EX - 5) distributed - whether the relation is distributed - integer
-         6) attrName - attribute used for range partitioning - char*
+    EX - 5) distributed - partitioning scheme of the relation (0 if not distributed) - integer
+         6) attrName - attribute used for range or hash partitioning - char*
+    7) tupleCount - number of tuples in the relation (statistics) - integer
 */
 struct SM_RelcatRecord {
     char relName[MAXNAME+1];
@@ -36,6 +44,9 @@ struct SM_RelcatRecord {
     // EX - for distributed databases
     int distributed;
     char attrName[MAXNAME+1];
+
+    // Statistics for the optimizer
+    int tupleCount;
 };
 
 // SM_AttrcatRecord - Records stored in the attrcat relation
@@ -46,6 +57,8 @@ struct SM_RelcatRecord {
     4) attrType - type of the attribute - AttrType
     5) attrLength - length of the attribute - integer
     6) indexNo - number of the index - integer
+    7) indexType - type of the index (IX_IndexType) - integer
+    8) distinctCount - number of distinct values (statistics) - integer
 */
 struct SM_AttrcatRecord {
     char relName[MAXNAME+1];
@@ -54,13 +67,61 @@ struct SM_AttrcatRecord {
     AttrType attrType;
     int attrLength;
     int indexNo;
+    int indexType;
+
+    // Statistics for the optimizer
+    int distinctCount;
+};
+
+// Number of equi-depth histogram buckets and HyperLogLog registers per attribute
+#define SM_HISTOGRAM_BUCKETS    16
+#define SM_HLL_REGISTERS        256
+
+// Number of leading characters of a string kept in its histogram key
+#define SM_HISTOGRAM_PREFIX     3
+
+// SM_StatcatRecord - Records stored in the statcat relation (one per attribute)
+/* Stores the following:
+    1) relName - name of the relation - char*
+    2) attrName - name of the attribute - char*
+    3) tupleCount - number of tuples in the relation - integer
+    4) pageCount - number of data pages of the relation - integer
+    5) distinctCount - estimated number of distinct values - integer
+    6) minValue - smallest histogram key of the attribute - float
+    7) maxValue - largest histogram key of the attribute - float
+    8) minPrefix - first characters of the smallest string (empty for numbers) - char*
+    9) maxPrefix - first characters of the largest string (empty for numbers) - char*
+   10) bounds - inner bounds of the equi-depth histogram - float array
+   11) registers - HyperLogLog registers of the attribute - unsigned char array
+   Only 1-9 are described in attrcat; 10 and 11 are read through GetStatInfo.
+*/
+struct SM_StatcatRecord {
+    char relName[MAXNAME+1];
+    char attrName[MAXNAME+1];
+    int tupleCount;
+    int pageCount;
+    int distinctCount;
+    float minValue;
+    float maxValue;
+    char minPrefix[SM_HISTOGRAM_PREFIX+1];
+    char maxPrefix[SM_HISTOGRAM_PREFIX+1];
+    float bounds[SM_HISTOGRAM_BUCKETS-1];
+    unsigned char registers[SM_HLL_REGISTERS];
 };
 
 // Constants
-#define SM_RELCAT_ATTR_COUNT    6
-#define SM_ATTRCAT_ATTR_COUNT   6
+#define SM_RELCAT_ATTR_COUNT    7
+#define SM_ATTRCAT_ATTR_COUNT   8
+#define SM_STATCAT_ATTR_COUNT   9
+
+// EX - Partitioning schemes of the relations (stored in the distributed field of relcat)
+#define EX_NOT_DISTRIBUTED      0   // Stored only in the master node
+#define EX_RANGE_PARTITIONED    1   // Ranges of the partition vector given by the user
+#define EX_HASH_PARTITIONED     2   // Hash of the partition attribute
+#define EX_REPLICATED           3   // Copy of the whole relation in every data node
 
 class EX_CommLayer;
+struct EX_RoutingTable;
 
 //
 // SM_Manager: provides data management
@@ -78,12 +139,13 @@ public:
                    int        attrCount,          //   number of attributes
                    AttrInfo   *attributes,        //   attribute data
                    // EX
-                   int isDistributed,             // distributed flag
+                   int isDistributed,             // partitioning scheme (0 if not distributed)
                    const char* partitionAttrName, // attribute name for partition
                    int nValues,                   // number of values in the partition vector
                    const Value values[]);         // partition vector
     RC CreateIndex(const char *relName,           // create an index for
-                   const char *attrName);         //   relName.attrName
+                   const char *attrName,          //   relName.attrName
+                   IX_IndexType indexType = IX_BTREE); // B+ tree or hash index
     RC DropTable  (const char *relName);          // destroy a relation
 
     RC DropIndex  (const char *relName,           // destroy index on
@@ -103,12 +165,29 @@ public:
     RC GetAttrInfo(const char* relName, const char* attrName, SM_AttrcatRecord* attributeData);
     RC GetRelInfo(const char* relName, SM_RelcatRecord* relationData);
 
+    // Method to maintain the statistics in the system catalogs
+    RC UpdateTupleCount(const char* relName, int tupleDelta);
+
+    // Methods to collect and read the statistics in statcat
+    RC Analyze    (const char *relName,           // collect the statistics of
+                   int samplePercent = 100);      //   relName from a page sample
+    RC GetStatInfo(const char* relName, int attrCount, SM_StatcatRecord* statistics, int &found);
+
+    // EX - Method to get the partition vector of a distributed relation from the routing tables
+    RC GetRoutingTable(const char* relName, const char* attrName, AttrType attrType,
+                       const EX_RoutingTable* &routingTable);
+
+    // EX - Method to get the communication layer to the data nodes (kept while the database is open)
+    EX_CommLayer* GetCommLayer();
+
     int getPrintFlag();             // Method to get the printCommands flag
     int getOpenFlag();              // Method to get the isOpen flag
     int getDistributedFlag();       // Method to get the distributed flag
     int getNumberNodes();           // Method to get the number of nodes
     int getOptimizeFlag();          // Method to get the optimizeQuery flag
     int getPartitionedPrintFlag();  // Method to get the partitionedPrint flag
+    int getSortMemory();            // Method to get the sortMemory parameter
+    int getParallelism();           // Method to get the parallelism parameter
 
 private:
     RM_Manager* rmManager;          // RM_Manager object
@@ -116,6 +195,7 @@ private:
 
     RM_FileHandle relcatFH;         // RM file handle for relcat
     RM_FileHandle attrcatFH;        // RM file handle for attrcat
+    RM_FileHandle statcatFH;        // RM file handle for statcat
     int isOpen;                     // Flag whether the database is open
     int distributed;                // Flag whether the database is distributed
     int numberNodes;                // Number of nodes in the database
@@ -123,8 +203,52 @@ private:
     int printCommands;              // System parameter specifying printing level
     int optimizeQuery;              // System parameter specifying optimization
     int partitionedPrint;           // System parameter specifying printing style
+    int sortMemory;                 // System parameter specifying the pages a sort keeps in memory
+    int parallelism;                // System parameter specifying the worker threads of a scan
+
+    // EX - Partition vectors of the distributed relations routed to so far (loaded once per
+    // relation, and dropped when the relation is created or dropped or the database changes)
+    std::vector<EX_RoutingTable*> routingTables;
+    void ClearRoutingTables(const char* relName = NULL);
+
+    EX_CommLayer* commLayer;        // EX - Communication layer with the open data node sessions
+
+    // Update the distinct value counts of the attributes of a relation
+    RC UpdateDistinctCounts(const char* relName, int attrCount, const int distinctCounts[]);
+
+    // Compute, replace and delete the statcat records of a relation
+    RC ComputeStatistics(const char* relName, int attrCount, DataAttrInfo* attributes,
+                         int samplePercent, SM_StatcatRecord* statistics);
+    RC WriteStatistics(const char* relName, int attrCount, const SM_StatcatRecord* statistics);
+    RC DeleteStatistics(const char* relName);
+};
+
+//
+// SM_StatisticsBuilder: accumulates the statcat record of one attribute
+//
+class SM_StatisticsBuilder {
+public:
+    SM_StatisticsBuilder(AttrType attrType, int attrLength);
+    ~SM_StatisticsBuilder();
+
+    void AddValue(const char* value);             // Add a value in its stored form
+    int GetValueCount();                          // Number of values added
+    void Build(SM_StatcatRecord &statistics);     // Fill the distinct count, bounds and registers
+
+private:
+    AttrType attrType;                            // Type of the attribute
+    int attrLength;                               // Length of the attribute
+    std::vector<float> keys;                      // Histogram keys of the values
+    unsigned char registers[SM_HLL_REGISTERS];    // HyperLogLog registers
 };
 
+// Statistics helpers
+float SM_HistogramKey(AttrType attrType, int attrLength, const char* value);
+void SM_HistogramPrefix(float key, char* prefix);
+float SM_HistogramFraction(const SM_StatcatRecord &statistics, float key);
+int SM_EstimateDistinct(const unsigned char registers[]);
+void SM_MergeStatistics(SM_StatcatRecord &target, const SM_StatcatRecord &source);
+
 //
 // Print-error function
 //
@@ -11,6 +11,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <cmath>
 #include "redbase.h"
 #include "sm.h"
 #include "ix.h"
@@ -33,11 +34,20 @@ SM_Manager::SM_Manager(IX_Manager &ixm, RM_Manager &rmm) {
     printCommands = FALSE;
     optimizeQuery = TRUE;
     partitionedPrint = FALSE;
+    sortMemory = SM_DEFAULT_SORT_MEMORY;
+    parallelism = SM_DEFAULT_PARALLELISM;
+
+    // EX - The communication layer is created when first used
+    commLayer = NULL;
 }
 
 // Destructor
 SM_Manager::~SM_Manager() {
-    // Nothing to free
+    // EX - Close the sessions of the data nodes
+    delete commLayer;
+
+    // Free the routing tables
+    ClearRoutingTables();
 }
 
 
@@ -104,6 +114,9 @@ RC SM_Manager::OpenDb(const char *dbName) {
     if ((rc = rmManager->OpenFile("attrcat", attrcatFH))) {
         return rc;
     }
+    if ((rc = rmManager->OpenFile("statcat", statcatFH))) {
+        return rc;
+    }
 
     // Update flag
     isOpen = TRUE;
@@ -117,8 +130,9 @@ RC SM_Manager::OpenDb(const char *dbName) {
 // Close the database
 /* Steps:
     1) Check that the database is not closed
-    2) Close the system catalogs
-    3) Update flag
+    2) EX - Close the sessions of the data nodes
+    3) Close the system catalogs
+    4) Update flag
 */
 RC SM_Manager::CloseDb() {
     // Check if closed
@@ -126,20 +140,36 @@ RC SM_Manager::CloseDb() {
         return SM_DATABASE_CLOSED;
     }
 
-    // Close the system catalogs
+    // EX - Close the sessions of the data nodes
     int rc;
+    if (commLayer != NULL) {
+        rc = commLayer->CloseSessions();
+        delete commLayer;
+        commLayer = NULL;
+        if (rc) {
+            return rc;
+        }
+    }
+
+    // Close the system catalogs
     if ((rc = rmManager->CloseFile(relcatFH))) {
         return rc;
     }
     if ((rc = rmManager->CloseFile(attrcatFH))) {
         return rc;
     }
+    if ((rc = rmManager->CloseFile(statcatFH))) {
+        return rc;
+    }
 
     // Change to the up directory
     if (chdir("../") == -1) {
         return SM_INVALID_DATABASE_CLOSE;
     }
 
+    // Drop the routing tables of the database
+    ClearRoutingTables();
+
     // Update flag
     isOpen = FALSE;
 
@@ -181,14 +211,25 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
     // EX - Check the distributed case parameters
     int distributedRelation = isDistributed;
     AttrType partitionAttrType = (AttrType) 0;
-    if (distributedRelation) {
+    if (distributedRelation == EX_REPLICATED) {
+        // A replicated relation has no partition attribute nor partition vector
+        if (nValues != 0) {
+            return EX_INCORRECT_VALUE_COUNT;
+        }
+    }
+    else if (distributedRelation) {
         // Check that the attribute is not null
         if (partitionAttrName == NULL) {
             return EX_INVALID_ATTRIBUTE;
         }
 
-        // Check the number of values
-        if (nValues != numberNodes-1) {
+        // Check the number of values (a hash partitioned relation has no partition vector)
+        if (distributedRelation == EX_HASH_PARTITIONED) {
+            if (nValues != 0) {
+                return EX_INCORRECT_VALUE_COUNT;
+            }
+        }
+        else if (distributedRelation != EX_RANGE_PARTITIONED || nValues != numberNodes-1) {
             return EX_INCORRECT_VALUE_COUNT;
         }
 
@@ -264,7 +305,7 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
     rcRecord->attrCount = attrCount;
     rcRecord->indexCount = 0;
     rcRecord->distributed = distributedRelation;
-    if (distributedRelation) {
+    if (distributedRelation && distributedRelation != EX_REPLICATED) {
         strcpy(rcRecord->attrName, partitionAttrName);
     }
     else {
@@ -285,6 +326,7 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
         acRecord->attrType = attributes[i].attrType;
         acRecord->attrLength = attributes[i].attrLength;
         acRecord->indexNo = -1;
+        acRecord->indexType = -1;
         if ((rc = attrcatFH.InsertRec((char*) acRecord, rid))) {
             return rc;
         }
@@ -305,10 +347,45 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
         char partitionVectorFileName[255];
         strcpy(partitionVectorFileName, relName);
         strcat(partitionVectorFileName, "_partitions_");
-        strcat(partitionVectorFileName, partitionAttrName);
+        if (distributedRelation != EX_REPLICATED) {
+            strcat(partitionVectorFileName, partitionAttrName);
+        }
 
         RM_FileHandle partitionVectorFH;
-        if (partitionAttrType == INT) {
+        if (distributedRelation == EX_REPLICATED) {
+            // A replicated relation is created whole in every data node
+        }
+        else if (distributedRelation == EX_HASH_PARTITIONED) {
+            // Create and open the RM file
+            if ((rc = rmManager->CreateFile(partitionVectorFileName, sizeof(EX_IntPartitionVectorRecord)))) {
+                return rc;
+            }
+            if ((rc = rmManager->OpenFile(partitionVectorFileName, partitionVectorFH))) {
+                return rc;
+            }
+
+            // Store an equal range of hash buckets for each node
+            EX_IntPartitionVectorRecord* pV = new EX_IntPartitionVectorRecord;
+            for (int i=1; i<=numberNodes; i++) {
+                // Set the values
+                pV->node = i;
+                pV->startValue = (i-1) * EX_HASH_BUCKETS / numberNodes;
+                pV->endValue = i * EX_HASH_BUCKETS / numberNodes;
+
+                // Insert the record
+                if ((rc = partitionVectorFH.InsertRec((char*) pV, rid))) {
+                    return rc;
+                }
+            }
+
+            // Close the file
+            if ((rc = rmManager->CloseFile(partitionVectorFH))) {
+                return rc;
+            }
+            delete pV;
+        }
+
+        else if (partitionAttrType == INT) {
             // Create and open the RM file
             if ((rc = rmManager->CreateFile(partitionVectorFileName, sizeof(EX_IntPartitionVectorRecord)))) {
                 return rc;
@@ -423,12 +500,15 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
         }
 
         // Create table in all the data nodes
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *GetCommLayer();
         for (int i=1; i<=numberNodes; i++) {
             if ((rc = commLayer.CreateTableInDataNode(relName, attrCount, attributes, i))) {
                 return rc;
             }
         }
+
+        // Route with the new partition vector
+        ClearRoutingTables(relName);
     }
 
     // Flush the system catalogs
@@ -454,6 +534,7 @@ RC SM_Manager::CreateTable(const char *relName, int attrCount, AttrInfo *attribu
         - Destroy the indexes and delete the entries
     5) Destroy the RM file for the relation
     6) Flush the system catalogs
+    7) Delete the statistics of the relation
 */
 RC SM_Manager::DropTable(const char *relName) {
     // Check that database is open
@@ -466,7 +547,7 @@ RC SM_Manager::DropTable(const char *relName) {
         return SM_NULL_RELATION;
     }
 
-    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0) {
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
         return SM_SYSTEM_CATALOG;
     }
 
@@ -558,6 +639,11 @@ RC SM_Manager::DropTable(const char *relName) {
         return rc;
     }
 
+    // Delete the statistics
+    if ((rc = DeleteStatistics(relName))) {
+        return rc;
+    }
+
     // Non distributed case
     if (!distributedRelation) {
         // Destroy the RM file for the relation
@@ -568,17 +654,20 @@ RC SM_Manager::DropTable(const char *relName) {
 
     // EX - Distributed case
     else {
-        // Delete the partition vector file
-        char partitionVectorFileName[255];
-        strcpy(partitionVectorFileName, relName);
-        strcat(partitionVectorFileName, "_partitions_");
-        strcat(partitionVectorFileName, partitionAttrName);
-        if ((rc = rmManager->DestroyFile(partitionVectorFileName))) {
-            return rc;
+        // Delete the partition vector file (none for a replicated relation)
+        if (distributedRelation != EX_REPLICATED) {
+            char partitionVectorFileName[255];
+            strcpy(partitionVectorFileName, relName);
+            strcat(partitionVectorFileName, "_partitions_");
+            strcat(partitionVectorFileName, partitionAttrName);
+            if ((rc = rmManager->DestroyFile(partitionVectorFileName))) {
+                return rc;
+            }
+            ClearRoutingTables(relName);
         }
 
         // Drop the table from the data nodes
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *GetCommLayer();
         for (int i=1; i<=numberNodes; i++) {
             if ((rc = commLayer.DropTableInDataNode(relName, i))) {
                 return rc;
@@ -591,8 +680,8 @@ RC SM_Manager::DropTable(const char *relName) {
 }
 
 
-// Method: CreateIndex(const char *relName, const char *attrName)
-// Create an index for relName.attrName
+// Method: CreateIndex(const char *relName, const char *attrName, IX_IndexType indexType)
+// Create a B+ tree or hash index for relName.attrName
 /* Steps:
     1) Check the parameters
     2) Check that the database is open
@@ -602,7 +691,8 @@ RC SM_Manager::DropTable(const char *relName) {
     6) Scan all the tuples and insert in the index
     7) Close the index file
 */
-RC SM_Manager::CreateIndex(const char *relName, const char *attrName) {
+RC SM_Manager::CreateIndex(const char *relName, const char *attrName,
+                           IX_IndexType indexType) {
     // Check the parameters
     if (relName == NULL) {
         return SM_NULL_RELATION;
@@ -615,7 +705,8 @@ RC SM_Manager::CreateIndex(const char *relName, const char *attrName) {
     if (printCommands) {
         cout << "CreateIndex\n"
              << "   relName =" << relName << "\n"
-             << "   attrName=" << attrName << "\n";
+             << "   attrName=" << attrName << "\n"
+             << "   indexType=" << (indexType == IX_HASH ? "hash" : "btree") << "\n";
     }
 
     // Check whether the index exists
@@ -645,9 +736,9 @@ RC SM_Manager::CreateIndex(const char *relName, const char *attrName) {
 
     // EX - Distributed relation case
     if (distributed) {
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *GetCommLayer();
         for (int i=1; i<=numberNodes; i++) {
-            if ((rc = commLayer.CreateIndexInDataNode(relName, attrName, i))) {
+            if ((rc = commLayer.CreateIndexInDataNode(relName, attrName, indexType, i))) {
                 return rc;
             }
         }
@@ -703,6 +794,7 @@ RC SM_Manager::CreateIndex(const char *relName, const char *attrName) {
                 // Check for the required attribute
                 if (strcmp(acRecord->attrName, attrName) == 0) {
                     acRecord->indexNo = position;
+                    acRecord->indexType = indexType;
                     if ((rc = attrcatFH.UpdateRec(rec))) {
                         return rc;
                     }
@@ -724,7 +816,7 @@ RC SM_Manager::CreateIndex(const char *relName, const char *attrName) {
         }
 
         // Create and open the index file
-        if ((rc = ixManager->CreateIndex(relName, position, attrType, attrLength))) {
+        if ((rc = ixManager->CreateIndex(relName, position, attrType, attrLength, indexType))) {
             return rc;
         }
         IX_IndexHandle ixIH;
@@ -849,7 +941,7 @@ RC SM_Manager::DropIndex(const char *relName, const char *attrName) {
 
     // EX - Distributed relation case
     if (distributed) {
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *GetCommLayer();
         for (int i=1; i<=numberNodes; i++) {
             if ((rc = commLayer.DropIndexInDataNode(relName, attrName, i))) {
                 return rc;
@@ -908,6 +1000,7 @@ RC SM_Manager::DropIndex(const char *relName, const char *attrName) {
                 if (strcmp(acRecord->attrName, attrName) == 0) {
                     position = acRecord->indexNo;
                     acRecord->indexNo = -1;
+                    acRecord->indexType = -1;
                     if ((rc = attrcatFH.UpdateRec(rec))) {
                         return rc;
                     }
@@ -938,6 +1031,26 @@ RC SM_Manager::DropIndex(const char *relName, const char *attrName) {
 }
 
 
+// Method: AddLoadedValue(SM_StatisticsBuilder& builder, const DataAttrInfo& attribute, const string& dataValue)
+// Add the stored form of a loaded value to the statistics of its attribute
+static void AddLoadedValue(SM_StatisticsBuilder& builder, const DataAttrInfo& attribute, const string& dataValue) {
+    if (attribute.attrType == INT) {
+        int value = atoi(dataValue.c_str());
+        builder.AddValue((char*) &value);
+    }
+    else if (attribute.attrType == FLOAT) {
+        float value = atof(dataValue.c_str());
+        builder.AddValue((char*) &value);
+    }
+    else {
+        char value[attribute.attrLength];
+        memset(value, 0, attribute.attrLength);
+        strncpy(value, dataValue.c_str(), attribute.attrLength);
+        builder.AddValue(value);
+    }
+}
+
+
 // Method: Load(const char *relName, const char *fileName)
 // Load relName from fileName
 /* Steps:
@@ -950,6 +1063,9 @@ RC SM_Manager::DropIndex(const char *relName, const char *attrName) {
         - Insert the tuple in the relation
         - Insert the entries in the indexes
     6) Close the files
+    7) Update the statistics in the system catalogs
+        - Merge the statistics of the loaded tuples into statcat, if the relation
+          was analyzed or empty before the load
 */
 RC SM_Manager::Load(const char *relName, const char *fileName) {
     // Check the parameters
@@ -960,7 +1076,7 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
         return SM_NULL_FILENAME;
     }
 
-    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0) {
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
         return SM_SYSTEM_CATALOG;
     }
 
@@ -1007,8 +1123,45 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
         return SM_INVALID_DATA_FILE;
     }
 
+    // Statistics of the loaded tuples
+    int loadedCount = 0;
+    int pageCount = -1;
+    vector<SM_StatisticsBuilder> builders;
+    for (int i=0; i<attrCount; i++) {
+        builders.push_back(SM_StatisticsBuilder(attributes[i].attrType, attributes[i].attrLength));
+    }
+
+    // EX - Replicated relation case
+    if (distributedRelation == EX_REPLICATED) {
+        // Read each line of the file
+        vector<string> tuples;
+        string line;
+        while (getline(dataFile, line)) {
+            // Collect the statistics
+            stringstream ss(line);
+            vector<string> dataValues;
+            string dataValue = "";
+            while (getline(ss, dataValue, ',')) {
+                dataValues.push_back(dataValue);
+            }
+            loadedCount++;
+            for (int i=0; i<attrCount && i<(int)dataValues.size(); i++) {
+                AddLoadedValue(builders[i], attributes[i], dataValues[i]);
+            }
+            tuples.push_back(line);
+        }
+
+        // Load all the tuples in every data node
+        EX_CommLayer &commLayer = *GetCommLayer();
+        for (int i=1; i<=numberNodes; i++) {
+            if ((rc = commLayer.LoadInDataNode(relName, tuples, i))) {
+                return rc;
+            }
+        }
+    }
+
     // EX - Distributed relation case
-    if (distributedRelation) {
+    else if (distributedRelation) {
         // Create vectors for each data node
         vector<string> nodeTuples[numberNodes+1];
 
@@ -1040,6 +1193,12 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
                 dataValues.push_back(dataValue);
             }
 
+            // Collect the statistics
+            loadedCount++;
+            for (int i=0; i<attrCount && i<(int)dataValues.size(); i++) {
+                AddLoadedValue(builders[i], attributes[i], dataValues[i]);
+            }
+
             // Form the key
             Value key;
             key.type = partitionAttrType;
@@ -1050,7 +1209,7 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
                 key.data = keyValue;
 
                 // Copy the line to the appropriate vector
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, partitionAttrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(this, key, relName, partitionAttrName, dataNode))) {
                     return rc;
                 }
                 if (dataNode <= 0 || dataNode > numberNodes) {
@@ -1066,7 +1225,7 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
                 key.data = keyValue;
 
                 // Copy the line to the appropriate vector
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, partitionAttrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(this, key, relName, partitionAttrName, dataNode))) {
                     return rc;
                 }
                 if (dataNode <= 0 || dataNode > numberNodes) {
@@ -1081,7 +1240,7 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
                 key.data = keyValue;
 
                 // Copy the line to the appropriate vector
-                if ((rc = GetDataNodeForTuple(rmManager, key, relName, partitionAttrName, dataNode))) {
+                if ((rc = GetDataNodeForTuple(this, key, relName, partitionAttrName, dataNode))) {
                     return rc;
                 }
                 if (dataNode <= 0 || dataNode > numberNodes) {
@@ -1093,7 +1252,7 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
         }
 
         // Load the tuples in the data nodes
-        EX_CommLayer commLayer(rmManager, ixManager);
+        EX_CommLayer &commLayer = *GetCommLayer();
         for (int i=1; i<=numberNodes; i++) {
             if ((rc = commLayer.LoadInDataNode(relName, nodeTuples[i], i))) {
                 return rc;
@@ -1139,6 +1298,12 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
                 dataValues.push_back(dataValue);
             }
 
+            // Collect the statistics
+            loadedCount++;
+            for (int i=0; i<attrCount && i<(int)dataValues.size(); i++) {
+                AddLoadedValue(builders[i], attributes[i], dataValues[i]);
+            }
+
             // Insert the tuple in the relation
             for (int i=0; i<attrCount; i++) {
                 if (attributes[i].attrType == INT) {
@@ -1188,6 +1353,9 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
         }
 
         // Close the RM file
+        if ((rc = rmFH.GetNumPages(pageCount))) {
+            return rc;
+        }
         if ((rc = rmManager->CloseFile(rmFH))) {
             return rc;
         }
@@ -1206,6 +1374,61 @@ RC SM_Manager::Load(const char *relName, const char *fileName) {
     // Close the data file
     dataFile.close();
 
+    // Update the statistics
+    if ((rc = UpdateTupleCount(relName, loadedCount))) {
+        return rc;
+    }
+    SM_StatcatRecord* loadedStatistics = new SM_StatcatRecord[attrCount];
+    memset(loadedStatistics, 0, attrCount*sizeof(SM_StatcatRecord));
+    int* distinctCounts = new int[attrCount];
+    for (int i=0; i<attrCount; i++) {
+        strcpy(loadedStatistics[i].relName, relName);
+        strcpy(loadedStatistics[i].attrName, attributes[i].attrName);
+        builders[i].Build(loadedStatistics[i]);
+        loadedStatistics[i].tupleCount = builders[i].GetValueCount();
+        distinctCounts[i] = loadedStatistics[i].distinctCount;
+    }
+    if ((rc = UpdateDistinctCounts(relName, attrCount, distinctCounts))) {
+        delete[] distinctCounts;
+        delete[] loadedStatistics;
+        return rc;
+    }
+    delete[] distinctCounts;
+
+    // Merge the loaded tuples into statcat
+    SM_StatcatRecord* statistics = new SM_StatcatRecord[attrCount];
+    memset(statistics, 0, attrCount*sizeof(SM_StatcatRecord));
+    int analyzed;
+    if ((rc = GetStatInfo(relName, attrCount, statistics, analyzed))) {
+        delete[] loadedStatistics;
+        delete[] statistics;
+        return rc;
+    }
+    if (attrCount > 0 && (analyzed || rcRecord->tupleCount == 0)) {
+        // EX - The pages of the data nodes are estimated from the tuple length
+        int loadedPages = (int) ceil((double) loadedCount * tupleLength / PF_PAGE_SIZE);
+        for (int i=0; i<attrCount; i++) {
+            if (!analyzed) {
+                strcpy(statistics[i].relName, relName);
+                strcpy(statistics[i].attrName, attributes[i].attrName);
+            }
+            SM_MergeStatistics(statistics[i], loadedStatistics[i]);
+            if (pageCount >= 0) {
+                statistics[i].pageCount = pageCount;
+            }
+            else {
+                statistics[i].pageCount += loadedPages;
+            }
+        }
+        if ((rc = WriteStatistics(relName, attrCount, statistics))) {
+            delete[] loadedStatistics;
+            delete[] statistics;
+            return rc;
+        }
+    }
+    delete[] loadedStatistics;
+    delete[] statistics;
+
     // Clean up
     delete rcRecord;
     delete[] attributes;
@@ -1386,6 +1609,7 @@ RC SM_Manager::Help(const char *relName) {
     4) Open the RM file
     5) Start a RM file scan and print each tuple
         - If distributed, get data from all nodes and then print UNION
+          (from one node if replicated)
     6) Print the footer
     7) Close the scan and file and clean up
 */
@@ -1432,15 +1656,17 @@ RC SM_Manager::Print(const char *relName) {
     p.PrintHeader(cout);
 
     // EX - Distributed case
+    // (a replicated relation is printed from its copy in the first data node)
     if (distributedRelation) {
-        EX_CommLayer commLayer(rmManager, ixManager);
-        for (int i=1; i<=numberNodes; i++) {
+        EX_CommLayer &commLayer = *GetCommLayer();
+        int printedNodes = distributedRelation == EX_REPLICATED ? 1 : numberNodes;
+        for (int i=1; i<=printedNodes; i++) {
             if ((rc = commLayer.PrintInDataNode(p, relName, i))) {
                 return rc;
             }
 
             // Show partitioned print
-            if (i != numberNodes && partitionedPrint) {
+            if (i != printedNodes && partitionedPrint) {
                 cout << "......." << endl;
             }
         }
@@ -1549,6 +1775,20 @@ RC SM_Manager::Set(const char *paramName, const char *value) {
         else {
             return SM_INVALID_VALUE;
         }
+    }
+    else if (strcmp(paramName, "sortMemory") == 0) {
+        int pages = atoi(value);
+        if (pages < 1) {
+            return SM_INVALID_VALUE;
+        }
+        sortMemory = pages;
+    }
+    else if (strcmp(paramName, "parallelism") == 0) {
+        int workers = atoi(value);
+        if (workers < 1 || workers > SM_MAX_PARALLELISM) {
+            return SM_INVALID_VALUE;
+        }
+        parallelism = workers;
     }
      else {
         return SM_INVALID_SYSTEM_PARAMETER;
@@ -1620,6 +1860,7 @@ RC SM_Manager::GetAttrInfo(const char* relName, int attrCount, char* attributeDa
             attributes[i].attrType = acRecord->attrType;
             attributes[i].attrLength = acRecord->attrLength;
             attributes[i].indexNo = acRecord->indexNo;
+            attributes[i].indexType = acRecord->indexType;
             i++;
         }
     }
@@ -1684,6 +1925,8 @@ RC SM_Manager::GetAttrInfo(const char* relName, const char* attrName, SM_Attrcat
                 attributeData->attrType = acRecord->attrType;
                 attributeData->attrLength = acRecord->attrLength;
                 attributeData->indexNo = acRecord->indexNo;
+                attributeData->indexType = acRecord->indexType;
+                attributeData->distinctCount = acRecord->distinctCount;
                 break;
             }
         }
@@ -1746,16 +1989,208 @@ RC SM_Manager::GetRelInfo(const char* relName, SM_RelcatRecord* relationData) {
     relationData->indexCount = rcRecord->indexCount;
     relationData->distributed = rcRecord->distributed;
     strcpy(relationData->attrName, rcRecord->attrName);
+    relationData->tupleCount = rcRecord->tupleCount;
+
+    // Close the scan
+    if ((rc = relcatFS.CloseScan())) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: UpdateTupleCount(const char* relName, int tupleDelta)
+// Update the tuple count of a relation in relcat
+/* Steps:
+    1) Start file scan of relcat for relName
+    2) Update the tuple count and the record
+*/
+RC SM_Manager::UpdateTupleCount(const char* relName, int tupleDelta) {
+    // Check the parameters
+    if (relName == NULL) {
+        return SM_NULL_RELATION;
+    }
+
+    int rc;
+    RM_FileScan relcatFS;
+    RM_Record rec;
+    char* recordData;
+    SM_RelcatRecord* rcRecord;
+
+    // Start file scan
+    char relationName[MAXNAME+1];
+    strcpy(relationName, relName);
+    if ((rc = relcatFS.OpenScan(relcatFH, STRING, MAXNAME, 0, EQ_OP, relationName))) {
+        return rc;
+    }
+
+    // Get the relation tuple
+    if ((rc = relcatFS.GetNextRec(rec))) {
+        if (rc == RM_EOF) {
+            return SM_TABLE_DOES_NOT_EXIST;
+        }
+        return rc;
+    }
+    if ((rc = rec.GetData(recordData))) {
+        return rc;
+    }
+    rcRecord = (SM_RelcatRecord*) recordData;
+
+    // Update the tuple count
+    rcRecord->tupleCount += tupleDelta;
+    if (rcRecord->tupleCount < 0) {
+        rcRecord->tupleCount = 0;
+    }
+    if ((rc = relcatFH.UpdateRec(rec))) {
+        return rc;
+    }
 
     // Close the scan
     if ((rc = relcatFS.CloseScan())) {
         return rc;
     }
 
+    // Write back the system catalog
+    if ((rc = relcatFH.ForcePages())) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: UpdateDistinctCounts(const char* relName, int attrCount, const int distinctCounts[])
+// Update the distinct value counts of the attributes of a relation in attrcat
+/* Steps:
+    1) Start file scan of attrcat for relName
+    2) For each record, keep the larger of the stored and the new count
+*/
+RC SM_Manager::UpdateDistinctCounts(const char* relName, int attrCount, const int distinctCounts[]) {
+    // Check the parameters
+    if (relName == NULL) {
+        return SM_NULL_RELATION;
+    }
+    if (attrCount < 0) {
+        return SM_INCORRECT_ATTRIBUTE_COUNT;
+    }
+
+    int rc;
+    RM_FileScan attrcatFS;
+    RM_Record rec;
+    char* recordData;
+    SM_AttrcatRecord* acRecord;
+
+    // Start file scan
+    char relationName[MAXNAME+1];
+    strcpy(relationName, relName);
+    if ((rc = attrcatFS.OpenScan(attrcatFH, STRING, MAXNAME, 0, EQ_OP, relationName))) {
+        return rc;
+    }
+
+    // Update all the attribute tuples, in the order of GetAttrInfo
+    int i = 0;
+    while (rc != RM_EOF) {
+        rc = attrcatFS.GetNextRec(rec);
+        if (rc != 0 && rc != RM_EOF) {
+            return rc;
+        }
+
+        if (rc != RM_EOF) {
+            if (i == attrCount) {
+                return SM_INCORRECT_ATTRIBUTE_COUNT;
+            }
+
+            if ((rc = rec.GetData(recordData))) {
+                return rc;
+            }
+            acRecord = (SM_AttrcatRecord*) recordData;
+
+            // A load never removes values, so the distinct count only grows
+            if (distinctCounts[i] > acRecord->distinctCount) {
+                acRecord->distinctCount = distinctCounts[i];
+                if ((rc = attrcatFH.UpdateRec(rec))) {
+                    return rc;
+                }
+            }
+            i++;
+        }
+    }
+
+    // Close the scan
+    if ((rc = attrcatFS.CloseScan())) {
+        return rc;
+    }
+
+    // Write back the system catalog
+    if ((rc = attrcatFH.ForcePages())) {
+        return rc;
+    }
+
     // Return OK
     return OK_RC;
 }
 
+// Method: GetCommLayer()
+// EX - Get the communication layer to the data nodes, creating it the first time
+EX_CommLayer* SM_Manager::GetCommLayer() {
+    if (commLayer == NULL) {
+        commLayer = new EX_CommLayer(rmManager, ixManager, this);
+    }
+    return commLayer;
+}
+
+// Method: GetRoutingTable(const char* relName, const char* attrName, AttrType attrType,
+//                         const EX_RoutingTable* &routingTable)
+// EX - Get the partition vector of a distributed relation, loading it into the routing tables
+// the first time (the pointer is valid till the relation or the database changes)
+// The partitioning scheme is read from relcat when loading, so the master node must route
+RC SM_Manager::GetRoutingTable(const char* relName, const char* attrName, AttrType attrType,
+                               const EX_RoutingTable* &routingTable) {
+    // Look for a loaded partition vector
+    for (unsigned int i=0; i<routingTables.size(); i++) {
+        if (strcmp(routingTables[i]->relName, relName) == 0 && strcmp(routingTables[i]->attrName, attrName) == 0) {
+            routingTable = routingTables[i];
+            return OK_RC;
+        }
+    }
+
+    // Get the partitioning scheme
+    int rc;
+    SM_RelcatRecord rcRecord;
+    if ((rc = GetRelInfo(relName, &rcRecord))) {
+        return rc;
+    }
+
+    // Load the partition vector file
+    EX_RoutingTable* newTable = new EX_RoutingTable;
+    if ((rc = LoadRoutingTable(rmManager, relName, attrName, attrType, rcRecord.distributed, *newTable))) {
+        delete newTable;
+        return rc;
+    }
+    routingTables.push_back(newTable);
+    routingTable = newTable;
+
+    return OK_RC;
+}
+
+// Method: ClearRoutingTables(const char* relName)
+// EX - Drop the loaded partition vectors of a relation (of all the relations if NULL)
+void SM_Manager::ClearRoutingTables(const char* relName) {
+    unsigned int kept = 0;
+    for (unsigned int i=0; i<routingTables.size(); i++) {
+        if (relName == NULL || strcmp(routingTables[i]->relName, relName) == 0) {
+            delete routingTables[i];
+        }
+        else {
+            routingTables[kept++] = routingTables[i];
+        }
+    }
+    routingTables.resize(kept);
+}
+
 // Method to get the printCommands flag
 int SM_Manager::getPrintFlag() {
     return printCommands;
@@ -1785,3 +2220,13 @@ int SM_Manager::getOptimizeFlag() {
 int SM_Manager::getPartitionedPrintFlag() {
     return partitionedPrint;
 }
+
+// Method to get the sortMemory parameter
+int SM_Manager::getSortMemory() {
+    return sortMemory;
+}
+
+// Method to get the parallelism parameter
+int SM_Manager::getParallelism() {
+    return parallelism;
+}
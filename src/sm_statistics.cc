@@ -0,0 +1,646 @@
+//
+// File:        sm_statistics.cc
+// Description: Statistics of the relations kept in statcat (ANALYZE)
+// Authors:     Aditya Bhandari (adityasb@stanford.edu)
+//
+
+#include <cstdio>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "redbase.h"
+#include "sm.h"
+#include "ix.h"
+#include "rm.h"
+#include "ex.h"
+#include "printer.h"
+#include "parser.h"
+using namespace std;
+
+
+// Method: HashValue(const char* value, int length)
+// 64 bit hash of the bytes of a value (FNV-1a followed by a finalizer)
+static unsigned long long HashValue(const char* value, int length) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i=0; i<length; i++) {
+        hash ^= (unsigned char) value[i];
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+
+// Method: SM_HistogramKey(AttrType attrType, int attrLength, const char* value)
+// Map a value to the float key used by the histograms
+/* Keys:
+    1) INT - the integer as a float
+    2) FLOAT - the float
+    3) STRING - the first SM_HISTOGRAM_PREFIX characters as a base 256 number, which keeps the order
+*/
+float SM_HistogramKey(AttrType attrType, int attrLength, const char* value) {
+    if (attrType == INT) {
+        int intValue;
+        memcpy(&intValue, value, sizeof(int));
+        return (float) intValue;
+    }
+    else if (attrType == FLOAT) {
+        float floatValue;
+        memcpy(&floatValue, value, sizeof(float));
+        return floatValue;
+    }
+
+    float key = 0;
+    bool ended = false;
+    for (int i=0; i<SM_HISTOGRAM_PREFIX; i++) {
+        if (i >= attrLength || value[i] == '\0') {
+            ended = true;
+        }
+        key = key * 256 + (ended ? 0 : (unsigned char) value[i]);
+    }
+    return key;
+}
+
+// Method: SM_HistogramPrefix(float key, char* prefix)
+// Get the leading characters of a string from its histogram key
+// (prefix has space for SM_HISTOGRAM_PREFIX characters and the terminator)
+void SM_HistogramPrefix(float key, char* prefix) {
+    int code = (int) key;
+    for (int i=SM_HISTOGRAM_PREFIX-1; i>=0; i--) {
+        prefix[i] = (char) (code % 256);
+        code /= 256;
+    }
+    prefix[SM_HISTOGRAM_PREFIX] = '\0';
+}
+
+// Method: SM_HistogramFraction(const SM_StatcatRecord &statistics, float key)
+// Estimated fraction of the tuples with a key below the given key
+/* The tuples of each bucket are assumed to be spread uniformly between its bounds
+*/
+float SM_HistogramFraction(const SM_StatcatRecord &statistics, float key) {
+    if (statistics.tupleCount <= 0 || key <= statistics.minValue) {
+        return 0;
+    }
+    if (key >= statistics.maxValue) {
+        return 1;
+    }
+
+    // Find the bucket of the key
+    float lower = statistics.minValue;
+    for (int i=0; i<SM_HISTOGRAM_BUCKETS; i++) {
+        float upper = (i == SM_HISTOGRAM_BUCKETS-1) ? statistics.maxValue : statistics.bounds[i];
+        if (key < upper) {
+            float inside = upper > lower ? (key - lower) / (upper - lower) : 0;
+            return (i + inside) / SM_HISTOGRAM_BUCKETS;
+        }
+        lower = upper;
+    }
+    return 1;
+}
+
+// Method: SM_EstimateDistinct(const unsigned char registers[])
+// HyperLogLog estimate of the number of distinct values, with linear counting for small sets
+int SM_EstimateDistinct(const unsigned char registers[]) {
+    double m = SM_HLL_REGISTERS;
+    double alpha = 0.7213 / (1 + 1.079 / m);
+    double sum = 0;
+    int zeros = 0;
+    for (int i=0; i<SM_HLL_REGISTERS; i++) {
+        sum += ldexp(1.0, -registers[i]);
+        if (registers[i] == 0) {
+            zeros++;
+        }
+    }
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * log(m / zeros);
+    }
+    return (int) (estimate + 0.5);
+}
+
+// Method: CumulativeCount(const SM_StatcatRecord &statistics, float key)
+// Estimated number of tuples with a key below the given key
+static double CumulativeCount(const SM_StatcatRecord &statistics, float key) {
+    return (double) statistics.tupleCount * SM_HistogramFraction(statistics, key);
+}
+
+// Method: SM_MergeStatistics(SM_StatcatRecord &target, const SM_StatcatRecord &source)
+// Merge the statistics of another set of tuples of the same attribute into target
+/* Steps:
+    1) Add the tuple and page counts
+    2) Take the maximum of each HyperLogLog register
+    3) Combine the minimum and maximum
+    4) Re-bucket the two histograms: each new bound is where the combined number of tuples
+       below it reaches the next multiple of a bucket, interpolated between the old bounds
+*/
+void SM_MergeStatistics(SM_StatcatRecord &target, const SM_StatcatRecord &source) {
+    // Nothing to merge
+    if (source.tupleCount <= 0) {
+        target.pageCount += source.pageCount;
+        return;
+    }
+    if (target.tupleCount <= 0) {
+        int pageCount = target.pageCount;
+        char relName[MAXNAME+1];
+        char attrName[MAXNAME+1];
+        strcpy(relName, target.relName);
+        strcpy(attrName, target.attrName);
+        target = source;
+        strcpy(target.relName, relName);
+        strcpy(target.attrName, attrName);
+        target.pageCount += pageCount;
+        return;
+    }
+
+    // Re-bucket the histograms
+    vector<float> points;
+    points.push_back(target.minValue);
+    points.push_back(target.maxValue);
+    points.push_back(source.minValue);
+    points.push_back(source.maxValue);
+    for (int i=0; i<SM_HISTOGRAM_BUCKETS-1; i++) {
+        points.push_back(target.bounds[i]);
+        points.push_back(source.bounds[i]);
+    }
+    sort(points.begin(), points.end());
+
+    double total = (double) target.tupleCount + source.tupleCount;
+    float bounds[SM_HISTOGRAM_BUCKETS-1];
+    unsigned int j = 0;
+    double previousCount = 0;
+    for (int k=1; k<SM_HISTOGRAM_BUCKETS; k++) {
+        double quantile = total * k / SM_HISTOGRAM_BUCKETS;
+        double count = CumulativeCount(target, points[j]) + CumulativeCount(source, points[j]);
+        while (count < quantile && j+1 < points.size()) {
+            previousCount = count;
+            j++;
+            count = CumulativeCount(target, points[j]) + CumulativeCount(source, points[j]);
+        }
+        if (j == 0 || count <= previousCount) {
+            bounds[k-1] = points[j];
+        }
+        else {
+            double inside = (quantile - previousCount) / (count - previousCount);
+            bounds[k-1] = points[j-1] + (points[j] - points[j-1]) * inside;
+        }
+    }
+    memcpy(target.bounds, bounds, sizeof(bounds));
+    if (source.minValue < target.minValue) {
+        target.minValue = source.minValue;
+        strcpy(target.minPrefix, source.minPrefix);
+    }
+    if (source.maxValue > target.maxValue) {
+        target.maxValue = source.maxValue;
+        strcpy(target.maxPrefix, source.maxPrefix);
+    }
+
+    // Merge the sketches; a sampled side may know of more values than its registers
+    for (int i=0; i<SM_HLL_REGISTERS; i++) {
+        if (source.registers[i] > target.registers[i]) {
+            target.registers[i] = source.registers[i];
+        }
+    }
+    int distinctCount = SM_EstimateDistinct(target.registers);
+    if (target.distinctCount > distinctCount) distinctCount = target.distinctCount;
+    if (source.distinctCount > distinctCount) distinctCount = source.distinctCount;
+
+    // Add the counts
+    target.tupleCount += source.tupleCount;
+    target.pageCount += source.pageCount;
+    target.distinctCount = distinctCount < target.tupleCount ? distinctCount : target.tupleCount;
+}
+
+
+/********** SM_StatisticsBuilder class **********/
+
+// Constructor
+SM_StatisticsBuilder::SM_StatisticsBuilder(AttrType attrType, int attrLength) {
+    this->attrType = attrType;
+    this->attrLength = attrLength;
+    memset(registers, 0, SM_HLL_REGISTERS);
+}
+
+// Destructor
+SM_StatisticsBuilder::~SM_StatisticsBuilder() {
+    // Nothing to free
+}
+
+// Method: AddValue(const char* value)
+// Add a value, given in the form stored in the records
+void SM_StatisticsBuilder::AddValue(const char* value) {
+    keys.push_back(SM_HistogramKey(attrType, attrLength, value));
+
+    // The first bits of the hash pick the register, the rest give the rank
+    int length = attrType == STRING ? strnlen(value, attrLength) : attrLength;
+    unsigned long long hash = HashValue(value, length);
+    int registerIndex = hash >> 56;
+    unsigned long long rest = hash << 8;
+    unsigned char rank = 1;
+    while (rank <= 56 && !(rest & (1ULL << 63))) {
+        rest <<= 1;
+        rank++;
+    }
+    if (rank > registers[registerIndex]) {
+        registers[registerIndex] = rank;
+    }
+}
+
+// Method: GetValueCount()
+// Number of values added
+int SM_StatisticsBuilder::GetValueCount() {
+    return keys.size();
+}
+
+// Method: Build(SM_StatcatRecord &statistics)
+// Fill the distinct count, minimum, maximum (with the prefixes of strings), histogram bounds
+// and registers of the record
+/* Steps:
+    1) Sort the keys
+    2) The bounds are the keys at every multiple of a bucket of the values
+    3) Estimate the distinct values from the registers
+*/
+void SM_StatisticsBuilder::Build(SM_StatcatRecord &statistics) {
+    int valueCount = keys.size();
+    memcpy(statistics.registers, registers, SM_HLL_REGISTERS);
+    if (valueCount == 0) {
+        statistics.distinctCount = 0;
+        statistics.minValue = 0;
+        statistics.maxValue = 0;
+        statistics.minPrefix[0] = '\0';
+        statistics.maxPrefix[0] = '\0';
+        memset(statistics.bounds, 0, sizeof(statistics.bounds));
+        return;
+    }
+
+    sort(keys.begin(), keys.end());
+    statistics.minValue = keys[0];
+    statistics.maxValue = keys[valueCount-1];
+    statistics.minPrefix[0] = '\0';
+    statistics.maxPrefix[0] = '\0';
+    if (attrType == STRING) {
+        SM_HistogramPrefix(statistics.minValue, statistics.minPrefix);
+        SM_HistogramPrefix(statistics.maxValue, statistics.maxPrefix);
+    }
+    for (int k=1; k<SM_HISTOGRAM_BUCKETS; k++) {
+        statistics.bounds[k-1] = keys[(long long) k * valueCount / SM_HISTOGRAM_BUCKETS];
+    }
+
+    int distinctCount = SM_EstimateDistinct(registers);
+    statistics.distinctCount = distinctCount < valueCount ? distinctCount : valueCount;
+}
+
+
+/********** SM_Manager statistics methods **********/
+
+// Method: Analyze(const char *relName, int samplePercent)
+// Collect the statistics of relName in statcat
+/* Steps:
+    1) Check the parameters
+    2) Obtain attribute information for the relation
+    3) Compute the statistics
+        - Non-distributed relation: scan the relation (or a sample of its pages)
+        - EX - Distributed relation: analyze each data node and merge the statistics
+          (only the first data node for a replicated relation)
+    4) Replace the statcat records of the relation
+    5) Correct the tuple count in relcat, unless the pages were sampled
+*/
+RC SM_Manager::Analyze(const char *relName, int samplePercent) {
+    // Check that the database is open
+    if (!isOpen) {
+        return SM_DATABASE_CLOSED;
+    }
+
+    // Check the parameters
+    if (relName == NULL) {
+        return SM_NULL_RELATION;
+    }
+    if (strcmp(relName, "relcat") == 0 || strcmp(relName, "attrcat") == 0 || strcmp(relName, "statcat") == 0) {
+        return SM_SYSTEM_CATALOG;
+    }
+    if (samplePercent < 1 || samplePercent > 100) {
+        return SM_INVALID_VALUE;
+    }
+
+    // Print the command
+    if (printCommands) {
+        cout << "Analyze\n"
+             << "   relName      =" << relName << "\n"
+             << "   samplePercent=" << samplePercent << "\n";
+    }
+
+    // Get the relation and attributes information
+    int rc;
+    SM_RelcatRecord* rcRecord = new SM_RelcatRecord;
+    memset(rcRecord, 0, sizeof(SM_RelcatRecord));
+    if ((rc = GetRelInfo(relName, rcRecord))) {
+        delete rcRecord;
+        return rc;
+    }
+    int attrCount = rcRecord->attrCount;
+    int distributedRelation = rcRecord->distributed;
+    int oldTupleCount = rcRecord->tupleCount;
+    delete rcRecord;
+
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    if ((rc = GetAttrInfo(relName, attrCount, (char*) attributes))) {
+        delete[] attributes;
+        return rc;
+    }
+    SM_StatcatRecord* statistics = new SM_StatcatRecord[attrCount];
+    memset(statistics, 0, attrCount*sizeof(SM_StatcatRecord));
+    for (int i=0; i<attrCount; i++) {
+        strcpy(statistics[i].relName, relName);
+        strcpy(statistics[i].attrName, attributes[i].attrName);
+    }
+
+    // Non-distributed relation case
+    if (!distributedRelation) {
+        if ((rc = ComputeStatistics(relName, attrCount, attributes, samplePercent, statistics))) {
+            delete[] attributes;
+            delete[] statistics;
+            return rc;
+        }
+    }
+
+    // EX - Distributed relation case
+    // (the copy of a replicated relation in the first data node holds all its tuples)
+    else {
+        EX_CommLayer &commLayer = *GetCommLayer();
+        SM_StatcatRecord* nodeStatistics = new SM_StatcatRecord[attrCount];
+        int analyzedNodes = distributedRelation == EX_REPLICATED ? 1 : numberNodes;
+        for (int i=1; i<=analyzedNodes; i++) {
+            if ((rc = commLayer.AnalyzeInDataNode(relName, samplePercent, attrCount, nodeStatistics, i))) {
+                delete[] attributes;
+                delete[] statistics;
+                delete[] nodeStatistics;
+                return rc;
+            }
+            for (int j=0; j<attrCount; j++) {
+                SM_MergeStatistics(statistics[j], nodeStatistics[j]);
+            }
+        }
+        delete[] nodeStatistics;
+    }
+    delete[] attributes;
+
+    // Replace the statcat records
+    if ((rc = WriteStatistics(relName, attrCount, statistics))) {
+        delete[] statistics;
+        return rc;
+    }
+
+    // Correct the tuple count after a full scan, since distributed deletes do not maintain it
+    if (attrCount > 0 && samplePercent == 100) {
+        if ((rc = UpdateTupleCount(relName, statistics[0].tupleCount - oldTupleCount))) {
+            delete[] statistics;
+            return rc;
+        }
+    }
+    delete[] statistics;
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: ComputeStatistics(const char* relName, int attrCount, DataAttrInfo* attributes,
+//                           int samplePercent, SM_StatcatRecord* statistics)
+// Compute the statistics of a local relation from all its pages or a sample of them
+/* Steps:
+    1) Open the RM file and get its number of pages
+    2) Scan all the pages, or every (100 / samplePercent)th page
+        - Add each value to the builder of its attribute
+    3) Build the statistics, scaling the tuple count (and the distinct count of attributes
+       that look unique) by the fraction of the pages read
+*/
+RC SM_Manager::ComputeStatistics(const char* relName, int attrCount, DataAttrInfo* attributes,
+                                 int samplePercent, SM_StatcatRecord* statistics) {
+    int rc;
+    RM_FileHandle rmFH;
+    if ((rc = rmManager->OpenFile(relName, rmFH))) {
+        return rc;
+    }
+    int pageCount;
+    PageNum lastPage;
+    if ((rc = rmFH.GetNumPages(pageCount))) {
+        return rc;
+    }
+    if ((rc = rmFH.GetLastPageNum(lastPage))) {
+        return rc;
+    }
+
+    vector<SM_StatisticsBuilder> builders;
+    for (int i=0; i<attrCount; i++) {
+        builders.push_back(SM_StatisticsBuilder(attributes[i].attrType, attributes[i].attrLength));
+    }
+
+    // Scan the pages
+    RM_FileScan rmFS;
+    RM_Record rec;
+    char* recordData;
+    if ((rc = rmFS.OpenScan(rmFH, INT, 4, 0, NO_OP, NULL))) {
+        return rc;
+    }
+    int sampledPages = 0;
+    int sampledTuples = 0;
+    double step = 100.0 / samplePercent;
+    double page = 1;
+    while (page <= lastPage) {
+        PageNum startPage = (PageNum) page;
+        if (samplePercent < 100) {
+            if ((rc = rmFS.SetPageRange(startPage, startPage+1))) {
+                return rc;
+            }
+            page += step;
+        }
+        else {
+            page = lastPage + 1;
+        }
+
+        int pageTuples = 0;
+        while ((rc = rmFS.GetNextRec(rec)) != RM_EOF) {
+            if (rc) {
+                return rc;
+            }
+            if ((rc = rec.GetData(recordData))) {
+                return rc;
+            }
+            for (int i=0; i<attrCount; i++) {
+                builders[i].AddValue(recordData + attributes[i].offset);
+            }
+            pageTuples++;
+        }
+        sampledTuples += pageTuples;
+        if (samplePercent < 100 && pageTuples > 0) {
+            sampledPages++;
+        }
+    }
+    if ((rc = rmFS.CloseScan())) {
+        return rc;
+    }
+    if ((rc = rmManager->CloseFile(rmFH))) {
+        return rc;
+    }
+
+    // Build the statistics
+    double scale = 1;
+    if (samplePercent < 100 && sampledPages > 0 && pageCount > sampledPages) {
+        scale = (double) pageCount / sampledPages;
+    }
+    for (int i=0; i<attrCount; i++) {
+        builders[i].Build(statistics[i]);
+        statistics[i].tupleCount = (int) (sampledTuples * scale + 0.5);
+        statistics[i].pageCount = pageCount;
+        if (scale > 1 && statistics[i].distinctCount >= 0.9 * sampledTuples) {
+            statistics[i].distinctCount = (int) (statistics[i].distinctCount * scale + 0.5);
+        }
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: WriteStatistics(const char* relName, int attrCount, const SM_StatcatRecord* statistics)
+// Replace the statcat records of a relation
+RC SM_Manager::WriteStatistics(const char* relName, int attrCount, const SM_StatcatRecord* statistics) {
+    int rc;
+    if ((rc = DeleteStatistics(relName))) {
+        return rc;
+    }
+
+    // Insert a record for each attribute
+    RID rid;
+    for (int i=0; i<attrCount; i++) {
+        if ((rc = statcatFH.InsertRec((const char*) &statistics[i], rid))) {
+            return rc;
+        }
+    }
+
+    // Write back the system catalog
+    if ((rc = statcatFH.ForcePages())) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: DeleteStatistics(const char* relName)
+// Delete the statcat records of a relation
+RC SM_Manager::DeleteStatistics(const char* relName) {
+    int rc;
+    RM_FileScan statcatFS;
+    RM_Record rec;
+    RID rid;
+
+    // Start file scan
+    char relationName[MAXNAME+1];
+    strcpy(relationName, relName);
+    if ((rc = statcatFS.OpenScan(statcatFH, STRING, MAXNAME, 0, EQ_OP, relationName))) {
+        return rc;
+    }
+
+    // Delete the records
+    while ((rc = statcatFS.GetNextRec(rec)) != RM_EOF) {
+        if (rc) {
+            return rc;
+        }
+        if ((rc = rec.GetRid(rid))) {
+            return rc;
+        }
+        if ((rc = statcatFH.DeleteRec(rid))) {
+            return rc;
+        }
+    }
+
+    // Close the scan
+    if ((rc = statcatFS.CloseScan())) {
+        return rc;
+    }
+
+    // Write back the system catalog
+    if ((rc = statcatFH.ForcePages())) {
+        return rc;
+    }
+
+    // Return OK
+    return OK_RC;
+}
+
+
+// Method: GetStatInfo(const char* relName, int attrCount, SM_StatcatRecord* statistics, int &found)
+// Get the statcat records of a relation, in the order of GetAttrInfo
+/* Steps:
+    1) Get the attributes of the relation
+    2) Start file scan of statcat for relName
+    3) Copy each record to the position of its attribute
+    4) Set found if every attribute has a record
+*/
+RC SM_Manager::GetStatInfo(const char* relName, int attrCount, SM_StatcatRecord* statistics, int &found) {
+    // Check the parameters
+    if (relName == NULL) {
+        return SM_NULL_RELATION;
+    }
+    if (statistics == NULL) {
+        return SM_NULL_ATTRIBUTES;
+    }
+
+    // Get the attributes
+    int rc;
+    DataAttrInfo* attributes = new DataAttrInfo[attrCount];
+    if ((rc = GetAttrInfo(relName, attrCount, (char*) attributes))) {
+        delete[] attributes;
+        return rc;
+    }
+
+    // Start file scan
+    RM_FileScan statcatFS;
+    RM_Record rec;
+    char* recordData;
+    char relationName[MAXNAME+1];
+    strcpy(relationName, relName);
+    if ((rc = statcatFS.OpenScan(statcatFH, STRING, MAXNAME, 0, EQ_OP, relationName))) {
+        delete[] attributes;
+        return rc;
+    }
+
+    // Copy the records
+    int foundCount = 0;
+    while ((rc = statcatFS.GetNextRec(rec)) != RM_EOF) {
+        if (rc) {
+            delete[] attributes;
+            return rc;
+        }
+        if ((rc = rec.GetData(recordData))) {
+            delete[] attributes;
+            return rc;
+        }
+        SM_StatcatRecord* scRecord = (SM_StatcatRecord*) recordData;
+        for (int i=0; i<attrCount; i++) {
+            if (strcmp(attributes[i].attrName, scRecord->attrName) == 0) {
+                memcpy(&statistics[i], scRecord, sizeof(SM_StatcatRecord));
+                foundCount++;
+                break;
+            }
+        }
+    }
+    delete[] attributes;
+
+    // Close the scan
+    if ((rc = statcatFS.CloseScan())) {
+        return rc;
+    }
+
+    found = (foundCount == attrCount) ? TRUE : FALSE;
+
+    // Return OK
+    return OK_RC;
+}
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_Y_TAB_H_INCLUDED
 # define YY_YY_Y_TAB_H_INCLUDED
 /* Debug traces.  */
@@ -40,53 +45,74 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    RW_CREATE = 258,
-    RW_DROP = 259,
-    RW_TABLE = 260,
-    RW_INDEX = 261,
-    RW_LOAD = 262,
-    RW_SET = 263,
-    RW_HELP = 264,
-    RW_PRINT = 265,
-    RW_EXIT = 266,
-    RW_SELECT = 267,
-    RW_FROM = 268,
-    RW_WHERE = 269,
-    RW_INSERT = 270,
-    RW_DELETE = 271,
-    RW_UPDATE = 272,
-    RW_AND = 273,
-    RW_INTO = 274,
-    RW_VALUES = 275,
-    T_EQ = 276,
-    T_LT = 277,
-    T_LE = 278,
-    T_GT = 279,
-    T_GE = 280,
-    T_NE = 281,
-    T_EOF = 282,
-    NOTOKEN = 283,
-    RW_RESET = 284,
-    RW_IO = 285,
-    RW_BUFFER = 286,
-    RW_RESIZE = 287,
-    RW_QUERY_PLAN = 288,
-    RW_ON = 289,
-    RW_OFF = 290,
-    RW_DISTRIBUTED = 291,
-    T_INT = 292,
-    T_REAL = 293,
-    T_STRING = 294,
-    T_QSTRING = 295,
-    T_SHELL_CMD = 296
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    RW_CREATE = 258,               /* RW_CREATE  */
+    RW_DROP = 259,                 /* RW_DROP  */
+    RW_TABLE = 260,                /* RW_TABLE  */
+    RW_INDEX = 261,                /* RW_INDEX  */
+    RW_LOAD = 262,                 /* RW_LOAD  */
+    RW_SET = 263,                  /* RW_SET  */
+    RW_HELP = 264,                 /* RW_HELP  */
+    RW_PRINT = 265,                /* RW_PRINT  */
+    RW_EXIT = 266,                 /* RW_EXIT  */
+    RW_SELECT = 267,               /* RW_SELECT  */
+    RW_FROM = 268,                 /* RW_FROM  */
+    RW_WHERE = 269,                /* RW_WHERE  */
+    RW_INSERT = 270,               /* RW_INSERT  */
+    RW_DELETE = 271,               /* RW_DELETE  */
+    RW_UPDATE = 272,               /* RW_UPDATE  */
+    RW_AND = 273,                  /* RW_AND  */
+    RW_INTO = 274,                 /* RW_INTO  */
+    RW_VALUES = 275,               /* RW_VALUES  */
+    T_EQ = 276,                    /* T_EQ  */
+    T_LT = 277,                    /* T_LT  */
+    T_LE = 278,                    /* T_LE  */
+    T_GT = 279,                    /* T_GT  */
+    T_GE = 280,                    /* T_GE  */
+    T_NE = 281,                    /* T_NE  */
+    T_EOF = 282,                   /* T_EOF  */
+    NOTOKEN = 283,                 /* NOTOKEN  */
+    RW_RESET = 284,                /* RW_RESET  */
+    RW_IO = 285,                   /* RW_IO  */
+    RW_BUFFER = 286,               /* RW_BUFFER  */
+    RW_RESIZE = 287,               /* RW_RESIZE  */
+    RW_QUERY_PLAN = 288,           /* RW_QUERY_PLAN  */
+    RW_ON = 289,                   /* RW_ON  */
+    RW_OFF = 290,                  /* RW_OFF  */
+    RW_DISTRIBUTED = 291,          /* RW_DISTRIBUTED  */
+    RW_USING = 292,                /* RW_USING  */
+    RW_HASH = 293,                 /* RW_HASH  */
+    RW_REPLICATED = 294,           /* RW_REPLICATED  */
+    RW_ORDER = 295,                /* RW_ORDER  */
+    RW_BY = 296,                   /* RW_BY  */
+    RW_LIMIT = 297,                /* RW_LIMIT  */
+    RW_ASC = 298,                  /* RW_ASC  */
+    RW_DESC = 299,                 /* RW_DESC  */
+    RW_GROUP = 300,                /* RW_GROUP  */
+    RW_ANALYZE = 301,              /* RW_ANALYZE  */
+    RW_SAMPLE = 302,               /* RW_SAMPLE  */
+    RW_EXPLAIN = 303,              /* RW_EXPLAIN  */
+    T_INT = 304,                   /* T_INT  */
+    T_REAL = 305,                  /* T_REAL  */
+    T_STRING = 306,                /* T_STRING  */
+    T_QSTRING = 307,               /* T_QSTRING  */
+    T_SHELL_CMD = 308              /* T_SHELL_CMD  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define RW_CREATE 258
 #define RW_DROP 259
 #define RW_TABLE 260
@@ -121,18 +147,29 @@ extern int yydebug;
 #define RW_ON 289
 #define RW_OFF 290
 #define RW_DISTRIBUTED 291
-#define T_INT 292
-#define T_REAL 293
-#define T_STRING 294
-#define T_QSTRING 295
-#define T_SHELL_CMD 296
+#define RW_USING 292
+#define RW_HASH 293
+#define RW_REPLICATED 294
+#define RW_ORDER 295
+#define RW_BY 296
+#define RW_LIMIT 297
+#define RW_ASC 298
+#define RW_DESC 299
+#define RW_GROUP 300
+#define RW_ANALYZE 301
+#define RW_SAMPLE 302
+#define RW_EXPLAIN 303
+#define T_INT 304
+#define T_REAL 305
+#define T_STRING 306
+#define T_QSTRING 307
+#define T_SHELL_CMD 308
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 72 "parse.y" /* yacc.c:1909  */
+#line 74 "parse.y"
 
     int ival;
     CompOp cval;
@@ -140,8 +177,10 @@ union YYSTYPE
     char *sval;
     NODE *n;
 
-#line 144 "y.tab.h" /* yacc.c:1909  */
+#line 181 "y.tab.h"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
@@ -149,6 +188,8 @@ union YYSTYPE
 
 extern YYSTYPE yylval;
 
+
 int yyparse (void);
 
+
 #endif /* !YY_YY_Y_TAB_H_INCLUDED  */